@@ -0,0 +1,11 @@
+#!/bin/sh
+cd source/external/gitsubmodules/PhysX/physx
+
+./generate_projects.sh linux
+
+cd compiler/linux-release
+make
+
+cd ../../
+cp bin/linux.clang/release/*.a ../../../lib/linux
+cp bin/linux.clang/release/*.so ../../../lib/linux
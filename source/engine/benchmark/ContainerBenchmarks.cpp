@@ -0,0 +1,205 @@
+#include "InnoBenchmark.h"
+#include "../common/InnoAllocator.h"
+
+INNO_PRIVATE_SCOPE InnoBenchmark
+{
+	const std::vector<size_t> m_containerSizes = { 64, 1024, 16384 };
+	const unsigned long long m_poolCapability = 16384;
+
+	// the size of a small component
+	struct PooledObject
+	{
+		float m_data[16];
+	};
+
+	void registerQueueBenchmarks();
+	void registerAllocatorBenchmarks();
+	void registerMapBenchmarks();
+}
+
+void InnoBenchmark::registerQueueBenchmarks()
+{
+	registerBenchmark("ThreadSafeQueue/push_pop", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_queue = std::make_shared<ThreadSafeQueue<size_t>>();
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				l_queue->push(i);
+			}
+			size_t l_value;
+			while (l_queue->tryPop(l_value))
+			{
+				doNotOptimize(l_value);
+			}
+		};
+	});
+
+	// one producer thread and one consumer thread, the thread creation is included
+	registerBenchmark("ThreadSafeQueue/producer_consumer", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_queue = std::make_shared<ThreadSafeQueue<size_t>>();
+		return [=]() {
+			std::thread l_producer([=]() {
+				for (size_t i = 0; i < size; i++)
+				{
+					l_queue->push(i);
+				}
+			});
+
+			size_t l_value;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_queue->waitPop(l_value);
+			}
+			doNotOptimize(l_value);
+
+			l_producer.join();
+		};
+	});
+
+	registerBenchmark("RingBuffer/push_pop", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_ringBuffer = std::make_shared<RingBuffer<size_t, 256>>();
+		return [=]() {
+			size_t l_value;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_ringBuffer->push(i);
+				if (l_ringBuffer->full())
+				{
+					while (l_ringBuffer->pop(l_value))
+					{
+						doNotOptimize(l_value);
+					}
+				}
+			}
+			l_ringBuffer->clear();
+		};
+	});
+}
+
+void InnoBenchmark::registerAllocatorBenchmarks()
+{
+	registerBenchmark("componentPool/allocate_free", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_pool = std::make_shared<componentPool<PooledObject, m_poolCapability>>();
+		l_pool->allocateInitialFreeChunks();
+		auto l_objects = std::make_shared<std::vector<PooledObject*>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_objects)[i] = l_pool->allocate();
+			}
+			doNotOptimize(*l_objects);
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_objects)[i]->~PooledObject();
+				l_pool->free((*l_objects)[i]);
+			}
+		};
+	});
+
+	registerBenchmark("operator_new/allocate_free", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_objects = std::make_shared<std::vector<PooledObject*>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_objects)[i] = new PooledObject();
+			}
+			doNotOptimize(*l_objects);
+			for (size_t i = 0; i < size; i++)
+			{
+				delete (*l_objects)[i];
+			}
+		};
+	});
+
+	registerBenchmark("SmallVector/push_back_4", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				SmallVector<size_t, 4> l_vector;
+				for (size_t j = 0; j < 4; j++)
+				{
+					l_vector.push_back(j);
+				}
+				doNotOptimize(l_vector);
+			}
+		};
+	});
+
+	registerBenchmark("std_vector/push_back_4", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				std::vector<size_t> l_vector;
+				for (size_t j = 0; j < 4; j++)
+				{
+					l_vector.push_back(j);
+				}
+				doNotOptimize(l_vector);
+			}
+		};
+	});
+}
+
+void InnoBenchmark::registerMapBenchmarks()
+{
+	registerBenchmark("FlatHashMap/insert", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		return [=]() {
+			FlatHashMap<size_t, size_t> l_map;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_map.emplace(i * 2654435761u, i);
+			}
+			doNotOptimize(l_map);
+		};
+	});
+
+	registerBenchmark("FlatHashMap/find", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_map = std::make_shared<FlatHashMap<size_t, size_t>>();
+		for (size_t i = 0; i < size; i++)
+		{
+			l_map->emplace(i * 2654435761u, i);
+		}
+		return [=]() {
+			size_t l_sum = 0;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_sum += l_map->find(i * 2654435761u)->second;
+			}
+			doNotOptimize(l_sum);
+		};
+	});
+
+	registerBenchmark("std_unordered_map/insert", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		return [=]() {
+			std::unordered_map<size_t, size_t> l_map;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_map.emplace(i * 2654435761u, i);
+			}
+			doNotOptimize(l_map);
+		};
+	});
+
+	registerBenchmark("std_unordered_map/find", m_containerSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_map = std::make_shared<std::unordered_map<size_t, size_t>>();
+		for (size_t i = 0; i < size; i++)
+		{
+			l_map->emplace(i * 2654435761u, i);
+		}
+		return [=]() {
+			size_t l_sum = 0;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_sum += l_map->find(i * 2654435761u)->second;
+			}
+			doNotOptimize(l_sum);
+		};
+	});
+}
+
+void InnoBenchmark::registerContainerBenchmarks()
+{
+	registerQueueBenchmarks();
+	registerAllocatorBenchmarks();
+	registerMapBenchmarks();
+}
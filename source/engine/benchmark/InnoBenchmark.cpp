@@ -0,0 +1,284 @@
+#include "InnoBenchmark.h"
+#include "../common/InnoMath.h"
+
+#include "json/json.hpp"
+using json = nlohmann::json;
+
+// usage: InnoBenchmark [--filter <substring>] [--out <file>] [--baseline <file>] [--threshold <ratio>] [--min-time <ms>]
+// the results are written as JSON to the output file or stdout, the comparison to the baseline is printed to stderr,
+// the exit code is 1 when the fastest sample of any benchmark is slower than the baseline by more than the threshold,
+// the fastest sample is less sensitive to the other load on the machine than the median
+INNO_PRIVATE_SCOPE InnoBenchmark
+{
+	struct BenchmarkCase
+	{
+		std::string m_name;
+		std::vector<size_t> m_sizes;
+		BenchmarkSetup m_setup;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string m_name;
+		size_t m_size;
+		size_t m_callsPerSample;
+		double m_nsPerItem;
+		double m_nsPerItemMin;
+	};
+
+	std::vector<BenchmarkCase>& getBenchmarkCases();
+
+	BenchmarkResult run(const BenchmarkCase& benchmarkCase, size_t size);
+	json getContext();
+	bool compare(const json& results, const json& baseline, double threshold);
+
+	const size_t m_sampleCount = 9;
+	std::chrono::nanoseconds m_minSampleTime = std::chrono::milliseconds(20);
+}
+
+std::vector<InnoBenchmark::BenchmarkCase>& InnoBenchmark::getBenchmarkCases()
+{
+	static std::vector<BenchmarkCase> l_cases;
+	return l_cases;
+}
+
+void InnoBenchmark::registerBenchmark(const std::string& name, const std::vector<size_t>& sizes, BenchmarkSetup setup)
+{
+	getBenchmarkCases().emplace_back(BenchmarkCase{ name, sizes, std::move(setup) });
+}
+
+InnoBenchmark::BenchmarkResult InnoBenchmark::run(const BenchmarkCase& benchmarkCase, size_t size)
+{
+	auto l_function = benchmarkCase.m_setup(size);
+
+	// warm up and calibrate the calls per sample to reach the minimum sample time
+	size_t l_callsPerSample = 1;
+	while (true)
+	{
+		auto l_begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < l_callsPerSample; i++)
+		{
+			l_function();
+		}
+		auto l_elapsed = std::chrono::steady_clock::now() - l_begin;
+
+		if (l_elapsed >= m_minSampleTime)
+		{
+			break;
+		}
+		l_callsPerSample *= 2;
+	}
+
+	std::vector<double> l_samples;
+	l_samples.reserve(m_sampleCount);
+
+	for (size_t i = 0; i < m_sampleCount; i++)
+	{
+		auto l_begin = std::chrono::steady_clock::now();
+		for (size_t j = 0; j < l_callsPerSample; j++)
+		{
+			l_function();
+		}
+		auto l_elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - l_begin).count();
+
+		l_samples.emplace_back(l_elapsed / double(l_callsPerSample * size));
+	}
+
+	std::sort(l_samples.begin(), l_samples.end());
+
+	return BenchmarkResult{ benchmarkCase.m_name, size, l_callsPerSample, l_samples[m_sampleCount / 2], l_samples[0] };
+}
+
+json InnoBenchmark::getContext()
+{
+	json l_context;
+
+#if defined (INNO_MATH_USE_AVX)
+	l_context["simd"] = "AVX";
+#elif defined (INNO_MATH_USE_SSE)
+	l_context["simd"] = "SSE";
+#else
+	l_context["simd"] = "none";
+#endif
+
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+	l_context["memory_layout"] = "column-major";
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+	l_context["memory_layout"] = "row-major";
+#endif
+
+#if defined (_MSC_VER)
+	l_context["compiler"] = "MSVC " + std::to_string(_MSC_VER);
+#elif defined (__clang__)
+	l_context["compiler"] = std::string("Clang ") + __clang_version__;
+#elif defined (__GNUC__)
+	l_context["compiler"] = std::string("GCC ") + __VERSION__;
+#endif
+
+#if defined (NDEBUG)
+	l_context["build_type"] = "release";
+#else
+	l_context["build_type"] = "debug";
+#endif
+
+	l_context["hardware_threads"] = std::thread::hardware_concurrency();
+	l_context["sample_count"] = m_sampleCount;
+	l_context["min_sample_time_ms"] = std::chrono::duration<double, std::milli>(m_minSampleTime).count();
+
+	return l_context;
+}
+
+bool InnoBenchmark::compare(const json& results, const json& baseline, double threshold)
+{
+	if (results["context"] != baseline["context"])
+	{
+		std::cerr << "InnoBenchmark: the baseline was measured in a different context, the comparison is only indicative:" << std::endl;
+		std::cerr << "    current:  " << results["context"].dump() << std::endl;
+		std::cerr << "    baseline: " << baseline["context"].dump() << std::endl;
+	}
+
+	std::map<std::pair<std::string, size_t>, double> l_baselineResults;
+	for (auto& i : baseline["benchmarks"])
+	{
+		l_baselineResults.emplace(std::make_pair(i["name"].get<std::string>(), i["size"].get<size_t>()), i["ns_per_item_min"].get<double>());
+	}
+
+	size_t l_regressionCount = 0;
+
+	std::cerr << std::left << std::setw(40) << "benchmark" << std::right << std::setw(10) << "size" << std::setw(14) << "baseline ns" << std::setw(14) << "current ns" << std::setw(10) << "ratio" << std::endl;
+
+	for (auto& i : results["benchmarks"])
+	{
+		auto l_name = i["name"].get<std::string>();
+		auto l_size = i["size"].get<size_t>();
+		auto l_current = i["ns_per_item_min"].get<double>();
+
+		std::cerr << std::left << std::setw(40) << l_name << std::right << std::setw(10) << l_size;
+
+		auto l_result = l_baselineResults.find(std::make_pair(l_name, l_size));
+		if (l_result == l_baselineResults.end())
+		{
+			std::cerr << std::setw(14) << "-" << std::setw(14) << std::fixed << std::setprecision(3) << l_current << std::setw(10) << "new" << std::endl;
+			continue;
+		}
+
+		auto l_ratio = l_current / l_result->second;
+		auto l_regressed = l_ratio > 1.0 + threshold;
+		if (l_regressed)
+		{
+			l_regressionCount++;
+		}
+
+		std::cerr << std::setw(14) << std::fixed << std::setprecision(3) << l_result->second << std::setw(14) << l_current << std::setw(10) << std::setprecision(2) << l_ratio << (l_regressed ? "  REGRESSED" : "") << std::endl;
+	}
+
+	std::cerr << "InnoBenchmark: " << l_regressionCount << " regression(s) beyond " << threshold * 100.0 << "%" << std::endl;
+
+	return l_regressionCount == 0;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string l_filter;
+	std::string l_outputPath;
+	std::string l_baselinePath;
+	double l_threshold = 0.15;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string l_arg = argv[i];
+		auto l_hasValue = i + 1 < argc;
+
+		if (l_arg == "--filter" && l_hasValue)
+		{
+			l_filter = argv[++i];
+		}
+		else if (l_arg == "--out" && l_hasValue)
+		{
+			l_outputPath = argv[++i];
+		}
+		else if (l_arg == "--baseline" && l_hasValue)
+		{
+			l_baselinePath = argv[++i];
+		}
+		else if (l_arg == "--threshold" && l_hasValue)
+		{
+			l_threshold = std::stod(argv[++i]);
+		}
+		else if (l_arg == "--min-time" && l_hasValue)
+		{
+			InnoBenchmark::m_minSampleTime = std::chrono::milliseconds(std::stoll(argv[++i]));
+		}
+		else
+		{
+			std::cerr << "usage: InnoBenchmark [--filter <substring>] [--out <file>] [--baseline <file>] [--threshold <ratio>] [--min-time <ms>]" << std::endl;
+			return 2;
+		}
+	}
+
+	InnoBenchmark::registerMathBenchmarks();
+	InnoBenchmark::registerContainerBenchmarks();
+
+	json l_results;
+	l_results["context"] = InnoBenchmark::getContext();
+	l_results["benchmarks"] = json::array();
+
+	for (auto& i : InnoBenchmark::getBenchmarkCases())
+	{
+		if (!l_filter.empty() && i.m_name.find(l_filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (auto l_size : i.m_sizes)
+		{
+			auto l_result = InnoBenchmark::run(i, l_size);
+
+			std::cerr << std::left << std::setw(40) << l_result.m_name << std::right << std::setw(10) << l_result.m_size << std::setw(14) << std::fixed << std::setprecision(3) << l_result.m_nsPerItem << " ns/item" << std::endl;
+
+			json l_entry;
+			l_entry["name"] = l_result.m_name;
+			l_entry["size"] = l_result.m_size;
+			l_entry["ns_per_item"] = l_result.m_nsPerItem;
+			l_entry["ns_per_item_min"] = l_result.m_nsPerItemMin;
+			l_entry["items_per_second"] = 1.0e9 / l_result.m_nsPerItem;
+			l_entry["calls_per_sample"] = l_result.m_callsPerSample;
+			l_results["benchmarks"].emplace_back(l_entry);
+		}
+	}
+
+	if (l_outputPath.empty())
+	{
+		std::cout << l_results.dump(4) << std::endl;
+	}
+	else
+	{
+		std::ofstream l_file(l_outputPath);
+		if (!l_file.is_open())
+		{
+			std::cerr << "InnoBenchmark: can't open " << l_outputPath << " for writing!" << std::endl;
+			return 2;
+		}
+		l_file << l_results.dump(4) << std::endl;
+	}
+
+	if (!l_baselinePath.empty())
+	{
+		std::ifstream l_file(l_baselinePath);
+		if (!l_file.is_open())
+		{
+			std::cerr << "InnoBenchmark: can't open baseline " << l_baselinePath << "!" << std::endl;
+			return 2;
+		}
+
+		json l_baseline;
+		l_file >> l_baseline;
+
+		if (!InnoBenchmark::compare(l_results, l_baseline, l_threshold))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "../common/InnoType.h"
+
+// a minimal microbenchmark harness without any window or graphics dependency,
+// the setup runs outside of the timing and returns the timed function, which should process "size" items per call
+INNO_PRIVATE_SCOPE InnoBenchmark
+{
+	using BenchmarkFunction = std::function<void()>;
+	using BenchmarkSetup = std::function<BenchmarkFunction(size_t size)>;
+
+	void registerBenchmark(const std::string& name, const std::vector<size_t>& sizes, BenchmarkSetup setup);
+
+	void registerMathBenchmarks();
+	void registerContainerBenchmarks();
+
+	// keep the value alive for the optimizer without any memory traffic
+	template<class T>
+	inline void doNotOptimize(const T& value)
+	{
+#if defined (_MSC_VER)
+		static const void* volatile l_sink;
+		l_sink = &value;
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+}
@@ -0,0 +1,483 @@
+#include "InnoBenchmark.h"
+#include "../common/InnoMath.h"
+
+INNO_PRIVATE_SCOPE InnoBenchmark
+{
+	const std::vector<size_t> m_mathSizes = { 64, 1024, 16384 };
+
+	std::mt19937 m_generator(42);
+
+	float randomFloat(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(m_generator);
+	}
+
+	vec4 randomVec4(float w)
+	{
+		return vec4(randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f), w);
+	}
+
+	vec4 randomQuat()
+	{
+		return vec4(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)).normalize();
+	}
+
+	vec4 randomScale()
+	{
+		return vec4(randomFloat(0.5f, 2.0f), randomFloat(0.5f, 2.0f), randomFloat(0.5f, 2.0f), 1.0f);
+	}
+
+	mat4 randomTransformationMatrix()
+	{
+		return InnoMath::composeTransformationMatrix(randomVec4(1.0f), randomQuat(), randomScale());
+	}
+
+	vec4 transform(const mat4& m, const vec4& v)
+	{
+		//Column-Major memory layout
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+		return InnoMath::mul(v, m);
+#endif
+		//Row-Major memory layout
+#if defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+		return InnoMath::mul(m, v);
+#endif
+	}
+
+	template<class Generator>
+	std::vector<vec4> generateVec4s(size_t size, Generator&& generator)
+	{
+		std::vector<vec4> l_result(size);
+		for (auto& i : l_result)
+		{
+			i = generator();
+		}
+		return l_result;
+	}
+
+	std::vector<float> generateFloats(size_t size, float min, float max)
+	{
+		std::vector<float> l_result(size);
+		for (auto& i : l_result)
+		{
+			i = randomFloat(min, max);
+		}
+		return l_result;
+	}
+
+	std::vector<mat4> generateMat4s(size_t size)
+	{
+		std::vector<mat4> l_result(size);
+		for (auto& i : l_result)
+		{
+			i = randomTransformationMatrix();
+		}
+		return l_result;
+	}
+
+	void registerVectorBenchmarks();
+	void registerMatrixBenchmarks();
+	void registerIntersectionBenchmarks();
+	void registerTrigonometryBenchmarks();
+	void registerBatchBenchmarks();
+}
+
+void InnoBenchmark::registerVectorBenchmarks()
+{
+	registerBenchmark("vec4/add", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i] + (*l_b)[i];
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("vec4/dot", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		return [=]() {
+			float l_sum = 0.0f;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_sum += (*l_a)[i] * (*l_b)[i];
+			}
+			doNotOptimize(l_sum);
+		};
+	});
+
+	registerBenchmark("vec4/cross", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(0.0f); }));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(0.0f); }));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i].cross((*l_b)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("vec4/normalize", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i].normalize();
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("quat/mul", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i].quatMul((*l_b)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("quat/slerp", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::slerp((*l_a)[i], (*l_b)[i], 0.3f);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("quat/nlerp", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::nlerp((*l_a)[i], (*l_b)[i], 0.3f);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+}
+
+void InnoBenchmark::registerMatrixBenchmarks()
+{
+	registerBenchmark("mat4/mul_mat4", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<mat4>>(generateMat4s(size));
+		auto l_b = std::make_shared<std::vector<mat4>>(generateMat4s(size));
+		auto l_c = std::make_shared<std::vector<mat4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i] * (*l_b)[i];
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("mat4/mul_vec4", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_m = randomTransformationMatrix();
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = transform(l_m, (*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("mat4/inverse", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<mat4>>(generateMat4s(size));
+		auto l_c = std::make_shared<std::vector<mat4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i].inverse();
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("mat4/inverse_affine", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<mat4>>(generateMat4s(size));
+		auto l_c = std::make_shared<std::vector<mat4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = (*l_a)[i].inverseAffine();
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("mat4/trs_product", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_pos = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_rot = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_scale = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomScale));
+		auto l_c = std::make_shared<std::vector<mat4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::toTranslationMatrix((*l_pos)[i]) * InnoMath::toRotationMatrix((*l_rot)[i]) * InnoMath::toScaleMatrix((*l_scale)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("mat4/trs_compose", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_pos = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_rot = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_scale = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomScale));
+		auto l_c = std::make_shared<std::vector<mat4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::composeTransformationMatrix((*l_pos)[i], (*l_rot)[i], (*l_scale)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+}
+
+void InnoBenchmark::registerIntersectionBenchmarks()
+{
+	registerBenchmark("intersect/aabb_ray", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_AABBs = std::make_shared<std::vector<AABB>>(size);
+		for (auto& i : *l_AABBs)
+		{
+			i.m_center = randomVec4(1.0f);
+			i.m_extend = randomScale() * 10.0f;
+			i.m_extend.w = 0.0f;
+			i.m_boundMax = i.m_center + i.m_extend * 0.5f;
+			i.m_boundMin = i.m_center - i.m_extend * 0.5f;
+		}
+
+		Ray l_ray;
+		l_ray.m_origin = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		l_ray.m_direction = randomVec4(0.0f).normalize();
+
+		return [=]() {
+			size_t l_hitCount = 0;
+			for (size_t i = 0; i < size; i++)
+			{
+				l_hitCount += InnoMath::intersectCheck((*l_AABBs)[i], l_ray);
+			}
+			doNotOptimize(l_hitCount);
+		};
+	});
+
+	registerBenchmark("intersect/frustum_spheres", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_frustum = InnoMath::makeFrustum(InnoMath::generatePerspectiveMatrix((90.0f / 180.0f) * PI<float>, 16.0f / 9.0f, 0.1f, 200.0f));
+		auto l_spheres = std::make_shared<SphereSoA>();
+		l_spheres->reserve(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			l_spheres->emplace_back(randomVec4(1.0f), randomFloat(1.0f, 10.0f));
+		}
+		auto l_result = std::make_shared<std::vector<unsigned char>>(size);
+
+		return [=]() {
+			auto l_visibleCount = InnoMath::intersectCheck(l_frustum, *l_spheres, 0, size, l_result->data());
+			doNotOptimize(l_visibleCount);
+		};
+	});
+
+	registerBenchmark("intersect/frustum_aabbs", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_frustum = InnoMath::makeFrustum(InnoMath::generatePerspectiveMatrix((90.0f / 180.0f) * PI<float>, 16.0f / 9.0f, 0.1f, 200.0f));
+		auto l_AABBs = std::make_shared<AABBSoA>();
+		l_AABBs->reserve(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			l_AABBs->emplace_back(randomVec4(1.0f), randomScale() * 5.0f);
+		}
+		auto l_result = std::make_shared<std::vector<unsigned char>>(size);
+
+		return [=]() {
+			auto l_visibleCount = InnoMath::intersectCheck(l_frustum, *l_AABBs, 0, size, l_result->data());
+			doNotOptimize(l_visibleCount);
+		};
+	});
+}
+
+void InnoBenchmark::registerTrigonometryBenchmarks()
+{
+	registerBenchmark("trig/sin_std", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = std::sin((*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("trig/sin_fast", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::fastSin((*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("trig/acos_std", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -1.0f, 1.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = std::acos((*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("trig/acos_fast", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -1.0f, 1.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::fastAcos((*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("trig/atan2_std", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_b = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = std::atan2((*l_a)[i], (*l_b)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("trig/atan2_fast", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_b = std::make_shared<std::vector<float>>(generateFloats(size, -10.0f, 10.0f));
+		auto l_c = std::make_shared<std::vector<float>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = InnoMath::fastAtan2((*l_a)[i], (*l_b)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+}
+
+void InnoBenchmark::registerBatchBenchmarks()
+{
+	registerBenchmark("batch/transform_points_scalar", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_m = randomTransformationMatrix();
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, [] { return randomVec4(1.0f); }));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			for (size_t i = 0; i < size; i++)
+			{
+				(*l_c)[i] = transform(l_m, (*l_a)[i]);
+			}
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("batch/transform_points", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_m = randomTransformationMatrix();
+		auto l_a = std::make_shared<VectorSoA>();
+		l_a->reserve(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			l_a->emplace_back(randomVec4(1.0f));
+		}
+		auto l_c = std::make_shared<VectorSoA>();
+		return [=]() {
+			InnoMath::transformPoints(l_m, *l_a, *l_c);
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("batch/transform_aabbs", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_m = randomTransformationMatrix();
+		auto l_a = std::make_shared<AABBSoA>();
+		l_a->reserve(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			l_a->emplace_back(randomVec4(1.0f), randomScale());
+		}
+		auto l_c = std::make_shared<AABBSoA>();
+		return [=]() {
+			InnoMath::transformAABBs(l_m, *l_a, *l_c);
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("batch/bound_spheres", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<AABBSoA>();
+		l_a->reserve(size);
+		for (size_t i = 0; i < size; i++)
+		{
+			l_a->emplace_back(randomVec4(1.0f), randomScale());
+		}
+		auto l_c = std::make_shared<SphereSoA>();
+		return [=]() {
+			InnoMath::generateBoundSpheres(*l_a, *l_c);
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("batch/slerp", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			InnoMath::slerp(l_a->data(), l_b->data(), 0.3f, l_c->data(), size);
+			doNotOptimize(*l_c);
+		};
+	});
+
+	registerBenchmark("batch/nlerp", m_mathSizes, [](size_t size) -> BenchmarkFunction {
+		auto l_a = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_b = std::make_shared<std::vector<vec4>>(generateVec4s(size, randomQuat));
+		auto l_c = std::make_shared<std::vector<vec4>>(size);
+		return [=]() {
+			InnoMath::nlerp(l_a->data(), l_b->data(), 0.3f, l_c->data(), size);
+			doNotOptimize(*l_c);
+		};
+	});
+}
+
+void InnoBenchmark::registerMathBenchmarks()
+{
+	registerVectorBenchmarks();
+	registerMatrixBenchmarks();
+	registerIntersectionBenchmarks();
+	registerTrigonometryBenchmarks();
+	registerBatchBenchmarks();
+}
@@ -36,3 +36,123 @@ public:
 		return !operator==(rhs);
 	}
 };
+
+//Double-linked-list
+class freeChunk
+{
+public:
+	void* m_target = nullptr;
+	freeChunk* m_next = nullptr;
+	freeChunk* m_prev = nullptr;
+};
+
+template <class T, unsigned long long TCapability>
+class objectPool
+{
+public:
+	objectPool() : objectPool(TCapability)
+	{
+	};
+
+	objectPool(unsigned long long capability)
+	{
+		m_capability = capability;
+		m_poolSize = capability * sizeof(T);
+		m_poolPtr = ::new unsigned char[m_poolSize];
+	};
+
+	~objectPool() {
+		::delete[] m_poolPtr;
+	};
+
+	unsigned long long m_capability = 0;
+	unsigned long long m_poolSize = 0;
+	unsigned char* m_poolPtr = nullptr;
+};
+
+// fixed capability storage of T with a free chunk list, the objects are constructed in place
+template <class T, unsigned long long TCapability>
+class componentPool
+{
+public:
+	componentPool() = default;
+
+	bool allocateInitialFreeChunks()
+	{
+		auto l_chuckUC = m_freeChunkPool.m_poolPtr;
+		auto l_componentUC = m_pool.m_poolPtr;
+
+		freeChunk* l_prevFreeChunk = nullptr;
+
+		/* walk through others */
+		for (unsigned long long i = 0; i < m_freeChunkPool.m_capability; i++)
+		{
+			auto l_newFreeChunk = new(l_chuckUC) freeChunk();
+
+			l_newFreeChunk->m_target = l_componentUC;
+			l_newFreeChunk->m_prev = l_prevFreeChunk;
+			if (l_prevFreeChunk)
+			{
+				l_newFreeChunk->m_prev->m_next = l_newFreeChunk;
+			}
+
+			l_prevFreeChunk = l_newFreeChunk;
+			l_chuckUC += sizeof(freeChunk);
+			l_componentUC += sizeof(T);
+		}
+
+		m_currentFreeChunk = reinterpret_cast<freeChunk*>(m_freeChunkPool.m_poolPtr);
+
+		return true;
+	}
+
+	// nullptr when the pool has run out
+	T* allocate()
+	{
+		if (!m_currentFreeChunk)
+		{
+			return nullptr;
+		}
+
+		auto l_ptr = new(m_currentFreeChunk->m_target) T();
+
+		auto l_next = m_currentFreeChunk->m_next;
+		if (l_next)
+		{
+			l_next->m_prev = nullptr;
+		}
+		m_currentFreeChunk = l_next;
+
+		return l_ptr;
+	}
+
+	// the object should be destructed already
+	bool free(T* p)
+	{
+		/* get pointer distance between this object and the head of the pool*/
+		auto l_offset = reinterpret_cast<unsigned char*>(p) - m_pool.m_poolPtr;
+		auto l_index = l_offset / sizeof(T);
+		auto l_freeChuck = new(m_freeChunkPool.m_poolPtr + l_index * sizeof(freeChunk)) freeChunk();
+		/* now insert after the current free chunk*/
+		l_freeChuck->m_target = p;
+		if (m_currentFreeChunk)
+		{
+			l_freeChuck->m_prev = m_currentFreeChunk;
+			l_freeChuck->m_next = m_currentFreeChunk->m_next;
+			m_currentFreeChunk->m_next = l_freeChuck;
+		}
+		else
+		{
+			m_currentFreeChunk = l_freeChuck;
+		}
+		/*finally wipe away all the old data*/
+		std::memset((void*)p, 0, sizeof(T));
+
+		return true;
+	}
+
+private:
+	objectPool<T, TCapability> m_pool;
+	objectPool<freeChunk, TCapability> m_freeChunkPool;
+	freeChunk* m_currentFreeChunk = nullptr;
+};
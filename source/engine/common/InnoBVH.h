@@ -0,0 +1,960 @@
+#pragma once
+#include "../common/stdafx.h"
+#include <deque>
+#include "InnoMath.h"
+#include "InnoContainer.h"
+
+// dynamic AABB tree, leaves are inserted incrementally and kept balanced by AVL rotations,
+// build() re-creates the whole hierarchy top-down with a binned SAH for the static part of the scene
+template<class T>
+class InnoBVH
+{
+public:
+	static constexpr int NULL_NODE = -1;
+
+	InnoBVH(float fatMargin = 0.1f) : m_fatMargin(fatMargin) {};
+	~InnoBVH() {};
+
+	// return the proxy ID of the new leaf
+	int insert(const AABB& bound, const T& userData)
+	{
+		auto l_leaf = allocateNode();
+		auto& l_node = m_nodes[l_leaf];
+
+		l_node.m_tightBound = Bound(bound);
+		l_node.m_bound = l_node.m_tightBound.expand(m_fatMargin);
+		l_node.m_userData = userData;
+		l_node.m_height = 0;
+
+		insertLeaf(l_leaf);
+		m_leafCount++;
+
+		return l_leaf;
+	}
+
+	void remove(int proxyID)
+	{
+		removeLeaf(proxyID);
+		freeNode(proxyID);
+		m_leafCount--;
+	}
+
+	// only write the leaf itself, it's safe to call it concurrently for different leaves as long as the tree is not restructured
+	// return false if the leaf has moved out of its fat bound and needs update()
+	bool updateTightBound(int proxyID, const AABB& bound)
+	{
+		auto& l_node = m_nodes[proxyID];
+
+		l_node.m_tightBound = Bound(bound);
+
+		return l_node.m_bound.contains(l_node.m_tightBound);
+	}
+
+	// return true if the leaf has been reinserted because it moved out of its fat bound
+	bool update(int proxyID, const AABB& bound)
+	{
+		auto& l_node = m_nodes[proxyID];
+
+		l_node.m_tightBound = Bound(bound);
+
+		if (l_node.m_bound.contains(l_node.m_tightBound))
+		{
+			return false;
+		}
+
+		removeLeaf(proxyID);
+		m_nodes[proxyID].m_bound = m_nodes[proxyID].m_tightBound.expand(m_fatMargin);
+		insertLeaf(proxyID);
+
+		return true;
+	}
+
+	// rebuild all the internal nodes with a binned SAH, the proxy IDs stay valid
+	void build()
+	{
+		std::vector<int> l_leaves;
+		l_leaves.reserve(m_leafCount);
+
+		for (int i = 0; i < (int)m_nodes.size(); i++)
+		{
+			if (m_nodes[i].m_height == 0)
+			{
+				l_leaves.emplace_back(i);
+			}
+			else if (m_nodes[i].m_height > 0)
+			{
+				freeNode(i);
+			}
+		}
+
+		if (l_leaves.empty())
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		m_root = buildRecursively(l_leaves, 0, l_leaves.size());
+		m_nodes[m_root].m_parent = NULL_NODE;
+	}
+
+	void clear()
+	{
+		m_nodes.clear();
+		m_root = NULL_NODE;
+		m_freeList = NULL_NODE;
+		m_leafCount = 0;
+	}
+
+	const T& getUserData(int proxyID) const
+	{
+		return m_nodes[proxyID].m_userData;
+	}
+
+	bool isTightBoundChanged(int proxyID, const AABB& bound) const
+	{
+		auto& l_tightBound = m_nodes[proxyID].m_tightBound;
+		auto l_bound = Bound(bound);
+
+		return std::memcmp(l_tightBound.m_min, l_bound.m_min, sizeof(l_bound.m_min)) != 0 || std::memcmp(l_tightBound.m_max, l_bound.m_max, sizeof(l_bound.m_max)) != 0;
+	}
+
+	AABB getBound(int proxyID) const
+	{
+		return m_nodes[proxyID].m_tightBound.toAABB();
+	}
+
+	// the fat bound of the root
+	AABB getRootBound() const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return AABB();
+		}
+		return m_nodes[m_root].m_bound.toAABB();
+	}
+
+	size_t size() const
+	{
+		return m_leafCount;
+	}
+
+	int getHeight() const
+	{
+		return m_root == NULL_NODE ? 0 : m_nodes[m_root].m_height;
+	}
+
+	// a subtree of a frustum query, the planes which are not in the mask have been passed by its ancestors
+	struct FrustumQueryNode
+	{
+		int m_index;
+		unsigned int m_planeMask;
+	};
+
+	// bits of the plane masks, in the order of InnoMath::getPlanes()
+	static constexpr unsigned int ALL_PLANES = (1 << 6) - 1;
+	static constexpr unsigned int NEAR_PLANE = 1 << 4;
+	static constexpr unsigned int FAR_PLANE = 1 << 5;
+
+	// callback(int proxyID) is invoked for every leaf whose tight bound intersects the frustum, the planes not in the mask are ignored
+	template<class Callback>
+	void queryFrustum(const Frustum& frustum, Callback&& callback, unsigned int planeMask = ALL_PLANES) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		queryFrustum(frustum, FrustumQueryNode{ m_root, planeMask }, callback);
+	}
+
+	template<class Callback>
+	void queryFrustum(const Frustum& frustum, const FrustumQueryNode& root, Callback&& callback) const
+	{
+		auto l_planes = InnoMath::getPlanes(frustum);
+
+		SmallVector<FrustumQueryNode, 64> l_stack;
+		l_stack.emplace_back(root);
+
+		while (!l_stack.empty())
+		{
+			auto l_queryNode = l_stack.back();
+			l_stack.pop_back();
+
+			auto& l_node = m_nodes[l_queryNode.m_index];
+
+			if (!classify(l_planes, l_node, l_queryNode.m_planeMask))
+			{
+				continue;
+			}
+
+			if (l_node.isLeaf())
+			{
+				callback(l_queryNode.m_index);
+			}
+			else if (l_queryNode.m_planeMask == 0)
+			{
+				collectLeaves(l_queryNode.m_index, callback);
+			}
+			else
+			{
+				l_stack.emplace_back(FrustumQueryNode{ l_node.m_child1, l_queryNode.m_planeMask });
+				l_stack.emplace_back(FrustumQueryNode{ l_node.m_child2, l_queryNode.m_planeMask });
+			}
+		}
+	}
+
+	// split a frustum query into at least count independent subtrees (if the tree is large enough) which could be walked in parallel
+	void splitFrustumQuery(const Frustum& frustum, size_t count, std::vector<FrustumQueryNode>& result) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		auto l_planes = InnoMath::getPlanes(frustum);
+
+		std::deque<FrustumQueryNode> l_openList;
+		l_openList.emplace_back(FrustumQueryNode{ m_root, ALL_PLANES });
+
+		while (!l_openList.empty() && l_openList.size() + result.size() < count)
+		{
+			auto l_queryNode = l_openList.front();
+			l_openList.pop_front();
+
+			auto& l_node = m_nodes[l_queryNode.m_index];
+			auto l_parentMask = l_queryNode.m_planeMask;
+
+			// leaves and fully visible subtrees can't be split further
+			if (l_node.isLeaf() || l_parentMask == 0)
+			{
+				result.emplace_back(l_queryNode);
+				continue;
+			}
+
+			for (auto l_child : { l_node.m_child1, l_node.m_child2 })
+			{
+				auto l_mask = l_parentMask;
+				if (classify(l_planes, m_nodes[l_child], l_mask))
+				{
+					l_openList.emplace_back(FrustumQueryNode{ l_child, l_mask });
+				}
+			}
+		}
+
+		result.insert(result.end(), l_openList.begin(), l_openList.end());
+	}
+
+	template<class Callback>
+	void queryOverlap(const AABB& bound, Callback&& callback) const
+	{
+		auto l_bound = Bound(bound);
+
+		traverse([&](const Bound& rhs) { return rhs.overlaps(l_bound); }, callback);
+	}
+
+	template<class Callback>
+	void queryOverlap(const Sphere& sphere, Callback&& callback) const
+	{
+		auto l_radiusSquared = sphere.m_radius * sphere.m_radius;
+
+		traverse([&](const Bound& rhs) { return rhs.distanceSquared(sphere.m_center) <= l_radiusSquared; }, callback);
+	}
+
+	// the closest leaf hit by the ray within maxDistance, distance is in the unit of the ray direction
+	bool rayCastClosest(const Ray& ray, int& proxyID, float& distance, float maxDistance = std::numeric_limits<float>::max()) const
+	{
+		return rayCastClosest(ray, proxyID, distance, maxDistance, [](int) { return true; });
+	}
+
+	// the leaves rejected by filter(int proxyID) are skipped
+	template<class Filter>
+	bool rayCastClosest(const Ray& ray, int& proxyID, float& distance, float maxDistance, Filter&& filter) const
+	{
+		proxyID = NULL_NODE;
+		distance = maxDistance;
+
+		if (m_root == NULL_NODE)
+		{
+			return false;
+		}
+
+		auto l_rayData = RayData(ray);
+
+		float l_rootDistance;
+		if (!m_nodes[m_root].m_bound.intersect(l_rayData, distance, l_rootDistance))
+		{
+			return false;
+		}
+
+		SmallVector<std::pair<int, float>, 64> l_stack;
+		l_stack.emplace_back(m_root, l_rootDistance);
+
+		while (!l_stack.empty())
+		{
+			auto l_index = l_stack.back().first;
+			auto l_entryDistance = l_stack.back().second;
+			l_stack.pop_back();
+
+			// a closer hit has been found after this node was pushed
+			if (l_entryDistance > distance)
+			{
+				continue;
+			}
+
+			auto& l_node = m_nodes[l_index];
+
+			if (l_node.isLeaf())
+			{
+				float l_leafDistance;
+				if (filter(l_index) && l_node.m_tightBound.intersect(l_rayData, distance, l_leafDistance))
+				{
+					distance = l_leafDistance;
+					proxyID = l_index;
+				}
+				continue;
+			}
+
+			float l_distance1, l_distance2;
+			auto l_hit1 = m_nodes[l_node.m_child1].m_bound.intersect(l_rayData, distance, l_distance1);
+			auto l_hit2 = m_nodes[l_node.m_child2].m_bound.intersect(l_rayData, distance, l_distance2);
+
+			// push the farther child first to visit the nearer one first
+			if (l_hit1 && l_hit2)
+			{
+				if (l_distance1 < l_distance2)
+				{
+					l_stack.emplace_back(l_node.m_child2, l_distance2);
+					l_stack.emplace_back(l_node.m_child1, l_distance1);
+				}
+				else
+				{
+					l_stack.emplace_back(l_node.m_child1, l_distance1);
+					l_stack.emplace_back(l_node.m_child2, l_distance2);
+				}
+			}
+			else if (l_hit1)
+			{
+				l_stack.emplace_back(l_node.m_child1, l_distance1);
+			}
+			else if (l_hit2)
+			{
+				l_stack.emplace_back(l_node.m_child2, l_distance2);
+			}
+		}
+
+		return proxyID != NULL_NODE;
+	}
+
+	bool rayCastAny(const Ray& ray, float maxDistance = std::numeric_limits<float>::max()) const
+	{
+		auto l_rayData = RayData(ray);
+		bool l_hit = false;
+
+		traverse([&](const Bound& rhs) { float l_distance; return !l_hit && rhs.intersect(l_rayData, maxDistance, l_distance); }, [&](int) { l_hit = true; });
+
+		return l_hit;
+	}
+
+private:
+	struct RayData
+	{
+		RayData(const Ray& ray)
+		{
+			float l_direction[3] = { ray.m_direction.x, ray.m_direction.y, ray.m_direction.z };
+
+			m_origin[0] = ray.m_origin.x;
+			m_origin[1] = ray.m_origin.y;
+			m_origin[2] = ray.m_origin.z;
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				// avoid 0 * inf when the origin lies on a slab
+				m_invDirection[i] = l_direction[i] != 0.0f ? 1.0f / l_direction[i] : std::copysign(std::numeric_limits<float>::max(), l_direction[i]);
+			}
+		}
+
+		float m_origin[3];
+		float m_invDirection[3];
+	};
+
+	struct Bound
+	{
+		Bound() {};
+		explicit Bound(const AABB& rhs)
+		{
+			m_min[0] = rhs.m_boundMin.x;
+			m_min[1] = rhs.m_boundMin.y;
+			m_min[2] = rhs.m_boundMin.z;
+			m_max[0] = rhs.m_boundMax.x;
+			m_max[1] = rhs.m_boundMax.y;
+			m_max[2] = rhs.m_boundMax.z;
+		}
+
+		float m_min[3] = { 0.0f, 0.0f, 0.0f };
+		float m_max[3] = { 0.0f, 0.0f, 0.0f };
+
+		AABB toAABB() const
+		{
+			AABB l_result;
+
+			l_result.m_boundMin = vec4(m_min[0], m_min[1], m_min[2], 1.0f);
+			l_result.m_boundMax = vec4(m_max[0], m_max[1], m_max[2], 1.0f);
+			l_result.m_center = (l_result.m_boundMax + l_result.m_boundMin) * 0.5f;
+			l_result.m_extend = l_result.m_boundMax - l_result.m_boundMin;
+
+			return l_result;
+		}
+
+		Bound merge(const Bound& rhs) const
+		{
+			Bound l_result;
+			for (size_t i = 0; i < 3; i++)
+			{
+				l_result.m_min[i] = std::min(m_min[i], rhs.m_min[i]);
+				l_result.m_max[i] = std::max(m_max[i], rhs.m_max[i]);
+			}
+			return l_result;
+		}
+
+		Bound expand(float margin) const
+		{
+			Bound l_result;
+			for (size_t i = 0; i < 3; i++)
+			{
+				l_result.m_min[i] = m_min[i] - margin;
+				l_result.m_max[i] = m_max[i] + margin;
+			}
+			return l_result;
+		}
+
+		bool contains(const Bound& rhs) const
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				if (rhs.m_min[i] < m_min[i] || rhs.m_max[i] > m_max[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool overlaps(const Bound& rhs) const
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				if (rhs.m_min[i] > m_max[i] || rhs.m_max[i] < m_min[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		float surfaceArea() const
+		{
+			auto l_x = m_max[0] - m_min[0];
+			auto l_y = m_max[1] - m_min[1];
+			auto l_z = m_max[2] - m_min[2];
+			return 2.0f * (l_x * l_y + l_y * l_z + l_z * l_x);
+		}
+
+		float center(size_t axis) const
+		{
+			return (m_min[axis] + m_max[axis]) * 0.5f;
+		}
+
+		// signed distance from the center to the plane
+		float distance(const Plane& plane) const
+		{
+			return plane.m_normal.x * center(0) + plane.m_normal.y * center(1) + plane.m_normal.z * center(2) - plane.m_distance;
+		}
+
+		// half extend projected onto the plane normal
+		float projectedRadius(const Plane& plane) const
+		{
+			return std::abs(plane.m_normal.x) * (m_max[0] - m_min[0]) * 0.5f
+				+ std::abs(plane.m_normal.y) * (m_max[1] - m_min[1]) * 0.5f
+				+ std::abs(plane.m_normal.z) * (m_max[2] - m_min[2]) * 0.5f;
+		}
+
+		float distanceSquared(const vec4& point) const
+		{
+			float l_point[3] = { point.x, point.y, point.z };
+			float l_result = 0.0f;
+			for (size_t i = 0; i < 3; i++)
+			{
+				auto l_closest = std::max(m_min[i], std::min(l_point[i], m_max[i]));
+				l_result += (l_point[i] - l_closest) * (l_point[i] - l_closest);
+			}
+			return l_result;
+		}
+
+		// slab test, entryDistance is clamped to 0 when the origin is inside
+		bool intersect(const RayData& ray, float maxDistance, float& entryDistance) const
+		{
+			auto l_tMin = 0.0f;
+			auto l_tMax = maxDistance;
+			for (size_t i = 0; i < 3; i++)
+			{
+				auto l_t1 = (m_min[i] - ray.m_origin[i]) * ray.m_invDirection[i];
+				auto l_t2 = (m_max[i] - ray.m_origin[i]) * ray.m_invDirection[i];
+				l_tMin = std::max(l_tMin, std::min(l_t1, l_t2));
+				l_tMax = std::min(l_tMax, std::max(l_t1, l_t2));
+			}
+			entryDistance = l_tMin;
+			return l_tMin <= l_tMax;
+		}
+	};
+
+	struct Node
+	{
+		// the fat bound for leaves
+		Bound m_bound;
+		Bound m_tightBound;
+		// next free node when the node is in the free list
+		int m_parent = NULL_NODE;
+		int m_child1 = NULL_NODE;
+		int m_child2 = NULL_NODE;
+		// leaf = 0, free node = -1
+		int m_height = -1;
+		T m_userData;
+
+		bool isLeaf() const
+		{
+			return m_child1 == NULL_NODE;
+		}
+	};
+
+	int allocateNode()
+	{
+		int l_index;
+		if (m_freeList == NULL_NODE)
+		{
+			l_index = (int)m_nodes.size();
+			m_nodes.emplace_back();
+		}
+		else
+		{
+			l_index = m_freeList;
+			m_freeList = m_nodes[l_index].m_parent;
+		}
+
+		auto& l_node = m_nodes[l_index];
+		l_node.m_parent = NULL_NODE;
+		l_node.m_child1 = NULL_NODE;
+		l_node.m_child2 = NULL_NODE;
+		l_node.m_height = 0;
+
+		return l_index;
+	}
+
+	void freeNode(int index)
+	{
+		auto& l_node = m_nodes[index];
+		l_node.m_parent = m_freeList;
+		l_node.m_child1 = NULL_NODE;
+		l_node.m_child2 = NULL_NODE;
+		l_node.m_height = -1;
+		m_freeList = index;
+	}
+
+	void insertLeaf(int leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].m_parent = NULL_NODE;
+			return;
+		}
+
+		// find the best sibling by the surface area heuristic
+		auto l_leafBound = m_nodes[leaf].m_bound;
+		auto l_index = m_root;
+
+		while (!m_nodes[l_index].isLeaf())
+		{
+			auto& l_node = m_nodes[l_index];
+
+			auto l_area = l_node.m_bound.surfaceArea();
+			auto l_combinedArea = l_node.m_bound.merge(l_leafBound).surfaceArea();
+
+			// cost of creating a new parent for this node and the new leaf
+			auto l_cost = 2.0f * l_combinedArea;
+			// minimum cost of pushing the leaf further down the tree
+			auto l_inheritanceCost = 2.0f * (l_combinedArea - l_area);
+
+			auto l_cost1 = descendingCost(l_node.m_child1, l_leafBound) + l_inheritanceCost;
+			auto l_cost2 = descendingCost(l_node.m_child2, l_leafBound) + l_inheritanceCost;
+
+			if (l_cost < l_cost1 && l_cost < l_cost2)
+			{
+				break;
+			}
+
+			l_index = l_cost1 < l_cost2 ? l_node.m_child1 : l_node.m_child2;
+		}
+
+		auto l_sibling = l_index;
+		auto l_oldParent = m_nodes[l_sibling].m_parent;
+		auto l_newParent = allocateNode();
+
+		m_nodes[l_newParent].m_parent = l_oldParent;
+		m_nodes[l_newParent].m_bound = l_leafBound.merge(m_nodes[l_sibling].m_bound);
+		m_nodes[l_newParent].m_height = m_nodes[l_sibling].m_height + 1;
+		m_nodes[l_newParent].m_child1 = l_sibling;
+		m_nodes[l_newParent].m_child2 = leaf;
+		m_nodes[l_sibling].m_parent = l_newParent;
+		m_nodes[leaf].m_parent = l_newParent;
+
+		if (l_oldParent != NULL_NODE)
+		{
+			replaceChild(l_oldParent, l_sibling, l_newParent);
+		}
+		else
+		{
+			m_root = l_newParent;
+		}
+
+		refit(m_nodes[leaf].m_parent);
+	}
+
+	void removeLeaf(int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		auto l_parent = m_nodes[leaf].m_parent;
+		auto l_grandParent = m_nodes[l_parent].m_parent;
+		auto l_sibling = m_nodes[l_parent].m_child1 == leaf ? m_nodes[l_parent].m_child2 : m_nodes[l_parent].m_child1;
+
+		if (l_grandParent != NULL_NODE)
+		{
+			replaceChild(l_grandParent, l_parent, l_sibling);
+			m_nodes[l_sibling].m_parent = l_grandParent;
+			freeNode(l_parent);
+
+			refit(l_grandParent);
+		}
+		else
+		{
+			m_root = l_sibling;
+			m_nodes[l_sibling].m_parent = NULL_NODE;
+			freeNode(l_parent);
+		}
+	}
+
+	float descendingCost(int index, const Bound& leafBound) const
+	{
+		auto& l_node = m_nodes[index];
+		auto l_combinedArea = l_node.m_bound.merge(leafBound).surfaceArea();
+
+		if (l_node.isLeaf())
+		{
+			return l_combinedArea;
+		}
+		return l_combinedArea - l_node.m_bound.surfaceArea();
+	}
+
+	void replaceChild(int parent, int oldChild, int newChild)
+	{
+		if (m_nodes[parent].m_child1 == oldChild)
+		{
+			m_nodes[parent].m_child1 = newChild;
+		}
+		else
+		{
+			m_nodes[parent].m_child2 = newChild;
+		}
+	}
+
+	// walk up to the root, rebalance and recalculate the bounds and heights
+	void refit(int index)
+	{
+		while (index != NULL_NODE)
+		{
+			index = balance(index);
+
+			auto& l_node = m_nodes[index];
+			auto& l_child1 = m_nodes[l_node.m_child1];
+			auto& l_child2 = m_nodes[l_node.m_child2];
+
+			l_node.m_height = 1 + std::max(l_child1.m_height, l_child2.m_height);
+			l_node.m_bound = l_child1.m_bound.merge(l_child2.m_bound);
+
+			index = l_node.m_parent;
+		}
+	}
+
+	// rotate the taller child up if the subtree of A is imbalanced, return the new root of the subtree
+	int balance(int iA)
+	{
+		auto& A = m_nodes[iA];
+		if (A.isLeaf() || A.m_height < 2)
+		{
+			return iA;
+		}
+
+		auto iB = A.m_child1;
+		auto iC = A.m_child2;
+		auto& B = m_nodes[iB];
+		auto& C = m_nodes[iC];
+
+		auto l_balance = C.m_height - B.m_height;
+
+		if (l_balance > 1)
+		{
+			return rotate(iA, iC, true);
+		}
+		if (l_balance < -1)
+		{
+			return rotate(iA, iB, false);
+		}
+		return iA;
+	}
+
+	int rotate(int iA, int iUp, bool upIsChild2)
+	{
+		auto& A = m_nodes[iA];
+		auto& Up = m_nodes[iUp];
+		auto iStay = upIsChild2 ? A.m_child1 : A.m_child2;
+
+		auto iF = Up.m_child1;
+		auto iG = Up.m_child2;
+		auto& F = m_nodes[iF];
+		auto& G = m_nodes[iG];
+
+		Up.m_child1 = iA;
+		Up.m_parent = A.m_parent;
+		A.m_parent = iUp;
+
+		if (Up.m_parent != NULL_NODE)
+		{
+			replaceChild(Up.m_parent, iA, iUp);
+		}
+		else
+		{
+			m_root = iUp;
+		}
+
+		// the taller grandchild stays with Up, the other one moves under A
+		auto iKeep = F.m_height > G.m_height ? iF : iG;
+		auto iMove = F.m_height > G.m_height ? iG : iF;
+
+		Up.m_child2 = iKeep;
+		if (upIsChild2)
+		{
+			A.m_child2 = iMove;
+		}
+		else
+		{
+			A.m_child1 = iMove;
+		}
+		m_nodes[iMove].m_parent = iA;
+
+		A.m_bound = m_nodes[iStay].m_bound.merge(m_nodes[iMove].m_bound);
+		A.m_height = 1 + std::max(m_nodes[iStay].m_height, m_nodes[iMove].m_height);
+
+		Up.m_bound = A.m_bound.merge(m_nodes[iKeep].m_bound);
+		Up.m_height = 1 + std::max(A.m_height, m_nodes[iKeep].m_height);
+
+		return iUp;
+	}
+
+	int buildRecursively(std::vector<int>& leaves, size_t begin, size_t end)
+	{
+		if (end - begin == 1)
+		{
+			return leaves[begin];
+		}
+
+		constexpr size_t l_binCount = 16;
+
+		// split along the longest axis of the centroid bound
+		Bound l_centroidBound;
+		for (size_t i = 0; i < 3; i++)
+		{
+			l_centroidBound.m_min[i] = std::numeric_limits<float>::max();
+			l_centroidBound.m_max[i] = -std::numeric_limits<float>::max();
+		}
+		for (size_t i = begin; i < end; i++)
+		{
+			for (size_t j = 0; j < 3; j++)
+			{
+				auto l_center = m_nodes[leaves[i]].m_bound.center(j);
+				l_centroidBound.m_min[j] = std::min(l_centroidBound.m_min[j], l_center);
+				l_centroidBound.m_max[j] = std::max(l_centroidBound.m_max[j], l_center);
+			}
+		}
+
+		size_t l_axis = 0;
+		for (size_t i = 1; i < 3; i++)
+		{
+			if (l_centroidBound.m_max[i] - l_centroidBound.m_min[i] > l_centroidBound.m_max[l_axis] - l_centroidBound.m_min[l_axis])
+			{
+				l_axis = i;
+			}
+		}
+
+		auto l_axisMin = l_centroidBound.m_min[l_axis];
+		auto l_axisExtend = l_centroidBound.m_max[l_axis] - l_axisMin;
+		auto l_mid = begin + (end - begin) / 2;
+
+		if (l_axisExtend > 0.0f)
+		{
+			auto l_binIndex = [&](int leaf) {
+				auto l_result = (size_t)((m_nodes[leaf].m_bound.center(l_axis) - l_axisMin) / l_axisExtend * l_binCount);
+				return std::min(l_result, l_binCount - 1);
+			};
+
+			std::array<Bound, l_binCount> l_binBounds;
+			std::array<size_t, l_binCount> l_binSizes = {};
+
+			for (size_t i = begin; i < end; i++)
+			{
+				auto l_bin = l_binIndex(leaves[i]);
+				l_binBounds[l_bin] = l_binSizes[l_bin] ? l_binBounds[l_bin].merge(m_nodes[leaves[i]].m_bound) : m_nodes[leaves[i]].m_bound;
+				l_binSizes[l_bin]++;
+			}
+
+			// sweep from the right to get the area of every right partition
+			std::array<float, l_binCount> l_rightAreas = {};
+			Bound l_rightBound;
+			size_t l_rightSize = 0;
+			for (size_t i = l_binCount - 1; i > 0; i--)
+			{
+				if (l_binSizes[i])
+				{
+					l_rightBound = l_rightSize ? l_rightBound.merge(l_binBounds[i]) : l_binBounds[i];
+					l_rightSize += l_binSizes[i];
+				}
+				l_rightAreas[i] = l_rightSize ? l_rightBound.surfaceArea() * l_rightSize : 0.0f;
+			}
+
+			auto l_bestCost = std::numeric_limits<float>::max();
+			size_t l_bestSplit = 0;
+			Bound l_leftBound;
+			size_t l_leftSize = 0;
+			for (size_t i = 0; i < l_binCount - 1; i++)
+			{
+				if (l_binSizes[i])
+				{
+					l_leftBound = l_leftSize ? l_leftBound.merge(l_binBounds[i]) : l_binBounds[i];
+					l_leftSize += l_binSizes[i];
+				}
+				auto l_cost = (l_leftSize ? l_leftBound.surfaceArea() * l_leftSize : 0.0f) + l_rightAreas[i + 1];
+				if (l_leftSize && l_leftSize < end - begin && l_cost < l_bestCost)
+				{
+					l_bestCost = l_cost;
+					l_bestSplit = i;
+				}
+			}
+
+			if (l_bestCost < std::numeric_limits<float>::max())
+			{
+				auto l_pivot = std::partition(leaves.begin() + begin, leaves.begin() + end, [&](int leaf) { return l_binIndex(leaf) <= l_bestSplit; });
+				l_mid = l_pivot - leaves.begin();
+			}
+		}
+
+		// all the centroids are in the same bin, fall back to a median split
+		if (l_mid == begin || l_mid == end)
+		{
+			l_mid = begin + (end - begin) / 2;
+		}
+
+		auto l_child1 = buildRecursively(leaves, begin, l_mid);
+		auto l_child2 = buildRecursively(leaves, l_mid, end);
+
+		auto l_index = allocateNode();
+		auto& l_node = m_nodes[l_index];
+
+		l_node.m_child1 = l_child1;
+		l_node.m_child2 = l_child2;
+		l_node.m_bound = m_nodes[l_child1].m_bound.merge(m_nodes[l_child2].m_bound);
+		l_node.m_height = 1 + std::max(m_nodes[l_child1].m_height, m_nodes[l_child2].m_height);
+		m_nodes[l_child1].m_parent = l_index;
+		m_nodes[l_child2].m_parent = l_index;
+
+		return l_index;
+	}
+
+	// return false if the node is outside of the frustum, remove the planes which the node is fully inside from the mask
+	bool classify(const std::array<const Plane*, 6>& planes, const Node& node, unsigned int& planeMask) const
+	{
+		auto& l_bound = node.isLeaf() ? node.m_tightBound : node.m_bound;
+
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			if (planeMask & (1 << i))
+			{
+				auto l_distance = l_bound.distance(*planes[i]);
+				auto l_radius = l_bound.projectedRadius(*planes[i]);
+
+				if (l_distance + l_radius < 0.0f)
+				{
+					return false;
+				}
+				if (l_distance - l_radius >= 0.0f)
+				{
+					planeMask &= ~(1 << i);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	template<class Callback>
+	void collectLeaves(int index, Callback&& callback) const
+	{
+		traverse([](const Bound&) { return true; }, callback, index);
+	}
+
+	// visit every leaf whose bounds (fat for internal nodes, tight for leaves) pass the test
+	template<class Test, class Callback>
+	void traverse(Test&& test, Callback&& callback, int root = NULL_NODE) const
+	{
+		if (root == NULL_NODE)
+		{
+			root = m_root;
+		}
+		if (root == NULL_NODE)
+		{
+			return;
+		}
+
+		SmallVector<int, 64> l_stack;
+		l_stack.emplace_back(root);
+
+		while (!l_stack.empty())
+		{
+			auto l_index = l_stack.back();
+			l_stack.pop_back();
+
+			auto& l_node = m_nodes[l_index];
+
+			if (l_node.isLeaf())
+			{
+				if (test(l_node.m_tightBound))
+				{
+					callback(l_index);
+				}
+			}
+			else if (test(l_node.m_bound))
+			{
+				l_stack.emplace_back(l_node.m_child1);
+				l_stack.emplace_back(l_node.m_child2);
+			}
+		}
+	}
+
+	std::vector<Node> m_nodes;
+	int m_root = NULL_NODE;
+	int m_freeList = NULL_NODE;
+	size_t m_leafCount = 0;
+	float m_fatMargin;
+};
@@ -2,6 +2,9 @@
 #include <future>
 #include "InnoContainer.h"
 
+// the alignment which keeps the independently written data on different cache lines
+#define INNO_CACHE_LINE_SIZE 64
+
 class IThreadTask
 {
 public:
@@ -68,9 +71,288 @@ public:
 
 	auto isReady(void)
 	{
-		return m_future._Is_ready();
+		return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 	}
 
 private:
 	std::future<T> m_future;
-};
\ No newline at end of file
+};
+
+inline void cpuRelax(void)
+{
+#ifdef INNO_CONTAINER_USE_SSE2
+	_mm_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+struct LockContentionData
+{
+	unsigned long long acquireCount = 0;
+	// acquisitions which had to wait for another thread
+	unsigned long long contendedCount = 0;
+	unsigned long long spinCount = 0;
+};
+
+class LockContentionCounter
+{
+public:
+	void record(unsigned long long spinCount)
+	{
+		m_acquireCount.fetch_add(1, std::memory_order_relaxed);
+		if (spinCount)
+		{
+			m_contendedCount.fetch_add(1, std::memory_order_relaxed);
+			m_spinCount.fetch_add(spinCount, std::memory_order_relaxed);
+		}
+	}
+
+	LockContentionData get(void) const
+	{
+		LockContentionData l_result;
+		l_result.acquireCount = m_acquireCount.load(std::memory_order_relaxed);
+		l_result.contendedCount = m_contendedCount.load(std::memory_order_relaxed);
+		l_result.spinCount = m_spinCount.load(std::memory_order_relaxed);
+		return l_result;
+	}
+
+	void reset(void)
+	{
+		m_acquireCount.store(0, std::memory_order_relaxed);
+		m_contendedCount.store(0, std::memory_order_relaxed);
+		m_spinCount.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<unsigned long long> m_acquireCount = 0;
+	std::atomic<unsigned long long> m_contendedCount = 0;
+	std::atomic<unsigned long long> m_spinCount = 0;
+};
+
+// test-and-test-and-set lock for very short critical sections, yield to the scheduler after spinning for a while
+class alignas(INNO_CACHE_LINE_SIZE) SpinLock
+{
+public:
+	void lock(void)
+	{
+		unsigned long long l_spinCount = 0;
+		while (m_locked.exchange(true, std::memory_order_acquire))
+		{
+			while (m_locked.load(std::memory_order_relaxed))
+			{
+				backoff(l_spinCount);
+			}
+		}
+		m_counter.record(l_spinCount);
+	}
+
+	bool try_lock(void)
+	{
+		if (!m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire))
+		{
+			m_counter.record(0);
+			return true;
+		}
+		return false;
+	}
+
+	void unlock(void)
+	{
+		m_locked.store(false, std::memory_order_release);
+	}
+
+	LockContentionData getContentionData(void) const
+	{
+		return m_counter.get();
+	}
+
+private:
+	static void backoff(unsigned long long& spinCount)
+	{
+		spinCount++;
+		if (spinCount % 64)
+		{
+			cpuRelax();
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	std::atomic<bool> m_locked = false;
+	char m_pad[INNO_CACHE_LINE_SIZE - sizeof(std::atomic<bool>)];
+	LockContentionCounter m_counter;
+};
+
+// FIFO-fair spin lock, the threads acquire it in the order they arrived
+class alignas(INNO_CACHE_LINE_SIZE) TicketLock
+{
+public:
+	void lock(void)
+	{
+		auto l_ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+		unsigned long long l_spinCount = 0;
+		while (m_nowServing.load(std::memory_order_acquire) != l_ticket)
+		{
+			l_spinCount++;
+			if (l_spinCount % 64)
+			{
+				cpuRelax();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+		m_counter.record(l_spinCount);
+	}
+
+	bool try_lock(void)
+	{
+		auto l_ticket = m_nowServing.load(std::memory_order_relaxed);
+		auto l_expected = l_ticket;
+		if (m_nextTicket.compare_exchange_strong(l_expected, l_ticket + 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			m_counter.record(0);
+			return true;
+		}
+		return false;
+	}
+
+	void unlock(void)
+	{
+		m_nowServing.store(m_nowServing.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	LockContentionData getContentionData(void) const
+	{
+		return m_counter.get();
+	}
+
+private:
+	// the ticket dispenser and the serving counter are written by different threads, keep them on separate cache lines
+	alignas(INNO_CACHE_LINE_SIZE) std::atomic<unsigned int> m_nextTicket = 0;
+	alignas(INNO_CACHE_LINE_SIZE) std::atomic<unsigned int> m_nowServing = 0;
+	LockContentionCounter m_counter;
+};
+
+// reader-writer lock for read-mostly data, readers only touch one atomic and never block each other.
+// A waiting writer stops new readers from entering so it can't be starved.
+// Satisfies SharedMutex, works with std::shared_lock and std::unique_lock
+class alignas(INNO_CACHE_LINE_SIZE) RWLock
+{
+public:
+	void lock_shared(void)
+	{
+		unsigned long long l_spinCount = 0;
+		while (true)
+		{
+			auto l_state = m_state.load(std::memory_order_relaxed);
+			if (!(l_state & (WRITER_LOCKED | WRITER_PENDING)))
+			{
+				if (m_state.compare_exchange_weak(l_state, l_state + READER, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else
+			{
+				backoff(l_spinCount);
+			}
+		}
+		m_readerCounter.record(l_spinCount);
+	}
+
+	bool try_lock_shared(void)
+	{
+		auto l_state = m_state.load(std::memory_order_relaxed);
+		if (!(l_state & (WRITER_LOCKED | WRITER_PENDING)) && m_state.compare_exchange_strong(l_state, l_state + READER, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			m_readerCounter.record(0);
+			return true;
+		}
+		return false;
+	}
+
+	void unlock_shared(void)
+	{
+		m_state.fetch_sub(READER, std::memory_order_release);
+	}
+
+	void lock(void)
+	{
+		unsigned long long l_spinCount = 0;
+		while (true)
+		{
+			auto l_state = m_state.load(std::memory_order_relaxed);
+			// no readers and no writer, the pending flag could be ours or another writer's
+			if (!(l_state & ~WRITER_PENDING))
+			{
+				if (m_state.compare_exchange_weak(l_state, WRITER_LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else
+			{
+				if (!(l_state & WRITER_PENDING))
+				{
+					m_state.fetch_or(WRITER_PENDING, std::memory_order_relaxed);
+				}
+				backoff(l_spinCount);
+			}
+		}
+		m_writerCounter.record(l_spinCount);
+	}
+
+	bool try_lock(void)
+	{
+		unsigned int l_expected = 0;
+		if (m_state.compare_exchange_strong(l_expected, WRITER_LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			m_writerCounter.record(0);
+			return true;
+		}
+		return false;
+	}
+
+	void unlock(void)
+	{
+		m_state.fetch_and(~WRITER_LOCKED, std::memory_order_release);
+	}
+
+	LockContentionData getReaderContentionData(void) const
+	{
+		return m_readerCounter.get();
+	}
+
+	LockContentionData getWriterContentionData(void) const
+	{
+		return m_writerCounter.get();
+	}
+
+private:
+	static constexpr unsigned int WRITER_LOCKED = 1;
+	static constexpr unsigned int WRITER_PENDING = 2;
+	static constexpr unsigned int READER = 4;
+
+	static void backoff(unsigned long long& spinCount)
+	{
+		spinCount++;
+		if (spinCount % 64)
+		{
+			cpuRelax();
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	std::atomic<unsigned int> m_state = 0;
+	char m_pad[INNO_CACHE_LINE_SIZE - sizeof(std::atomic<unsigned int>)];
+	LockContentionCounter m_readerCounter;
+	LockContentionCounter m_writerCounter;
+};
@@ -1,10 +1,18 @@
 #pragma once
 #include "../common/stdafx.h"
 #include <atomic>
+#include <cstdint>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INNO_CONTAINER_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 #include "InnoAllocator.h"
 
@@ -168,6 +176,13 @@ public:
 		return m_vector;
 	}
 
+	void setRawData(std::vector<T>&& rhs)
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_vector = std::move(rhs);
+		m_condition.notify_all();
+	}
+
 private:
 	std::atomic_bool m_valid{ true };
 	mutable std::mutex m_mutex;
@@ -175,6 +190,778 @@ private:
 	std::condition_variable m_condition;
 };
 
+// non-owning read-only view of contiguous elements, the owner should outlive it
+template <typename T>
+class ArrayView
+{
+public:
+	ArrayView(void)
+	{
+	}
+
+	ArrayView(const T* data, size_t size) : m_data(data), m_size(size)
+	{
+	}
+
+	template <typename Allocator>
+	ArrayView(const std::vector<T, Allocator>& rhs) : m_data(rhs.data()), m_size(rhs.size())
+	{
+	}
+
+	const T& operator[](size_t pos) const
+	{
+		return m_data[pos];
+	}
+
+	const T* data(void) const
+	{
+		return m_data;
+	}
+
+	const T* begin(void) const
+	{
+		return m_data;
+	}
+
+	const T* end(void) const
+	{
+		return m_data + m_size;
+	}
+
+	size_t size(void) const
+	{
+		return m_size;
+	}
+
+	bool empty(void) const
+	{
+		return m_size == 0;
+	}
+
+private:
+	const T* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+// fixed-capacity FIFO, push() overwrites the oldest element when it's full
+template <typename T, size_t Capacity>
+class RingBuffer
+{
+public:
+	static_assert(Capacity > 0, "RingBuffer capacity must be greater than zero");
+
+	// return false if the oldest element has been overwritten
+	bool push(T value)
+	{
+		auto l_tail = (m_head + m_size) % Capacity;
+		m_buffer[l_tail] = std::move(value);
+
+		if (m_size < Capacity)
+		{
+			m_size++;
+			return true;
+		}
+		else
+		{
+			m_head = (m_head + 1) % Capacity;
+			return false;
+		}
+	}
+
+	bool pop(T& out)
+	{
+		if (m_size == 0)
+		{
+			return false;
+		}
+		out = std::move(m_buffer[m_head]);
+		m_head = (m_head + 1) % Capacity;
+		m_size--;
+		return true;
+	}
+
+	// 0 is the oldest element
+	T& operator[](size_t pos)
+	{
+		return m_buffer[(m_head + pos) % Capacity];
+	}
+
+	const T& operator[](size_t pos) const
+	{
+		return m_buffer[(m_head + pos) % Capacity];
+	}
+
+	T& front(void)
+	{
+		return m_buffer[m_head];
+	}
+
+	T& back(void)
+	{
+		return m_buffer[(m_head + m_size - 1) % Capacity];
+	}
+
+	void clear(void)
+	{
+		m_head = 0;
+		m_size = 0;
+	}
+
+	size_t size(void) const
+	{
+		return m_size;
+	}
+
+	bool empty(void) const
+	{
+		return m_size == 0;
+	}
+
+	bool full(void) const
+	{
+		return m_size == Capacity;
+	}
+
+	static constexpr size_t capacity(void)
+	{
+		return Capacity;
+	}
+
+private:
+	std::array<T, Capacity> m_buffer;
+	size_t m_head = 0;
+	size_t m_size = 0;
+};
+
+// vector with inline storage for the first N elements, only touches the heap when it grows beyond that
+template <typename T, size_t N>
+class SmallVector
+{
+public:
+	SmallVector(void)
+	{
+	}
+
+	SmallVector(std::initializer_list<T> list)
+	{
+		reserve(list.size());
+		for (auto& i : list)
+		{
+			emplace_back(i);
+		}
+	}
+
+	SmallVector(const SmallVector& rhs)
+	{
+		reserve(rhs.m_size);
+		for (size_t i = 0; i < rhs.m_size; i++)
+		{
+			emplace_back(rhs.m_data[i]);
+		}
+	}
+
+	SmallVector(SmallVector&& rhs)
+	{
+		moveFrom(std::move(rhs));
+	}
+
+	SmallVector& operator=(const SmallVector& rhs)
+	{
+		if (this != &rhs)
+		{
+			clear();
+			reserve(rhs.m_size);
+			for (size_t i = 0; i < rhs.m_size; i++)
+			{
+				emplace_back(rhs.m_data[i]);
+			}
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& rhs)
+	{
+		if (this != &rhs)
+		{
+			clear();
+			releaseHeapStorage();
+			moveFrom(std::move(rhs));
+		}
+		return *this;
+	}
+
+	~SmallVector(void)
+	{
+		clear();
+		releaseHeapStorage();
+	}
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity)
+		{
+			reserve(m_capacity * 2);
+		}
+		auto l_result = new (m_data + m_size) T(std::forward<Args>(args)...);
+		m_size++;
+		return *l_result;
+	}
+
+	void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	void pop_back(void)
+	{
+		m_size--;
+		m_data[m_size].~T();
+	}
+
+	void reserve(size_t capacity)
+	{
+		if (capacity <= m_capacity)
+		{
+			return;
+		}
+
+		auto l_data = reinterpret_cast<T*>(::operator new(capacity * sizeof(T)));
+		for (size_t i = 0; i < m_size; i++)
+		{
+			new (l_data + i) T(std::move(m_data[i]));
+			m_data[i].~T();
+		}
+
+		releaseHeapStorage();
+		m_data = l_data;
+		m_capacity = capacity;
+	}
+
+	void resize(size_t size)
+	{
+		reserve(size);
+		while (m_size < size)
+		{
+			emplace_back();
+		}
+		while (m_size > size)
+		{
+			pop_back();
+		}
+	}
+
+	void clear(void)
+	{
+		for (size_t i = 0; i < m_size; i++)
+		{
+			m_data[i].~T();
+		}
+		m_size = 0;
+	}
+
+	T& operator[](size_t pos)
+	{
+		return m_data[pos];
+	}
+
+	const T& operator[](size_t pos) const
+	{
+		return m_data[pos];
+	}
+
+	T& front(void)
+	{
+		return m_data[0];
+	}
+
+	T& back(void)
+	{
+		return m_data[m_size - 1];
+	}
+
+	T* data(void)
+	{
+		return m_data;
+	}
+
+	const T* data(void) const
+	{
+		return m_data;
+	}
+
+	T* begin(void)
+	{
+		return m_data;
+	}
+
+	T* end(void)
+	{
+		return m_data + m_size;
+	}
+
+	const T* begin(void) const
+	{
+		return m_data;
+	}
+
+	const T* end(void) const
+	{
+		return m_data + m_size;
+	}
+
+	size_t size(void) const
+	{
+		return m_size;
+	}
+
+	size_t capacity(void) const
+	{
+		return m_capacity;
+	}
+
+	bool empty(void) const
+	{
+		return m_size == 0;
+	}
+
+	bool isInline(void) const
+	{
+		return m_data == getInlineStorage();
+	}
+
+private:
+	T* getInlineStorage(void) const
+	{
+		return reinterpret_cast<T*>(const_cast<unsigned char*>(m_inlineStorage));
+	}
+
+	void releaseHeapStorage(void)
+	{
+		if (!isInline())
+		{
+			::operator delete(m_data);
+		}
+		m_data = getInlineStorage();
+		m_capacity = N;
+	}
+
+	void moveFrom(SmallVector&& rhs)
+	{
+		if (rhs.isInline())
+		{
+			for (size_t i = 0; i < rhs.m_size; i++)
+			{
+				new (m_data + i) T(std::move(rhs.m_data[i]));
+			}
+			m_size = rhs.m_size;
+			rhs.clear();
+		}
+		else
+		{
+			// steal the heap storage
+			m_data = rhs.m_data;
+			m_size = rhs.m_size;
+			m_capacity = rhs.m_capacity;
+			rhs.m_data = rhs.getInlineStorage();
+			rhs.m_size = 0;
+			rhs.m_capacity = N;
+		}
+	}
+
+	alignas(T) unsigned char m_inlineStorage[sizeof(T) * (N > 0 ? N : 1)];
+	T* m_data = getInlineStorage();
+	size_t m_size = 0;
+	size_t m_capacity = N > 0 ? N : 1;
+};
+
+// open-addressing hash map in the style of Swiss tables:
+// one control byte per slot holds 7 bits of the hash, probing scans 16 control bytes at a time and only compares the keys whose control byte matches.
+// Key and Value must be default-constructible, erased slots are reset to a default value
+template <typename Key, typename Value, typename Hasher = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+{
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<Key, Value>;
+
+private:
+	static constexpr size_t GROUP_SIZE = 16;
+	static constexpr int8_t CTRL_EMPTY = -128;
+	static constexpr int8_t CTRL_DELETED = -2;
+
+	template <bool IsConst>
+	class Iterator
+	{
+	public:
+		using MapType = typename std::conditional<IsConst, const FlatHashMap, FlatHashMap>::type;
+		using reference = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+		using pointer = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+
+		Iterator(MapType* map, size_t index) : m_map(map), m_index(index)
+		{
+			skipEmptySlots();
+		}
+
+		operator Iterator<true>() const
+		{
+			return Iterator<true>(m_map, m_index);
+		}
+
+		reference operator*() const
+		{
+			return m_map->m_slots[m_index];
+		}
+
+		pointer operator->() const
+		{
+			return &m_map->m_slots[m_index];
+		}
+
+		Iterator& operator++()
+		{
+			m_index++;
+			skipEmptySlots();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto l_result = *this;
+			++(*this);
+			return l_result;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return m_index == rhs.m_index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return m_index != rhs.m_index;
+		}
+
+	private:
+		friend class FlatHashMap;
+
+		void skipEmptySlots()
+		{
+			while (m_index < m_map->m_ctrl.size() && m_map->m_ctrl[m_index] < 0)
+			{
+				m_index++;
+			}
+		}
+
+		MapType* m_map;
+		size_t m_index;
+	};
+
+public:
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	iterator begin(void)
+	{
+		return iterator(this, 0);
+	}
+
+	iterator end(void)
+	{
+		return iterator(this, m_ctrl.size());
+	}
+
+	const_iterator begin(void) const
+	{
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end(void) const
+	{
+		return const_iterator(this, m_ctrl.size());
+	}
+
+	iterator find(const Key& key)
+	{
+		return iterator(this, findIndex(key));
+	}
+
+	const_iterator find(const Key& key) const
+	{
+		return const_iterator(this, findIndex(key));
+	}
+
+	size_t count(const Key& key) const
+	{
+		return findIndex(key) != m_ctrl.size() ? 1 : 0;
+	}
+
+	std::pair<iterator, bool> emplace(const Key& key, const Value& value)
+	{
+		return emplace(value_type(key, value));
+	}
+
+	std::pair<iterator, bool> emplace(value_type value)
+	{
+		auto l_hash = hash(value.first);
+		auto l_index = findIndex(value.first, l_hash);
+		if (l_index != m_ctrl.size())
+		{
+			return { iterator(this, l_index), false };
+		}
+
+		if ((m_size + m_deleted + 1) * 8 > m_ctrl.size() * 7)
+		{
+			rehash(m_size + 1 > m_ctrl.size() * 7 / 16 ? m_ctrl.size() * 2 : m_ctrl.size());
+		}
+
+		l_index = findInsertIndex(l_hash);
+		if (m_ctrl[l_index] == CTRL_DELETED)
+		{
+			m_deleted--;
+		}
+		m_ctrl[l_index] = (int8_t)(l_hash & 0x7F);
+		m_slots[l_index] = std::move(value);
+		m_size++;
+
+		return { iterator(this, l_index), true };
+	}
+
+	std::pair<iterator, bool> insert(value_type value)
+	{
+		return emplace(std::move(value));
+	}
+
+	Value& operator[](const Key& key)
+	{
+		auto l_index = findIndex(key);
+		if (l_index != m_ctrl.size())
+		{
+			return m_slots[l_index].second;
+		}
+		return emplace(value_type(key, Value())).first->second;
+	}
+
+	size_t erase(const Key& key)
+	{
+		auto l_index = findIndex(key);
+		if (l_index == m_ctrl.size())
+		{
+			return 0;
+		}
+		eraseAt(l_index);
+		return 1;
+	}
+
+	iterator erase(iterator pos)
+	{
+		eraseAt(pos.m_index);
+		return iterator(this, pos.m_index + 1);
+	}
+
+	void clear(void)
+	{
+		for (size_t i = 0; i < m_ctrl.size(); i++)
+		{
+			if (m_ctrl[i] >= 0)
+			{
+				m_slots[i] = value_type();
+			}
+			m_ctrl[i] = CTRL_EMPTY;
+		}
+		m_size = 0;
+		m_deleted = 0;
+	}
+
+	void reserve(size_t count)
+	{
+		auto l_capacity = std::max(m_ctrl.size(), GROUP_SIZE);
+		while (count * 8 > l_capacity * 7)
+		{
+			l_capacity *= 2;
+		}
+		if (l_capacity != m_ctrl.size())
+		{
+			rehash(l_capacity);
+		}
+	}
+
+	size_t size(void) const
+	{
+		return m_size;
+	}
+
+	bool empty(void) const
+	{
+		return m_size == 0;
+	}
+
+private:
+	size_t hash(const Key& key) const
+	{
+		// std::hash is the identity for integers and pointers on most implementations, mix the bits before splitting them
+		uint64_t l_hash = (uint64_t)Hasher()(key);
+		l_hash ^= l_hash >> 33;
+		l_hash *= 0xff51afd7ed558ccdULL;
+		l_hash ^= l_hash >> 33;
+		return (size_t)l_hash;
+	}
+
+	// bit i is set if the i-th control byte of the group equals the value
+	uint32_t matchGroup(size_t groupIndex, int8_t value) const
+	{
+		auto l_ctrl = &m_ctrl[groupIndex * GROUP_SIZE];
+#ifdef INNO_CONTAINER_USE_SSE2
+		auto l_group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l_ctrl));
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(l_group, _mm_set1_epi8(value)));
+#else
+		uint32_t l_result = 0;
+		for (size_t i = 0; i < GROUP_SIZE; i++)
+		{
+			if (l_ctrl[i] == value)
+			{
+				l_result |= 1u << i;
+			}
+		}
+		return l_result;
+#endif
+	}
+
+	// bit i is set if the i-th control byte of the group is empty or deleted
+	uint32_t matchGroupEmptyOrDeleted(size_t groupIndex) const
+	{
+		auto l_ctrl = &m_ctrl[groupIndex * GROUP_SIZE];
+#ifdef INNO_CONTAINER_USE_SSE2
+		auto l_group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l_ctrl));
+		return (uint32_t)_mm_movemask_epi8(l_group);
+#else
+		uint32_t l_result = 0;
+		for (size_t i = 0; i < GROUP_SIZE; i++)
+		{
+			if (l_ctrl[i] < 0)
+			{
+				l_result |= 1u << i;
+			}
+		}
+		return l_result;
+#endif
+	}
+
+	static size_t countTrailingZeros(uint32_t mask)
+	{
+		size_t l_result = 0;
+		while ((mask & 1) == 0)
+		{
+			mask >>= 1;
+			l_result++;
+		}
+		return l_result;
+	}
+
+	size_t findIndex(const Key& key) const
+	{
+		return findIndex(key, hash(key));
+	}
+
+	size_t findIndex(const Key& key, size_t hash) const
+	{
+		if (m_ctrl.empty())
+		{
+			return 0;
+		}
+
+		auto l_groupMask = m_ctrl.size() / GROUP_SIZE - 1;
+		auto l_groupIndex = (hash >> 7) & l_groupMask;
+		auto l_tag = (int8_t)(hash & 0x7F);
+
+		for (size_t i = 0; i <= l_groupMask; i++)
+		{
+			auto l_match = matchGroup(l_groupIndex, l_tag);
+			while (l_match)
+			{
+				auto l_index = l_groupIndex * GROUP_SIZE + countTrailingZeros(l_match);
+				if (KeyEqual()(m_slots[l_index].first, key))
+				{
+					return l_index;
+				}
+				l_match &= l_match - 1;
+			}
+
+			// an empty slot terminates the probe sequence
+			if (matchGroup(l_groupIndex, CTRL_EMPTY))
+			{
+				break;
+			}
+
+			l_groupIndex = (l_groupIndex + i + 1) & l_groupMask;
+		}
+
+		return m_ctrl.size();
+	}
+
+	size_t findInsertIndex(size_t hash) const
+	{
+		auto l_groupMask = m_ctrl.size() / GROUP_SIZE - 1;
+		auto l_groupIndex = (hash >> 7) & l_groupMask;
+
+		for (size_t i = 0; ; i++)
+		{
+			auto l_match = matchGroupEmptyOrDeleted(l_groupIndex);
+			if (l_match)
+			{
+				return l_groupIndex * GROUP_SIZE + countTrailingZeros(l_match);
+			}
+			l_groupIndex = (l_groupIndex + i + 1) & l_groupMask;
+		}
+	}
+
+	void eraseAt(size_t index)
+	{
+		m_slots[index] = value_type();
+		m_ctrl[index] = CTRL_DELETED;
+		m_size--;
+		m_deleted++;
+	}
+
+	void rehash(size_t capacity)
+	{
+		if (capacity < GROUP_SIZE)
+		{
+			capacity = GROUP_SIZE;
+		}
+
+		auto l_oldCtrl = std::move(m_ctrl);
+		auto l_oldSlots = std::move(m_slots);
+
+		m_ctrl = std::vector<int8_t>(capacity, CTRL_EMPTY);
+		m_slots = std::vector<value_type>(capacity);
+		m_size = 0;
+		m_deleted = 0;
+
+		for (size_t i = 0; i < l_oldCtrl.size(); i++)
+		{
+			if (l_oldCtrl[i] >= 0)
+			{
+				auto l_index = findInsertIndex(hash(l_oldSlots[i].first));
+				m_ctrl[l_index] = l_oldCtrl[i];
+				m_slots[l_index] = std::move(l_oldSlots[i]);
+				m_size++;
+			}
+		}
+	}
+
+	std::vector<int8_t> m_ctrl;
+	std::vector<value_type> m_slots;
+	size_t m_size = 0;
+	size_t m_deleted = 0;
+};
+
 #ifdef INNO_PLATFORM_WIN
 template<class _Ty, class _Ax = innoAllocator<_Ty> >
 class innoList : public std::list<_Ty, _Ax>
@@ -3,7 +3,34 @@
 #include "../common/config.h"
 #include "../common/InnoType.h"
 
-//typedef __m128 TVec4;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INNO_MATH_USE_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define INNO_MATH_USE_AVX
+#include <immintrin.h>
+#endif
+
+#if defined(__FMA__)
+#define INNO_MATH_USE_FMA
+#endif
+
+// the float vectors and matrices are aligned to the SSE register width and loaded directly into it
+template<class T>
+struct TSIMDAlignment
+{
+	static constexpr size_t value = alignof(T);
+};
+
+#if defined (INNO_MATH_USE_SSE)
+template<>
+struct TSIMDAlignment<float>
+{
+	static constexpr size_t value = 16;
+};
+#endif
 
 template<class T>
 const static T PI = T(3.14159265358979323846264338327950288L);
@@ -130,7 +157,7 @@ public:
 template <class T>
 // In Homogeneous Coordinates, the w component is a scalar of x, y and z, to represent 3D point vector in 4D, set w to 1.0; to represent 3D direction vector in 4D, set w to 0.0.
 // In Quaternion, the w component is sin(theta / 2).
-class TVec4
+class alignas(TSIMDAlignment<T>::value) TVec4
 {
 public:
 	T x;
@@ -263,20 +290,17 @@ public:
 
 	auto length() -> T
 	{
-		// @TODO: replace with SIMD impl
 		return std::sqrt(x * x + y * y + z * z + w * w);
 	}
 
 	auto normalize() -> TVec4<T>
 	{
-		// @TODO: replace with SIMD impl
 		auto l_length = length();
 		return TVec4(x / l_length, y / l_length, z / l_length, w / l_length);
 	}
 
 	bool operator!=(const TVec4<T> & rhs)
 	{
-		// @TODO: replace with SIMD impl
 		if (x != rhs.x)
 		{
 			return true;
@@ -301,7 +325,6 @@ public:
 
 	bool operator==(const TVec4<T> & rhs)
 	{
-		// @TODO: replace with SIMD impl
 		return !(*this != rhs);
 	}
 
@@ -344,6 +367,168 @@ public:
 	}
 };
 
+#if defined (INNO_MATH_USE_SSE)
+// the SSE implementations of TVec4<float>, the generic template is kept for the other types
+namespace InnoMathSIMD
+{
+	inline __m128 load(const TVec4<float>& rhs)
+	{
+		return _mm_load_ps(&rhs.x);
+	}
+
+	inline TVec4<float> store(__m128 rhs)
+	{
+		TVec4<float> l_result;
+		_mm_store_ps(&l_result.x, rhs);
+		return l_result;
+	}
+
+	// the sum of all the lanes in all the lanes
+	inline __m128 horizontalAdd(__m128 rhs)
+	{
+		auto l_sum = _mm_add_ps(rhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(l_sum, _mm_shuffle_ps(l_sum, l_sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+
+	inline __m128 dot(__m128 lhs, __m128 rhs)
+	{
+		return horizontalAdd(_mm_mul_ps(lhs, rhs));
+	}
+
+	inline __m128 madd(__m128 a, __m128 b, __m128 c)
+	{
+#if defined (INNO_MATH_USE_FMA)
+		return _mm_fmadd_ps(a, b, c);
+#else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+	}
+
+	inline __m128 normalize(__m128 rhs)
+	{
+		return _mm_div_ps(rhs, _mm_sqrt_ps(dot(rhs, rhs)));
+	}
+
+	inline __m128 cross(__m128 lhs, __m128 rhs)
+	{
+		// (y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x, w * rhs.w - w * rhs.w)
+		auto l_lhsYZX = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+		auto l_rhsYZX = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+		auto l_result = _mm_sub_ps(_mm_mul_ps(lhs, l_rhsYZX), _mm_mul_ps(l_lhsYZX, rhs));
+		l_result = _mm_shuffle_ps(l_result, l_result, _MM_SHUFFLE(3, 0, 2, 1));
+		// clear the w component since inf or NaN could leave a NaN there
+		return _mm_and_ps(l_result, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+	}
+
+	inline __m128 quatMul(__m128 lhs, __m128 rhs)
+	{
+		auto l_w = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 3, 3, 3));
+		auto l_x = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 0, 0));
+		auto l_y = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(1, 1, 1, 1));
+		auto l_z = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 2, 2));
+
+		// (rhs.w, -rhs.z, rhs.y, -rhs.x)
+		auto l_rhsX = _mm_xor_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+		// (rhs.z, rhs.w, -rhs.x, -rhs.y)
+		auto l_rhsY = _mm_xor_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+		// (-rhs.y, rhs.x, rhs.w, -rhs.z)
+		auto l_rhsZ = _mm_xor_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+		auto l_result = _mm_mul_ps(l_w, rhs);
+		l_result = madd(l_x, l_rhsX, l_result);
+		l_result = madd(l_y, l_rhsY, l_result);
+		l_result = madd(l_z, l_rhsZ, l_result);
+
+		return l_result;
+	}
+}
+
+template<>
+inline auto TVec4<float>::operator+(const TVec4<float>& rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_add_ps(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator+(float rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_add_ps(InnoMathSIMD::load(*this), _mm_set1_ps(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator-(const TVec4<float>& rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_sub_ps(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator-(float rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_sub_ps(InnoMathSIMD::load(*this), _mm_set1_ps(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator*(const TVec4<float>& rhs) const -> float
+{
+	return _mm_cvtss_f32(InnoMathSIMD::dot(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::cross(const TVec4<float>& rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(InnoMathSIMD::cross(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::scale(const TVec4<float>& rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_mul_ps(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator*(float rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_mul_ps(InnoMathSIMD::load(*this), _mm_set1_ps(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::operator/(float rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(_mm_div_ps(InnoMathSIMD::load(*this), _mm_set1_ps(rhs)));
+}
+
+template<>
+inline auto TVec4<float>::quatMul(const TVec4<float>& rhs) const -> TVec4<float>
+{
+	return InnoMathSIMD::store(InnoMathSIMD::normalize(InnoMathSIMD::quatMul(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs))));
+}
+
+template<>
+inline auto TVec4<float>::length() -> float
+{
+	auto l_data = InnoMathSIMD::load(*this);
+	return _mm_cvtss_f32(_mm_sqrt_ss(InnoMathSIMD::dot(l_data, l_data)));
+}
+
+template<>
+inline auto TVec4<float>::normalize() -> TVec4<float>
+{
+	return InnoMathSIMD::store(InnoMathSIMD::normalize(InnoMathSIMD::load(*this)));
+}
+
+template<>
+inline bool TVec4<float>::operator!=(const TVec4<float>& rhs)
+{
+	return _mm_movemask_ps(_mm_cmpneq_ps(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs))) != 0;
+}
+
+template<>
+inline bool TVec4<float>::operator==(const TVec4<float>& rhs)
+{
+	return _mm_movemask_ps(_mm_cmpneq_ps(InnoMathSIMD::load(*this), InnoMathSIMD::load(rhs))) == 0;
+}
+#endif
+
 /*
 
 matrix4x4 mathematical convention :
@@ -414,7 +599,7 @@ m00 <-> x m01 <-> y m02 <-> z m03 <-> w  (best choice)
 */
 
 template<class T>
-class TMat4
+class alignas(TSIMDAlignment<T>::value) TMat4
 {
 public:
 	T m00 = T();
@@ -495,9 +680,8 @@ public:
 	}
 	//Column-Major memory layout
 #if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
-	auto TMat4::operator*(const TMat4<T> & rhs) -> TMat4<T>
+	auto operator*(const TMat4<T> & rhs) -> TMat4<T>
 	{
-		// @TODO: replace with SIMD impl
 		TMat4<T> l_m;
 
 		l_m.m00 = m00 * rhs.m00 + m10 * rhs.m01 + m20 * rhs.m02 + m30 * rhs.m03;
@@ -526,7 +710,6 @@ public:
 #elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
 	auto operator*(const TMat4<T> & rhs) -> TMat4<T>
 	{
-		// @TODO: replace with SIMD impl
 		TMat4<T> l_m;
 
 		l_m.m00 = m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30;
@@ -555,7 +738,6 @@ public:
 
 	auto operator*(const T rhs) -> TMat4<T>
 	{
-		// @TODO: replace with SIMD impl
 		TMat4<T> l_m;
 
 		l_m.m00 = rhs * m00;
@@ -580,7 +762,6 @@ public:
 
 	auto transpose() -> TMat4<T>
 	{
-		// @TODO: replace with SIMD impl
 		TMat4<T> l_m;
 
 		l_m.m00 = m00;
@@ -602,6 +783,99 @@ public:
 
 		return l_m;
 	}
+
+	// the element in the column vector convention, independent of the memory layout
+	auto at(size_t row, size_t column) -> T&
+	{
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+		return (&m00)[column * 4 + row];
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+		return (&m00)[row * 4 + column];
+#endif
+	}
+	auto at(size_t row, size_t column) const -> const T&
+	{
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+		return (&m00)[column * 4 + row];
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+		return (&m00)[row * 4 + column];
+#endif
+	}
+
+	// for the affine transformations, the projective part should be (0, 0, 0, 1)
+	auto inverseAffine() -> TMat4<T>
+	{
+		TMat4<T> l_m;
+
+		auto l_c00 = at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1);
+		auto l_c01 = at(1, 2) * at(2, 0) - at(1, 0) * at(2, 2);
+		auto l_c02 = at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0);
+
+		auto l_invDet = one<T> / (at(0, 0) * l_c00 + at(0, 1) * l_c01 + at(0, 2) * l_c02);
+
+		l_m.at(0, 0) = l_c00 * l_invDet;
+		l_m.at(1, 0) = l_c01 * l_invDet;
+		l_m.at(2, 0) = l_c02 * l_invDet;
+		l_m.at(0, 1) = (at(0, 2) * at(2, 1) - at(0, 1) * at(2, 2)) * l_invDet;
+		l_m.at(1, 1) = (at(0, 0) * at(2, 2) - at(0, 2) * at(2, 0)) * l_invDet;
+		l_m.at(2, 1) = (at(0, 1) * at(2, 0) - at(0, 0) * at(2, 1)) * l_invDet;
+		l_m.at(0, 2) = (at(0, 1) * at(1, 2) - at(0, 2) * at(1, 1)) * l_invDet;
+		l_m.at(1, 2) = (at(0, 2) * at(1, 0) - at(0, 0) * at(1, 2)) * l_invDet;
+		l_m.at(2, 2) = (at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0)) * l_invDet;
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			l_m.at(i, 3) = -(l_m.at(i, 0) * at(0, 3) + l_m.at(i, 1) * at(1, 3) + l_m.at(i, 2) * at(2, 3));
+		}
+		l_m.at(3, 3) = one<T>;
+
+		return l_m;
+	}
+
+	// for the rotations followed by the translations, without any scaling
+	auto inverseRigid() -> TMat4<T>
+	{
+		TMat4<T> l_m;
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			l_m.at(i, 0) = at(0, i);
+			l_m.at(i, 1) = at(1, i);
+			l_m.at(i, 2) = at(2, i);
+		}
+		for (size_t i = 0; i < 3; i++)
+		{
+			l_m.at(i, 3) = -(l_m.at(i, 0) * at(0, 3) + l_m.at(i, 1) * at(1, 3) + l_m.at(i, 2) * at(2, 3));
+		}
+		l_m.at(3, 3) = one<T>;
+
+		return l_m;
+	}
+
+	// for the pure rotations, the inverse is the transpose
+	auto inverseOrthonormal() -> TMat4<T>
+	{
+		return transpose();
+	}
+
+	// for the matrices from generatePerspectiveMatrix, the off-center (jittered) terms are preserved
+	auto inversePerspective() -> TMat4<T>
+	{
+		TMat4<T> l_m;
+
+		auto l_invE = one<T> / at(3, 2);
+
+		l_m.at(0, 0) = one<T> / at(0, 0);
+		l_m.at(0, 3) = -at(0, 2) * l_m.at(0, 0) * l_invE;
+		l_m.at(1, 1) = one<T> / at(1, 1);
+		l_m.at(1, 3) = -at(1, 2) * l_m.at(1, 1) * l_invE;
+		l_m.at(2, 3) = l_invE;
+		l_m.at(3, 2) = one<T> / at(2, 3);
+		l_m.at(3, 3) = -at(2, 2) * l_m.at(3, 2) * l_invE;
+
+		return l_m;
+	}
+
 	auto inverse() -> TMat4<T>
 	{
 		// @TODO: replace with SIMD impl
@@ -643,6 +917,183 @@ public:
 	}
 };
 
+#if defined (INNO_MATH_USE_SSE)
+// the SSE / AVX implementations of TMat4<float>, the matrices are only aligned to 16 bytes so the 256-bit accesses are unaligned
+namespace InnoMathSIMD
+{
+	// result row i = sum(lhs[i][k] * rhs row k), the rows are the rows in the memory
+	inline void multiply(const TMat4<float>& lhs, const TMat4<float>& rhs, TMat4<float>& result)
+	{
+		auto l_lhs = &lhs.m00;
+		auto l_rhs = &rhs.m00;
+		auto l_result = &result.m00;
+
+#if defined (INNO_MATH_USE_AVX)
+		// two result rows at once, each 128-bit lane holds one row
+		auto l_rhs0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l_rhs));
+		auto l_rhs1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l_rhs + 4));
+		auto l_rhs2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l_rhs + 8));
+		auto l_rhs3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l_rhs + 12));
+
+		for (size_t i = 0; i < 16; i += 8)
+		{
+			auto l_rows = _mm256_loadu_ps(l_lhs + i);
+			auto l_row = _mm256_mul_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(0, 0, 0, 0)), l_rhs0);
+#if defined (INNO_MATH_USE_FMA)
+			l_row = _mm256_fmadd_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(1, 1, 1, 1)), l_rhs1, l_row);
+			l_row = _mm256_fmadd_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(2, 2, 2, 2)), l_rhs2, l_row);
+			l_row = _mm256_fmadd_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(3, 3, 3, 3)), l_rhs3, l_row);
+#else
+			l_row = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(1, 1, 1, 1)), l_rhs1), l_row);
+			l_row = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(2, 2, 2, 2)), l_rhs2), l_row);
+			l_row = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(l_rows, l_rows, _MM_SHUFFLE(3, 3, 3, 3)), l_rhs3), l_row);
+#endif
+			_mm256_storeu_ps(l_result + i, l_row);
+		}
+#else
+		auto l_rhs0 = _mm_load_ps(l_rhs);
+		auto l_rhs1 = _mm_load_ps(l_rhs + 4);
+		auto l_rhs2 = _mm_load_ps(l_rhs + 8);
+		auto l_rhs3 = _mm_load_ps(l_rhs + 12);
+
+		for (size_t i = 0; i < 16; i += 4)
+		{
+			auto l_row = _mm_mul_ps(_mm_set1_ps(l_lhs[i]), l_rhs0);
+			l_row = madd(_mm_set1_ps(l_lhs[i + 1]), l_rhs1, l_row);
+			l_row = madd(_mm_set1_ps(l_lhs[i + 2]), l_rhs2, l_row);
+			l_row = madd(_mm_set1_ps(l_lhs[i + 3]), l_rhs3, l_row);
+			_mm_store_ps(l_result + i, l_row);
+		}
+#endif
+	}
+
+	// result[i] = dot(lhs row i, rhs)
+	inline __m128 transform(const TMat4<float>& lhs, __m128 rhs)
+	{
+		auto l_lhs = &lhs.m00;
+
+#if defined (INNO_MATH_USE_AVX)
+		auto l_rhs = _mm256_set_m128(rhs, rhs);
+		auto l_rows01 = _mm256_mul_ps(_mm256_loadu_ps(l_lhs), l_rhs);
+		auto l_rows23 = _mm256_mul_ps(_mm256_loadu_ps(l_lhs + 8), l_rhs);
+		// (d0, d2, d0, d2 | d1, d3, d1, d3)
+		auto l_sum = _mm256_hadd_ps(l_rows01, l_rows23);
+		l_sum = _mm256_hadd_ps(l_sum, l_sum);
+		return _mm_unpacklo_ps(_mm256_castps256_ps128(l_sum), _mm256_extractf128_ps(l_sum, 1));
+#else
+		auto l_row0 = _mm_mul_ps(_mm_load_ps(l_lhs), rhs);
+		auto l_row1 = _mm_mul_ps(_mm_load_ps(l_lhs + 4), rhs);
+		auto l_row2 = _mm_mul_ps(_mm_load_ps(l_lhs + 8), rhs);
+		auto l_row3 = _mm_mul_ps(_mm_load_ps(l_lhs + 12), rhs);
+		_MM_TRANSPOSE4_PS(l_row0, l_row1, l_row2, l_row3);
+		return _mm_add_ps(_mm_add_ps(l_row0, l_row1), _mm_add_ps(l_row2, l_row3));
+#endif
+	}
+
+	// result = sum(rhs[k] * lhs row k)
+	inline __m128 transformTransposed(const TMat4<float>& lhs, __m128 rhs)
+	{
+		auto l_lhs = &lhs.m00;
+
+		auto l_result = _mm_mul_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 0, 0, 0)), _mm_load_ps(l_lhs));
+		l_result = madd(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 1, 1, 1)), _mm_load_ps(l_lhs + 4), l_result);
+		l_result = madd(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 2, 2, 2)), _mm_load_ps(l_lhs + 8), l_result);
+		l_result = madd(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 3, 3, 3)), _mm_load_ps(l_lhs + 12), l_result);
+
+		return l_result;
+	}
+
+	// translation * rotation * scale in one pass, the columns of the rotation matrix come from the quaternion directly
+	inline void compose(__m128 pos, __m128 rot, __m128 scale, TMat4<float>& result)
+	{
+		auto l_maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		auto l_rot2 = _mm_add_ps(rot, rot);
+
+		// (1 - 2yy - 2zz, 1 - 2xx - 2zz, 1 - 2xx - 2yy, 0)
+		auto l_diagonal = _mm_mul_ps(_mm_shuffle_ps(rot, rot, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(l_rot2, l_rot2, _MM_SHUFFLE(3, 0, 0, 1)));
+		l_diagonal = madd(_mm_shuffle_ps(rot, rot, _MM_SHUFFLE(3, 1, 2, 2)), _mm_shuffle_ps(l_rot2, l_rot2, _MM_SHUFFLE(3, 1, 2, 2)), l_diagonal);
+		l_diagonal = _mm_and_ps(_mm_sub_ps(_mm_set1_ps(1.0f), l_diagonal), l_maskXYZ);
+
+		// (2xy, 2xz, 2yz, 0) +/- (2wz, 2wy, 2wx, 0)
+		auto l_a = _mm_mul_ps(_mm_shuffle_ps(rot, rot, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(l_rot2, l_rot2, _MM_SHUFFLE(3, 2, 2, 1)));
+		auto l_b = _mm_mul_ps(_mm_shuffle_ps(rot, rot, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(l_rot2, l_rot2, _MM_SHUFFLE(3, 0, 1, 2)));
+		auto l_sum = _mm_and_ps(_mm_add_ps(l_a, l_b), l_maskXYZ);
+		auto l_difference = _mm_and_ps(_mm_sub_ps(l_a, l_b), l_maskXYZ);
+
+		auto l_column0 = _mm_shuffle_ps(_mm_unpacklo_ps(l_diagonal, l_sum), l_difference, _MM_SHUFFLE(3, 1, 1, 0));
+		auto l_column1 = _mm_shuffle_ps(_mm_shuffle_ps(l_difference, l_diagonal, _MM_SHUFFLE(1, 1, 0, 0)), l_sum, _MM_SHUFFLE(3, 2, 2, 0));
+		auto l_column2 = _mm_shuffle_ps(_mm_shuffle_ps(l_sum, l_difference, _MM_SHUFFLE(2, 2, 1, 1)), l_diagonal, _MM_SHUFFLE(3, 2, 2, 0));
+		auto l_column3 = _mm_or_ps(_mm_and_ps(pos, l_maskXYZ), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+		l_column0 = _mm_mul_ps(l_column0, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(0, 0, 0, 0)));
+		l_column1 = _mm_mul_ps(l_column1, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 1, 1, 1)));
+		l_column2 = _mm_mul_ps(l_column2, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 2, 2)));
+		l_column3 = _mm_mul_ps(l_column3, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(3, 3, 3, 3)));
+
+		//Row-Major memory layout
+#if defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+		_MM_TRANSPOSE4_PS(l_column0, l_column1, l_column2, l_column3);
+#endif
+		_mm_store_ps(&result.m00, l_column0);
+		_mm_store_ps(&result.m10, l_column1);
+		_mm_store_ps(&result.m20, l_column2);
+		_mm_store_ps(&result.m30, l_column3);
+	}
+}
+
+//Column-Major memory layout
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+template<>
+inline auto TMat4<float>::operator*(const TMat4<float>& rhs) -> TMat4<float>
+{
+	TMat4<float> l_m;
+	InnoMathSIMD::multiply(rhs, *this, l_m);
+	return l_m;
+}
+//Row-Major memory layout
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+template<>
+inline auto TMat4<float>::operator*(const TMat4<float>& rhs) -> TMat4<float>
+{
+	TMat4<float> l_m;
+	InnoMathSIMD::multiply(*this, rhs, l_m);
+	return l_m;
+}
+#endif
+
+template<>
+inline auto TMat4<float>::operator*(const float rhs) -> TMat4<float>
+{
+	TMat4<float> l_m;
+	auto l_rhs = _mm_set1_ps(rhs);
+
+	for (size_t i = 0; i < 16; i += 4)
+	{
+		_mm_store_ps(&l_m.m00 + i, _mm_mul_ps(_mm_load_ps(&m00 + i), l_rhs));
+	}
+
+	return l_m;
+}
+
+template<>
+inline auto TMat4<float>::transpose() -> TMat4<float>
+{
+	TMat4<float> l_m;
+
+	auto l_row0 = _mm_load_ps(&m00);
+	auto l_row1 = _mm_load_ps(&m10);
+	auto l_row2 = _mm_load_ps(&m20);
+	auto l_row3 = _mm_load_ps(&m30);
+	_MM_TRANSPOSE4_PS(l_row0, l_row1, l_row2, l_row3);
+	_mm_store_ps(&l_m.m00, l_row0);
+	_mm_store_ps(&l_m.m10, l_row1);
+	_mm_store_ps(&l_m.m20, l_row2);
+	_mm_store_ps(&l_m.m30, l_row3);
+
+	return l_m;
+}
+#endif
+
 template<class T>
 class TVertex
 {
@@ -852,81 +1303,238 @@ enum direction { FORWARD, BACKWARD, UP, DOWN, RIGHT, LEFT };
 
 namespace InnoMath
 {
+	// the polynomial approximations of the trigonometric functions, no libm call and no table, the same polynomials are evaluated by the SIMD batches,
+	// the max errors are measured in float over the documented domains
+
+	// Taylor series of sin(x) / x in x^2, enough for |x| <= PI / 2
 	template<class T>
-	auto lerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
-	{
-		return a * alpha + b * (one<T> -alpha);
-	}
+	constexpr T sinCoefficients[6] = { T(1.0L), T(-1.0L / 6.0L), T(1.0L / 120.0L), T(-1.0L / 5040.0L), T(1.0L / 362880.0L), T(-1.0L / 39916800.0L) };
 
+	// Abramowitz and Stegun 4.4.46, acos(x) = sqrt(1 - x) * P(x) for 0 <= x <= 1
 	template<class T>
-	auto slerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
-	{
-		T cosOfAngle = a * b;
-		// use nlerp for quaternions which are too close
-		if (cosOfAngle > one<T> - epsilon4<T>) {
-			return (a * alpha + b * (one<T>-alpha)).normalize();
-		}
-		// for shorter path
-		if (cosOfAngle < T()) {
-			auto theta_0 = acos(-cosOfAngle);
-			auto theta = theta_0 * alpha;
-			auto sin_theta = sin(theta);
-			auto sin_theta_0 = sin(theta_0);
+	constexpr T acosCoefficients[8] = { T(1.5707963050L), T(-0.2145988016L), T(0.0889789874L), T(-0.0501743046L), T(0.0308918810L), T(-0.0170881256L), T(0.0066700901L), T(-0.0012624911L) };
 
-			auto s0 = sin_theta / sin_theta_0;
-			auto s1 = cos(theta) + cosOfAngle * sin_theta / sin_theta_0;
+	// Abramowitz and Stegun 4.4.49, atan(x) / x in x^2 for 0 <= x <= 1
+	template<class T>
+	constexpr T atanCoefficients[9] = { T(1.0L), T(-0.3333314528L), T(0.1999355085L), T(-0.1420889944L), T(0.1065626393L), T(-0.0752896400L), T(0.0429096138L), T(-0.0161657367L), T(0.0028662257L) };
 
-			return ((a * -one<T> * s0) + (b * s1)).normalize();
-}
-		else
-		{
-			auto theta_0 = acos(cosOfAngle);
-			auto theta = theta_0 * alpha;
-			auto sin_theta = std::sin(theta);
-			auto sin_theta_0 = std::sin(theta_0);
+	// PI split for the range reduction, the multiples of the high part are exact for |k| < 2^15
+	template<class T>
+	constexpr T PIHigh = T(3.140625L);
+	template<class T>
+	constexpr T PILow = T(9.67653589793238462643383279502884197e-4L);
 
-			auto s0 = sin_theta / sin_theta_0;
-			auto s1 = std::cos(theta) - cosOfAngle * sin_theta / sin_theta_0;
+	// |x| <= PI / 2
+	template<class T>
+	auto sinPolynomial(T x) -> T
+	{
+		auto l_x2 = x * x;
+		auto l_result = sinCoefficients<T>[5];
+		l_result = l_result * l_x2 + sinCoefficients<T>[4];
+		l_result = l_result * l_x2 + sinCoefficients<T>[3];
+		l_result = l_result * l_x2 + sinCoefficients<T>[2];
+		l_result = l_result * l_x2 + sinCoefficients<T>[1];
 
-			return ((a * s0) + (b * s1)).normalize();
-		}
+		return x + x * l_x2 * l_result;
 	}
 
+	// max absolute error 1.7e-7 for |x| <= 8192
 	template<class T>
-	auto nlerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
+	auto fastSin(T x) -> T
 	{
-		return (a * alpha + b * (one<T> -alpha)).normalize();
+		// x = k * PI + r, |r| <= PI / 2, sin(x) = (-1)^k * sin(r)
+		auto l_k = std::round(x / PI<T>);
+		auto l_r = (x - l_k * PIHigh<T>) - l_k * PILow<T>;
+		auto l_result = sinPolynomial(l_r);
+		auto l_isOdd = l_k - two<T> * std::floor(l_k * half<T>) != zero<T>;
+
+		return l_isOdd ? -l_result : l_result;
 	}
 
-#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+	// max absolute error 1.7e-7 for |x| <= 8192
 	template<class T>
-	auto mul(const TVec4<T> & lhs, const TMat4<T> & rhs) -> TVec4<T>
+	auto fastCos(T x) -> T
 	{
-		// @TODO: replace with SIMD impl
-		TVec4<T> l_TVec4;
-
-		l_TVec4.x = lhs.x * rhs.m00 + lhs.y * rhs.m10 + lhs.z * rhs.m20 + lhs.w * rhs.m30;
-		l_TVec4.y = lhs.x * rhs.m01 + lhs.y * rhs.m11 + lhs.z * rhs.m21 + lhs.w * rhs.m31;
-		l_TVec4.z = lhs.x * rhs.m02 + lhs.y * rhs.m12 + lhs.z * rhs.m22 + lhs.w * rhs.m32;
-		l_TVec4.w = lhs.x * rhs.m03 + lhs.y * rhs.m13 + lhs.z * rhs.m23 + lhs.w * rhs.m33;
+		// x = (k + 1 / 2) * PI + r, |r| <= PI / 2, cos(x) = -(-1)^k * sin(r)
+		auto l_k = std::round(x / PI<T> - half<T>);
+		auto l_m = l_k + half<T>;
+		auto l_r = (x - l_m * PIHigh<T>) - l_m * PILow<T>;
+		auto l_result = sinPolynomial(l_r);
+		auto l_isOdd = l_k - two<T> * std::floor(l_k * half<T>) != zero<T>;
 
-		return l_TVec4;
+		return l_isOdd ? l_result : -l_result;
 	}
-#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+
+	// max absolute error 4.4e-7, x is clamped to [-1, 1]
 	template<class T>
-	auto mul(const TMat4<T> & lhs, const TVec4<T> & rhs) -> TVec4<T>
+	auto fastAcos(T x) -> T
 	{
-		// @TODO: replace with SIMD impl
-		TVec4<T> l_TVec4;
-
-		l_TVec4.x = lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z + lhs.m03 * rhs.w;
-		l_TVec4.y = lhs.m10 * rhs.x + lhs.m11 * rhs.y + lhs.m12 * rhs.z + lhs.m13 * rhs.w;
-		l_TVec4.z = lhs.m20 * rhs.x + lhs.m21 * rhs.y + lhs.m22 * rhs.z + lhs.m23 * rhs.w;
-		l_TVec4.w = lhs.m30 * rhs.x + lhs.m31 * rhs.y + lhs.m32 * rhs.z + lhs.m33 * rhs.w;
+		auto l_abs = std::min(std::abs(x), one<T>);
+		auto l_result = acosCoefficients<T>[7];
+		for (int i = 6; i >= 0; i--)
+		{
+			l_result = l_result * l_abs + acosCoefficients<T>[i];
+		}
+		l_result *= std::sqrt(one<T> - l_abs);
 
-		return l_TVec4;
+		return x < zero<T> ? PI<T> - l_result : l_result;
 	}
-#endif
+
+	// max absolute error 4.4e-7, x is clamped to [-1, 1]
+	template<class T>
+	auto fastAsin(T x) -> T
+	{
+		return PI<T> * half<T> - fastAcos(x);
+	}
+
+	// max absolute error 3.2e-7, returns 0 for (0, 0)
+	template<class T>
+	auto fastAtan2(T y, T x) -> T
+	{
+		auto l_absX = std::abs(x);
+		auto l_absY = std::abs(y);
+		auto l_max = std::max(l_absX, l_absY);
+
+		if (l_max == zero<T>)
+		{
+			return zero<T>;
+		}
+
+		auto l_t = std::min(l_absX, l_absY) / l_max;
+		auto l_t2 = l_t * l_t;
+		auto l_result = atanCoefficients<T>[8];
+		for (int i = 7; i >= 0; i--)
+		{
+			l_result = l_result * l_t2 + atanCoefficients<T>[i];
+		}
+		l_result *= l_t;
+
+		if (l_absY > l_absX)
+		{
+			l_result = PI<T> * half<T> - l_result;
+		}
+		if (x < zero<T>)
+		{
+			l_result = PI<T> - l_result;
+		}
+
+		return y < zero<T> ? -l_result : l_result;
+	}
+
+	// the trigonometric functions of the engine, INNO_MATH_FAST_TRIGONOMETRY selects the polynomial approximations instead of the standard library
+#if defined (INNO_MATH_FAST_TRIGONOMETRY)
+	template<class T>
+	auto sin(T x) -> T { return fastSin(x); }
+	template<class T>
+	auto cos(T x) -> T { return fastCos(x); }
+	template<class T>
+	auto acos(T x) -> T { return fastAcos(x); }
+	template<class T>
+	auto asin(T x) -> T { return fastAsin(x); }
+	template<class T>
+	auto atan2(T y, T x) -> T { return fastAtan2(y, x); }
+#else
+	template<class T>
+	auto sin(T x) -> T { return std::sin(x); }
+	template<class T>
+	auto cos(T x) -> T { return std::cos(x); }
+	template<class T>
+	auto acos(T x) -> T { return std::acos(x); }
+	template<class T>
+	auto asin(T x) -> T { return std::asin(x); }
+	template<class T>
+	auto atan2(T y, T x) -> T { return std::atan2(y, x); }
+#endif
+
+	template<class T>
+	auto lerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
+	{
+		return a * alpha + b * (one<T> -alpha);
+	}
+
+	template<class T>
+	auto slerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
+	{
+		T cosOfAngle = a * b;
+		// use nlerp for quaternions which are too close
+		if (cosOfAngle > one<T> - epsilon4<T>) {
+			return (a * alpha + b * (one<T>-alpha)).normalize();
+		}
+		// for shorter path
+		if (cosOfAngle < T()) {
+			auto theta_0 = acos(-cosOfAngle);
+			auto theta = theta_0 * alpha;
+			auto sin_theta = sin(theta);
+			auto sin_theta_0 = sin(theta_0);
+
+			auto s0 = sin_theta / sin_theta_0;
+			auto s1 = cos(theta) + cosOfAngle * sin_theta / sin_theta_0;
+
+			return ((a * -one<T> * s0) + (b * s1)).normalize();
+}
+		else
+		{
+			auto theta_0 = acos(cosOfAngle);
+			auto theta = theta_0 * alpha;
+			auto sin_theta = sin(theta);
+			auto sin_theta_0 = sin(theta_0);
+
+			auto s0 = sin_theta / sin_theta_0;
+			auto s1 = cos(theta) - cosOfAngle * sin_theta / sin_theta_0;
+
+			return ((a * s0) + (b * s1)).normalize();
+		}
+	}
+
+	template<class T>
+	auto nlerp(const TVec4<T>& a, const TVec4<T>& b, T alpha) -> TVec4<T>
+	{
+		return (a * alpha + b * (one<T> -alpha)).normalize();
+	}
+
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+	template<class T>
+	auto mul(const TVec4<T> & lhs, const TMat4<T> & rhs) -> TVec4<T>
+	{
+		TVec4<T> l_TVec4;
+
+		l_TVec4.x = lhs.x * rhs.m00 + lhs.y * rhs.m10 + lhs.z * rhs.m20 + lhs.w * rhs.m30;
+		l_TVec4.y = lhs.x * rhs.m01 + lhs.y * rhs.m11 + lhs.z * rhs.m21 + lhs.w * rhs.m31;
+		l_TVec4.z = lhs.x * rhs.m02 + lhs.y * rhs.m12 + lhs.z * rhs.m22 + lhs.w * rhs.m32;
+		l_TVec4.w = lhs.x * rhs.m03 + lhs.y * rhs.m13 + lhs.z * rhs.m23 + lhs.w * rhs.m33;
+
+		return l_TVec4;
+	}
+
+#if defined (INNO_MATH_USE_SSE)
+	template<>
+	inline auto mul(const TVec4<float> & lhs, const TMat4<float> & rhs) -> TVec4<float>
+	{
+		return InnoMathSIMD::store(InnoMathSIMD::transformTransposed(rhs, InnoMathSIMD::load(lhs)));
+	}
+#endif
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+	template<class T>
+	auto mul(const TMat4<T> & lhs, const TVec4<T> & rhs) -> TVec4<T>
+	{
+		TVec4<T> l_TVec4;
+
+		l_TVec4.x = lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z + lhs.m03 * rhs.w;
+		l_TVec4.y = lhs.m10 * rhs.x + lhs.m11 * rhs.y + lhs.m12 * rhs.z + lhs.m13 * rhs.w;
+		l_TVec4.z = lhs.m20 * rhs.x + lhs.m21 * rhs.y + lhs.m22 * rhs.z + lhs.m23 * rhs.w;
+		l_TVec4.w = lhs.m30 * rhs.x + lhs.m31 * rhs.y + lhs.m32 * rhs.z + lhs.m33 * rhs.w;
+
+		return l_TVec4;
+	}
+
+#if defined (INNO_MATH_USE_SSE)
+	template<>
+	inline auto mul(const TMat4<float> & lhs, const TVec4<float> & rhs) -> TVec4<float>
+	{
+		return InnoMathSIMD::store(InnoMathSIMD::transform(lhs, InnoMathSIMD::load(rhs)));
+	}
+#endif
+#endif
 
 	template<class T>
 	auto generateIdentityMatrix() ->TMat4<T>
@@ -1086,7 +1694,7 @@ namespace InnoMath
 		TMat4<T> l_m;
 
 		l_m.m00 = (one<T> -two<T> * rhs.y * rhs.y - two<T> * rhs.z * rhs.z);
-		l_m.m01 = (two<T> * rhs.x * y + two<T> * rhs.z * rhs.w);
+		l_m.m01 = (two<T> * rhs.x * rhs.y + two<T> * rhs.z * rhs.w);
 		l_m.m02 = (two<T> * rhs.x * rhs.z - two<T> * rhs.y * rhs.w);
 		l_m.m03 = (T());
 
@@ -1161,9 +1769,9 @@ namespace InnoMath
 		// @TODO: replace with SIMD impl
 		TVec4<T> l_result;
 
-		l_result.x = l_m.m30;
-		l_result.y = l_m.m31;
-		l_result.z = l_m.m32;
+		l_result.x = rhs.m30;
+		l_result.y = rhs.m31;
+		l_result.z = rhs.m32;
 		l_result.w = one<T>;
 
 		return l_result;
@@ -1176,9 +1784,9 @@ namespace InnoMath
 		// @TODO: replace with SIMD impl
 		TVec4<T> l_result;
 
-		l_result.x = l_m.m03;
-		l_result.y = l_m.m13;
-		l_result.z = l_m.m23;
+		l_result.x = rhs.m03;
+		l_result.y = rhs.m13;
+		l_result.z = rhs.m23;
 		l_result.w = one<T>;
 
 		return l_result;
@@ -1188,7 +1796,7 @@ namespace InnoMath
 	//Column-Major memory layout
 #if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
 	template<class T>
-	auto toRotationVector(const TVec4<T>& rhs) -> TMat4<T>
+	auto toRotationVector(const TMat4<T>& rhs) -> TVec4<T>
 	{
 		// @TODO: replace with SIMD impl
 		TVec4<T> l_result;
@@ -1285,10 +1893,10 @@ namespace InnoMath
 		// @TODO: replace with SIMD impl
 		TVec4<T> l_result;
 
-		l_result.x = l_m.m00;
-		l_result.y = l_m.m11;
-		l_result.z = l_m.m22;
-		l_result.w = l_m.m33;
+		l_result.x = rhs.m00;
+		l_result.y = rhs.m11;
+		l_result.z = rhs.m22;
+		l_result.w = rhs.m33;
 
 		return l_result;
 	}
@@ -1630,8 +2238,8 @@ namespace InnoMath
 	{
 		TVec4<T> normalizedAxis = axis;
 		normalizedAxis = normalizedAxis.normalize();
-		T sinHalfAngle = std::sin((angle * PI<T> / halfCircumference<T>) / two<T>);
-		T cosHalfAngle = std::cos((angle * PI<T> / halfCircumference<T>) / two<T>);
+		T sinHalfAngle = sin((angle * PI<T> / halfCircumference<T>) / two<T>);
+		T cosHalfAngle = cos((angle * PI<T> / halfCircumference<T>) / two<T>);
 
 		return TVec4<T>(normalizedAxis.x * sinHalfAngle, normalizedAxis.y * sinHalfAngle, normalizedAxis.z * sinHalfAngle, cosHalfAngle);
 	}
@@ -1707,6 +2315,42 @@ namespace InnoMath
 		return transform.m_translationMat * transform.m_rotationMat * transform.m_scaleMat;
 	}
 
+	// the same as toTranslationMatrix(pos) * toRotationMatrix(rot) * toScaleMatrix(scale)
+	template<class T>
+	auto composeTransformationMatrix(const TVec4<T> & pos, const TVec4<T> & rot, const TVec4<T> & scale) -> TMat4<T>
+	{
+		TMat4<T> l_m;
+
+		l_m.at(0, 0) = (one<T> -two<T> * rot.y * rot.y - two<T> * rot.z * rot.z) * scale.x;
+		l_m.at(0, 1) = (two<T> * rot.x * rot.y - two<T> * rot.z * rot.w) * scale.y;
+		l_m.at(0, 2) = (two<T> * rot.x * rot.z + two<T> * rot.y * rot.w) * scale.z;
+		l_m.at(0, 3) = pos.x * scale.w;
+
+		l_m.at(1, 0) = (two<T> * rot.x * rot.y + two<T> * rot.z * rot.w) * scale.x;
+		l_m.at(1, 1) = (one<T> -two<T> * rot.x * rot.x - two<T> * rot.z * rot.z) * scale.y;
+		l_m.at(1, 2) = (two<T> * rot.y * rot.z - two<T> * rot.x * rot.w) * scale.z;
+		l_m.at(1, 3) = pos.y * scale.w;
+
+		l_m.at(2, 0) = (two<T> * rot.x * rot.z - two<T> * rot.y * rot.w) * scale.x;
+		l_m.at(2, 1) = (two<T> * rot.y * rot.z + two<T> * rot.x * rot.w) * scale.y;
+		l_m.at(2, 2) = (one<T> -two<T> * rot.x * rot.x - two<T> * rot.y * rot.y) * scale.z;
+		l_m.at(2, 3) = pos.z * scale.w;
+
+		l_m.at(3, 3) = scale.w;
+
+		return l_m;
+	}
+
+#if defined (INNO_MATH_USE_SSE)
+	template<>
+	inline auto composeTransformationMatrix(const TVec4<float> & pos, const TVec4<float> & rot, const TVec4<float> & scale) -> TMat4<float>
+	{
+		TMat4<float> l_m;
+		InnoMathSIMD::compose(InnoMathSIMD::load(pos), InnoMathSIMD::load(rot), InnoMathSIMD::load(scale), l_m);
+		return l_m;
+	}
+#endif
+
 	template<class T>
 	auto TransformVectorToTransformMatrix(const TTransformVector<T> & transformVector)->TTransformMatrix<T>
 	{
@@ -1714,7 +2358,7 @@ namespace InnoMath
 		m.m_translationMat = InnoMath::toTranslationMatrix(transformVector.m_pos);
 		m.m_rotationMat = InnoMath::toRotationMatrix(transformVector.m_rot);
 		m.m_scaleMat = InnoMath::toScaleMatrix(transformVector.m_scale);
-		m.m_transformationMat = caclTransformationMatrix(m);
+		m.m_transformationMat = composeTransformationMatrix(transformVector.m_pos, transformVector.m_rot, transformVector.m_scale);
 		return m;
 	}
 
@@ -1798,7 +2442,7 @@ namespace InnoMath
 		// roll (x-axis rotation)
 		T sinr_cosp = +two<T> * (rhs.w * rhs.x + rhs.y * rhs.z);
 		T cosr_cosp = +one<T> - two<T> * (rhs.x * rhs.x + rhs.y * rhs.y);
-		T roll = std::atan2(sinr_cosp, cosr_cosp);
+		T roll = atan2(sinr_cosp, cosr_cosp);
 
 		// pitch (y-axis rotation)
 		T sinp = +two<T> * (rhs.w * rhs.y - rhs.z * rhs.x);
@@ -1809,13 +2453,13 @@ namespace InnoMath
 		}
 		else
 		{
-			pitch = std::asin(sinp);
+			pitch = asin(sinp);
 		}
 
 		// yaw (z-axis rotation)
 		T siny_cosp = +two<T> * (rhs.w * rhs.z + rhs.x * rhs.y);
 		T cosy_cosp = +one<T> - two<T> * (rhs.y * rhs.y + rhs.z * rhs.z);
-		T yaw = std::atan2(siny_cosp, cosy_cosp);
+		T yaw = atan2(siny_cosp, cosy_cosp);
 
 		return TVec4<T>(roll, pitch, yaw, zero<T>);
 	}
@@ -1824,12 +2468,12 @@ namespace InnoMath
 	auto eulerAngleToQuat(T roll, T pitch, T yaw) -> TVec4<T>
 	{
 		// Abbreviations for the various angular functions
-		T cy = std::cos(yaw * half<T>);
-		T sy = std::sin(yaw * half<T>);
-		T cp = std::cos(pitch * half<T>);
-		T sp = std::sin(pitch * half<T>);
-		T cr = std::cos(roll * half<T>);
-		T sr = std::sin(roll * half<T>);
+		T cy = cos(yaw * half<T>);
+		T sy = sin(yaw * half<T>);
+		T cp = cos(pitch * half<T>);
+		T sp = sin(pitch * half<T>);
+		T cr = cos(roll * half<T>);
+		T sr = sin(roll * half<T>);
 
 		T w = cy * cp * cr + sy * sp * sr;
 		T x = cy * cp * sr - sy * sp * cr;
@@ -1935,7 +2579,7 @@ namespace InnoMath
 
 		for (auto& l_vertexData : l_vertices)
 		{
-			l_vertexData.m_normal = vec4(l_vertexData.m_pos.x, l_vertexData.m_pos.y, l_vertexData.m_pos.z, zero<T>).normalize();
+			l_vertexData.m_normal = TVec4<T>(l_vertexData.m_pos.x, l_vertexData.m_pos.y, l_vertexData.m_pos.z, zero<T>).normalize();
 		}
 
 		return l_vertices;
@@ -1968,6 +2612,92 @@ namespace InnoMath
 
 		return l_result;
 	};
+
+	template<class T>
+	auto makePlane(T a, T b, T c, T d) -> TPlane<T>
+	{
+		TPlane<T> l_result;
+
+		auto l_invLength = one<T> / std::sqrt(a * a + b * b + c * c);
+
+		l_result.m_normal = TVec4<T>(a * l_invLength, b * l_invLength, c * l_invLength, zero<T>);
+		l_result.m_distance = -d * l_invLength;
+
+		return l_result;
+	};
+
+	// Gribb-Hartmann plane extraction, the normals point into the frustum, a point p is inside when m_normal * p >= m_distance
+	// m_px/m_nx: right/left, m_py/m_ny: top/bottom, m_pz/m_nz: near/far
+	//Column-Major memory layout
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+	template<class T>
+	auto makeFrustum(const TMat4<T>& viewProjection) -> TFrustum<T>
+	{
+		auto& m = viewProjection;
+		TFrustum<T> l_result;
+
+		l_result.m_px = makePlane(m.m03 - m.m00, m.m13 - m.m10, m.m23 - m.m20, m.m33 - m.m30);
+		l_result.m_nx = makePlane(m.m03 + m.m00, m.m13 + m.m10, m.m23 + m.m20, m.m33 + m.m30);
+		l_result.m_py = makePlane(m.m03 - m.m01, m.m13 - m.m11, m.m23 - m.m21, m.m33 - m.m31);
+		l_result.m_ny = makePlane(m.m03 + m.m01, m.m13 + m.m11, m.m23 + m.m21, m.m33 + m.m31);
+		l_result.m_pz = makePlane(m.m03 + m.m02, m.m13 + m.m12, m.m23 + m.m22, m.m33 + m.m32);
+		l_result.m_nz = makePlane(m.m03 - m.m02, m.m13 - m.m12, m.m23 - m.m22, m.m33 - m.m32);
+
+		return l_result;
+	};
+	//Row-Major memory layout
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+	template<class T>
+	auto makeFrustum(const TMat4<T>& viewProjection) -> TFrustum<T>
+	{
+		auto& m = viewProjection;
+		TFrustum<T> l_result;
+
+		l_result.m_px = makePlane(m.m30 - m.m00, m.m31 - m.m01, m.m32 - m.m02, m.m33 - m.m03);
+		l_result.m_nx = makePlane(m.m30 + m.m00, m.m31 + m.m01, m.m32 + m.m02, m.m33 + m.m03);
+		l_result.m_py = makePlane(m.m30 - m.m10, m.m31 - m.m11, m.m32 - m.m12, m.m33 - m.m13);
+		l_result.m_ny = makePlane(m.m30 + m.m10, m.m31 + m.m11, m.m32 + m.m12, m.m33 + m.m13);
+		l_result.m_pz = makePlane(m.m30 + m.m20, m.m31 + m.m21, m.m32 + m.m22, m.m33 + m.m23);
+		l_result.m_nz = makePlane(m.m30 - m.m20, m.m31 - m.m21, m.m32 - m.m22, m.m33 - m.m23);
+
+		return l_result;
+	};
+#endif
+
+	template<class T>
+	auto getPlanes(const TFrustum<T>& frustum) -> std::array<const TPlane<T>*, 6>
+	{
+		return { &frustum.m_px, &frustum.m_nx, &frustum.m_py, &frustum.m_ny, &frustum.m_pz, &frustum.m_nz };
+	};
+
+	template<class T>
+	bool intersectCheck(const TFrustum<T> & lhs, const TSphere<T> & rhs)
+	{
+		for (auto l_plane : getPlanes(lhs))
+		{
+			if (l_plane->m_normal.x * rhs.m_center.x + l_plane->m_normal.y * rhs.m_center.y + l_plane->m_normal.z * rhs.m_center.z - l_plane->m_distance < -rhs.m_radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	template<class T>
+	bool intersectCheck(const TFrustum<T> & lhs, const TAABB<T> & rhs)
+	{
+		auto l_halfExtend = rhs.m_extend * half<T>;
+		for (auto l_plane : getPlanes(lhs))
+		{
+			auto l_distance = l_plane->m_normal.x * rhs.m_center.x + l_plane->m_normal.y * rhs.m_center.y + l_plane->m_normal.z * rhs.m_center.z - l_plane->m_distance;
+			auto l_radius = std::abs(l_plane->m_normal.x * l_halfExtend.x) + std::abs(l_plane->m_normal.y * l_halfExtend.y) + std::abs(l_plane->m_normal.z * l_halfExtend.z);
+			if (l_distance < -l_radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
 }
 
 using vec2 = TVec2<float>;
@@ -1981,3 +2711,1126 @@ using Plane = TPlane<float>;
 using Frustum = TFrustum<float>;
 using TransformVector = TTransformVector<float>;
 using TransformMatrix = TTransformMatrix<float>;
+
+// structure-of-arrays bounds for the batched culling kernels
+struct SphereSoA
+{
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_radius;
+
+	size_t size() const { return m_radius.size(); }
+
+	void clear()
+	{
+		m_centerX.clear();
+		m_centerY.clear();
+		m_centerZ.clear();
+		m_radius.clear();
+	}
+
+	void reserve(size_t capacity)
+	{
+		m_centerX.reserve(capacity);
+		m_centerY.reserve(capacity);
+		m_centerZ.reserve(capacity);
+		m_radius.reserve(capacity);
+	}
+
+	void resize(size_t size)
+	{
+		m_centerX.resize(size);
+		m_centerY.resize(size);
+		m_centerZ.resize(size);
+		m_radius.resize(size);
+	}
+
+	void emplace_back(const vec4& center, float radius)
+	{
+		m_centerX.emplace_back(center.x);
+		m_centerY.emplace_back(center.y);
+		m_centerZ.emplace_back(center.z);
+		m_radius.emplace_back(radius);
+	}
+};
+
+// m_extend* are half extends here, unlike AABB::m_extend
+struct AABBSoA
+{
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_extendX;
+	std::vector<float> m_extendY;
+	std::vector<float> m_extendZ;
+
+	size_t size() const { return m_extendX.size(); }
+
+	void clear()
+	{
+		m_centerX.clear();
+		m_centerY.clear();
+		m_centerZ.clear();
+		m_extendX.clear();
+		m_extendY.clear();
+		m_extendZ.clear();
+	}
+
+	void reserve(size_t capacity)
+	{
+		m_centerX.reserve(capacity);
+		m_centerY.reserve(capacity);
+		m_centerZ.reserve(capacity);
+		m_extendX.reserve(capacity);
+		m_extendY.reserve(capacity);
+		m_extendZ.reserve(capacity);
+	}
+
+	void resize(size_t size)
+	{
+		m_centerX.resize(size);
+		m_centerY.resize(size);
+		m_centerZ.resize(size);
+		m_extendX.resize(size);
+		m_extendY.resize(size);
+		m_extendZ.resize(size);
+	}
+
+	void emplace_back(const vec4& center, const vec4& halfExtend)
+	{
+		m_centerX.emplace_back(center.x);
+		m_centerY.emplace_back(center.y);
+		m_centerZ.emplace_back(center.z);
+		m_extendX.emplace_back(halfExtend.x);
+		m_extendY.emplace_back(halfExtend.y);
+		m_extendZ.emplace_back(halfExtend.z);
+	}
+
+	AABB get(size_t index) const
+	{
+		AABB l_result;
+		l_result.m_center = vec4(m_centerX[index], m_centerY[index], m_centerZ[index], 1.0f);
+		auto l_halfExtend = vec4(m_extendX[index], m_extendY[index], m_extendZ[index], 0.0f);
+		l_result.m_extend = l_halfExtend * 2.0f;
+		l_result.m_boundMax = l_result.m_center + l_halfExtend;
+		l_result.m_boundMin = l_result.m_center - l_halfExtend;
+		return l_result;
+	}
+};
+
+// positions or directions for the batched transform kernels, w is implied by the kernel
+struct VectorSoA
+{
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_z;
+
+	size_t size() const { return m_x.size(); }
+
+	void clear()
+	{
+		m_x.clear();
+		m_y.clear();
+		m_z.clear();
+	}
+
+	void reserve(size_t capacity)
+	{
+		m_x.reserve(capacity);
+		m_y.reserve(capacity);
+		m_z.reserve(capacity);
+	}
+
+	void resize(size_t size)
+	{
+		m_x.resize(size);
+		m_y.resize(size);
+		m_z.resize(size);
+	}
+
+	void emplace_back(const vec4& rhs)
+	{
+		m_x.emplace_back(rhs.x);
+		m_y.emplace_back(rhs.y);
+		m_z.emplace_back(rhs.z);
+	}
+
+	vec4 get(size_t index, float w) const
+	{
+		return vec4(m_x[index], m_y[index], m_z[index], w);
+	}
+};
+
+namespace InnoMath
+{
+	// test [begin, end) against the frustum, write 1 for visible and 0 for culled into result, return the visible count
+	inline size_t intersectCheck(const Frustum& frustum, const SphereSoA& spheres, size_t begin, size_t end, unsigned char* result)
+	{
+		auto l_planes = getPlanes(frustum);
+		size_t l_visibleCount = 0;
+		size_t i = begin;
+
+#if defined (INNO_MATH_USE_AVX)
+		for (; i + 8 <= end; i += 8)
+		{
+			auto l_x = _mm256_loadu_ps(&spheres.m_centerX[i]);
+			auto l_y = _mm256_loadu_ps(&spheres.m_centerY[i]);
+			auto l_z = _mm256_loadu_ps(&spheres.m_centerZ[i]);
+			auto l_negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&spheres.m_radius[i]));
+			auto l_inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (auto l_plane : l_planes)
+			{
+				auto l_distance = _mm256_mul_ps(l_x, _mm256_set1_ps(l_plane->m_normal.x));
+				l_distance = _mm256_add_ps(l_distance, _mm256_mul_ps(l_y, _mm256_set1_ps(l_plane->m_normal.y)));
+				l_distance = _mm256_add_ps(l_distance, _mm256_mul_ps(l_z, _mm256_set1_ps(l_plane->m_normal.z)));
+				l_distance = _mm256_sub_ps(l_distance, _mm256_set1_ps(l_plane->m_distance));
+				l_inside = _mm256_and_ps(l_inside, _mm256_cmp_ps(l_distance, l_negRadius, _CMP_GE_OQ));
+			}
+
+			auto l_mask = _mm256_movemask_ps(l_inside);
+			for (size_t j = 0; j < 8; j++)
+			{
+				result[i + j] = (l_mask >> j) & 1;
+				l_visibleCount += result[i + j];
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		for (; i + 4 <= end; i += 4)
+		{
+			auto l_x = _mm_loadu_ps(&spheres.m_centerX[i]);
+			auto l_y = _mm_loadu_ps(&spheres.m_centerY[i]);
+			auto l_z = _mm_loadu_ps(&spheres.m_centerZ[i]);
+			auto l_negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.m_radius[i]));
+			auto l_inside = _mm_cmpeq_ps(l_x, l_x);
+
+			for (auto l_plane : l_planes)
+			{
+				auto l_distance = _mm_mul_ps(l_x, _mm_set1_ps(l_plane->m_normal.x));
+				l_distance = _mm_add_ps(l_distance, _mm_mul_ps(l_y, _mm_set1_ps(l_plane->m_normal.y)));
+				l_distance = _mm_add_ps(l_distance, _mm_mul_ps(l_z, _mm_set1_ps(l_plane->m_normal.z)));
+				l_distance = _mm_sub_ps(l_distance, _mm_set1_ps(l_plane->m_distance));
+				l_inside = _mm_and_ps(l_inside, _mm_cmpge_ps(l_distance, l_negRadius));
+			}
+
+			auto l_mask = _mm_movemask_ps(l_inside);
+			for (size_t j = 0; j < 4; j++)
+			{
+				result[i + j] = (l_mask >> j) & 1;
+				l_visibleCount += result[i + j];
+			}
+		}
+#endif
+		for (; i < end; i++)
+		{
+			Sphere l_sphere;
+			l_sphere.m_center = vec4(spheres.m_centerX[i], spheres.m_centerY[i], spheres.m_centerZ[i], 1.0f);
+			l_sphere.m_radius = spheres.m_radius[i];
+			result[i] = intersectCheck(frustum, l_sphere);
+			l_visibleCount += result[i];
+		}
+
+		return l_visibleCount;
+	}
+
+	inline size_t intersectCheck(const Frustum& frustum, const AABBSoA& AABBs, size_t begin, size_t end, unsigned char* result)
+	{
+		auto l_planes = getPlanes(frustum);
+		size_t l_visibleCount = 0;
+		size_t i = begin;
+
+#if defined (INNO_MATH_USE_AVX)
+		auto l_absMask8 = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+		for (; i + 8 <= end; i += 8)
+		{
+			auto l_x = _mm256_loadu_ps(&AABBs.m_centerX[i]);
+			auto l_y = _mm256_loadu_ps(&AABBs.m_centerY[i]);
+			auto l_z = _mm256_loadu_ps(&AABBs.m_centerZ[i]);
+			auto l_ex = _mm256_loadu_ps(&AABBs.m_extendX[i]);
+			auto l_ey = _mm256_loadu_ps(&AABBs.m_extendY[i]);
+			auto l_ez = _mm256_loadu_ps(&AABBs.m_extendZ[i]);
+			auto l_inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (auto l_plane : l_planes)
+			{
+				auto l_nx = _mm256_set1_ps(l_plane->m_normal.x);
+				auto l_ny = _mm256_set1_ps(l_plane->m_normal.y);
+				auto l_nz = _mm256_set1_ps(l_plane->m_normal.z);
+
+				auto l_distance = _mm256_mul_ps(l_x, l_nx);
+				l_distance = _mm256_add_ps(l_distance, _mm256_mul_ps(l_y, l_ny));
+				l_distance = _mm256_add_ps(l_distance, _mm256_mul_ps(l_z, l_nz));
+				l_distance = _mm256_sub_ps(l_distance, _mm256_set1_ps(l_plane->m_distance));
+
+				auto l_radius = _mm256_mul_ps(l_ex, _mm256_and_ps(l_nx, l_absMask8));
+				l_radius = _mm256_add_ps(l_radius, _mm256_mul_ps(l_ey, _mm256_and_ps(l_ny, l_absMask8)));
+				l_radius = _mm256_add_ps(l_radius, _mm256_mul_ps(l_ez, _mm256_and_ps(l_nz, l_absMask8)));
+
+				l_inside = _mm256_and_ps(l_inside, _mm256_cmp_ps(_mm256_add_ps(l_distance, l_radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			auto l_mask = _mm256_movemask_ps(l_inside);
+			for (size_t j = 0; j < 8; j++)
+			{
+				result[i + j] = (l_mask >> j) & 1;
+				l_visibleCount += result[i + j];
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		auto l_absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		for (; i + 4 <= end; i += 4)
+		{
+			auto l_x = _mm_loadu_ps(&AABBs.m_centerX[i]);
+			auto l_y = _mm_loadu_ps(&AABBs.m_centerY[i]);
+			auto l_z = _mm_loadu_ps(&AABBs.m_centerZ[i]);
+			auto l_ex = _mm_loadu_ps(&AABBs.m_extendX[i]);
+			auto l_ey = _mm_loadu_ps(&AABBs.m_extendY[i]);
+			auto l_ez = _mm_loadu_ps(&AABBs.m_extendZ[i]);
+			auto l_inside = _mm_cmpeq_ps(l_x, l_x);
+
+			for (auto l_plane : l_planes)
+			{
+				auto l_nx = _mm_set1_ps(l_plane->m_normal.x);
+				auto l_ny = _mm_set1_ps(l_plane->m_normal.y);
+				auto l_nz = _mm_set1_ps(l_plane->m_normal.z);
+
+				auto l_distance = _mm_mul_ps(l_x, l_nx);
+				l_distance = _mm_add_ps(l_distance, _mm_mul_ps(l_y, l_ny));
+				l_distance = _mm_add_ps(l_distance, _mm_mul_ps(l_z, l_nz));
+				l_distance = _mm_sub_ps(l_distance, _mm_set1_ps(l_plane->m_distance));
+
+				auto l_radius = _mm_mul_ps(l_ex, _mm_and_ps(l_nx, l_absMask));
+				l_radius = _mm_add_ps(l_radius, _mm_mul_ps(l_ey, _mm_and_ps(l_ny, l_absMask)));
+				l_radius = _mm_add_ps(l_radius, _mm_mul_ps(l_ez, _mm_and_ps(l_nz, l_absMask)));
+
+				l_inside = _mm_and_ps(l_inside, _mm_cmpge_ps(_mm_add_ps(l_distance, l_radius), _mm_setzero_ps()));
+			}
+
+			auto l_mask = _mm_movemask_ps(l_inside);
+			for (size_t j = 0; j < 4; j++)
+			{
+				result[i + j] = (l_mask >> j) & 1;
+				l_visibleCount += result[i + j];
+			}
+		}
+#endif
+		for (; i < end; i++)
+		{
+			AABB l_AABB;
+			l_AABB.m_center = vec4(AABBs.m_centerX[i], AABBs.m_centerY[i], AABBs.m_centerZ[i], 1.0f);
+			l_AABB.m_extend = vec4(AABBs.m_extendX[i], AABBs.m_extendY[i], AABBs.m_extendZ[i], 0.0f) * 2.0f;
+			result[i] = intersectCheck(frustum, l_AABB);
+			l_visibleCount += result[i];
+		}
+
+		return l_visibleCount;
+	}
+}
+
+namespace InnoMath
+{
+	// the bounds of the vertex positions, w of the results is 1
+	inline void generateBounds(const Vertex* vertices, size_t count, vec4& boundMax, vec4& boundMin)
+	{
+		if (!count)
+		{
+			boundMax = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			boundMin = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			return;
+		}
+
+		float l_max[4] = { vertices[0].m_pos.x, vertices[0].m_pos.y, vertices[0].m_pos.z, 1.0f };
+		float l_min[4] = { vertices[0].m_pos.x, vertices[0].m_pos.y, vertices[0].m_pos.z, 1.0f };
+		size_t i = 1;
+
+#if defined (INNO_MATH_USE_AVX)
+		{
+			// two positions per register, two accumulators to hide the latency
+			auto l_first = _mm256_set_ps(1.0f, l_max[2], l_max[1], l_max[0], 1.0f, l_max[2], l_max[1], l_max[0]);
+			auto l_max0 = l_first;
+			auto l_max1 = l_first;
+			auto l_min0 = l_first;
+			auto l_min1 = l_first;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				auto l_p0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&vertices[i].m_pos.x)), _mm_loadu_ps(&vertices[i + 1].m_pos.x), 1);
+				auto l_p1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&vertices[i + 2].m_pos.x)), _mm_loadu_ps(&vertices[i + 3].m_pos.x), 1);
+				l_max0 = _mm256_max_ps(l_max0, l_p0);
+				l_max1 = _mm256_max_ps(l_max1, l_p1);
+				l_min0 = _mm256_min_ps(l_min0, l_p0);
+				l_min1 = _mm256_min_ps(l_min1, l_p1);
+			}
+
+			l_max0 = _mm256_max_ps(l_max0, l_max1);
+			l_min0 = _mm256_min_ps(l_min0, l_min1);
+			_mm_storeu_ps(l_max, _mm_max_ps(_mm256_castps256_ps128(l_max0), _mm256_extractf128_ps(l_max0, 1)));
+			_mm_storeu_ps(l_min, _mm_min_ps(_mm256_castps256_ps128(l_min0), _mm256_extractf128_ps(l_min0, 1)));
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		{
+			auto l_max0 = _mm_loadu_ps(l_max);
+			auto l_max1 = l_max0;
+			auto l_min0 = _mm_loadu_ps(l_min);
+			auto l_min1 = l_min0;
+
+			for (; i + 2 <= count; i += 2)
+			{
+				auto l_p0 = _mm_loadu_ps(&vertices[i].m_pos.x);
+				auto l_p1 = _mm_loadu_ps(&vertices[i + 1].m_pos.x);
+				l_max0 = _mm_max_ps(l_max0, l_p0);
+				l_max1 = _mm_max_ps(l_max1, l_p1);
+				l_min0 = _mm_min_ps(l_min0, l_p0);
+				l_min1 = _mm_min_ps(l_min1, l_p1);
+			}
+
+			_mm_storeu_ps(l_max, _mm_max_ps(l_max0, l_max1));
+			_mm_storeu_ps(l_min, _mm_min_ps(l_min0, l_min1));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			l_max[0] = std::max(l_max[0], vertices[i].m_pos.x);
+			l_max[1] = std::max(l_max[1], vertices[i].m_pos.y);
+			l_max[2] = std::max(l_max[2], vertices[i].m_pos.z);
+			l_min[0] = std::min(l_min[0], vertices[i].m_pos.x);
+			l_min[1] = std::min(l_min[1], vertices[i].m_pos.y);
+			l_min[2] = std::min(l_min[2], vertices[i].m_pos.z);
+		}
+
+		boundMax = vec4(l_max[0], l_max[1], l_max[2], 1.0f);
+		boundMin = vec4(l_min[0], l_min[1], l_min[2], 1.0f);
+	}
+
+	// the distance from center to the farthest vertex position
+	inline float generateBoundRadius(const Vertex* vertices, size_t count, const vec4& center)
+	{
+		float l_maxDistanceSquared = 0.0f;
+		size_t i = 0;
+
+#if defined (INNO_MATH_USE_SSE)
+		{
+			auto l_cx = _mm_set1_ps(center.x);
+			auto l_cy = _mm_set1_ps(center.y);
+			auto l_cz = _mm_set1_ps(center.z);
+			auto l_max = _mm_setzero_ps();
+
+			for (; i + 4 <= count; i += 4)
+			{
+				auto l_x = _mm_loadu_ps(&vertices[i].m_pos.x);
+				auto l_y = _mm_loadu_ps(&vertices[i + 1].m_pos.x);
+				auto l_z = _mm_loadu_ps(&vertices[i + 2].m_pos.x);
+				auto l_w = _mm_loadu_ps(&vertices[i + 3].m_pos.x);
+				_MM_TRANSPOSE4_PS(l_x, l_y, l_z, l_w);
+
+				auto l_dx = _mm_sub_ps(l_x, l_cx);
+				auto l_dy = _mm_sub_ps(l_y, l_cy);
+				auto l_dz = _mm_sub_ps(l_z, l_cz);
+				auto l_distanceSquared = _mm_mul_ps(l_dx, l_dx);
+				l_distanceSquared = _mm_add_ps(l_distanceSquared, _mm_mul_ps(l_dy, l_dy));
+				l_distanceSquared = _mm_add_ps(l_distanceSquared, _mm_mul_ps(l_dz, l_dz));
+				l_max = _mm_max_ps(l_max, l_distanceSquared);
+			}
+
+			float l_lanes[4];
+			_mm_storeu_ps(l_lanes, l_max);
+			l_maxDistanceSquared = std::max(std::max(l_lanes[0], l_lanes[1]), std::max(l_lanes[2], l_lanes[3]));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			auto l_dx = vertices[i].m_pos.x - center.x;
+			auto l_dy = vertices[i].m_pos.y - center.y;
+			auto l_dz = vertices[i].m_pos.z - center.z;
+			l_maxDistanceSquared = std::max(l_maxDistanceSquared, l_dx * l_dx + l_dy * l_dy + l_dz * l_dz);
+		}
+
+		return std::sqrt(l_maxDistanceSquared);
+	}
+
+	// the smaller one of the sphere around the AABB center and Ritter's sphere, both radii are refitted to the farthest vertex
+	// "An Efficient Bounding Sphere", Jack Ritter, Graphics Gems, 1990
+	inline Sphere generateBoundSphere(const Vertex* vertices, size_t count, const vec4& boundMax, const vec4& boundMin)
+	{
+		Sphere l_result;
+		l_result.m_center = vec4((boundMax.x + boundMin.x) * 0.5f, (boundMax.y + boundMin.y) * 0.5f, (boundMax.z + boundMin.z) * 0.5f, 1.0f);
+		l_result.m_radius = generateBoundRadius(vertices, count, l_result.m_center);
+
+		if (count < 2)
+		{
+			return l_result;
+		}
+
+		auto l_distanceSquared = [](const vec4& lhs, const vec4& rhs) {
+			auto l_dx = lhs.x - rhs.x;
+			auto l_dy = lhs.y - rhs.y;
+			auto l_dz = lhs.z - rhs.z;
+			return l_dx * l_dx + l_dy * l_dy + l_dz * l_dz;
+		};
+
+		auto l_farthest = [&](const vec4& from) {
+			size_t l_index = 0;
+			float l_max = 0.0f;
+			for (size_t i = 0; i < count; i++)
+			{
+				auto l_distance = l_distanceSquared(vertices[i].m_pos, from);
+				if (l_distance > l_max)
+				{
+					l_max = l_distance;
+					l_index = i;
+				}
+			}
+			return vertices[l_index].m_pos;
+		};
+
+		auto l_p1 = l_farthest(vertices[0].m_pos);
+		auto l_p2 = l_farthest(l_p1);
+
+		auto l_center = vec4((l_p1.x + l_p2.x) * 0.5f, (l_p1.y + l_p2.y) * 0.5f, (l_p1.z + l_p2.z) * 0.5f, 1.0f);
+		auto l_radius = std::sqrt(l_distanceSquared(l_p1, l_p2)) * 0.5f;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto l_distance = std::sqrt(l_distanceSquared(vertices[i].m_pos, l_center));
+			if (l_distance > l_radius)
+			{
+				auto l_newRadius = (l_radius + l_distance) * 0.5f;
+				auto l_t = (l_newRadius - l_radius) / l_distance;
+				l_center.x += (vertices[i].m_pos.x - l_center.x) * l_t;
+				l_center.y += (vertices[i].m_pos.y - l_center.y) * l_t;
+				l_center.z += (vertices[i].m_pos.z - l_center.z) * l_t;
+				l_radius = l_newRadius;
+			}
+		}
+
+		l_radius = generateBoundRadius(vertices, count, l_center);
+
+		if (l_radius < l_result.m_radius)
+		{
+			l_result.m_center = l_center;
+			l_result.m_radius = l_radius;
+		}
+
+		return l_result;
+	}
+}
+
+
+namespace InnoMath
+{
+	// the coefficients a[row][column] in the column vector convention, independent of the memory layout
+	inline void getCoefficients(const mat4& m, float(&a)[4][4])
+	{
+		auto l_m = &m.m00;
+		for (size_t i = 0; i < 4; i++)
+		{
+			for (size_t j = 0; j < 4; j++)
+			{
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+				a[i][j] = l_m[j * 4 + i];
+#elif defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+				a[i][j] = l_m[i * 4 + j];
+#endif
+			}
+		}
+	}
+
+	// transform the vectors with the implied w, the results are divided by their transformed w when isProjective is set,
+	// out could be the same as in
+	inline void transformVectors(const mat4& m, float w, bool isProjective, const VectorSoA& in, VectorSoA& out)
+	{
+		float a[4][4];
+		getCoefficients(m, a);
+
+		float t[4] = { a[0][3] * w, a[1][3] * w, a[2][3] * w, a[3][3] * w };
+
+		auto l_count = in.size();
+		out.resize(l_count);
+		size_t i = 0;
+
+#if defined (INNO_MATH_USE_AVX)
+		{
+			__m256 l_a[4][3];
+			__m256 l_t[4];
+			for (size_t j = 0; j < 4; j++)
+			{
+				l_a[j][0] = _mm256_set1_ps(a[j][0]);
+				l_a[j][1] = _mm256_set1_ps(a[j][1]);
+				l_a[j][2] = _mm256_set1_ps(a[j][2]);
+				l_t[j] = _mm256_set1_ps(t[j]);
+			}
+
+			for (; i + 8 <= l_count; i += 8)
+			{
+				auto l_x = _mm256_loadu_ps(&in.m_x[i]);
+				auto l_y = _mm256_loadu_ps(&in.m_y[i]);
+				auto l_z = _mm256_loadu_ps(&in.m_z[i]);
+
+				__m256 l_result[4];
+				for (size_t j = 0; j < (isProjective ? 4u : 3u); j++)
+				{
+					l_result[j] = _mm256_add_ps(_mm256_mul_ps(l_a[j][0], l_x), l_t[j]);
+					l_result[j] = _mm256_add_ps(_mm256_mul_ps(l_a[j][1], l_y), l_result[j]);
+					l_result[j] = _mm256_add_ps(_mm256_mul_ps(l_a[j][2], l_z), l_result[j]);
+				}
+
+				if (isProjective)
+				{
+					auto l_invW = _mm256_div_ps(_mm256_set1_ps(1.0f), l_result[3]);
+					l_result[0] = _mm256_mul_ps(l_result[0], l_invW);
+					l_result[1] = _mm256_mul_ps(l_result[1], l_invW);
+					l_result[2] = _mm256_mul_ps(l_result[2], l_invW);
+				}
+
+				_mm256_storeu_ps(&out.m_x[i], l_result[0]);
+				_mm256_storeu_ps(&out.m_y[i], l_result[1]);
+				_mm256_storeu_ps(&out.m_z[i], l_result[2]);
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		{
+			__m128 l_a[4][3];
+			__m128 l_t[4];
+			for (size_t j = 0; j < 4; j++)
+			{
+				l_a[j][0] = _mm_set1_ps(a[j][0]);
+				l_a[j][1] = _mm_set1_ps(a[j][1]);
+				l_a[j][2] = _mm_set1_ps(a[j][2]);
+				l_t[j] = _mm_set1_ps(t[j]);
+			}
+
+			for (; i + 4 <= l_count; i += 4)
+			{
+				auto l_x = _mm_loadu_ps(&in.m_x[i]);
+				auto l_y = _mm_loadu_ps(&in.m_y[i]);
+				auto l_z = _mm_loadu_ps(&in.m_z[i]);
+
+				__m128 l_result[4];
+				for (size_t j = 0; j < (isProjective ? 4u : 3u); j++)
+				{
+					l_result[j] = _mm_add_ps(_mm_mul_ps(l_a[j][0], l_x), l_t[j]);
+					l_result[j] = _mm_add_ps(_mm_mul_ps(l_a[j][1], l_y), l_result[j]);
+					l_result[j] = _mm_add_ps(_mm_mul_ps(l_a[j][2], l_z), l_result[j]);
+				}
+
+				if (isProjective)
+				{
+					auto l_invW = _mm_div_ps(_mm_set1_ps(1.0f), l_result[3]);
+					l_result[0] = _mm_mul_ps(l_result[0], l_invW);
+					l_result[1] = _mm_mul_ps(l_result[1], l_invW);
+					l_result[2] = _mm_mul_ps(l_result[2], l_invW);
+				}
+
+				_mm_storeu_ps(&out.m_x[i], l_result[0]);
+				_mm_storeu_ps(&out.m_y[i], l_result[1]);
+				_mm_storeu_ps(&out.m_z[i], l_result[2]);
+			}
+		}
+#endif
+		for (; i < l_count; i++)
+		{
+			auto l_x = in.m_x[i];
+			auto l_y = in.m_y[i];
+			auto l_z = in.m_z[i];
+
+			float l_result[4];
+			for (size_t j = 0; j < 4; j++)
+			{
+				l_result[j] = a[j][0] * l_x + a[j][1] * l_y + a[j][2] * l_z + t[j];
+			}
+
+			if (isProjective)
+			{
+				auto l_invW = 1.0f / l_result[3];
+				l_result[0] *= l_invW;
+				l_result[1] *= l_invW;
+				l_result[2] *= l_invW;
+			}
+
+			out.m_x[i] = l_result[0];
+			out.m_y[i] = l_result[1];
+			out.m_z[i] = l_result[2];
+		}
+	}
+
+	// w = 1, the projective row is ignored
+	inline void transformPoints(const mat4& m, const VectorSoA& in, VectorSoA& out)
+	{
+		transformVectors(m, 1.0f, false, in, out);
+	}
+
+	// w = 1, with the perspective division
+	inline void transformPointsProjective(const mat4& m, const VectorSoA& in, VectorSoA& out)
+	{
+		transformVectors(m, 1.0f, true, in, out);
+	}
+
+	// w = 0, the translation is ignored
+	inline void transformDirections(const mat4& m, const VectorSoA& in, VectorSoA& out)
+	{
+		transformVectors(m, 0.0f, false, in, out);
+	}
+
+	// the tight AABBs of the transformed AABBs by an affine matrix, out could be the same as in
+	// "Transforming Axis-Aligned Bounding Boxes", James Arvo, Graphics Gems, 1990
+	inline void transformAABBs(const mat4& m, const AABBSoA& in, AABBSoA& out)
+	{
+		float a[4][4];
+		getCoefficients(m, a);
+
+		float l_abs[3][3];
+		for (size_t j = 0; j < 3; j++)
+		{
+			l_abs[j][0] = std::abs(a[j][0]);
+			l_abs[j][1] = std::abs(a[j][1]);
+			l_abs[j][2] = std::abs(a[j][2]);
+		}
+
+		auto l_count = in.size();
+		out.resize(l_count);
+		size_t i = 0;
+
+		float* l_outCenter[3] = { out.m_centerX.data(), out.m_centerY.data(), out.m_centerZ.data() };
+		float* l_outExtend[3] = { out.m_extendX.data(), out.m_extendY.data(), out.m_extendZ.data() };
+
+#if defined (INNO_MATH_USE_AVX)
+		for (; i + 8 <= l_count; i += 8)
+		{
+			auto l_cx = _mm256_loadu_ps(&in.m_centerX[i]);
+			auto l_cy = _mm256_loadu_ps(&in.m_centerY[i]);
+			auto l_cz = _mm256_loadu_ps(&in.m_centerZ[i]);
+			auto l_ex = _mm256_loadu_ps(&in.m_extendX[i]);
+			auto l_ey = _mm256_loadu_ps(&in.m_extendY[i]);
+			auto l_ez = _mm256_loadu_ps(&in.m_extendZ[i]);
+
+			for (size_t j = 0; j < 3; j++)
+			{
+				auto l_center = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[j][0]), l_cx), _mm256_set1_ps(a[j][3]));
+				l_center = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[j][1]), l_cy), l_center);
+				l_center = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[j][2]), l_cz), l_center);
+
+				auto l_extend = _mm256_mul_ps(_mm256_set1_ps(l_abs[j][0]), l_ex);
+				l_extend = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(l_abs[j][1]), l_ey), l_extend);
+				l_extend = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(l_abs[j][2]), l_ez), l_extend);
+
+				_mm256_storeu_ps(l_outCenter[j] + i, l_center);
+				_mm256_storeu_ps(l_outExtend[j] + i, l_extend);
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		for (; i + 4 <= l_count; i += 4)
+		{
+			auto l_cx = _mm_loadu_ps(&in.m_centerX[i]);
+			auto l_cy = _mm_loadu_ps(&in.m_centerY[i]);
+			auto l_cz = _mm_loadu_ps(&in.m_centerZ[i]);
+			auto l_ex = _mm_loadu_ps(&in.m_extendX[i]);
+			auto l_ey = _mm_loadu_ps(&in.m_extendY[i]);
+			auto l_ez = _mm_loadu_ps(&in.m_extendZ[i]);
+
+			for (size_t j = 0; j < 3; j++)
+			{
+				auto l_center = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[j][0]), l_cx), _mm_set1_ps(a[j][3]));
+				l_center = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[j][1]), l_cy), l_center);
+				l_center = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[j][2]), l_cz), l_center);
+
+				auto l_extend = _mm_mul_ps(_mm_set1_ps(l_abs[j][0]), l_ex);
+				l_extend = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(l_abs[j][1]), l_ey), l_extend);
+				l_extend = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(l_abs[j][2]), l_ez), l_extend);
+
+				_mm_storeu_ps(l_outCenter[j] + i, l_center);
+				_mm_storeu_ps(l_outExtend[j] + i, l_extend);
+			}
+		}
+#endif
+		for (; i < l_count; i++)
+		{
+			auto l_cx = in.m_centerX[i];
+			auto l_cy = in.m_centerY[i];
+			auto l_cz = in.m_centerZ[i];
+			auto l_ex = in.m_extendX[i];
+			auto l_ey = in.m_extendY[i];
+			auto l_ez = in.m_extendZ[i];
+
+			for (size_t j = 0; j < 3; j++)
+			{
+				l_outCenter[j][i] = a[j][0] * l_cx + a[j][1] * l_cy + a[j][2] * l_cz + a[j][3];
+				l_outExtend[j][i] = l_abs[j][0] * l_ex + l_abs[j][1] * l_ey + l_abs[j][2] * l_ez;
+			}
+		}
+	}
+
+	// the circumscribed spheres of the AABBs
+	inline void generateBoundSpheres(const AABBSoA& AABBs, SphereSoA& result)
+	{
+		auto l_count = AABBs.size();
+		result.resize(l_count);
+		size_t i = 0;
+
+#if defined (INNO_MATH_USE_AVX)
+		for (; i + 8 <= l_count; i += 8)
+		{
+			auto l_ex = _mm256_loadu_ps(&AABBs.m_extendX[i]);
+			auto l_ey = _mm256_loadu_ps(&AABBs.m_extendY[i]);
+			auto l_ez = _mm256_loadu_ps(&AABBs.m_extendZ[i]);
+			auto l_lengthSquared = _mm256_mul_ps(l_ex, l_ex);
+			l_lengthSquared = _mm256_add_ps(_mm256_mul_ps(l_ey, l_ey), l_lengthSquared);
+			l_lengthSquared = _mm256_add_ps(_mm256_mul_ps(l_ez, l_ez), l_lengthSquared);
+			_mm256_storeu_ps(&result.m_radius[i], _mm256_sqrt_ps(l_lengthSquared));
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		for (; i + 4 <= l_count; i += 4)
+		{
+			auto l_ex = _mm_loadu_ps(&AABBs.m_extendX[i]);
+			auto l_ey = _mm_loadu_ps(&AABBs.m_extendY[i]);
+			auto l_ez = _mm_loadu_ps(&AABBs.m_extendZ[i]);
+			auto l_lengthSquared = _mm_mul_ps(l_ex, l_ex);
+			l_lengthSquared = _mm_add_ps(_mm_mul_ps(l_ey, l_ey), l_lengthSquared);
+			l_lengthSquared = _mm_add_ps(_mm_mul_ps(l_ez, l_ez), l_lengthSquared);
+			_mm_storeu_ps(&result.m_radius[i], _mm_sqrt_ps(l_lengthSquared));
+		}
+#endif
+		for (; i < l_count; i++)
+		{
+			auto l_ex = AABBs.m_extendX[i];
+			auto l_ey = AABBs.m_extendY[i];
+			auto l_ez = AABBs.m_extendZ[i];
+			result.m_radius[i] = std::sqrt(l_ex * l_ex + l_ey * l_ey + l_ez * l_ez);
+		}
+
+		std::copy(AABBs.m_centerX.begin(), AABBs.m_centerX.end(), result.m_centerX.begin());
+		std::copy(AABBs.m_centerY.begin(), AABBs.m_centerY.end(), result.m_centerY.begin());
+		std::copy(AABBs.m_centerZ.begin(), AABBs.m_centerZ.end(), result.m_centerZ.begin());
+	}
+}
+#if defined (INNO_MATH_USE_SSE)
+// the 4-wide and 8-wide versions of the polynomial approximations and the quaternion transpositions
+namespace InnoMathSIMD
+{
+	// |x| <= PI / 2
+	inline __m128 sinPolynomial(__m128 x)
+	{
+		auto l_x2 = _mm_mul_ps(x, x);
+		auto l_result = _mm_set1_ps(InnoMath::sinCoefficients<float>[5]);
+		l_result = madd(l_result, l_x2, _mm_set1_ps(InnoMath::sinCoefficients<float>[4]));
+		l_result = madd(l_result, l_x2, _mm_set1_ps(InnoMath::sinCoefficients<float>[3]));
+		l_result = madd(l_result, l_x2, _mm_set1_ps(InnoMath::sinCoefficients<float>[2]));
+		l_result = madd(l_result, l_x2, _mm_set1_ps(InnoMath::sinCoefficients<float>[1]));
+
+		return madd(_mm_mul_ps(x, l_x2), l_result, x);
+	}
+
+	// 0 <= x <= 1
+	inline __m128 acosPolynomial(__m128 x)
+	{
+		auto l_result = _mm_set1_ps(InnoMath::acosCoefficients<float>[7]);
+		for (int i = 6; i >= 0; i--)
+		{
+			l_result = madd(l_result, x, _mm_set1_ps(InnoMath::acosCoefficients<float>[i]));
+		}
+
+		return _mm_mul_ps(l_result, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)));
+	}
+
+	inline void loadTransposed(const TVec4<float>* rhs, __m128& x, __m128& y, __m128& z, __m128& w)
+	{
+		x = _mm_loadu_ps(&rhs[0].x);
+		y = _mm_loadu_ps(&rhs[1].x);
+		z = _mm_loadu_ps(&rhs[2].x);
+		w = _mm_loadu_ps(&rhs[3].x);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+	}
+
+	inline void storeTransposed(__m128 x, __m128 y, __m128 z, __m128 w, TVec4<float>* result)
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(&result[0].x, x);
+		_mm_storeu_ps(&result[1].x, y);
+		_mm_storeu_ps(&result[2].x, z);
+		_mm_storeu_ps(&result[3].x, w);
+	}
+
+#if defined (INNO_MATH_USE_AVX)
+	inline __m256 madd(__m256 a, __m256 b, __m256 c)
+	{
+#if defined (INNO_MATH_USE_FMA)
+		return _mm256_fmadd_ps(a, b, c);
+#else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+	}
+
+	inline __m256 sinPolynomial(__m256 x)
+	{
+		auto l_x2 = _mm256_mul_ps(x, x);
+		auto l_result = _mm256_set1_ps(InnoMath::sinCoefficients<float>[5]);
+		l_result = madd(l_result, l_x2, _mm256_set1_ps(InnoMath::sinCoefficients<float>[4]));
+		l_result = madd(l_result, l_x2, _mm256_set1_ps(InnoMath::sinCoefficients<float>[3]));
+		l_result = madd(l_result, l_x2, _mm256_set1_ps(InnoMath::sinCoefficients<float>[2]));
+		l_result = madd(l_result, l_x2, _mm256_set1_ps(InnoMath::sinCoefficients<float>[1]));
+
+		return madd(_mm256_mul_ps(x, l_x2), l_result, x);
+	}
+
+	inline __m256 acosPolynomial(__m256 x)
+	{
+		auto l_result = _mm256_set1_ps(InnoMath::acosCoefficients<float>[7]);
+		for (int i = 6; i >= 0; i--)
+		{
+			l_result = madd(l_result, x, _mm256_set1_ps(InnoMath::acosCoefficients<float>[i]));
+		}
+
+		return _mm256_mul_ps(l_result, _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x)));
+	}
+
+	// the low 128-bit lanes hold rhs[0, 4), the high lanes hold rhs[4, 8)
+	inline void transpose(__m256& x, __m256& y, __m256& z, __m256& w)
+	{
+		auto l_xy01 = _mm256_unpacklo_ps(x, y);
+		auto l_xy23 = _mm256_unpacklo_ps(z, w);
+		auto l_zw01 = _mm256_unpackhi_ps(x, y);
+		auto l_zw23 = _mm256_unpackhi_ps(z, w);
+		x = _mm256_shuffle_ps(l_xy01, l_xy23, _MM_SHUFFLE(1, 0, 1, 0));
+		y = _mm256_shuffle_ps(l_xy01, l_xy23, _MM_SHUFFLE(3, 2, 3, 2));
+		z = _mm256_shuffle_ps(l_zw01, l_zw23, _MM_SHUFFLE(1, 0, 1, 0));
+		w = _mm256_shuffle_ps(l_zw01, l_zw23, _MM_SHUFFLE(3, 2, 3, 2));
+	}
+
+	inline __m256 load(const TVec4<float>& low, const TVec4<float>& high)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&low.x)), _mm_loadu_ps(&high.x), 1);
+	}
+
+	inline void store(__m256 rhs, TVec4<float>& low, TVec4<float>& high)
+	{
+		_mm_storeu_ps(&low.x, _mm256_castps256_ps128(rhs));
+		_mm_storeu_ps(&high.x, _mm256_extractf128_ps(rhs, 1));
+	}
+
+	inline void loadTransposed(const TVec4<float>* rhs, __m256& x, __m256& y, __m256& z, __m256& w)
+	{
+		x = load(rhs[0], rhs[4]);
+		y = load(rhs[1], rhs[5]);
+		z = load(rhs[2], rhs[6]);
+		w = load(rhs[3], rhs[7]);
+		transpose(x, y, z, w);
+	}
+
+	inline void storeTransposed(__m256 x, __m256 y, __m256 z, __m256 w, TVec4<float>* result)
+	{
+		transpose(x, y, z, w);
+		store(x, result[0], result[4]);
+		store(y, result[1], result[5]);
+		store(z, result[2], result[6]);
+		store(w, result[3], result[7]);
+	}
+#endif
+}
+#endif
+
+namespace InnoMath
+{
+	// result[i] = slerp(a[i], b[i], alpha) for 0 <= alpha <= 1, always with the polynomial approximations,
+	// the max deviation from the precise slerp is 2e-7 per component
+	inline void slerp(const vec4* a, const vec4* b, float alpha, vec4* result, size_t count)
+	{
+		size_t i = 0;
+
+#if defined (INNO_MATH_USE_AVX)
+		{
+			auto l_one = _mm256_set1_ps(1.0f);
+			auto l_signMask = _mm256_set1_ps(-0.0f);
+			auto l_threshold = _mm256_set1_ps(1.0f - epsilon4<float>);
+			auto l_alpha = _mm256_set1_ps(alpha);
+			auto l_oneMinusAlpha = _mm256_set1_ps(1.0f - alpha);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 l_ax, l_ay, l_az, l_aw, l_bx, l_by, l_bz, l_bw;
+				InnoMathSIMD::loadTransposed(a + i, l_ax, l_ay, l_az, l_aw);
+				InnoMathSIMD::loadTransposed(b + i, l_bx, l_by, l_bz, l_bw);
+
+				auto l_cos = _mm256_mul_ps(l_ax, l_bx);
+				l_cos = InnoMathSIMD::madd(l_ay, l_by, l_cos);
+				l_cos = InnoMathSIMD::madd(l_az, l_bz, l_cos);
+				l_cos = InnoMathSIMD::madd(l_aw, l_bw, l_cos);
+
+				// for the shorter path
+				auto l_sign = _mm256_and_ps(l_cos, l_signMask);
+				l_cos = _mm256_min_ps(_mm256_xor_ps(l_cos, l_sign), l_one);
+				l_ax = _mm256_xor_ps(l_ax, l_sign);
+				l_ay = _mm256_xor_ps(l_ay, l_sign);
+				l_az = _mm256_xor_ps(l_az, l_sign);
+				l_aw = _mm256_xor_ps(l_aw, l_sign);
+
+				auto l_theta = InnoMathSIMD::acosPolynomial(l_cos);
+				auto l_sinTheta = _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(l_one, _mm256_mul_ps(l_cos, l_cos)), _mm256_set1_ps(epsilon8<float>)));
+				auto l_s0 = _mm256_div_ps(InnoMathSIMD::sinPolynomial(_mm256_mul_ps(l_theta, l_alpha)), l_sinTheta);
+				auto l_s1 = _mm256_div_ps(InnoMathSIMD::sinPolynomial(_mm256_mul_ps(l_theta, l_oneMinusAlpha)), l_sinTheta);
+
+				// nlerp for the quaternions which are too close
+				auto l_isClose = _mm256_cmp_ps(l_cos, l_threshold, _CMP_GT_OQ);
+				l_s0 = _mm256_blendv_ps(l_s0, l_alpha, l_isClose);
+				l_s1 = _mm256_blendv_ps(l_s1, l_oneMinusAlpha, l_isClose);
+
+				auto l_x = InnoMathSIMD::madd(l_ax, l_s0, _mm256_mul_ps(l_bx, l_s1));
+				auto l_y = InnoMathSIMD::madd(l_ay, l_s0, _mm256_mul_ps(l_by, l_s1));
+				auto l_z = InnoMathSIMD::madd(l_az, l_s0, _mm256_mul_ps(l_bz, l_s1));
+				auto l_w = InnoMathSIMD::madd(l_aw, l_s0, _mm256_mul_ps(l_bw, l_s1));
+
+				auto l_length = _mm256_mul_ps(l_x, l_x);
+				l_length = InnoMathSIMD::madd(l_y, l_y, l_length);
+				l_length = InnoMathSIMD::madd(l_z, l_z, l_length);
+				l_length = InnoMathSIMD::madd(l_w, l_w, l_length);
+				auto l_inverseLength = _mm256_div_ps(l_one, _mm256_sqrt_ps(l_length));
+
+				InnoMathSIMD::storeTransposed(_mm256_mul_ps(l_x, l_inverseLength), _mm256_mul_ps(l_y, l_inverseLength), _mm256_mul_ps(l_z, l_inverseLength), _mm256_mul_ps(l_w, l_inverseLength), result + i);
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		{
+			auto l_one = _mm_set1_ps(1.0f);
+			auto l_signMask = _mm_set1_ps(-0.0f);
+			auto l_threshold = _mm_set1_ps(1.0f - epsilon4<float>);
+			auto l_alpha = _mm_set1_ps(alpha);
+			auto l_oneMinusAlpha = _mm_set1_ps(1.0f - alpha);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 l_ax, l_ay, l_az, l_aw, l_bx, l_by, l_bz, l_bw;
+				InnoMathSIMD::loadTransposed(a + i, l_ax, l_ay, l_az, l_aw);
+				InnoMathSIMD::loadTransposed(b + i, l_bx, l_by, l_bz, l_bw);
+
+				auto l_cos = _mm_mul_ps(l_ax, l_bx);
+				l_cos = InnoMathSIMD::madd(l_ay, l_by, l_cos);
+				l_cos = InnoMathSIMD::madd(l_az, l_bz, l_cos);
+				l_cos = InnoMathSIMD::madd(l_aw, l_bw, l_cos);
+
+				auto l_sign = _mm_and_ps(l_cos, l_signMask);
+				l_cos = _mm_min_ps(_mm_xor_ps(l_cos, l_sign), l_one);
+				l_ax = _mm_xor_ps(l_ax, l_sign);
+				l_ay = _mm_xor_ps(l_ay, l_sign);
+				l_az = _mm_xor_ps(l_az, l_sign);
+				l_aw = _mm_xor_ps(l_aw, l_sign);
+
+				auto l_theta = InnoMathSIMD::acosPolynomial(l_cos);
+				auto l_sinTheta = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(l_one, _mm_mul_ps(l_cos, l_cos)), _mm_set1_ps(epsilon8<float>)));
+				auto l_s0 = _mm_div_ps(InnoMathSIMD::sinPolynomial(_mm_mul_ps(l_theta, l_alpha)), l_sinTheta);
+				auto l_s1 = _mm_div_ps(InnoMathSIMD::sinPolynomial(_mm_mul_ps(l_theta, l_oneMinusAlpha)), l_sinTheta);
+
+				auto l_isClose = _mm_cmpgt_ps(l_cos, l_threshold);
+				l_s0 = _mm_or_ps(_mm_and_ps(l_isClose, l_alpha), _mm_andnot_ps(l_isClose, l_s0));
+				l_s1 = _mm_or_ps(_mm_and_ps(l_isClose, l_oneMinusAlpha), _mm_andnot_ps(l_isClose, l_s1));
+
+				auto l_x = InnoMathSIMD::madd(l_ax, l_s0, _mm_mul_ps(l_bx, l_s1));
+				auto l_y = InnoMathSIMD::madd(l_ay, l_s0, _mm_mul_ps(l_by, l_s1));
+				auto l_z = InnoMathSIMD::madd(l_az, l_s0, _mm_mul_ps(l_bz, l_s1));
+				auto l_w = InnoMathSIMD::madd(l_aw, l_s0, _mm_mul_ps(l_bw, l_s1));
+
+				auto l_length = _mm_mul_ps(l_x, l_x);
+				l_length = InnoMathSIMD::madd(l_y, l_y, l_length);
+				l_length = InnoMathSIMD::madd(l_z, l_z, l_length);
+				l_length = InnoMathSIMD::madd(l_w, l_w, l_length);
+				auto l_inverseLength = _mm_div_ps(l_one, _mm_sqrt_ps(l_length));
+
+				InnoMathSIMD::storeTransposed(_mm_mul_ps(l_x, l_inverseLength), _mm_mul_ps(l_y, l_inverseLength), _mm_mul_ps(l_z, l_inverseLength), _mm_mul_ps(l_w, l_inverseLength), result + i);
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			auto l_a = a[i];
+			auto l_cos = l_a * b[i];
+			if (l_cos < 0.0f)
+			{
+				l_a = l_a * -1.0f;
+				l_cos = -l_cos;
+			}
+			l_cos = std::min(l_cos, 1.0f);
+
+			auto l_s0 = alpha;
+			auto l_s1 = 1.0f - alpha;
+			if (l_cos <= 1.0f - epsilon4<float>)
+			{
+				auto l_theta = fastAcos(l_cos);
+				auto l_sinTheta = std::sqrt(std::max(1.0f - l_cos * l_cos, epsilon8<float>));
+				l_s0 = sinPolynomial(l_theta * alpha) / l_sinTheta;
+				l_s1 = sinPolynomial(l_theta * (1.0f - alpha)) / l_sinTheta;
+			}
+
+			result[i] = (l_a * l_s0 + b[i] * l_s1).normalize();
+		}
+	}
+
+	// result[i] = nlerp(a[i], b[i], alpha)
+	inline void nlerp(const vec4* a, const vec4* b, float alpha, vec4* result, size_t count)
+	{
+		size_t i = 0;
+
+#if defined (INNO_MATH_USE_AVX)
+		{
+			auto l_one = _mm256_set1_ps(1.0f);
+			auto l_alpha = _mm256_set1_ps(alpha);
+			auto l_oneMinusAlpha = _mm256_set1_ps(1.0f - alpha);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 l_ax, l_ay, l_az, l_aw, l_bx, l_by, l_bz, l_bw;
+				InnoMathSIMD::loadTransposed(a + i, l_ax, l_ay, l_az, l_aw);
+				InnoMathSIMD::loadTransposed(b + i, l_bx, l_by, l_bz, l_bw);
+
+				auto l_x = InnoMathSIMD::madd(l_ax, l_alpha, _mm256_mul_ps(l_bx, l_oneMinusAlpha));
+				auto l_y = InnoMathSIMD::madd(l_ay, l_alpha, _mm256_mul_ps(l_by, l_oneMinusAlpha));
+				auto l_z = InnoMathSIMD::madd(l_az, l_alpha, _mm256_mul_ps(l_bz, l_oneMinusAlpha));
+				auto l_w = InnoMathSIMD::madd(l_aw, l_alpha, _mm256_mul_ps(l_bw, l_oneMinusAlpha));
+
+				auto l_length = _mm256_mul_ps(l_x, l_x);
+				l_length = InnoMathSIMD::madd(l_y, l_y, l_length);
+				l_length = InnoMathSIMD::madd(l_z, l_z, l_length);
+				l_length = InnoMathSIMD::madd(l_w, l_w, l_length);
+				auto l_inverseLength = _mm256_div_ps(l_one, _mm256_sqrt_ps(l_length));
+
+				InnoMathSIMD::storeTransposed(_mm256_mul_ps(l_x, l_inverseLength), _mm256_mul_ps(l_y, l_inverseLength), _mm256_mul_ps(l_z, l_inverseLength), _mm256_mul_ps(l_w, l_inverseLength), result + i);
+			}
+		}
+#endif
+#if defined (INNO_MATH_USE_SSE)
+		{
+			auto l_one = _mm_set1_ps(1.0f);
+			auto l_alpha = _mm_set1_ps(alpha);
+			auto l_oneMinusAlpha = _mm_set1_ps(1.0f - alpha);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 l_ax, l_ay, l_az, l_aw, l_bx, l_by, l_bz, l_bw;
+				InnoMathSIMD::loadTransposed(a + i, l_ax, l_ay, l_az, l_aw);
+				InnoMathSIMD::loadTransposed(b + i, l_bx, l_by, l_bz, l_bw);
+
+				auto l_x = InnoMathSIMD::madd(l_ax, l_alpha, _mm_mul_ps(l_bx, l_oneMinusAlpha));
+				auto l_y = InnoMathSIMD::madd(l_ay, l_alpha, _mm_mul_ps(l_by, l_oneMinusAlpha));
+				auto l_z = InnoMathSIMD::madd(l_az, l_alpha, _mm_mul_ps(l_bz, l_oneMinusAlpha));
+				auto l_w = InnoMathSIMD::madd(l_aw, l_alpha, _mm_mul_ps(l_bw, l_oneMinusAlpha));
+
+				auto l_length = _mm_mul_ps(l_x, l_x);
+				l_length = InnoMathSIMD::madd(l_y, l_y, l_length);
+				l_length = InnoMathSIMD::madd(l_z, l_z, l_length);
+				l_length = InnoMathSIMD::madd(l_w, l_w, l_length);
+				auto l_inverseLength = _mm_div_ps(l_one, _mm_sqrt_ps(l_length));
+
+				InnoMathSIMD::storeTransposed(_mm_mul_ps(l_x, l_inverseLength), _mm_mul_ps(l_y, l_inverseLength), _mm_mul_ps(l_z, l_inverseLength), _mm_mul_ps(l_w, l_inverseLength), result + i);
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			result[i] = nlerp(a[i], b[i], alpha);
+		}
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "../common/stdafx.h"
+#include <deque>
+#include <shared_mutex>
+#include <string_view>
+
+#include "InnoType.h"
+
+// global interned string table, each distinct string is stored once and identified by a 32-bit InnoSymbol
+class InnoStringTable
+{
+public:
+	~InnoStringTable() {};
+	InnoStringTable(const InnoStringTable&) = delete;
+	InnoStringTable& operator=(const InnoStringTable&) = delete;
+
+	static InnoStringTable& get()
+	{
+		static InnoStringTable instance;
+		return instance;
+	}
+
+	static constexpr InnoSymbol INVALID_SYMBOL = 0;
+
+	InnoSymbol intern(const std::string_view& str)
+	{
+		auto l_hash = std::hash<std::string_view>()(str);
+
+		{
+			std::shared_lock<std::shared_mutex> lock{ m_mutex };
+			auto l_result = m_symbolMap.find(str);
+			if (l_result != m_symbolMap.end())
+			{
+				return l_result->second;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock{ m_mutex };
+		// another thread might have interned it between the two locks
+		auto l_result = m_symbolMap.find(str);
+		if (l_result != m_symbolMap.end())
+		{
+			return l_result->second;
+		}
+
+		// std::deque never relocates its elements on push_back, the views stay valid
+		m_strings.emplace_back(str);
+		m_hashes.emplace_back(l_hash);
+
+		auto l_symbol = (InnoSymbol)m_strings.size() - 1;
+		m_symbolMap.emplace(std::string_view(m_strings.back()), l_symbol);
+
+		return l_symbol;
+	}
+
+	// return INVALID_SYMBOL if the string has never been interned
+	InnoSymbol find(const std::string_view& str) const
+	{
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
+		auto l_result = m_symbolMap.find(str);
+		if (l_result != m_symbolMap.end())
+		{
+			return l_result->second;
+		}
+		return INVALID_SYMBOL;
+	}
+
+	const std::string& getString(InnoSymbol symbol) const
+	{
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
+		if (symbol >= m_strings.size())
+		{
+			return m_strings[INVALID_SYMBOL];
+		}
+		return m_strings[symbol];
+	}
+
+	size_t getHash(InnoSymbol symbol) const
+	{
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
+		if (symbol >= m_hashes.size())
+		{
+			return m_hashes[INVALID_SYMBOL];
+		}
+		return m_hashes[symbol];
+	}
+
+	size_t size(void) const
+	{
+		std::shared_lock<std::shared_mutex> lock{ m_mutex };
+		return m_strings.size();
+	}
+
+private:
+	InnoStringTable()
+	{
+		// reserve the invalid symbol for the empty string
+		m_strings.emplace_back();
+		m_hashes.emplace_back(std::hash<std::string_view>()(std::string_view()));
+		m_symbolMap.emplace(std::string_view(m_strings.back()), INVALID_SYMBOL);
+	};
+
+	mutable std::shared_mutex m_mutex;
+	std::unordered_map<std::string_view, InnoSymbol> m_symbolMap;
+	std::deque<std::string> m_strings;
+	std::deque<size_t> m_hashes;
+};
+
+namespace InnoUtility
+{
+	inline InnoSymbol intern(const std::string_view& str)
+	{
+		return InnoStringTable::get().intern(str);
+	}
+
+	inline const std::string& toString(InnoSymbol symbol)
+	{
+		return InnoStringTable::get().getString(symbol);
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "../common/stdafx.h"
 #include "../common/config.h"
+#include "../common/InnoContainer.h"
 
 #define INNO_INTERFACE class
 #define INNO_IMPLEMENT public
@@ -20,11 +21,20 @@ enum class ObjectStatus
 
 using EntityID = std::string;
 
+// see InnoStringTable
+using InnoSymbol = unsigned int;
+
 enum class componentType { TransformComponent, VisibleComponent, DirectionalLightComponent, PointLightComponent, SphereLightComponent, CameraComponent, InputComponent, EnvironmentCaptureComponent, PhysicsDataComponent, MeshDataComponent, MaterialDataComponent, TextureDataComponent };
 
-using componentMetadataPair = std::pair<componentType, std::string>;
-using componentMetadataMap = std::unordered_map<void*, componentMetadataPair>;
-using enitityChildrenComponentsMetadataMap = std::unordered_map<EntityID, componentMetadataMap>;
+// the display name "ClassName_Index" is only built by the tools which show it
+struct componentMetadata
+{
+	componentType m_componentType;
+	InnoSymbol m_className;
+	unsigned int m_index;
+};
+using componentMetadataMap = FlatHashMap<void*, componentMetadata>;
+using enitityChildrenComponentsMetadataMap = FlatHashMap<EntityID, componentMetadataMap>;
 using enitityNamePair = std::pair<EntityID, std::string>;
 using enitityNameMap = std::unordered_map<EntityID, std::string>;
 
@@ -39,6 +49,17 @@ struct TimeData
 	long long millisecond;
 };
 
+// all values in milliseconds, sampled over the last frames
+struct FrameTimeStatistics
+{
+	double mean = 0.0;
+	double p50 = 0.0;
+	double p95 = 0.0;
+	double p99 = 0.0;
+	double variance = 0.0;
+	unsigned int sampleCount = 0;
+};
+
 using Index = unsigned int;
 
 enum class VisiblilityType { INNO_INVISIBLE, INNO_BILLBOARD, INNO_OPAQUE, INNO_TRANSPARENT, INNO_EMISSIVE, INNO_DEBUG };
@@ -46,6 +67,8 @@ enum class VisiblilityType { INNO_INVISIBLE, INNO_BILLBOARD, INNO_OPAQUE, INNO_T
 enum class MeshUsageType { STATIC, DYNAMIC };
 enum class MeshShapeType { LINE, QUAD, CUBE, SPHERE, TERRAIN, CUSTOM };
 enum class MeshPrimitiveTopology { POINT, LINE, TRIANGLE, TRIANGLE_STRIP };
+// UNPACKED is the in-memory Vertex, the others are the compact GPU layouts of the converted meshes
+enum class VertexFormat { UNPACKED, QUANTIZED, FLOAT3 };
 // texture custom types
 enum class TextureUsageType { INVISIBLE, NORMAL, ALBEDO, METALLIC, ROUGHNESS, AMBIENT_OCCLUSION, CUBEMAP, EQUIRETANGULAR, RENDER_TARGET };
 enum class TextureColorComponentsFormat { RED, RG, RGB, RGBA, R8, RG8, RGB8, RGBA8, R16, RG16, RGB16, RGBA16, R16F, RG16F, RGB16F, RGBA16F, R32F, RG32F, RGB32F, RGBA32F, SRGB, SRGBA, SRGB8, SRGBA8, DEPTH_COMPONENT };
@@ -102,7 +125,6 @@ struct MeshCustomMaterial
 };
 
 enum class ButtonStatus { RELEASED, PRESSED };
-using ButtonStatusMap = std::unordered_map<int, ButtonStatus>;
 
 struct ButtonData
 {
@@ -126,6 +148,22 @@ struct ButtonHasher
 using ButtonStatusCallbackMap = std::unordered_map<ButtonData, std::vector<std::function<void()>*>, ButtonHasher>;
 using MouseMovementCallbackMap = std::unordered_map<int, std::vector<std::function<void(float)>*>>;
 
+enum class InputEventType { BUTTON, MOUSE_MOVEMENT };
+
+struct InputEvent
+{
+	// in nanoseconds, from ITimeSystem::getCurrentTimeInNanoSec()
+	long long m_timeStamp = 0;
+	InputEventType m_type = InputEventType::BUTTON;
+	// button code, or 0 / 1 for the mouse X / Y axis
+	int m_code = 0;
+	ButtonStatus m_status = ButtonStatus::RELEASED;
+	float m_offset = 0.0f;
+};
+
+// receives all the input events of one frame in a batch
+using InputEventCallback = std::function<void(const InputEvent* events, size_t eventCount)>;
+
 enum class LogType { INNO_DEV_VERBOSE, INNO_WARNING, INNO_ERROR, INNO_DEV_SUCCESS };
 
 #define INNO_KEY_SPACE              32
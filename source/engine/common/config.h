@@ -0,0 +1,6 @@
+#define USE_ROW_MAJOR_MEMORY_LAYOUT
+/* #undef USE_COLUMN_MAJOR_MEMORY_LAYOUT */
+
+/* #undef INNO_PLATFORM_WIN */
+#define INNO_PLATFORM_LINUX
+/* #undef INNO_PLATFORM_MAC */
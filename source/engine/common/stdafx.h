@@ -25,6 +25,8 @@
 #include <iomanip>
 
 #include <atomic>
+#include <chrono>
+#include <thread>
 
 #include <filesystem>
 #include <optional>
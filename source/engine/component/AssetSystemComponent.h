@@ -38,9 +38,10 @@ public:
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 	EntityID m_parentEntity;
 
-	std::unordered_map<EntityID, MeshDataComponent*> m_meshMap;
-	std::unordered_map<EntityID, MaterialDataComponent*> m_materialMap;
-	std::unordered_map<EntityID, TextureDataComponent*> m_textureMap;
+	RWLock m_assetRegistryLock;
+	FlatHashMap<EntityID, MeshDataComponent*> m_meshMap;
+	FlatHashMap<EntityID, MaterialDataComponent*> m_materialMap;
+	FlatHashMap<EntityID, TextureDataComponent*> m_textureMap;
 
 	MeshDataComponent* m_UnitLineMDC;
 	MeshDataComponent* m_UnitQuadMDC;
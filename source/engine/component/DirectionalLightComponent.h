@@ -23,6 +23,6 @@ public:
 	// in World space
 	std::vector<AABB> m_AABBsInWorldSpace;
 
-	std::vector<mat4> m_projectionMatrices;
+	SmallVector<mat4, 4> m_projectionMatrices;
 };
 
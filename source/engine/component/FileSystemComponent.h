@@ -6,6 +6,7 @@
 #include "../component/VisibleComponent.h"
 
 #include "../common/InnoConcurrency.h"
+#include "../common/InnoStringTable.h"
 
 class FileSystemComponent
 {
@@ -21,13 +22,20 @@ public:
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 	EntityID m_parentEntity;
 
-	std::unordered_map<std::string, ModelMap> m_loadedModelMap;
-	std::unordered_map<std::string, ModelPair> m_loadedModelPair;
-	std::unordered_map<std::string, TextureDataComponent*> m_loadedTexture;
+	// keyed by the interned file path
+	RWLock m_loadedAssetLock;
+	FlatHashMap<InnoSymbol, ModelMap> m_loadedModelMap;
+	FlatHashMap<InnoSymbol, ModelPair> m_loadedModelPair;
+	FlatHashMap<InnoSymbol, TextureDataComponent*> m_loadedTexture;
 
 	ThreadSafeQueue<MeshDataComponent*> m_uninitializedMeshComponents;
 	ThreadSafeQueue<TextureDataComponent*> m_uninitializedTextureComponents;
 
+	// the triangle ratios to the source mesh of the LODs generated by the model conversion
+	std::vector<float> m_LODTriangleRatios = { 0.5f, 0.25f, 0.125f };
+	// the vertex layout written by the model conversion
+	VertexFormat m_convertedVertexFormat = VertexFormat::QUANTIZED;
+
 private:
 	FileSystemComponent() {};
 };
\ No newline at end of file
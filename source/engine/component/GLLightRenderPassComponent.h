@@ -40,7 +40,11 @@ public:
 		"uni_brdfLUT",
 		"uni_brdfMSLUT",
 		"uni_irradianceMap",
-		"uni_preFiltedMap"
+		"uni_preFiltedMap",
+		"uni_pointLightBuffer",
+		"uni_sphereLightBuffer",
+		"uni_clusterGridBuffer",
+		"uni_lightIndexBuffer"
 	};
 
 	std::vector<GLuint> m_uni_shadowSplitAreas;
@@ -53,13 +57,21 @@ public:
 	GLuint m_uni_dirLight_luminance;
 	GLuint m_uni_dirLight_rot;
 
-	std::vector<GLuint> m_uni_pointLights_position;
-	std::vector<GLuint> m_uni_pointLights_attenuationRadius;
-	std::vector<GLuint> m_uni_pointLights_luminance;
+	// 2 texels per light, position + attenuation radius / sphere radius and luminance
+	GLuint m_pointLightTBO = 0;
+	GLuint m_pointLightTBOTexture = 0;
+	GLuint m_sphereLightTBO = 0;
+	GLuint m_sphereLightTBOTexture = 0;
 
-	std::vector<GLuint> m_uni_sphereLights_position;
-	std::vector<GLuint> m_uni_sphereLights_sphereRadius;
-	std::vector<GLuint> m_uni_sphereLights_luminance;
+	// light cluster offset and counts, then the light indices of all the clusters
+	GLuint m_clusterGridTBO = 0;
+	GLuint m_clusterGridTBOTexture = 0;
+	GLuint m_lightIndexTBO = 0;
+	GLuint m_lightIndexTBOTexture = 0;
+
+	GLuint m_uni_clusterView;
+	GLuint m_uni_clusterCount;
+	GLuint m_uni_clusterDepthSlice;
 
 	GLuint m_uni_isEmissive;
 private:
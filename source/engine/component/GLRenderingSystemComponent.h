@@ -139,10 +139,8 @@ public:
 
 	std::queue<DebuggerPassDataPack> m_debuggerPassDataQueue;
 
-	const unsigned int m_maxPointLights = 64;
 	std::vector<PointLightData> m_PointLightDatas;
 
-	const unsigned int m_maxSphereLights = 64;
 	std::vector<SphereLightData> m_SphereLightDatas;
 
 private:
@@ -2,6 +2,7 @@
 #include "../common/InnoType.h"
 #include "../common/ComponentHeaders.h"
 #include "../common/InnoConcurrency.h"
+#include "../common/InnoStringTable.h"
 
 class GameSystemComponent
 {
@@ -30,17 +31,22 @@ public:
 	std::vector<InputComponent*> m_InputComponents;
 	std::vector<EnvironmentCaptureComponent*> m_EnvironmentCaptureComponents;
 	
-	std::unordered_map<EntityID, TransformComponent*> m_TransformComponentsMap;
-	std::unordered_multimap<EntityID, VisibleComponent*> m_VisibleComponentsMap;
-	std::unordered_multimap<EntityID, DirectionalLightComponent*> m_DirectionalLightComponentsMap;
-	std::unordered_multimap<EntityID, PointLightComponent*> m_PointLightComponentsMap;
-	std::unordered_multimap<EntityID, SphereLightComponent*> m_SphereLightComponentsMap;
-	std::unordered_multimap<EntityID, CameraComponent*> m_CameraComponentsMap;
-	std::unordered_multimap<EntityID, InputComponent*> m_InputComponentsMap;
-	std::unordered_multimap<EntityID, EnvironmentCaptureComponent*> m_EnvironmentCaptureComponentsMap;
-
+	// @TODO: one component per type and entity for now
+	FlatHashMap<EntityID, TransformComponent*> m_TransformComponentsMap;
+	FlatHashMap<EntityID, VisibleComponent*> m_VisibleComponentsMap;
+	FlatHashMap<EntityID, DirectionalLightComponent*> m_DirectionalLightComponentsMap;
+	FlatHashMap<EntityID, PointLightComponent*> m_PointLightComponentsMap;
+	FlatHashMap<EntityID, SphereLightComponent*> m_SphereLightComponentsMap;
+	FlatHashMap<EntityID, CameraComponent*> m_CameraComponentsMap;
+	FlatHashMap<EntityID, InputComponent*> m_InputComponentsMap;
+	FlatHashMap<EntityID, EnvironmentCaptureComponent*> m_EnvironmentCaptureComponentsMap;
+
+	// guards the component maps and the metadata map, written on spawn and scene loading only
+	RWLock m_componentRegistryLock;
 	enitityChildrenComponentsMetadataMap m_enitityChildrenComponentsMetadataMap;
+	RWLock m_enitityNameLock;
 	enitityNameMap m_enitityNameMap;
+	std::unordered_map<InnoSymbol, EntityID> m_enitityNameSymbolMap;
 
 	InnoFuture<void>* m_asyncTask;
 
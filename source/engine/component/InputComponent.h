@@ -12,4 +12,5 @@ public:
 
 	ButtonStatusCallbackMap m_buttonStatusCallbackImpl;
 	MouseMovementCallbackMap m_mouseMovementCallbackImpl;
+	std::vector<InputEventCallback*> m_inputEventCallbackImpl;
 };
@@ -1,6 +1,8 @@
 #pragma once
 #include "../common/InnoType.h"
 #include "../common/InnoMath.h"
+#include "../system/FileMappingUtilities.h"
+#include <memory>
 
 class MeshDataComponent
 {
@@ -17,5 +19,37 @@ public:
 	size_t m_indicesSize = 0;
 	std::vector<Vertex> m_vertices;
 	std::vector<Index> m_indices;
+
+	// the converted meshes keep their vertices in the file layout until the GPU upload, m_vertices is empty then
+	VertexFormat m_vertexFormat = VertexFormat::UNPACKED;
+	std::vector<unsigned char> m_packedVertices;
+	// model space position = m_positionOffset + quantized position * m_positionScale, only used by VertexFormat::QUANTIZED
+	vec4 m_positionOffset = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	float m_positionScale = 1.0f;
+
+	// the loaded meshes reference the packed vertices and the indices in the mapped .InnoRaw file instead of m_packedVertices and m_indices, the LODs share the same file
+	std::shared_ptr<MappedFile> m_mappedFile;
+	ArrayView<unsigned char> m_mappedVertices;
+	ArrayView<Index> m_mappedIndices;
+
+	ArrayView<unsigned char> getPackedVertices() const
+	{
+		return m_mappedFile ? m_mappedVertices : ArrayView<unsigned char>(m_packedVertices);
+	}
+
+	ArrayView<Index> getIndices() const
+	{
+		return m_mappedFile ? m_mappedIndices : ArrayView<Index>(m_indices);
+	}
+
+	// model space bounds computed at the model conversion, the physics system scans the vertices when they are absent
+	bool m_hasBounds = false;
+	AABB m_AABB;
+	Sphere m_boundSphere;
+
+	// lower detail versions ordered from fine to coarse, LOD 0 is this mesh itself
+	std::vector<MeshDataComponent*> m_LODs;
+	// the max deviation from this mesh in model space of each LOD, same order as m_LODs
+	std::vector<float> m_LODErrors;
 };
 
@@ -5,10 +5,25 @@
 
 struct PhysicsData
 {
-	MeshDataComponent* MDC;
-	MeshDataComponent* wireframeMDC;
+	MeshDataComponent* MDC = nullptr;
+	// created on demand when VisibleComponent::m_drawAABB is enabled
+	MeshDataComponent* wireframeMDC = nullptr;
 	AABB aabb;
 	Sphere sphere;
+	int BVHProxyID = -1;
+	// the LOD level selected in the last frame it was visible, the hysteresis starts from it
+	unsigned int LODLevel = 0;
+};
+
+class VisibleComponent;
+struct TransformComponent;
+
+// the user data of a BVH leaf
+struct PhysicsProxy
+{
+	TransformComponent* transformComponent = nullptr;
+	VisibleComponent* visibleComponent = nullptr;
+	PhysicsData* physicsData = nullptr;
 };
 
 class PhysicsDataComponent
@@ -20,5 +35,5 @@ public:
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 	EntityID m_parentEntity;
 
-	std::vector<PhysicsData> m_physicsDatas;
+	SmallVector<PhysicsData, 2> m_physicsDatas;
 };
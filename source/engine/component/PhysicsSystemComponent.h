@@ -3,6 +3,7 @@
 #include "../common/ComponentHeaders.h"
 
 #include "../common/InnoConcurrency.h"
+#include "../common/InnoBVH.h"
 
 struct CullingDataPack
 {
@@ -11,6 +12,8 @@ struct CullingDataPack
 	mat4 normalMat;
 	VisibleComponent* visibleComponent;
 	MeshDataComponent* MDC;
+	// index into MDC->m_LODs plus 1, 0 is MDC itself
+	unsigned int LODLevel = 0;
 };
 
 class PhysicsSystemComponent
@@ -27,8 +30,35 @@ public:
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 	EntityID m_parentEntity;
 
+	// world space bounds of all the PhysicsData in the scene
+	InnoBVH<PhysicsProxy> m_BVH;
+	RWLock m_BVHLock;
+
 	std::atomic<bool> m_isCullingDataPackValid = false;
 	ThreadSafeVector<CullingDataPack> m_cullingDataPack;
+	// shadow casters of each cascade of the first directional light
+	ThreadSafeVector<std::vector<CullingDataPack>> m_shadowCullingDataPack;
+
+	// culling statistics of the last frame
+	std::atomic<unsigned int> m_cullingCandidateCount = 0;
+	std::atomic<unsigned int> m_BVHCulledCount = 0;
+	std::atomic<unsigned int> m_sphereCulledCount = 0;
+	std::atomic<unsigned int> m_occluderCount = 0;
+	std::atomic<unsigned int> m_occlusionTestedCount = 0;
+	std::atomic<unsigned int> m_occlusionCulledCount = 0;
+	// sum of all cascades, a caster is counted once per cascade it overlaps
+	std::atomic<unsigned int> m_shadowCasterCount = 0;
+	// visible meshes per LOD level, the last one counts all the coarser levels too
+	std::atomic<unsigned int> m_LODLevelCounts[4] = {};
+	std::atomic<unsigned int> m_LODSavedTriangleCount = 0;
+	// rigid body statistics of the last update
+	std::atomic<unsigned int> m_rigidBodyCount = 0;
+	std::atomic<unsigned int> m_awakeRigidBodyCount = 0;
+	std::atomic<unsigned int> m_rigidBodyIslandCount = 0;
+	std::atomic<unsigned int> m_rigidBodyContactCount = 0;
+
+	// the max screen space error of the selected LODs in pixels
+	std::atomic<float> m_LODErrorBudget = 1.0f;
 
 	VisibleComponent* m_selectedVisibleComponent;
 private:
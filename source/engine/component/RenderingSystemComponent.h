@@ -14,6 +14,7 @@ struct RenderDataPack
 	MeshDataComponent* MDC;
 	MaterialDataComponent* material;
 	VisiblilityType visiblilityType;
+	unsigned int LODLevel;
 };
 
 class RenderingSystemComponent
@@ -48,7 +49,7 @@ public:
 	vec4 m_sunLuminance;
 	mat4 m_sunRot;
 
-	std::vector<mat4> m_CSMProjs;
+	SmallVector<mat4, 4> m_CSMProjs;
 	std::vector<mat4> m_CSMViews;
 	std::vector<vec4> m_CSMSplitCorners;
 
@@ -61,10 +62,13 @@ public:
 	bool m_drawTerrain = false;
 	bool m_drawSky = false;
 	bool m_drawOverlapWireframe = false;
+	bool m_drawLODLevels = false;
 
 	std::function<void(RenderPassType)> f_reloadShader;
 	std::function<void()> f_captureEnvironment;	
 	ThreadSafeVector<RenderDataPack> m_renderDataPack;
+	// shadow casters of each cascade
+	ThreadSafeVector<std::vector<RenderDataPack>> m_shadowRenderDataPack;
 
 	VisibleComponent* m_selectedVisibleComponent;
 	std::vector<Sphere> m_debugSpheres;
@@ -6,7 +6,7 @@
 #include "PhysicsDataComponent.h"
 
 using ModelPair = std::pair<MeshDataComponent*, MaterialDataComponent*>;
-using ModelMap = std::unordered_map<MeshDataComponent*, MaterialDataComponent*>;
+using ModelMap = FlatHashMap<MeshDataComponent*, MaterialDataComponent*>;
 
 class VisibleComponent
 {
@@ -23,6 +23,11 @@ public:
 	TextureWrapMethod m_textureWrapMethod = TextureWrapMethod::REPEAT;
 
 	bool m_drawAABB = false;
+	// always rasterized into the occlusion depth buffer when visible
+	bool m_isOccluder = false;
+	// simulated as a rigid body, a mass of 0 makes a static collider
+	bool m_simulatePhysics = false;
+	float m_mass = 0.0f;
 
 	std::string m_modelFileName;
 
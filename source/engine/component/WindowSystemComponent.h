@@ -28,9 +28,19 @@ public:
 	const int NUM_KEYCODES = 256;
 	const int NUM_MOUSEBUTTONS = 5;
 
-	ButtonStatusMap m_buttonStatus;
-	ButtonStatusCallbackMap m_buttonStatusCallback;
-	MouseMovementCallbackMap m_mouseMovementCallback;
+	static constexpr size_t INPUT_EVENT_QUEUE_SIZE = 512;
+
+	// indexed by button code
+	std::vector<ButtonStatus> m_buttonStatus;
+	// indexed by button code * 2 + button status
+	std::vector<std::vector<std::function<void()>*>> m_buttonStatusCallback;
+	std::vector<int> m_boundButtonCodes;
+	// indexed by mouse axis
+	std::array<std::vector<std::function<void(float)>*>, 2> m_mouseMovementCallback;
+	std::vector<InputEventCallback*> m_inputEventCallback;
+
+	RingBuffer<InputEvent, INPUT_EVENT_QUEUE_SIZE> m_inputEventQueue;
+	std::vector<InputEvent> m_frameInputEvents;
 
 	float m_mouseXOffset;
 	float m_mouseYOffset;
@@ -0,0 +1,42 @@
+
+#ifndef INNO_SYSTEM_EXPORT_H
+#define INNO_SYSTEM_EXPORT_H
+
+#ifdef INNO_SYSTEM_BUILT_AS_STATIC
+#  define INNO_SYSTEM_EXPORT
+#  define INNO_SYSTEM_NO_EXPORT
+#else
+#  ifndef INNO_SYSTEM_EXPORT
+#    ifdef InnoSystem_EXPORTS
+        /* We are building this library */
+#      define INNO_SYSTEM_EXPORT __attribute__((visibility("default")))
+#    else
+        /* We are using this library */
+#      define INNO_SYSTEM_EXPORT __attribute__((visibility("default")))
+#    endif
+#  endif
+
+#  ifndef INNO_SYSTEM_NO_EXPORT
+#    define INNO_SYSTEM_NO_EXPORT __attribute__((visibility("hidden")))
+#  endif
+#endif
+
+#ifndef INNO_SYSTEM_DEPRECATED
+#  define INNO_SYSTEM_DEPRECATED __attribute__ ((__deprecated__))
+#endif
+
+#ifndef INNO_SYSTEM_DEPRECATED_EXPORT
+#  define INNO_SYSTEM_DEPRECATED_EXPORT INNO_SYSTEM_EXPORT INNO_SYSTEM_DEPRECATED
+#endif
+
+#ifndef INNO_SYSTEM_DEPRECATED_NO_EXPORT
+#  define INNO_SYSTEM_DEPRECATED_NO_EXPORT INNO_SYSTEM_NO_EXPORT INNO_SYSTEM_DEPRECATED
+#endif
+
+#if 0 /* DEFINE_NO_DEPRECATED */
+#  ifndef INNO_SYSTEM_NO_DEPRECATED
+#    define INNO_SYSTEM_NO_DEPRECATED
+#  endif
+#endif
+
+#endif /* INNO_SYSTEM_EXPORT_H */
@@ -97,6 +97,7 @@ MeshDataComponent* InnoAssetSystemNS::addMeshDataComponent()
 	auto newMesh = g_pCoreSystem->getMemorySystem()->spawn<MeshDataComponent>();
 	auto l_parentEntity = InnoMath::createEntityID();
 	newMesh->m_parentEntity = l_parentEntity;
+	std::unique_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_meshMap = &AssetSystemComponent::get().m_meshMap;
 	l_meshMap->emplace(std::pair<EntityID, MeshDataComponent*>(l_parentEntity, newMesh));
 	return newMesh;
@@ -107,6 +108,7 @@ MaterialDataComponent* InnoAssetSystemNS::addMaterialDataComponent()
 	auto newMaterial = g_pCoreSystem->getMemorySystem()->spawn<MaterialDataComponent>();
 	auto l_parentEntity = InnoMath::createEntityID();
 	newMaterial->m_parentEntity = l_parentEntity;
+	std::unique_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_materialMap = &AssetSystemComponent::get().m_materialMap;
 	l_materialMap->emplace(std::pair<EntityID, MaterialDataComponent*>(l_parentEntity, newMaterial));
 	return newMaterial;
@@ -117,6 +119,7 @@ TextureDataComponent* InnoAssetSystemNS::addTextureDataComponent()
 	auto newTexture = g_pCoreSystem->getMemorySystem()->spawn<TextureDataComponent>();
 	auto l_parentEntity = InnoMath::createEntityID();
 	newTexture->m_parentEntity = l_parentEntity;
+	std::unique_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_textureMap = &AssetSystemComponent::get().m_textureMap;
 	l_textureMap->emplace(std::pair<EntityID, TextureDataComponent*>(l_parentEntity, newTexture));
 	return newTexture;
@@ -124,6 +127,7 @@ TextureDataComponent* InnoAssetSystemNS::addTextureDataComponent()
 
 MeshDataComponent* InnoAssetSystem::getMeshDataComponent(EntityID EntityID)
 {
+	std::shared_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto result = AssetSystemComponent::get().m_meshMap.find(EntityID);
 	if (result != AssetSystemComponent::get().m_meshMap.end())
 	{
@@ -138,6 +142,7 @@ MeshDataComponent* InnoAssetSystem::getMeshDataComponent(EntityID EntityID)
 
 TextureDataComponent * InnoAssetSystem::getTextureDataComponent(EntityID EntityID)
 {
+	std::shared_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto result = AssetSystemComponent::get().m_textureMap.find(EntityID);
 	if (result != AssetSystemComponent::get().m_textureMap.end())
 	{
@@ -233,6 +238,7 @@ INNO_SYSTEM_EXPORT TextureDataComponent * InnoAssetSystem::getTextureDataCompone
 
 bool InnoAssetSystem::removeMeshDataComponent(EntityID EntityID)
 {
+	std::unique_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_meshMap = &AssetSystemComponent::get().m_meshMap;
 	auto l_mesh = l_meshMap->find(EntityID);
 	if (l_mesh != l_meshMap->end())
@@ -250,6 +256,7 @@ bool InnoAssetSystem::removeMeshDataComponent(EntityID EntityID)
 
 bool InnoAssetSystem::removeTextureDataComponent(EntityID EntityID)
 {
+	std::unique_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_textureMap = &AssetSystemComponent::get().m_textureMap;
 	auto l_texture = l_textureMap->find(EntityID);
 	if (l_texture != l_textureMap->end())
@@ -272,6 +279,7 @@ bool InnoAssetSystem::removeTextureDataComponent(EntityID EntityID)
 
 bool InnoAssetSystem::releaseRawDataForMeshDataComponent(EntityID EntityID)
 {
+	std::shared_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_meshMap = &AssetSystemComponent::get().m_meshMap;
 	auto l_mesh = l_meshMap->find(EntityID);
 	if (l_mesh != l_meshMap->end())
@@ -279,8 +287,13 @@ bool InnoAssetSystem::releaseRawDataForMeshDataComponent(EntityID EntityID)
 		// @TODO:
 		l_mesh->second->m_vertices.clear();
 		l_mesh->second->m_vertices.shrink_to_fit();
+		l_mesh->second->m_packedVertices.clear();
+		l_mesh->second->m_packedVertices.shrink_to_fit();
 		l_mesh->second->m_indices.clear();
 		l_mesh->second->m_indices.shrink_to_fit();
+		l_mesh->second->m_mappedVertices = ArrayView<unsigned char>();
+		l_mesh->second->m_mappedIndices = ArrayView<Index>();
+		l_mesh->second->m_mappedFile.reset();
 		return true;
 	}
 	else
@@ -292,6 +305,7 @@ bool InnoAssetSystem::releaseRawDataForMeshDataComponent(EntityID EntityID)
 
 bool InnoAssetSystem::releaseRawDataForTextureDataComponent(EntityID EntityID)
 {
+	std::shared_lock<RWLock> l_lock(AssetSystemComponent::get().m_assetRegistryLock);
 	auto l_textureMap = &AssetSystemComponent::get().m_textureMap;
 	auto l_texture = l_textureMap->find(EntityID);
 	if (l_texture != l_textureMap->end())
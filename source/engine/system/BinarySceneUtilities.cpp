@@ -0,0 +1,571 @@
+#include "BinarySceneUtilities.h"
+
+using json = nlohmann::json;
+
+INNO_PRIVATE_SCOPE BinarySceneUtilities
+{
+	struct ColumnLayout
+	{
+		unsigned int m_stride;
+		bool m_isString;
+	};
+
+	struct BlockBuilder
+	{
+		componentType m_type;
+		unsigned int m_count = 0;
+		std::vector<std::vector<char>> m_columns;
+	};
+
+	struct SceneBuilder
+	{
+		std::vector<std::string> m_strings;
+		std::unordered_map<std::string, unsigned int> m_stringIndices;
+		std::vector<BinarySceneEntity> m_entities;
+		std::vector<BlockBuilder> m_blocks;
+	};
+
+	const std::vector<ColumnLayout>& getColumnLayouts(componentType type)
+	{
+		static const std::vector<ColumnLayout> l_transform = { { 4, false }, { 4, true }, { 16, false }, { 16, false }, { 16, false } };
+		static const std::vector<ColumnLayout> l_visible = { { 4, false }, { 4, false }, { 4, false }, { 4, false }, { 4, false }, { 4, false }, { 4, false }, { 4, true } };
+		static const std::vector<ColumnLayout> l_directionalLight = { { 4, false }, { 4, false }, { 16, false }, { 4, false } };
+		static const std::vector<ColumnLayout> l_pointLight = { { 4, false }, { 4, false }, { 16, false } };
+		static const std::vector<ColumnLayout> l_sphereLight = { { 4, false }, { 4, false }, { 4, false }, { 16, false } };
+		static const std::vector<ColumnLayout> l_environmentCapture = { { 4, false }, { 4, true } };
+		static const std::vector<ColumnLayout> l_unsupported;
+
+		switch (type)
+		{
+		case componentType::TransformComponent: return l_transform;
+		case componentType::VisibleComponent: return l_visible;
+		case componentType::DirectionalLightComponent: return l_directionalLight;
+		case componentType::PointLightComponent: return l_pointLight;
+		case componentType::SphereLightComponent: return l_sphereLight;
+		case componentType::EnvironmentCaptureComponent: return l_environmentCapture;
+		default: return l_unsupported;
+		}
+	}
+
+	bool isInRange(size_t offset, size_t count, size_t stride, size_t size)
+	{
+		return offset <= size && count * stride <= size - offset;
+	}
+
+	unsigned int addString(SceneBuilder& builder, const std::string& str)
+	{
+		auto l_result = builder.m_stringIndices.find(str);
+		if (l_result != builder.m_stringIndices.end())
+		{
+			return l_result->second;
+		}
+
+		auto l_index = (unsigned int)builder.m_strings.size();
+		builder.m_strings.emplace_back(str);
+		builder.m_stringIndices.emplace(str, l_index);
+
+		return l_index;
+	}
+
+	BlockBuilder& getBlock(SceneBuilder& builder, componentType type)
+	{
+		for (auto& i : builder.m_blocks)
+		{
+			if (i.m_type == type)
+			{
+				return i;
+			}
+		}
+
+		BlockBuilder l_block;
+		l_block.m_type = type;
+		l_block.m_columns.resize(getColumnLayouts(type).size());
+		builder.m_blocks.emplace_back(std::move(l_block));
+
+		return builder.m_blocks.back();
+	}
+
+	template<typename T, typename Column>
+	void append(BlockBuilder& block, Column column, const T& value)
+	{
+		auto& l_column = block.m_columns[(unsigned int)column];
+		auto l_size = l_column.size();
+		l_column.resize(l_size + sizeof(T));
+		std::memcpy(&l_column[l_size], &value, sizeof(T));
+	}
+
+	template<typename Column>
+	void appendVec4(BlockBuilder& block, Column column, float x, float y, float z, float w)
+	{
+		float l_value[4] = { x, y, z, w };
+		append(block, column, l_value);
+	}
+
+	template<typename Column>
+	void appendColor(BlockBuilder& block, Column column, const json& j)
+	{
+		appendVec4(block, column, j["R"].get<float>(), j["G"].get<float>(), j["B"].get<float>(), j["A"].get<float>());
+	}
+
+	template<typename Column>
+	json getColor(const BinarySceneView& scene, const BinarySceneBlock& block, Column column, unsigned int index)
+	{
+		auto l_color = scene.getColumn<float>(block, column) + index * 4;
+		return json{ { "R", l_color[0] }, { "G", l_color[1] }, { "B", l_color[2] }, { "A", l_color[3] } };
+	}
+
+	void addComponent(SceneBuilder& builder, const json& j, unsigned int entityIndex)
+	{
+		auto l_type = componentType(j["ComponentType"].get<unsigned int>());
+
+		switch (l_type)
+		{
+		case componentType::TransformComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			auto& l_transformVector = j["LocalTransformVector"];
+			auto& l_position = l_transformVector["Position"];
+			auto& l_rotation = l_transformVector["Rotation"];
+			auto& l_scale = l_transformVector["Scale"];
+
+			append(l_block, TransformColumn::Entity, entityIndex);
+			append(l_block, TransformColumn::ParentTransformComponentEntityName, addString(builder, j["ParentTransformComponentEntityName"].get<std::string>()));
+			appendVec4(l_block, TransformColumn::Position, l_position["X"].get<float>(), l_position["Y"].get<float>(), l_position["Z"].get<float>(), 1.0f);
+			appendVec4(l_block, TransformColumn::Rotation, l_rotation["X"].get<float>(), l_rotation["Y"].get<float>(), l_rotation["Z"].get<float>(), l_rotation["W"].get<float>());
+			appendVec4(l_block, TransformColumn::Scale, l_scale["X"].get<float>(), l_scale["Y"].get<float>(), l_scale["Z"].get<float>(), 1.0f);
+			l_block.m_count++;
+			break;
+		}
+		case componentType::VisibleComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			unsigned int l_flags = 0;
+			if (j["drawAABB"].get<bool>())
+			{
+				l_flags |= VisibleFlags::DrawAABB;
+			}
+			if (j.value("isOccluder", false))
+			{
+				l_flags |= VisibleFlags::IsOccluder;
+			}
+			if (j.value("simulatePhysics", false))
+			{
+				l_flags |= VisibleFlags::SimulatePhysics;
+			}
+
+			append(l_block, VisibleColumn::Entity, entityIndex);
+			append(l_block, VisibleColumn::VisiblilityType, j["VisiblilityType"].get<unsigned int>());
+			append(l_block, VisibleColumn::MeshShapeType, j["MeshShapeType"].get<unsigned int>());
+			append(l_block, VisibleColumn::MeshPrimitiveTopology, j["MeshPrimitiveTopology"].get<unsigned int>());
+			append(l_block, VisibleColumn::TextureWrapMethod, j["TextureWrapMethod"].get<unsigned int>());
+			append(l_block, VisibleColumn::Flags, l_flags);
+			append(l_block, VisibleColumn::Mass, j.value("mass", 0.0f));
+			append(l_block, VisibleColumn::ModelFileName, addString(builder, j["ModelFileName"].get<std::string>()));
+			l_block.m_count++;
+			break;
+		}
+		case componentType::DirectionalLightComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			append(l_block, DirectionalLightColumn::Entity, entityIndex);
+			append(l_block, DirectionalLightColumn::LuminousFlux, j["LuminousFlux"].get<float>());
+			appendColor(l_block, DirectionalLightColumn::Color, j["Color"]);
+			append(l_block, DirectionalLightColumn::DrawAABB, (unsigned int)j["drawAABB"].get<bool>());
+			l_block.m_count++;
+			break;
+		}
+		case componentType::PointLightComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			append(l_block, PointLightColumn::Entity, entityIndex);
+			append(l_block, PointLightColumn::LuminousFlux, j["LuminousFlux"].get<float>());
+			appendColor(l_block, PointLightColumn::Color, j["Color"]);
+			l_block.m_count++;
+			break;
+		}
+		case componentType::SphereLightComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			append(l_block, SphereLightColumn::Entity, entityIndex);
+			append(l_block, SphereLightColumn::SphereRadius, j["SphereRadius"].get<float>());
+			append(l_block, SphereLightColumn::LuminousFlux, j["LuminousFlux"].get<float>());
+			appendColor(l_block, SphereLightColumn::Color, j["Color"]);
+			l_block.m_count++;
+			break;
+		}
+		case componentType::EnvironmentCaptureComponent:
+		{
+			auto& l_block = getBlock(builder, l_type);
+			append(l_block, EnvironmentCaptureColumn::Entity, entityIndex);
+			append(l_block, EnvironmentCaptureColumn::CubemapName, addString(builder, j["CubemapName"].get<std::string>()));
+			l_block.m_count++;
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	size_t alignOffset(size_t offset, size_t alignment)
+	{
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+bool BinarySceneView::initialize(const char* data, size_t size)
+{
+	m_data = nullptr;
+	m_size = 0;
+
+	if (!data || size < sizeof(BinarySceneHeader) || size > std::numeric_limits<unsigned int>::max())
+	{
+		return false;
+	}
+
+	auto& l_header = *reinterpret_cast<const BinarySceneHeader*>(data);
+
+	if (l_header.m_magic != BinarySceneMagic || l_header.m_version != BinarySceneVersion || l_header.m_fileSize != size)
+	{
+		return false;
+	}
+
+	if (l_header.m_stringCount == 0
+		|| l_header.m_stringsOffset % 4 != 0
+		|| l_header.m_entitiesOffset % 4 != 0
+		|| l_header.m_blocksOffset % 4 != 0
+		|| !BinarySceneUtilities::isInRange(l_header.m_stringsOffset, l_header.m_stringCount, sizeof(BinarySceneString), size)
+		|| !BinarySceneUtilities::isInRange(l_header.m_entitiesOffset, l_header.m_entityCount, sizeof(BinarySceneEntity), size)
+		|| !BinarySceneUtilities::isInRange(l_header.m_blocksOffset, l_header.m_blockCount, sizeof(BinarySceneBlock), size)
+		|| l_header.m_sceneName >= l_header.m_stringCount)
+	{
+		return false;
+	}
+
+	auto l_strings = reinterpret_cast<const BinarySceneString*>(data + l_header.m_stringsOffset);
+	for (unsigned int i = 0; i < l_header.m_stringCount; i++)
+	{
+		if (!BinarySceneUtilities::isInRange(l_strings[i].m_offset, (size_t)l_strings[i].m_length + 1, 1, size) || data[l_strings[i].m_offset + l_strings[i].m_length] != '\0')
+		{
+			return false;
+		}
+	}
+
+	auto l_entities = reinterpret_cast<const BinarySceneEntity*>(data + l_header.m_entitiesOffset);
+	for (unsigned int i = 0; i < l_header.m_entityCount; i++)
+	{
+		if (l_entities[i].m_entityID >= l_header.m_stringCount || l_entities[i].m_entityName >= l_header.m_stringCount)
+		{
+			return false;
+		}
+	}
+
+	auto l_blocks = reinterpret_cast<const BinarySceneBlock*>(data + l_header.m_blocksOffset);
+	for (unsigned int i = 0; i < l_header.m_blockCount; i++)
+	{
+		auto& l_block = l_blocks[i];
+
+		if (l_block.m_columnCount == 0 || l_block.m_columnCount > BinarySceneMaxColumns || l_block.m_columnStrides[0] != sizeof(unsigned int))
+		{
+			return false;
+		}
+
+		for (unsigned int j = 0; j < l_block.m_columnCount; j++)
+		{
+			if (l_block.m_columnOffsets[j] % 16 != 0 || !BinarySceneUtilities::isInRange(l_block.m_columnOffsets[j], l_block.m_count, l_block.m_columnStrides[j], size))
+			{
+				return false;
+			}
+		}
+
+		auto& l_layouts = BinarySceneUtilities::getColumnLayouts(componentType(l_block.m_componentType));
+		if (l_block.m_columnCount < l_layouts.size())
+		{
+			return false;
+		}
+
+		for (unsigned int j = 0; j < l_layouts.size(); j++)
+		{
+			if (l_block.m_columnStrides[j] != l_layouts[j].m_stride)
+			{
+				return false;
+			}
+		}
+
+		auto l_entityIndices = reinterpret_cast<const unsigned int*>(data + l_block.m_columnOffsets[0]);
+		for (unsigned int j = 0; j < l_block.m_count; j++)
+		{
+			if (l_entityIndices[j] >= l_header.m_entityCount)
+			{
+				return false;
+			}
+		}
+
+		for (unsigned int j = 0; j < l_layouts.size(); j++)
+		{
+			if (l_layouts[j].m_isString)
+			{
+				auto l_stringIndices = reinterpret_cast<const unsigned int*>(data + l_block.m_columnOffsets[j]);
+				for (unsigned int k = 0; k < l_block.m_count; k++)
+				{
+					if (l_stringIndices[k] >= l_header.m_stringCount)
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	m_data = data;
+	m_size = size;
+
+	return true;
+}
+
+bool BinarySceneUtilities::isBinarySceneFile(const std::string & fileName)
+{
+	return std::filesystem::path(fileName).extension().generic_string() == ".InnoBinaryScene";
+}
+
+bool BinarySceneUtilities::convertFromJson(const json & j, std::vector<char>& result)
+{
+	SceneBuilder l_builder;
+	addString(l_builder, "");
+
+	auto l_sceneName = addString(l_builder, j.value("SceneName", ""));
+
+	auto l_sceneEntities = j.find("SceneEntities");
+	if (l_sceneEntities != j.end())
+	{
+		for (auto& i : *l_sceneEntities)
+		{
+			auto l_entityIndex = (unsigned int)l_builder.m_entities.size();
+			l_builder.m_entities.emplace_back(BinarySceneEntity{ addString(l_builder, i["EntityID"].get<std::string>()), addString(l_builder, i["EntityName"].get<std::string>()) });
+
+			auto l_components = i.find("ChildrenComponents");
+			if (l_components != i.end())
+			{
+				for (auto& k : *l_components)
+				{
+					addComponent(l_builder, k, l_entityIndex);
+				}
+			}
+		}
+	}
+
+	// lay out the sections
+	BinarySceneHeader l_header = {};
+	l_header.m_magic = BinarySceneMagic;
+	l_header.m_version = BinarySceneVersion;
+	l_header.m_sceneName = l_sceneName;
+	l_header.m_stringCount = (unsigned int)l_builder.m_strings.size();
+	l_header.m_entityCount = (unsigned int)l_builder.m_entities.size();
+	l_header.m_blockCount = (unsigned int)l_builder.m_blocks.size();
+
+	size_t l_offset = sizeof(BinarySceneHeader);
+
+	l_header.m_stringsOffset = (unsigned int)l_offset;
+	l_offset += l_builder.m_strings.size() * sizeof(BinarySceneString);
+
+	std::vector<BinarySceneString> l_strings;
+	l_strings.reserve(l_builder.m_strings.size());
+	for (auto& i : l_builder.m_strings)
+	{
+		l_strings.emplace_back(BinarySceneString{ (unsigned int)l_offset, (unsigned int)i.size() });
+		l_offset += i.size() + 1;
+	}
+
+	l_offset = alignOffset(l_offset, 4);
+	l_header.m_entitiesOffset = (unsigned int)l_offset;
+	l_offset += l_builder.m_entities.size() * sizeof(BinarySceneEntity);
+
+	l_header.m_blocksOffset = (unsigned int)l_offset;
+	l_offset += l_builder.m_blocks.size() * sizeof(BinarySceneBlock);
+
+	std::vector<BinarySceneBlock> l_blocks;
+	l_blocks.reserve(l_builder.m_blocks.size());
+	for (auto& i : l_builder.m_blocks)
+	{
+		auto& l_layouts = getColumnLayouts(i.m_type);
+
+		BinarySceneBlock l_block = {};
+		l_block.m_componentType = (unsigned int)i.m_type;
+		l_block.m_count = i.m_count;
+		l_block.m_columnCount = (unsigned int)l_layouts.size();
+
+		for (size_t j = 0; j < l_layouts.size(); j++)
+		{
+			l_offset = alignOffset(l_offset, 16);
+			l_block.m_columnStrides[j] = l_layouts[j].m_stride;
+			l_block.m_columnOffsets[j] = (unsigned int)l_offset;
+			l_offset += i.m_columns[j].size();
+		}
+
+		l_blocks.emplace_back(l_block);
+	}
+
+	if (l_offset > std::numeric_limits<unsigned int>::max())
+	{
+		return false;
+	}
+
+	l_header.m_fileSize = (unsigned int)l_offset;
+
+	// fill the sections
+	result.clear();
+	result.resize(l_offset, 0);
+
+	std::memcpy(result.data(), &l_header, sizeof(BinarySceneHeader));
+	std::memcpy(result.data() + l_header.m_stringsOffset, l_strings.data(), l_strings.size() * sizeof(BinarySceneString));
+
+	for (size_t i = 0; i < l_strings.size(); i++)
+	{
+		std::memcpy(result.data() + l_strings[i].m_offset, l_builder.m_strings[i].data(), l_strings[i].m_length);
+	}
+
+	if (!l_builder.m_entities.empty())
+	{
+		std::memcpy(result.data() + l_header.m_entitiesOffset, l_builder.m_entities.data(), l_builder.m_entities.size() * sizeof(BinarySceneEntity));
+	}
+
+	for (size_t i = 0; i < l_blocks.size(); i++)
+	{
+		std::memcpy(result.data() + l_header.m_blocksOffset + i * sizeof(BinarySceneBlock), &l_blocks[i], sizeof(BinarySceneBlock));
+
+		for (size_t j = 0; j < l_blocks[i].m_columnCount; j++)
+		{
+			auto& l_column = l_builder.m_blocks[i].m_columns[j];
+			if (!l_column.empty())
+			{
+				std::memcpy(result.data() + l_blocks[i].m_columnOffsets[j], l_column.data(), l_column.size());
+			}
+		}
+	}
+
+	return true;
+}
+
+bool BinarySceneUtilities::convertToJson(const BinarySceneView& scene, json & result)
+{
+	auto& l_header = scene.getHeader();
+
+	result = json();
+	result["SceneName"] = std::string(scene.getString(l_header.m_sceneName));
+
+	auto& l_sceneEntities = result["SceneEntities"];
+	l_sceneEntities = json::array();
+
+	for (unsigned int i = 0; i < l_header.m_entityCount; i++)
+	{
+		auto& l_entity = scene.getEntity(i);
+		l_sceneEntities.emplace_back(json{
+			{ "EntityID", std::string(scene.getString(l_entity.m_entityID)) },
+			{ "EntityName", std::string(scene.getString(l_entity.m_entityName)) },
+			});
+	}
+
+	for (unsigned int i = 0; i < l_header.m_blockCount; i++)
+	{
+		auto& l_block = scene.getBlock(i);
+		auto l_type = componentType(l_block.m_componentType);
+		auto l_entityIndices = scene.getColumn<unsigned int>(l_block, 0);
+
+		for (unsigned int k = 0; k < l_block.m_count; k++)
+		{
+			json j;
+
+			switch (l_type)
+			{
+			case componentType::TransformComponent:
+			{
+				auto l_position = scene.getColumn<float>(l_block, TransformColumn::Position) + k * 4;
+				auto l_rotation = scene.getColumn<float>(l_block, TransformColumn::Rotation) + k * 4;
+				auto l_scale = scene.getColumn<float>(l_block, TransformColumn::Scale) + k * 4;
+
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"ParentTransformComponentEntityName", std::string(scene.getString(scene.getColumn<unsigned int>(l_block, TransformColumn::ParentTransformComponentEntityName)[k]))},
+					{"LocalTransformVector",
+						{
+							{"Position", { {"X", l_position[0]}, {"Y", l_position[1]}, {"Z", l_position[2]} } },
+							{"Rotation", { {"X", l_rotation[0]}, {"Y", l_rotation[1]}, {"Z", l_rotation[2]}, {"W", l_rotation[3]} } },
+							{"Scale", { {"X", l_scale[0]}, {"Y", l_scale[1]}, {"Z", l_scale[2]} } },
+						}
+					},
+				};
+				break;
+			}
+			case componentType::VisibleComponent:
+			{
+				auto l_flags = scene.getColumn<unsigned int>(l_block, VisibleColumn::Flags)[k];
+
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"VisiblilityType", scene.getColumn<unsigned int>(l_block, VisibleColumn::VisiblilityType)[k]},
+					{"MeshShapeType", scene.getColumn<unsigned int>(l_block, VisibleColumn::MeshShapeType)[k]},
+					{"MeshPrimitiveTopology", scene.getColumn<unsigned int>(l_block, VisibleColumn::MeshPrimitiveTopology)[k]},
+					{"TextureWrapMethod", scene.getColumn<unsigned int>(l_block, VisibleColumn::TextureWrapMethod)[k]},
+					{"drawAABB", (l_flags & VisibleFlags::DrawAABB) != 0},
+					{"isOccluder", (l_flags & VisibleFlags::IsOccluder) != 0},
+					{"simulatePhysics", (l_flags & VisibleFlags::SimulatePhysics) != 0},
+					{"mass", scene.getColumn<float>(l_block, VisibleColumn::Mass)[k]},
+					{"ModelFileName", std::string(scene.getString(scene.getColumn<unsigned int>(l_block, VisibleColumn::ModelFileName)[k]))},
+				};
+				break;
+			}
+			case componentType::DirectionalLightComponent:
+			{
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"LuminousFlux", scene.getColumn<float>(l_block, DirectionalLightColumn::LuminousFlux)[k]},
+					{"Color", getColor(scene, l_block, DirectionalLightColumn::Color, k)},
+					{"drawAABB", scene.getColumn<unsigned int>(l_block, DirectionalLightColumn::DrawAABB)[k] != 0},
+				};
+				break;
+			}
+			case componentType::PointLightComponent:
+			{
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"LuminousFlux", scene.getColumn<float>(l_block, PointLightColumn::LuminousFlux)[k]},
+					{"Color", getColor(scene, l_block, PointLightColumn::Color, k)},
+				};
+				break;
+			}
+			case componentType::SphereLightComponent:
+			{
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"SphereRadius", scene.getColumn<float>(l_block, SphereLightColumn::SphereRadius)[k]},
+					{"LuminousFlux", scene.getColumn<float>(l_block, SphereLightColumn::LuminousFlux)[k]},
+					{"Color", getColor(scene, l_block, SphereLightColumn::Color, k)},
+				};
+				break;
+			}
+			case componentType::EnvironmentCaptureComponent:
+			{
+				j = json
+				{
+					{"ComponentType", l_block.m_componentType},
+					{"CubemapName", std::string(scene.getString(scene.getColumn<unsigned int>(l_block, EnvironmentCaptureColumn::CubemapName)[k]))},
+				};
+				break;
+			}
+			default:
+				break;
+			}
+
+			if (!j.is_null())
+			{
+				l_sceneEntities[l_entityIndices[k]]["ChildrenComponents"].emplace_back(j);
+			}
+		}
+	}
+
+	return true;
+}
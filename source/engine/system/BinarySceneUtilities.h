@@ -0,0 +1,101 @@
+#pragma once
+#include <string_view>
+#include "../common/InnoType.h"
+#include "json/json.hpp"
+
+// .InnoBinaryScene, the cooked form of .InnoScene for loading, JSON stays the authoring format
+// [BinarySceneHeader][BinarySceneString x stringCount][string data][BinarySceneEntity x entityCount][BinarySceneBlock x blockCount][columns]
+// all the offsets are in bytes from the beginning of the file, so it's used in place from a read-only mapping
+// the strings are null-terminated, the string 0 is the empty string and every column starts at 16 bytes alignment
+constexpr unsigned int BinarySceneMagic = 0x43534E49; // "INSC"
+constexpr unsigned int BinarySceneVersion = 1;
+constexpr unsigned int BinarySceneMaxColumns = 12;
+
+struct BinarySceneHeader
+{
+	unsigned int m_magic;
+	unsigned int m_version;
+	unsigned int m_fileSize;
+	unsigned int m_sceneName;
+	unsigned int m_stringCount;
+	unsigned int m_stringsOffset;
+	unsigned int m_entityCount;
+	unsigned int m_entitiesOffset;
+	unsigned int m_blockCount;
+	unsigned int m_blocksOffset;
+};
+
+struct BinarySceneString
+{
+	unsigned int m_offset;
+	unsigned int m_length;
+};
+
+struct BinarySceneEntity
+{
+	unsigned int m_entityID;
+	unsigned int m_entityName;
+};
+
+// all the components of one type in SoA layout, each column is an array of m_count elements of m_columnStrides[i] bytes
+// the column 0 is always the index of the owner entity
+struct BinarySceneBlock
+{
+	unsigned int m_componentType;
+	unsigned int m_count;
+	unsigned int m_columnCount;
+	unsigned int m_columnStrides[BinarySceneMaxColumns];
+	unsigned int m_columnOffsets[BinarySceneMaxColumns];
+};
+
+// the string columns store the string indices, the vec4 columns store 4 floats
+enum class TransformColumn : unsigned int { Entity, ParentTransformComponentEntityName, Position, Rotation, Scale, Count };
+enum class VisibleColumn : unsigned int { Entity, VisiblilityType, MeshShapeType, MeshPrimitiveTopology, TextureWrapMethod, Flags, Mass, ModelFileName, Count };
+enum class DirectionalLightColumn : unsigned int { Entity, LuminousFlux, Color, DrawAABB, Count };
+enum class PointLightColumn : unsigned int { Entity, LuminousFlux, Color, Count };
+enum class SphereLightColumn : unsigned int { Entity, SphereRadius, LuminousFlux, Color, Count };
+enum class EnvironmentCaptureColumn : unsigned int { Entity, CubemapName, Count };
+
+enum VisibleFlags : unsigned int
+{
+	DrawAABB = 1,
+	IsOccluder = 1 << 1,
+	SimulatePhysics = 1 << 2,
+};
+
+// a validated view over the bytes of a binary scene, nothing is copied
+class BinarySceneView
+{
+public:
+	// check the header, every offset and every index against the size, the blocks of the supported component types should have their full layout
+	bool initialize(const char* data, size_t size);
+
+	const BinarySceneHeader& getHeader() const { return *reinterpret_cast<const BinarySceneHeader*>(m_data); }
+	const BinarySceneEntity& getEntity(unsigned int index) const { return reinterpret_cast<const BinarySceneEntity*>(m_data + getHeader().m_entitiesOffset)[index]; }
+	const BinarySceneBlock& getBlock(unsigned int index) const { return reinterpret_cast<const BinarySceneBlock*>(m_data + getHeader().m_blocksOffset)[index]; }
+
+	std::string_view getString(unsigned int index) const
+	{
+		auto& l_string = reinterpret_cast<const BinarySceneString*>(m_data + getHeader().m_stringsOffset)[index];
+		return std::string_view(m_data + l_string.m_offset, l_string.m_length);
+	}
+
+	template<typename T, typename Column>
+	const T* getColumn(const BinarySceneBlock& block, Column column) const
+	{
+		return reinterpret_cast<const T*>(m_data + block.m_columnOffsets[(unsigned int)column]);
+	}
+
+private:
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+INNO_PRIVATE_SCOPE BinarySceneUtilities
+{
+	bool isBinarySceneFile(const std::string& fileName);
+
+	// the JSON is in the .InnoScene format
+	bool convertFromJson(const nlohmann::json& j, std::vector<char>& result);
+	bool convertToJson(const BinarySceneView& scene, nlohmann::json& result);
+}
@@ -1,4 +1,5 @@
 #include "DXRenderingSystemUtilities.h"
+#include "VertexPackingUtilities.h"
 
 #include "../component/WindowSystemComponent.h"
 #include "../component/DXWindowSystemComponent.h"
@@ -435,11 +436,20 @@ DXMeshDataComponent* DXRenderingSystemNS::generateDXMeshDataComponent(MeshDataCo
 	{
 		auto l_ptr = addDXMeshDataComponent(rhs->m_parentEntity);
 
+		// the DX input layout still takes the unpacked vertices
+		auto l_vertices = &rhs->m_vertices;
+		std::vector<Vertex> l_unpackedVertices;
+		if (rhs->m_vertexFormat != VertexFormat::UNPACKED)
+		{
+			VertexPackingUtilities::unpack(rhs, l_unpackedVertices);
+			l_vertices = &l_unpackedVertices;
+		}
+
 		// Set up the description of the static vertex buffer.
 		D3D11_BUFFER_DESC vertexBufferDesc;
 		ZeroMemory(&vertexBufferDesc, sizeof(vertexBufferDesc));
 		vertexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		vertexBufferDesc.ByteWidth = sizeof(Vertex) * (UINT)rhs->m_vertices.size();
+		vertexBufferDesc.ByteWidth = sizeof(Vertex) * (UINT)l_vertices->size();
 		vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		vertexBufferDesc.CPUAccessFlags = 0;
 		vertexBufferDesc.MiscFlags = 0;
@@ -448,7 +458,7 @@ DXMeshDataComponent* DXRenderingSystemNS::generateDXMeshDataComponent(MeshDataCo
 		// Give the subresource structure a pointer to the vertex data.
 		D3D11_SUBRESOURCE_DATA vertexData;
 		ZeroMemory(&vertexData, sizeof(vertexData));
-		vertexData.pSysMem = &rhs->m_vertices[0];
+		vertexData.pSysMem = l_vertices->data();
 		vertexData.SysMemPitch = 0;
 		vertexData.SysMemSlicePitch = 0;
 
@@ -462,10 +472,11 @@ DXMeshDataComponent* DXRenderingSystemNS::generateDXMeshDataComponent(MeshDataCo
 		}
 
 		// Set up the description of the static index buffer.
+		auto l_indices = rhs->getIndices();
 		D3D11_BUFFER_DESC indexBufferDesc;
 		ZeroMemory(&indexBufferDesc, sizeof(indexBufferDesc));
 		indexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		indexBufferDesc.ByteWidth = (UINT)(rhs->m_indices.size() * sizeof(unsigned int));
+		indexBufferDesc.ByteWidth = (UINT)(l_indices.size() * sizeof(unsigned int));
 		indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		indexBufferDesc.CPUAccessFlags = 0;
 		indexBufferDesc.MiscFlags = 0;
@@ -474,7 +485,7 @@ DXMeshDataComponent* DXRenderingSystemNS::generateDXMeshDataComponent(MeshDataCo
 		// Give the subresource structure a pointer to the index data.
 		D3D11_SUBRESOURCE_DATA indexData;
 		ZeroMemory(&indexData, sizeof(indexData));
-		indexData.pSysMem = &rhs->m_indices[0];
+		indexData.pSysMem = l_indices.data();
 		indexData.SysMemPitch = 0;
 		indexData.SysMemSlicePitch = 0;
 
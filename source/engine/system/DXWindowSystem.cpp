@@ -216,57 +216,33 @@ LRESULT windowCallbackWrapper::MessageHandler(HWND hwnd, UINT umsg, WPARAM wpara
 	{
 	case WM_KEYDOWN:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find((int)wparam);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::PRESSED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback((int)wparam, ButtonStatus::PRESSED);
 		return 0;
 	}
 	case WM_KEYUP:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find((int)wparam);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::RELEASED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback((int)wparam, ButtonStatus::RELEASED);
 
 		return 0;
 	}
 	case WM_LBUTTONDOWN:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(INNO_MOUSE_BUTTON_LEFT);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::PRESSED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback(INNO_MOUSE_BUTTON_LEFT, ButtonStatus::PRESSED);
 		return 0;
 	}
 	case WM_LBUTTONUP:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(INNO_MOUSE_BUTTON_LEFT);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::RELEASED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback(INNO_MOUSE_BUTTON_LEFT, ButtonStatus::RELEASED);
 		return 0;
 	}
 	case WM_RBUTTONDOWN:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(INNO_MOUSE_BUTTON_RIGHT);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::PRESSED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback(INNO_MOUSE_BUTTON_RIGHT, ButtonStatus::PRESSED);
 		return 0;
 	}
 	case WM_RBUTTONUP:
 	{
-		auto l_result = DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(INNO_MOUSE_BUTTON_RIGHT);
-		if (l_result != DXWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-		{
-			l_result->second = ButtonStatus::RELEASED;
-		}
+		DXWindowSystemNS::m_inputSystem->buttonStatusCallback(INNO_MOUSE_BUTTON_RIGHT, ButtonStatus::RELEASED);
 		return 0;
 	}
 
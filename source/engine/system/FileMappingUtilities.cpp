@@ -0,0 +1,191 @@
+#include "FileMappingUtilities.h"
+
+#if defined INNO_PLATFORM_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+{
+	*this = std::move(rhs);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		close();
+
+		m_data = rhs.m_data;
+		m_size = rhs.m_size;
+		m_isOpened = rhs.m_isOpened;
+#if defined INNO_PLATFORM_WIN
+		m_fileHandle = rhs.m_fileHandle;
+		m_mappingHandle = rhs.m_mappingHandle;
+		rhs.m_fileHandle = nullptr;
+		rhs.m_mappingHandle = nullptr;
+#endif
+		rhs.m_data = nullptr;
+		rhs.m_size = 0;
+		rhs.m_isOpened = false;
+	}
+
+	return *this;
+}
+
+#if defined INNO_PLATFORM_WIN
+bool MappedFile::open(const std::string& fileName)
+{
+	close();
+
+	auto l_fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (l_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER l_fileSize;
+	if (!GetFileSizeEx(l_fileHandle, &l_fileSize))
+	{
+		CloseHandle(l_fileHandle);
+		return false;
+	}
+
+	m_fileHandle = l_fileHandle;
+	m_size = (size_t)l_fileSize.QuadPart;
+	m_isOpened = true;
+
+	// a mapping of 0 bytes can't be created
+	if (m_size == 0)
+	{
+		return true;
+	}
+
+	auto l_mappingHandle = CreateFileMappingA(l_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!l_mappingHandle)
+	{
+		close();
+		return false;
+	}
+	m_mappingHandle = l_mappingHandle;
+
+	m_data = (const char*)MapViewOfFile(l_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!m_data)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::releasePages(const void* data, size_t size) const
+{
+	if (!m_data || size == 0)
+	{
+		return;
+	}
+
+	// a range that is not locked is removed from the working set
+	VirtualUnlock((LPVOID)data, size);
+}
+
+void MappedFile::close()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpened = false;
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+}
+#else
+bool MappedFile::open(const std::string& fileName)
+{
+	close();
+
+	auto l_fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+	if (l_fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat l_fileStat;
+	if (fstat(l_fileDescriptor, &l_fileStat) != 0)
+	{
+		::close(l_fileDescriptor);
+		return false;
+	}
+
+	m_size = (size_t)l_fileStat.st_size;
+
+	if (m_size > 0)
+	{
+		auto l_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, l_fileDescriptor, 0);
+		if (l_data == MAP_FAILED)
+		{
+			::close(l_fileDescriptor);
+			m_size = 0;
+			return false;
+		}
+		m_data = (const char*)l_data;
+	}
+
+	// the mapping keeps its own reference to the file
+	::close(l_fileDescriptor);
+	m_isOpened = true;
+
+	return true;
+}
+
+void MappedFile::releasePages(const void* data, size_t size) const
+{
+	if (!m_data || size == 0)
+	{
+		return;
+	}
+
+	// madvise needs a page aligned range, the neighbour pages are read again if they are still used
+	auto l_pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+	auto l_begin = std::max((uintptr_t)data, (uintptr_t)m_data) & ~(l_pageSize - 1);
+	auto l_end = std::min((uintptr_t)data + size, (uintptr_t)m_data + m_size);
+
+	if (l_end > l_begin)
+	{
+		madvise((void*)l_begin, l_end - l_begin, MADV_DONTNEED);
+	}
+}
+
+void MappedFile::close()
+{
+	if (m_data)
+	{
+		munmap((void*)m_data, m_size);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpened = false;
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+#include "../common/InnoType.h"
+
+// a read-only view of a whole file, the pages are loaded by the OS on the first access and shared with the file cache
+class MappedFile
+{
+public:
+	MappedFile() {};
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& rhs) noexcept;
+	MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+	// an empty file is opened successfully with a null data pointer
+	bool open(const std::string& fileName);
+	void close();
+
+	// drop the physical pages of the range from the process, a later access reads them again from the file
+	void releasePages(const void* data, size_t size) const;
+
+	bool isOpened() const { return m_isOpened; }
+	const char* getData() const { return m_data; }
+	size_t getSize() const { return m_size; }
+
+private:
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_isOpened = false;
+#if defined INNO_PLATFORM_WIN
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#endif
+};
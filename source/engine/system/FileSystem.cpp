@@ -9,6 +9,12 @@ using json = nlohmann::json;
 #include "../component/MeshDataComponent.h"
 #include "../component/TextureDataComponent.h"
 
+#include "MeshSimplificationUtilities.h"
+#include "VertexPackingUtilities.h"
+#include "BinarySceneUtilities.h"
+#include "FileMappingUtilities.h"
+#include "JsonStreamingUtilities.h"
+
 #include "../../engine/system/ICoreSystem.h"
 
 INNO_SYSTEM_EXPORT extern ICoreSystem* g_pCoreSystem;
@@ -28,9 +34,9 @@ INNO_PRIVATE_SCOPE InnoFileSystemNS
 	{
 		bool convertModel(const std::string & fileName, const std::string & exportPath);
 		json processAssimpScene(const aiScene* aiScene);
-		json processAssimpNode(const aiNode * node, const aiScene * scene);
-		json processAssimpMesh(const aiScene * scene, unsigned int meshIndex);
-		std::pair<EntityID, size_t> processMeshData(const aiMesh * aiMesh);
+		json processAssimpNode(const aiNode * node, const aiScene * scene, const std::vector<json>& meshDatas);
+		json processAssimpMesh(const aiScene * scene, unsigned int meshIndex, const std::vector<json>& meshDatas);
+		json processMeshData(const aiMesh * aiMesh);
 		json processAssimpMaterial(const aiMaterial * aiMaterial);
 		json processTextureData(const std::string & fileName, TextureUsageType textureUsageType);
 	};
@@ -38,8 +44,6 @@ INNO_PRIVATE_SCOPE InnoFileSystemNS
 	namespace ModelLoader
 	{
 		ModelMap loadModelFromDisk(const std::string & fileName);
-		ModelMap processSceneJsonData(const json & j);
-		ModelMap processNodeJsonData(const json & j);
 		ModelPair processMeshJsonData(const json& j);
 		MaterialDataComponent* processMaterialJsonData(const json& j);
 		TextureDataComponent* loadTexture(const std::string& fileName);
@@ -70,6 +74,13 @@ INNO_PRIVATE_SCOPE InnoFileSystemNS
 	void from_json(const json& j, SphereLightComponent& p);
 	void from_json(const json& j, EnvironmentCaptureComponent& p);
 
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, TransformComponent& p);
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, VisibleComponent& p);
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, DirectionalLightComponent& p);
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, PointLightComponent& p);
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, SphereLightComponent& p);
+	void from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, EnvironmentCaptureComponent& p);
+
 	template<typename T>
 	inline bool loadComponentData(const json& j, const EntityID& entityID)
 	{
@@ -80,6 +91,29 @@ INNO_PRIVATE_SCOPE InnoFileSystemNS
 		return true;
 	}
 
+	template<typename T>
+	inline bool loadComponentBlock(const BinarySceneView& scene, const BinarySceneBlock& block, const std::vector<EntityID>& entityIDs)
+	{
+		auto l_entityIndices = scene.getColumn<unsigned int>(block, 0);
+
+		for (unsigned int i = 0; i < block.m_count; i++)
+		{
+			auto& l_entityID = entityIDs[l_entityIndices[i]];
+
+			// the components of the root entity are skipped
+			if (l_entityID.empty())
+			{
+				continue;
+			}
+
+			auto l_result = g_pCoreSystem->getGameSystem()->spawn<T>(l_entityID);
+
+			from_binary(scene, block, i, *l_result);
+		}
+
+		return true;
+	}
+
 	template<typename T>
 	inline bool saveComponentData(json& topLevel, T* rhs)
 	{
@@ -107,11 +141,15 @@ INNO_PRIVATE_SCOPE InnoFileSystemNS
 
 	bool loadJsonDataFromDisk(const std::string & fileName, json & data);
 	bool saveJsonDataToDisk(const std::string & fileName, const json & data);
+	bool saveBinaryDataToDisk(const std::string & fileName, const std::vector<char>& data);
 
 	bool prepareForLoadingScene(const std::string& fileName);
 	bool loadScene(const std::string& fileName);
+	bool loadJsonScene(const std::string& fileName);
+	bool loadBinaryScene(const std::string& fileName);
 	bool cleanScene();
 	bool saveScene(const std::string& fileName);
+	bool convertScene(const std::string& fileName, const std::string& exportPath);
 
 	bool serialize(std::ostream& os, void* ptr, size_t size)
 	{
@@ -323,6 +361,9 @@ void InnoFileSystemNS::to_json(json& j, const VisibleComponent& p)
 		{"MeshPrimitiveTopology", p.m_meshPrimitiveTopology},
 		{"TextureWrapMethod", p.m_textureWrapMethod},
 		{"drawAABB", p.m_drawAABB},
+		{"isOccluder", p.m_isOccluder},
+		{"simulatePhysics", p.m_simulatePhysics},
+		{"mass", p.m_mass},
 		{"ModelFileName", p.m_modelFileName},
 	};
 }
@@ -417,6 +458,9 @@ void InnoFileSystemNS::from_json(const json & j, VisibleComponent & p)
 	p.m_meshPrimitiveTopology = j["MeshPrimitiveTopology"];
 	p.m_textureWrapMethod = j["TextureWrapMethod"];
 	p.m_drawAABB = j["drawAABB"];
+	p.m_isOccluder = j.value("isOccluder", false);
+	p.m_simulatePhysics = j.value("simulatePhysics", false);
+	p.m_mass = j.value("mass", 0.0f);
 	p.m_modelFileName = j["ModelFileName"];
 }
 
@@ -453,6 +497,73 @@ void InnoFileSystemNS::from_json(const json & j, EnvironmentCaptureComponent & p
 	p.m_cubemapTextureFileName = j["CubemapName"];
 }
 
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, TransformComponent& p)
+{
+	auto l_position = scene.getColumn<float>(block, TransformColumn::Position) + index * 4;
+	auto l_rotation = scene.getColumn<float>(block, TransformColumn::Rotation) + index * 4;
+	auto l_scale = scene.getColumn<float>(block, TransformColumn::Scale) + index * 4;
+
+	p.m_localTransformVector.m_pos = vec4(l_position[0], l_position[1], l_position[2], 1.0f);
+	p.m_localTransformVector.m_rot = vec4(l_rotation[0], l_rotation[1], l_rotation[2], l_rotation[3]);
+	p.m_localTransformVector.m_scale = vec4(l_scale[0], l_scale[1], l_scale[2], 1.0f);
+
+	auto l_parentTransformComponentEntityName = scene.getString(scene.getColumn<unsigned int>(block, TransformColumn::ParentTransformComponentEntityName)[index]);
+	if (l_parentTransformComponentEntityName == "RootTransform")
+	{
+		p.m_parentTransformComponent = g_pCoreSystem->getGameSystem()->getRootTransformComponent();
+	}
+	else
+	{
+		m_orphanTransformComponents.push({ &p, std::string(l_parentTransformComponentEntityName) });
+	}
+}
+
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, VisibleComponent& p)
+{
+	auto l_flags = scene.getColumn<unsigned int>(block, VisibleColumn::Flags)[index];
+
+	p.m_visiblilityType = VisiblilityType(scene.getColumn<unsigned int>(block, VisibleColumn::VisiblilityType)[index]);
+	p.m_meshShapeType = MeshShapeType(scene.getColumn<unsigned int>(block, VisibleColumn::MeshShapeType)[index]);
+	p.m_meshPrimitiveTopology = MeshPrimitiveTopology(scene.getColumn<unsigned int>(block, VisibleColumn::MeshPrimitiveTopology)[index]);
+	p.m_textureWrapMethod = TextureWrapMethod(scene.getColumn<unsigned int>(block, VisibleColumn::TextureWrapMethod)[index]);
+	p.m_drawAABB = (l_flags & VisibleFlags::DrawAABB) != 0;
+	p.m_isOccluder = (l_flags & VisibleFlags::IsOccluder) != 0;
+	p.m_simulatePhysics = (l_flags & VisibleFlags::SimulatePhysics) != 0;
+	p.m_mass = scene.getColumn<float>(block, VisibleColumn::Mass)[index];
+	p.m_modelFileName = scene.getString(scene.getColumn<unsigned int>(block, VisibleColumn::ModelFileName)[index]);
+}
+
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, DirectionalLightComponent& p)
+{
+	auto l_color = scene.getColumn<float>(block, DirectionalLightColumn::Color) + index * 4;
+
+	p.m_luminousFlux = scene.getColumn<float>(block, DirectionalLightColumn::LuminousFlux)[index];
+	p.m_drawAABB = scene.getColumn<unsigned int>(block, DirectionalLightColumn::DrawAABB)[index] != 0;
+	p.m_color = vec4(l_color[0], l_color[1], l_color[2], l_color[3]);
+}
+
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, PointLightComponent& p)
+{
+	auto l_color = scene.getColumn<float>(block, PointLightColumn::Color) + index * 4;
+
+	p.m_luminousFlux = scene.getColumn<float>(block, PointLightColumn::LuminousFlux)[index];
+	p.m_color = vec4(l_color[0], l_color[1], l_color[2], l_color[3]);
+}
+
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, SphereLightComponent& p)
+{
+	auto l_color = scene.getColumn<float>(block, SphereLightColumn::Color) + index * 4;
+
+	p.m_luminousFlux = scene.getColumn<float>(block, SphereLightColumn::LuminousFlux)[index];
+	p.m_sphereRadius = scene.getColumn<float>(block, SphereLightColumn::SphereRadius)[index];
+	p.m_color = vec4(l_color[0], l_color[1], l_color[2], l_color[3]);
+}
+
+void InnoFileSystemNS::from_binary(const BinarySceneView& scene, const BinarySceneBlock& block, unsigned int index, EnvironmentCaptureComponent& p)
+{
+	p.m_cubemapTextureFileName = scene.getString(scene.getColumn<unsigned int>(block, EnvironmentCaptureColumn::CubemapName)[index]);
+}
+
 bool InnoFileSystemNS::loadJsonDataFromDisk(const std::string & fileName, json & data)
 {
 	std::ifstream i(fileName);
@@ -481,6 +592,25 @@ bool InnoFileSystemNS::saveJsonDataToDisk(const std::string & fileName, const js
 	return true;
 }
 
+bool InnoFileSystemNS::saveBinaryDataToDisk(const std::string & fileName, const std::vector<char>& data)
+{
+	std::ofstream o;
+	o.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+
+	if (!o.is_open())
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't open binary file : " + fileName + "!");
+		return false;
+	}
+
+	serialize(o, (void*)data.data(), data.size());
+	o.close();
+
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: binary file : " + fileName + " has been saved.");
+
+	return true;
+}
+
 bool InnoFileSystemNS::prepareForLoadingScene(const std::string& fileName)
 {
 	m_nextLoadingScene = fileName;
@@ -497,17 +627,85 @@ bool InnoFileSystemNS::loadScene(const std::string& fileName)
 		return true;
 	}
 
-	json j;
-	if (!loadJsonDataFromDisk(fileName, j))
+	auto l_result = BinarySceneUtilities::isBinarySceneFile(fileName) ? loadBinaryScene(fileName) : loadJsonScene(fileName);
+	if (!l_result)
 	{
 		return false;
 	}
 
-	cleanScene();
+	while (InnoFileSystemNS::m_orphanTransformComponents.size() > 0)
+	{
+		std::pair<TransformComponent*, std::string> l_orphan;
+		if (InnoFileSystemNS::m_orphanTransformComponents.tryPop(l_orphan))
+		{
+			auto t = g_pCoreSystem->getGameSystem()->get<TransformComponent>(g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second));
+			if (t)
+			{
+				l_orphan.first->m_parentTransformComponent = t;
+			}
+			else
+			{
+				g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't find TransformComponent with entity name" + l_orphan.second + "!");
+			}
+		}
+	}
+	while (InnoFileSystemNS::m_orphanCameraComponents.size() > 0)
+	{
+		std::pair<CameraComponent*, std::string> l_orphan;
+		if (InnoFileSystemNS::m_orphanCameraComponents.tryPop(l_orphan))
+		{
+			l_orphan.first->m_parentEntity = g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second);
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: reattached CameraComponent to entity " + l_orphan.second + ".");
+		}
+	}
+	while (InnoFileSystemNS::m_orphanInputComponents.size() > 0)
+	{
+		std::pair<InputComponent*, std::string> l_orphan;
+		if (InnoFileSystemNS::m_orphanInputComponents.tryPop(l_orphan))
+		{
+			l_orphan.first->m_parentEntity = g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second);
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: reattached InputComponent to entity " + l_orphan.second + ".");
+		}
+	}
+
+	g_pCoreSystem->getAssetSystem()->loadAssetsForComponents();
+
+	for (auto i : m_sceneLoadingCallbacks)
+	{
+		(*i)();
+	}
 
-	auto l_sceneName = j["SceneName"];
+	m_currentScene = fileName;
+
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: scene " + fileName + " has been loaded.");
+
+	return true;
+}
+
+bool InnoFileSystemNS::loadJsonScene(const std::string& fileName)
+{
+	std::ifstream l_file(fileName);
+
+	if (!l_file.is_open())
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't open JSON file : " + fileName + "!");
+		return false;
+	}
+
+	// the current scene is only cleaned after the whole file is known to be valid, the entities are created while parsing the second time
+	if (!JsonStreamingUtilities::validate(l_file))
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: " + fileName + " is not a valid JSON file!");
+		return false;
+	}
+
+	l_file.clear();
+	l_file.seekg(0);
+
+	cleanScene();
 
-	for (auto& i : j["SceneEntities"])
+	// only one entity is in memory at a time
+	auto l_result = JsonStreamingUtilities::streamArrayElements(l_file, { "SceneEntities" }, [&](json& i)
 	{
 		if (i["EntityName"] != "RootTransform")
 		{
@@ -548,53 +746,74 @@ bool InnoFileSystemNS::loadScene(const std::string& fileName)
 				}
 			}
 		}
-	}
 
-	while (InnoFileSystemNS::m_orphanTransformComponents.size() > 0)
+		return true;
+	});
+
+	if (!l_result)
 	{
-		std::pair<TransformComponent*, std::string> l_orphan;
-		if (InnoFileSystemNS::m_orphanTransformComponents.tryPop(l_orphan))
-		{
-			auto t = g_pCoreSystem->getGameSystem()->get<TransformComponent>(g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second));
-			if (t)
-			{
-				l_orphan.first->m_parentTransformComponent = t;
-			}
-			else
-			{
-				g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't find TransformComponent with entity name" + l_orphan.second + "!");
-			}
-		}
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: " + fileName + " can't be read!");
+		return false;
 	}
-	while (InnoFileSystemNS::m_orphanCameraComponents.size() > 0)
+
+	return true;
+}
+
+bool InnoFileSystemNS::loadBinaryScene(const std::string& fileName)
+{
+	MappedFile l_file;
+	if (!l_file.open(fileName))
 	{
-		std::pair<CameraComponent*, std::string> l_orphan;
-		if (InnoFileSystemNS::m_orphanCameraComponents.tryPop(l_orphan))
-		{
-			l_orphan.first->m_parentEntity = g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second);
-			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: reattached CameraComponent to entity " + l_orphan.second + ".");
-		}
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't open binary scene file : " + fileName + "!");
+		return false;
 	}
-	while (InnoFileSystemNS::m_orphanInputComponents.size() > 0)
+
+	BinarySceneView l_scene;
+	if (!l_scene.initialize(l_file.getData(), l_file.getSize()))
 	{
-		std::pair<InputComponent*, std::string> l_orphan;
-		if (InnoFileSystemNS::m_orphanInputComponents.tryPop(l_orphan))
-		{
-			l_orphan.first->m_parentEntity = g_pCoreSystem->getGameSystem()->getEntityID(l_orphan.second);
-			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: reattached InputComponent to entity " + l_orphan.second + ".");
-		}
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: " + fileName + " is not a valid binary scene of version " + std::to_string(BinarySceneVersion) + "!");
+		return false;
 	}
 
-	g_pCoreSystem->getAssetSystem()->loadAssetsForComponents();
+	cleanScene();
 
-	for (auto i : m_sceneLoadingCallbacks)
+	auto& l_header = l_scene.getHeader();
+
+	// the root entity keeps an empty ID
+	std::vector<EntityID> l_entityIDs(l_header.m_entityCount);
+	for (unsigned int i = 0; i < l_header.m_entityCount; i++)
 	{
-		(*i)();
+		auto l_entityName = std::string(l_scene.getString(l_scene.getEntity(i).m_entityName));
+		if (l_entityName != "RootTransform")
+		{
+			g_pCoreSystem->getGameSystem()->removeEntity(l_entityName);
+
+			l_entityIDs[i] = g_pCoreSystem->getGameSystem()->createEntity(l_entityName);
+		}
 	}
 
-	m_currentScene = fileName;
+	for (unsigned int i = 0; i < l_header.m_blockCount; i++)
+	{
+		auto& l_block = l_scene.getBlock(i);
 
-	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: scene " + fileName + " has been loaded.");
+		switch (componentType(l_block.m_componentType))
+		{
+		case componentType::TransformComponent: loadComponentBlock<TransformComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		case componentType::VisibleComponent: loadComponentBlock<VisibleComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		case componentType::DirectionalLightComponent: loadComponentBlock<DirectionalLightComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		case componentType::PointLightComponent: loadComponentBlock<PointLightComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		case componentType::SphereLightComponent: loadComponentBlock<SphereLightComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		case componentType::EnvironmentCaptureComponent: loadComponentBlock<EnvironmentCaptureComponent>(l_scene, l_block, l_entityIDs);
+			break;
+		default:
+			break;
+		}
+	}
 
 	return true;
 }
@@ -611,6 +830,11 @@ bool InnoFileSystemNS::cleanScene()
 		m_orphanInputComponents.push(std::pair<InputComponent*, std::string>(i, g_pCoreSystem->getGameSystem()->getEntityName(i->m_parentEntity)));
 	}
 
+	// the BVH leaves point to the components destroyed below
+	g_pCoreSystem->getPhysicsSystem()->clearPhysicsProxies();
+
+	std::unique_lock<RWLock> l_lock(GameSystemComponent::get().m_componentRegistryLock);
+
 	for (auto i : GameSystemComponent::get().m_TransformComponents)
 	{
 		g_pCoreSystem->getGameSystem()->destroy(i);
@@ -695,13 +919,75 @@ bool InnoFileSystemNS::saveScene(const std::string& fileName)
 		saveComponentData(topLevel, i);
 	}
 
-	saveJsonDataToDisk(fileName, topLevel);
+	if (BinarySceneUtilities::isBinarySceneFile(fileName))
+	{
+		std::vector<char> l_binaryData;
+		if (!BinarySceneUtilities::convertFromJson(topLevel, l_binaryData) || !saveBinaryDataToDisk(fileName, l_binaryData))
+		{
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: can't save scene " + fileName + "!");
+			return false;
+		}
+	}
+	else
+	{
+		saveJsonDataToDisk(fileName, topLevel);
+	}
 
 	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "FileSystem: scene " + fileName + " has been saved.");
 
 	return true;
 }
 
+bool InnoFileSystemNS::convertScene(const std::string& fileName, const std::string& exportPath)
+{
+	auto l_exportFileName = fs::path(fileName).stem().generic_string();
+	auto l_extension = fs::path(fileName).extension().generic_string();
+
+	if (l_extension == ".InnoScene")
+	{
+		json j;
+		if (!loadJsonDataFromDisk(fileName, j))
+		{
+			return false;
+		}
+
+		std::vector<char> l_binaryData;
+		if (!BinarySceneUtilities::convertFromJson(j, l_binaryData))
+		{
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: " + fileName + " is too large for the binary scene format!");
+			return false;
+		}
+
+		if (!saveBinaryDataToDisk(exportPath + l_exportFileName + ".InnoBinaryScene", l_binaryData))
+		{
+			return false;
+		}
+	}
+	else if (BinarySceneUtilities::isBinarySceneFile(fileName))
+	{
+		MappedFile l_file;
+		BinarySceneView l_scene;
+		if (!l_file.open(fileName) || !l_scene.initialize(l_file.getData(), l_file.getSize()))
+		{
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: " + fileName + " is not a valid binary scene of version " + std::to_string(BinarySceneVersion) + "!");
+			return false;
+		}
+
+		json j;
+		BinarySceneUtilities::convertToJson(l_scene, j);
+		saveJsonDataToDisk(exportPath + l_exportFileName + ".InnoScene", j);
+	}
+	else
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "FileSystem: " + fileName + " is not supported!");
+		return false;
+	}
+
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: " + fileName + " has been converted.");
+
+	return true;
+}
+
 INNO_SYSTEM_EXPORT bool InnoFileSystem::setup()
 {
 	g_pCoreSystem->getAssetSystem()->loadDefaultAssets();
@@ -772,6 +1058,11 @@ INNO_SYSTEM_EXPORT bool InnoFileSystem::convertModel(const std::string & fileNam
 	return InnoFileSystemNS::convertModel(fileName, exportPath);
 }
 
+INNO_SYSTEM_EXPORT bool InnoFileSystem::convertScene(const std::string & fileName, const std::string & exportPath)
+{
+	return InnoFileSystemNS::convertScene(fileName, exportPath);
+}
+
 INNO_SYSTEM_EXPORT ModelMap InnoFileSystem::loadModel(const std::string & fileName)
 {
 	auto l_extension = fs::path(fileName).extension().generic_string();
@@ -847,22 +1138,30 @@ json InnoFileSystemNS::AssimpWrapper::processAssimpScene(const aiScene* aiScene)
 
 	l_sceneData["Timestamp"] = l_timeDataStr;
 
+	// convert the mesh data in parallel, the LOD generation is the most expensive part of the conversion
+	std::vector<json> l_meshDatas(aiScene->mNumMeshes);
+	std::vector<InnoFuture<void>> l_asyncTask;
+
+	g_pCoreSystem->getTaskSystem()->dispatch(aiScene->mNumMeshes, [&](size_t i) {
+		l_meshDatas[i] = processMeshData(aiScene->mMeshes[i]);
+	}, l_asyncTask);
+
 	//check if root node has mesh attached, btw there SHOULD NOT BE ANY MESH ATTACHED TO ROOT NODE!!!
 	if (aiScene->mRootNode->mNumMeshes > 0)
 	{
-		l_sceneData["Nodes"].emplace_back(processAssimpNode(aiScene->mRootNode, aiScene));
+		l_sceneData["Nodes"].emplace_back(processAssimpNode(aiScene->mRootNode, aiScene, l_meshDatas));
 	}
 	for (unsigned int i = 0; i < aiScene->mRootNode->mNumChildren; i++)
 	{
 		if (aiScene->mRootNode->mChildren[i]->mNumMeshes > 0)
 		{
-			l_sceneData["Nodes"].emplace_back(processAssimpNode(aiScene->mRootNode->mChildren[i], aiScene));
+			l_sceneData["Nodes"].emplace_back(processAssimpNode(aiScene->mRootNode->mChildren[i], aiScene, l_meshDatas));
 		}
 	}
 	return l_sceneData;
 }
 
-json InnoFileSystemNS::AssimpWrapper::processAssimpNode(const aiNode * node, const aiScene * scene)
+json InnoFileSystemNS::AssimpWrapper::processAssimpNode(const aiNode * node, const aiScene * scene, const std::vector<json>& meshDatas)
 {
 	json l_nodeData;
 
@@ -871,23 +1170,20 @@ json InnoFileSystemNS::AssimpWrapper::processAssimpNode(const aiNode * node, con
 	// process each mesh located at the current node
 	for (unsigned int i = 0; i < node->mNumMeshes; i++)
 	{
-		l_nodeData["Meshes"].emplace_back(processAssimpMesh(scene, node->mMeshes[i]));
+		l_nodeData["Meshes"].emplace_back(processAssimpMesh(scene, node->mMeshes[i], meshDatas));
 	}
 
 	return l_nodeData;
 }
 
-json InnoFileSystemNS::AssimpWrapper::processAssimpMesh(const aiScene * scene, unsigned int meshIndex)
+json InnoFileSystemNS::AssimpWrapper::processAssimpMesh(const aiScene * scene, unsigned int meshIndex, const std::vector<json>& meshDatas)
 {
-	json l_meshData;
+	json l_meshData = meshDatas[meshIndex];
 
 	auto l_aiMesh = scene->mMeshes[meshIndex];
 
 	l_meshData["MeshName"] = *l_aiMesh->mName.C_Str();
 	l_meshData["VerticesNumber"] = l_aiMesh->mNumVertices;
-	auto l_meshFileName = processMeshData(l_aiMesh);
-	l_meshData["MeshFile"] = l_meshFileName.first.c_str();
-	l_meshData["IndicesNumber"] = l_meshFileName.second;
 
 	// process material
 	if (l_aiMesh->mMaterialIndex > 0)
@@ -898,7 +1194,7 @@ json InnoFileSystemNS::AssimpWrapper::processAssimpMesh(const aiScene * scene, u
 	return l_meshData;
 }
 
-std::pair<EntityID, size_t> InnoFileSystemNS::AssimpWrapper::processMeshData(const aiMesh * aiMesh)
+json InnoFileSystemNS::AssimpWrapper::processMeshData(const aiMesh * aiMesh)
 {
 	auto l_verticesNumber = aiMesh->mNumVertices;
 
@@ -989,14 +1285,62 @@ std::pair<EntityID, size_t> InnoFileSystemNS::AssimpWrapper::processMeshData(con
 
 	auto l_exportFileFullPath = "..//res//convertedAssets//" + l_exportFileName + ".InnoRaw";
 
+	auto l_LODs = MeshSimplificationUtilities::generateLODs(l_vertices, l_indices, FileSystemComponent::get().m_LODTriangleRatios);
+
+	vec4 l_boundMax;
+	vec4 l_boundMin;
+	InnoMath::generateBounds(l_vertices.data(), l_vertices.size(), l_boundMax, l_boundMin);
+	auto l_boundSphere = InnoMath::generateBoundSphere(l_vertices.data(), l_vertices.size(), l_boundMax, l_boundMin);
+
+	// the LOD vertices are a subset of the source vertices, so they share the quantization bounds
+	auto l_vertexFormat = FileSystemComponent::get().m_convertedVertexFormat;
+	vec4 l_positionOffset;
+	float l_positionScale;
+	VertexPackingUtilities::getQuantizationParameters(l_boundMax, l_boundMin, l_positionOffset, l_positionScale);
+
+	std::vector<unsigned char> l_packedVertices;
+	VertexPackingUtilities::pack(l_vertices, l_vertexFormat, l_positionOffset, l_positionScale, l_packedVertices);
+
 	std::ofstream l_file(l_exportFileFullPath, std::ios::binary);
 
-	serializeVector(l_file, l_vertices);
+	serializeVector(l_file, l_packedVertices);
 	serializeVector(l_file, l_indices);
 
+	json l_meshData;
+
+	l_meshData["MeshFile"] = l_exportFileFullPath.c_str();
+	l_meshData["IndicesNumber"] = l_indiceSize;
+	l_meshData["VertexFormat"] = (int)l_vertexFormat;
+	if (l_vertexFormat == VertexFormat::QUANTIZED)
+	{
+		to_json(l_meshData["PositionOffset"], l_positionOffset);
+		l_meshData["PositionScale"] = l_positionScale;
+	}
+	to_json(l_meshData["BoundMax"], l_boundMax);
+	to_json(l_meshData["BoundMin"], l_boundMin);
+	to_json(l_meshData["BoundSphereCenter"], l_boundSphere.m_center);
+	l_meshData["BoundSphereRadius"] = l_boundSphere.m_radius;
+
+	// the LODs follow the full resolution mesh in the same file
+	for (auto& i : l_LODs)
+	{
+		VertexPackingUtilities::pack(i.m_vertices, l_vertexFormat, l_positionOffset, l_positionScale, l_packedVertices);
+
+		serializeVector(l_file, l_packedVertices);
+		serializeVector(l_file, i.m_indices);
+
+		json l_LODData;
+
+		l_LODData["VerticesNumber"] = i.m_vertices.size();
+		l_LODData["IndicesNumber"] = i.m_indices.size();
+		l_LODData["Error"] = i.m_error;
+
+		l_meshData["LODs"].emplace_back(l_LODData);
+	}
+
 	l_file.close();
 
-	return std::pair<EntityID, size_t>(l_exportFileFullPath, l_indiceSize);
+	return l_meshData;
 }
 
 /*
@@ -1134,12 +1478,24 @@ ModelMap InnoFileSystemNS::ModelLoader::loadModelFromDisk(const std::string & fi
 	ModelMap l_result;
 
 	// check if this file has already been loaded once
-	auto l_loadedModelMap = FileSystemComponent::get().m_loadedModelMap.find(fileName);
-	if (l_loadedModelMap != FileSystemComponent::get().m_loadedModelMap.end())
+	auto l_fileNameSymbol = InnoUtility::intern(fileName);
+	ModelMap l_loadedModelMap;
+	bool l_isLoaded = false;
+	{
+		std::shared_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+		auto l_result = FileSystemComponent::get().m_loadedModelMap.find(l_fileNameSymbol);
+		if (l_result != FileSystemComponent::get().m_loadedModelMap.end())
+		{
+			l_loadedModelMap = l_result->second;
+			l_isLoaded = true;
+		}
+	}
+
+	if (l_isLoaded)
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: ModelLoader: " + fileName + " has been already loaded.");
 		// Just copy new materials
-		for (auto& i : l_loadedModelMap->second)
+		for (auto& i : l_loadedModelMap)
 		{
 			auto l_material = g_pCoreSystem->getAssetSystem()->addMaterialDataComponent();
 			*l_material = *i.second;
@@ -1148,47 +1504,35 @@ ModelMap InnoFileSystemNS::ModelLoader::loadModelFromDisk(const std::string & fi
 		return l_result;
 	}
 
-	json j;
+	std::ifstream l_file(fileName);
 
-	if (loadJsonDataFromDisk(fileName, j))
-	{
-		l_result = std::move(processSceneJsonData(j));
-		FileSystemComponent::get().m_loadedModelMap.emplace(fileName, l_result);
-	}
-	else
+	// no mesh is created before the whole file is known to be valid
+	if (!l_file.is_open() || !JsonStreamingUtilities::validate(l_file))
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: ModelLoader: can't load " + fileName + "!");
+		return ModelMap();
 	}
 
-	return l_result;
-}
-
-ModelMap InnoFileSystemNS::ModelLoader::processSceneJsonData(const json & j)
-{
-	ModelMap l_SceneResult;
+	l_file.clear();
+	l_file.seekg(0);
 
-	for (auto i : j["Nodes"])
+	// the meshes of all the nodes are loaded while parsing
+	if (!JsonStreamingUtilities::streamArrayElements(l_file, { "Nodes", "Meshes" }, [&](json& j)
 	{
-		auto l_nodeResult = std::move(processNodeJsonData(i));
-		for (auto i : l_nodeResult)
-		{
-			l_SceneResult.emplace(i);
-		}
+		l_result.emplace(processMeshJsonData(j));
+		return true;
+	}))
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: ModelLoader: can't read " + fileName + "!");
+		return ModelMap();
 	}
 
-	return l_SceneResult;
-}
-
-ModelMap InnoFileSystemNS::ModelLoader::processNodeJsonData(const json & j)
-{
-	ModelMap l_nodeResult;
-
-	for (auto i : j["Meshes"])
 	{
-		l_nodeResult.emplace(processMeshJsonData(i));
+		std::unique_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+		FileSystemComponent::get().m_loadedModelMap.emplace(l_fileNameSymbol, l_result);
 	}
 
-	return l_nodeResult;
+	return l_result;
 }
 
 ModelPair InnoFileSystemNS::ModelLoader::processMeshJsonData(const json & j)
@@ -1197,42 +1541,148 @@ ModelPair InnoFileSystemNS::ModelLoader::processMeshJsonData(const json & j)
 
 	auto l_meshFileName = j["MeshFile"].get<std::string>();
 
-	auto l_loadedModelPair = FileSystemComponent::get().m_loadedModelPair.find(l_meshFileName);
-	if (l_loadedModelPair != FileSystemComponent::get().m_loadedModelPair.end())
+	auto l_meshFileNameSymbol = InnoUtility::intern(l_meshFileName);
+	bool l_isLoaded = false;
+	{
+		std::shared_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+		auto l_loadedModelPair = FileSystemComponent::get().m_loadedModelPair.find(l_meshFileNameSymbol);
+		if (l_loadedModelPair != FileSystemComponent::get().m_loadedModelPair.end())
+		{
+			l_result = l_loadedModelPair->second;
+			l_isLoaded = true;
+		}
+	}
+
+	if (l_isLoaded)
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: ModelLoader: " + l_meshFileName + " has been already loaded.");
-		l_result = l_loadedModelPair->second;
 	}
 	else
 	{
-		std::ifstream l_meshFile(l_meshFileName, std::ios::binary);
+		auto l_meshFile = std::make_shared<MappedFile>();
 
-		if (!l_meshFile.is_open())
+		if (!l_meshFile->open(l_meshFileName))
 		{
-			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: std::ifstream: can't open file " + l_meshFileName + "!");
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: ModelLoader: can't open file " + l_meshFileName + "!");
 			return ModelPair();
 		}
 
-		auto l_MeshDC = g_pCoreSystem->getAssetSystem()->addMeshDataComponent();
+		// the files converted before the packed formats have no "VertexFormat"
+		auto l_vertexFormat = VertexFormat::UNPACKED;
+		vec4 l_positionOffset = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		float l_positionScale = 1.0f;
+
+		if (j.find("VertexFormat") != j.end())
+		{
+			l_vertexFormat = VertexFormat(j["VertexFormat"].get<int>());
+		}
+		if (l_vertexFormat == VertexFormat::QUANTIZED)
+		{
+			from_json(j["PositionOffset"], l_positionOffset);
+			l_positionScale = j["PositionScale"];
+		}
+
+		auto l_vertexStride = VertexPackingUtilities::getStride(l_vertexFormat);
 
 		size_t l_verticesNumber = j["VerticesNumber"];
 		size_t l_indicesNumber = j["IndicesNumber"];
 
-		deserializeVector(l_meshFile, 0, l_verticesNumber * sizeof(Vertex), l_MeshDC->m_vertices);
+		// validate the file size before any component references the mapping
+		auto l_requiredSize = l_verticesNumber * l_vertexStride + l_indicesNumber * sizeof(Index);
+		if (j.find("LODs") != j.end())
+		{
+			for (auto& i : j["LODs"])
+			{
+				l_requiredSize += i["VerticesNumber"].get<size_t>() * l_vertexStride + i["IndicesNumber"].get<size_t>() * sizeof(Index);
+			}
+		}
+		if (l_meshFile->getSize() < l_requiredSize)
+		{
+			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "FileSystem: ModelLoader: " + l_meshFileName + " is smaller than its description!");
+			return ModelPair();
+		}
+
+		// the packed vertices and the indices stay in the mapping and are uploaded to the GPU from there, only the legacy unpacked vertices are copied
+		auto f_loadMeshData = [&](MeshDataComponent* MDC, size_t offset, size_t verticesNumber, size_t indicesNumber)
+		{
+			auto l_vertices = l_meshFile->getData() + offset;
+			auto l_indices = l_vertices + verticesNumber * l_vertexStride;
+
+			MDC->m_vertexFormat = l_vertexFormat;
+			MDC->m_positionOffset = l_positionOffset;
+			MDC->m_positionScale = l_positionScale;
+			MDC->m_mappedFile = l_meshFile;
+
+			if (l_vertexFormat == VertexFormat::UNPACKED)
+			{
+				MDC->m_vertices.resize(verticesNumber);
+				if (verticesNumber)
+				{
+					std::memcpy((void*)MDC->m_vertices.data(), l_vertices, verticesNumber * l_vertexStride);
+				}
+			}
+			else
+			{
+				MDC->m_mappedVertices = ArrayView<unsigned char>((const unsigned char*)l_vertices, verticesNumber * l_vertexStride);
+			}
 
+			MDC->m_mappedIndices = ArrayView<Index>((const Index*)l_indices, indicesNumber);
+			MDC->m_indicesSize = indicesNumber;
+		};
 
-		deserializeVector(l_meshFile, l_verticesNumber * sizeof(Vertex), l_indicesNumber * sizeof(Index), l_MeshDC->m_indices);
+		auto l_MeshDC = g_pCoreSystem->getAssetSystem()->addMeshDataComponent();
 
-		l_meshFile.close();
+		f_loadMeshData(l_MeshDC, 0, l_verticesNumber, l_indicesNumber);
 
-		l_MeshDC->m_indicesSize = l_MeshDC->m_indices.size();
 		l_MeshDC->m_meshShapeType = MeshShapeType::CUSTOM;
 		l_MeshDC->m_objectStatus = ObjectStatus::STANDBY;
 
+		if (j.find("BoundMax") != j.end())
+		{
+			vec4 l_boundMax;
+			vec4 l_boundMin;
+			from_json(j["BoundMax"], l_boundMax);
+			from_json(j["BoundMin"], l_boundMin);
+			l_MeshDC->m_AABB.m_boundMax = l_boundMax;
+			l_MeshDC->m_AABB.m_boundMin = l_boundMin;
+			l_MeshDC->m_AABB.m_center = (l_boundMax + l_boundMin) * 0.5f;
+			l_MeshDC->m_AABB.m_extend = l_boundMax - l_boundMin;
+			from_json(j["BoundSphereCenter"], l_MeshDC->m_boundSphere.m_center);
+			l_MeshDC->m_boundSphere.m_radius = j["BoundSphereRadius"];
+			l_MeshDC->m_hasBounds = true;
+		}
+
+		if (j.find("LODs") != j.end())
+		{
+			size_t l_offset = l_verticesNumber * l_vertexStride + l_indicesNumber * sizeof(Index);
+
+			for (auto& i : j["LODs"])
+			{
+				auto l_LODMeshDC = g_pCoreSystem->getAssetSystem()->addMeshDataComponent();
+
+				size_t l_LODVerticesNumber = i["VerticesNumber"];
+				size_t l_LODIndicesNumber = i["IndicesNumber"];
+
+				f_loadMeshData(l_LODMeshDC, l_offset, l_LODVerticesNumber, l_LODIndicesNumber);
+				l_offset += l_LODVerticesNumber * l_vertexStride + l_LODIndicesNumber * sizeof(Index);
+
+				l_LODMeshDC->m_meshShapeType = MeshShapeType::CUSTOM;
+				l_LODMeshDC->m_objectStatus = ObjectStatus::STANDBY;
+
+				l_MeshDC->m_LODs.emplace_back(l_LODMeshDC);
+				l_MeshDC->m_LODErrors.emplace_back(i["Error"].get<float>());
+
+				FileSystemComponent::get().m_uninitializedMeshComponents.push(l_LODMeshDC);
+			}
+		}
+
 		l_result.first = l_MeshDC;
 		l_result.second = processMaterialJsonData(j["Material"]);
 
-		FileSystemComponent::get().m_loadedModelPair.emplace(l_meshFileName, l_result);
+		{
+			std::unique_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+			FileSystemComponent::get().m_loadedModelPair.emplace(l_meshFileNameSymbol, l_result);
+		}
 		FileSystemComponent::get().m_uninitializedMeshComponents.push(l_MeshDC);
 	}
 
@@ -1245,7 +1695,7 @@ MaterialDataComponent * InnoFileSystemNS::ModelLoader::processMaterialJsonData(c
 
 	if (j.find("Textures") != j.end())
 	{
-		for (auto i : j["Textures"])
+		for (auto& i : j["Textures"])
 		{
 			auto l_TDC = loadTexture(i["TextureFile"]);
 			l_TDC->m_textureDataDesc.textureUsageType = TextureUsageType(i["TextureUsageType"]);
@@ -1277,13 +1727,20 @@ MaterialDataComponent * InnoFileSystemNS::ModelLoader::processMaterialJsonData(c
 
 TextureDataComponent* InnoFileSystemNS::ModelLoader::loadTexture(const std::string& fileName)
 {
-	TextureDataComponent* l_TDC;
+	TextureDataComponent* l_TDC = nullptr;
+
+	{
+		std::shared_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+		auto l_loadedTDC = FileSystemComponent::get().m_loadedTexture.find(InnoUtility::intern(fileName));
+		if (l_loadedTDC != FileSystemComponent::get().m_loadedTexture.end())
+		{
+			l_TDC = l_loadedTDC->second;
+		}
+	}
 
-	auto l_loadedTDC = FileSystemComponent::get().m_loadedTexture.find(fileName);
-	if (l_loadedTDC != FileSystemComponent::get().m_loadedTexture.end())
+	if (l_TDC)
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: ModelLoader: " + fileName + " has been already loaded.");
-		l_TDC = l_loadedTDC->second;
 	}
 	else
 	{
@@ -1327,7 +1784,10 @@ TextureDataComponent* InnoFileSystemNS::ModelLoader::loadTextureFromDisk(const s
 
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "FileSystem: ModelLoader: STB_Image: " + fileName + " has been loaded.");
 
-		FileSystemComponent::get().m_loadedTexture.emplace(fileName, l_TDC);
+		{
+			std::unique_lock<RWLock> l_lock(FileSystemComponent::get().m_loadedAssetLock);
+			FileSystemComponent::get().m_loadedTexture.emplace(InnoUtility::intern(fileName), l_TDC);
+		}
 		FileSystemComponent::get().m_uninitializedTextureComponents.push(l_TDC);
 
 		return l_TDC;
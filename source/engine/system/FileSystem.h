@@ -22,6 +22,7 @@ public:
 	INNO_SYSTEM_EXPORT bool addSceneLoadingCallback(std::function<void()>* functor) override;
 
 	INNO_SYSTEM_EXPORT bool convertModel(const std::string & fileName, const std::string & exportPath) override;
+	INNO_SYSTEM_EXPORT bool convertScene(const std::string & fileName, const std::string & exportPath) override;
 
 	INNO_SYSTEM_EXPORT ModelMap loadModel(const std::string & fileName) override;
 	INNO_SYSTEM_EXPORT TextureDataComponent* loadTexture(const std::string & fileName) override;
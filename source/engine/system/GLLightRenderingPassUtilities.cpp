@@ -6,6 +6,7 @@
 #include "../component/GLGeometryRenderPassComponent.h"
 #include "../component/GLRenderingSystemComponent.h"
 #include "../component/RenderingSystemComponent.h"
+#include "LightClusteringUtilities.h"
 
 #include "ICoreSystem.h"
 
@@ -17,8 +18,12 @@ INNO_PRIVATE_SCOPE GLLightRenderingPassUtilities
 {
 	void initializeLightPassShaders();
 	void bindLightPassUniformLocations(GLShaderProgramComponent* rhs);
+	void updateLightBuffers();
 
 	EntityID m_entityID;
+
+	std::vector<vec4> m_pointLightBuffer;
+	std::vector<vec4> m_sphereLightBuffer;
 }
 
 void GLLightRenderingPassUtilities::initialize()
@@ -28,6 +33,11 @@ void GLLightRenderingPassUtilities::initialize()
 	GLLightRenderPassComponent::get().m_GLRPC = addGLRenderPassComponent(1, GLRenderingSystemComponent::get().deferredPassFBDesc, GLRenderingSystemComponent::get().deferredPassTextureDesc);
 
 	initializeLightPassShaders();
+
+	generateTBO(GL_RGBA32F, GLLightRenderPassComponent::get().m_pointLightTBO, GLLightRenderPassComponent::get().m_pointLightTBOTexture);
+	generateTBO(GL_RGBA32F, GLLightRenderPassComponent::get().m_sphereLightTBO, GLLightRenderPassComponent::get().m_sphereLightTBOTexture);
+	generateTBO(GL_RGBA32UI, GLLightRenderPassComponent::get().m_clusterGridTBO, GLLightRenderPassComponent::get().m_clusterGridTBOTexture);
+	generateTBO(GL_R32UI, GLLightRenderPassComponent::get().m_lightIndexTBO, GLLightRenderPassComponent::get().m_lightIndexTBOTexture);
 }
 
 void GLLightRenderingPassUtilities::initializeLightPassShaders()
@@ -69,31 +79,15 @@ void GLLightRenderingPassUtilities::bindLightPassUniformLocations(GLShaderProgra
 		rhs->m_program,
 		"uni_dirLight.luminance");
 
-	for (size_t i = 0; i < GLRenderingSystemComponent::get().m_maxPointLights; i++)
-	{
-		GLLightRenderPassComponent::get().m_uni_pointLights_position.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_pointLights[" + std::to_string(i) + "].position")
-		);
-		GLLightRenderPassComponent::get().m_uni_pointLights_attenuationRadius.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_pointLights[" + std::to_string(i) + "].attenuationRadius")
-		);
-		GLLightRenderPassComponent::get().m_uni_pointLights_luminance.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_pointLights[" + std::to_string(i) + "].luminance")
-		);
-	}
-
-	for (size_t i = 0; i < GLRenderingSystemComponent::get().m_maxSphereLights; i++)
-	{
-		GLLightRenderPassComponent::get().m_uni_sphereLights_position.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_sphereLights[" + std::to_string(i) + "].position")
-		);
-		GLLightRenderPassComponent::get().m_uni_sphereLights_sphereRadius.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_sphereLights[" + std::to_string(i) + "].sphereRadius")
-		);
-		GLLightRenderPassComponent::get().m_uni_sphereLights_luminance.emplace_back(
-			getUniformLocation(rhs->m_program, "uni_sphereLights[" + std::to_string(i) + "].luminance")
-		);
-	}
+	GLLightRenderPassComponent::get().m_uni_clusterView = getUniformLocation(
+		rhs->m_program,
+		"uni_clusterView");
+	GLLightRenderPassComponent::get().m_uni_clusterCount = getUniformLocation(
+		rhs->m_program,
+		"uni_clusterCount");
+	GLLightRenderPassComponent::get().m_uni_clusterDepthSlice = getUniformLocation(
+		rhs->m_program,
+		"uni_clusterDepthSlice");
 
 	GLLightRenderPassComponent::get().m_uni_isEmissive = getUniformLocation(
 		rhs->m_program,
@@ -194,39 +188,23 @@ void GLLightRenderingPassUtilities::update()
 			RenderingSystemComponent::get().m_CSMViews[j]);
 	}
 
-	for (size_t i = 0; i < GLRenderingSystemComponent::get().m_PointLightDatas.size(); i++)
-	{
-		auto l_pos = GLRenderingSystemComponent::get().m_PointLightDatas[i].pos;
-		auto l_luminance = GLRenderingSystemComponent::get().m_PointLightDatas[i].luminance;
-		auto l_attenuationRadius = GLRenderingSystemComponent::get().m_PointLightDatas[i].attenuationRadius;
-
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_pointLights_position[i],
-			l_pos.x, l_pos.y, l_pos.z);
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_pointLights_attenuationRadius[i],
-			l_attenuationRadius);
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_pointLights_luminance[i],
-			l_luminance.x, l_luminance.y, l_luminance.z);
-	}
+	// clustered point and sphere lights
+	updateLightBuffers();
 
-	for (size_t i = 0; i < GLRenderingSystemComponent::get().m_SphereLightDatas.size(); i++)
-	{
-		auto l_pos = GLRenderingSystemComponent::get().m_SphereLightDatas[i].pos;
-		auto l_luminance = GLRenderingSystemComponent::get().m_SphereLightDatas[i].luminance;
-		auto l_sphereRadius = GLRenderingSystemComponent::get().m_SphereLightDatas[i].sphereRadius;
+	activateTBO(GLLightRenderPassComponent::get().m_pointLightTBOTexture, 11);
+	activateTBO(GLLightRenderPassComponent::get().m_sphereLightTBOTexture, 12);
+	activateTBO(GLLightRenderPassComponent::get().m_clusterGridTBOTexture, 13);
+	activateTBO(GLLightRenderPassComponent::get().m_lightIndexTBOTexture, 14);
 
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_sphereLights_position[i],
-			l_pos.x, l_pos.y, l_pos.z);
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_sphereLights_sphereRadius[i],
-			l_sphereRadius);
-		updateUniform(
-			GLLightRenderPassComponent::get().m_uni_sphereLights_luminance[i],
-			l_luminance.x, l_luminance.y, l_luminance.z);
-	}
+	updateUniform(
+		GLLightRenderPassComponent::get().m_uni_clusterView,
+		RenderingSystemComponent::get().m_CamRot * RenderingSystemComponent::get().m_CamTrans);
+	updateUniform(
+		GLLightRenderPassComponent::get().m_uni_clusterCount,
+		(float)LightClusteringUtilities::m_clusterCountX, (float)LightClusteringUtilities::m_clusterCountY, (float)LightClusteringUtilities::m_clusterCountZ);
+	updateUniform(
+		GLLightRenderPassComponent::get().m_uni_clusterDepthSlice,
+		LightClusteringUtilities::getDepthSliceScale(), LightClusteringUtilities::getDepthSliceBias());
 
 	// draw light pass rectangle
 	auto l_MDC = g_pCoreSystem->getAssetSystem()->getMeshDataComponent(MeshShapeType::QUAD);
@@ -253,6 +231,41 @@ void GLLightRenderingPassUtilities::update()
 	glDisable(GL_STENCIL_TEST);
 }
 
+void GLLightRenderingPassUtilities::updateLightBuffers()
+{
+	auto& l_pointLightDatas = GLRenderingSystemComponent::get().m_PointLightDatas;
+
+	m_pointLightBuffer.resize(l_pointLightDatas.size() * 2);
+
+	for (size_t i = 0; i < l_pointLightDatas.size(); i++)
+	{
+		auto& l_pos = l_pointLightDatas[i].pos;
+		auto& l_luminance = l_pointLightDatas[i].luminance;
+		m_pointLightBuffer[i * 2] = vec4(l_pos.x, l_pos.y, l_pos.z, l_pointLightDatas[i].attenuationRadius);
+		m_pointLightBuffer[i * 2 + 1] = vec4(l_luminance.x, l_luminance.y, l_luminance.z, 0.0f);
+	}
+
+	auto& l_sphereLightDatas = GLRenderingSystemComponent::get().m_SphereLightDatas;
+
+	m_sphereLightBuffer.resize(l_sphereLightDatas.size() * 2);
+
+	for (size_t i = 0; i < l_sphereLightDatas.size(); i++)
+	{
+		auto& l_pos = l_sphereLightDatas[i].pos;
+		auto& l_luminance = l_sphereLightDatas[i].luminance;
+		m_sphereLightBuffer[i * 2] = vec4(l_pos.x, l_pos.y, l_pos.z, l_sphereLightDatas[i].sphereRadius);
+		m_sphereLightBuffer[i * 2 + 1] = vec4(l_luminance.x, l_luminance.y, l_luminance.z, 0.0f);
+	}
+
+	auto& l_clusterGrid = LightClusteringUtilities::getClusterGrid();
+	auto& l_lightIndices = LightClusteringUtilities::getLightIndices();
+
+	updateTBO(GLLightRenderPassComponent::get().m_pointLightTBO, m_pointLightBuffer.size() * sizeof(vec4), m_pointLightBuffer.data());
+	updateTBO(GLLightRenderPassComponent::get().m_sphereLightTBO, m_sphereLightBuffer.size() * sizeof(vec4), m_sphereLightBuffer.data());
+	updateTBO(GLLightRenderPassComponent::get().m_clusterGridTBO, l_clusterGrid.size() * sizeof(unsigned int), l_clusterGrid.data());
+	updateTBO(GLLightRenderPassComponent::get().m_lightIndexTBO, l_lightIndices.size() * sizeof(unsigned int), l_lightIndices.data());
+}
+
 bool GLLightRenderingPassUtilities::resize()
 {
 	resizeGLRenderPassComponent(GLLightRenderPassComponent::get().m_GLRPC, GLRenderingSystemComponent::get().deferredPassFBDesc);
@@ -7,6 +7,8 @@
 #include "GLGeometryRenderingPassUtilities.h"
 #include "GLLightRenderingPassUtilities.h"
 #include "GLFinalRenderingPassUtilities.h"
+#include "LightClusteringUtilities.h"
+#include "VertexPackingUtilities.h"
 
 #include "../component/FileSystemComponent.h"
 #include "../component/GameSystemComponent.h"
@@ -59,6 +61,14 @@ INNO_PRIVATE_SCOPE GLRenderingSystemNS
 
 	std::vector<RenderDataPack> m_renderDataPack;
 
+	std::vector<Sphere> m_pointLightBounds;
+	std::vector<Sphere> m_sphereLightBounds;
+
+	const float m_lightLuminanceThreshold = 0.03f;
+
+	// white, green, yellow, red from the full resolution to the coarsest LOD
+	const std::vector<vec4> m_LODLevelColors = { vec4(1.0f, 1.0f, 1.0f, 1.0f), vec4(0.0f, 1.0f, 0.0f, 1.0f), vec4(1.0f, 1.0f, 0.0f, 1.0f), vec4(1.0f, 0.0f, 0.0f, 1.0f) };
+
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 }
 
@@ -280,8 +290,8 @@ bool GLRenderingSystemNS::prepareGeometryPassData()
 				l_GLRenderDataPack.indiceSize = i.MDC->m_indicesSize;
 				l_GLRenderDataPack.meshPrimitiveTopology = i.MDC->m_meshPrimitiveTopology;
 				l_GLRenderDataPack.meshShapeType = i.MDC->m_meshShapeType;
-				l_GLRenderDataPack.meshUBOData.m = i.m;
-				l_GLRenderDataPack.meshUBOData.m_prev = i.m_prev;
+				l_GLRenderDataPack.meshUBOData.m = VertexPackingUtilities::foldPositionDecoding(i.m, i.MDC);
+				l_GLRenderDataPack.meshUBOData.m_prev = VertexPackingUtilities::foldPositionDecoding(i.m_prev, i.MDC);
 				l_GLRenderDataPack.GLMDC = l_GLMDC;
 
 				auto l_material = i.material;
@@ -349,6 +359,12 @@ bool GLRenderingSystemNS::prepareGeometryPassData()
 					1.0f
 				);
 
+				if (RenderingSystemComponent::get().m_drawLODLevels)
+				{
+					l_GLRenderDataPack.textureUBOData.useAlbedoTexture = false;
+					l_GLRenderDataPack.textureUBOData.albedo = m_LODLevelColors[std::min<size_t>(i.LODLevel, m_LODLevelColors.size() - 1)];
+				}
+
 				l_GLRenderDataPack.visiblilityType = i.visiblilityType;
 
 				GLRenderingSystemComponent::get().m_opaquePassDataQueue.push(l_GLRenderDataPack);
@@ -360,8 +376,8 @@ bool GLRenderingSystemNS::prepareGeometryPassData()
 				l_GLRenderDataPack.indiceSize = i.MDC->m_indicesSize;
 				l_GLRenderDataPack.meshPrimitiveTopology = i.MDC->m_meshPrimitiveTopology;
 				l_GLRenderDataPack.meshShapeType = i.MDC->m_meshShapeType;
-				l_GLRenderDataPack.meshUBOData.m = i.m;
-				l_GLRenderDataPack.meshUBOData.m_prev = i.m_prev;
+				l_GLRenderDataPack.meshUBOData.m = VertexPackingUtilities::foldPositionDecoding(i.m, i.MDC);
+				l_GLRenderDataPack.meshUBOData.m_prev = VertexPackingUtilities::foldPositionDecoding(i.m_prev, i.MDC);
 				l_GLRenderDataPack.GLMDC = l_GLMDC;
 
 				auto l_material = i.material;
@@ -404,6 +420,43 @@ bool GLRenderingSystemNS::prepareLightPassData()
 		GLRenderingSystemComponent::get().m_SphereLightDatas.emplace_back(l_SphereLightData);
 	}
 
+	// assign the lights to the clusters of the main camera
+	m_pointLightBounds.clear();
+	m_pointLightBounds.reserve(GLRenderingSystemComponent::get().m_PointLightDatas.size());
+
+	for (auto& i : GLRenderingSystemComponent::get().m_PointLightDatas)
+	{
+		Sphere l_sphere;
+		l_sphere.m_center = vec4(i.pos.x, i.pos.y, i.pos.z, 1.0f);
+		l_sphere.m_radius = i.attenuationRadius;
+		m_pointLightBounds.emplace_back(l_sphere);
+	}
+
+	m_sphereLightBounds.clear();
+	m_sphereLightBounds.reserve(GLRenderingSystemComponent::get().m_SphereLightDatas.size());
+
+	for (auto& i : GLRenderingSystemComponent::get().m_SphereLightDatas)
+	{
+		// the illuminance of a sphere light falls off as PI * luminance * (sphereRadius / distance)^2,
+		// it's out of range when that's below the eye sensitivity threshold
+		auto l_relativeLuminance = 0.2126f * i.luminance.x + 0.7152f * i.luminance.y + 0.0722f * i.luminance.z;
+
+		Sphere l_sphere;
+		l_sphere.m_center = vec4(i.pos.x, i.pos.y, i.pos.z, 1.0f);
+		l_sphere.m_radius = i.sphereRadius * std::sqrt(std::max(PI<float> * l_relativeLuminance / m_lightLuminanceThreshold, 1.0f));
+		m_sphereLightBounds.emplace_back(l_sphere);
+	}
+
+	auto l_mainCamera = GameSystemComponent::get().m_CameraComponents[0];
+
+	LightClusteringUtilities::update(
+		RenderingSystemComponent::get().m_CamRot * RenderingSystemComponent::get().m_CamTrans,
+		RenderingSystemComponent::get().m_CamProjOriginal,
+		l_mainCamera->m_zNear,
+		l_mainCamera->m_zFar,
+		m_pointLightBounds,
+		m_sphereLightBounds);
+
 	return true;
 }
 
@@ -453,7 +506,7 @@ bool GLRenderingSystemNS::prepareDebuggerPassData()
 			auto l_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(RenderingSystemComponent::get().m_selectedVisibleComponent->m_parentEntity);
 			auto l_globalTm = l_transformComponent->m_globalTransformMatrix.m_transformationMat;
 
-			l_GLRenderDataPack.m = l_globalTm;
+			l_GLRenderDataPack.m = VertexPackingUtilities::foldPositionDecoding(l_globalTm, i.first);
 			l_GLRenderDataPack.GLMDC = getGLMeshDataComponent(i.first->m_parentEntity);
 			l_GLRenderDataPack.indiceSize = i.first->m_indicesSize;
 			l_GLRenderDataPack.meshPrimitiveTopology = i.first->m_meshPrimitiveTopology;
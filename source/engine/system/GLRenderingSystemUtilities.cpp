@@ -1,4 +1,5 @@
 #include "GLRenderingSystemUtilities.h"
+#include "VertexPackingUtilities.h"
 
 #include "ICoreSystem.h"
 
@@ -13,11 +14,11 @@ INNO_PRIVATE_SCOPE GLRenderingSystemNS
 	GLenum getTexturePixelDataFormat(TexturePixelDataFormat rhs);
 	GLenum getTexturePixelDataType(TexturePixelDataType rhs);
 
-	std::unordered_map<EntityID, GLMeshDataComponent*> m_initializedGLMDC;
+	FlatHashMap<EntityID, GLMeshDataComponent*> m_initializedGLMDC;
 	std::unordered_map<EntityID, GLTextureDataComponent*> m_initializedGLTDC;
 
-	std::unordered_map<EntityID, GLMeshDataComponent*> m_meshMap;
-	std::unordered_map<EntityID, GLTextureDataComponent*> m_textureMap;
+	FlatHashMap<EntityID, GLMeshDataComponent*> m_meshMap;
+	FlatHashMap<EntityID, GLTextureDataComponent*> m_textureMap;
 
 	const std::string m_shaderRelativePath = std::string{ "..//res//shaders//" };
 }
@@ -261,7 +262,7 @@ GLMeshDataComponent* GLRenderingSystemNS::generateGLMeshDataComponent(MeshDataCo
 	{
 		auto l_ptr = addGLMeshDataComponent(rhs->m_parentEntity);
 
-		initializeGLMeshDataComponent(l_ptr, rhs->m_vertices, rhs->m_indices);
+		initializeGLMeshDataComponent(l_ptr, rhs);
 
 		rhs->m_objectStatus = ObjectStatus::ALIVE;
 
@@ -409,23 +410,22 @@ bool GLRenderingSystemNS::initializeGLShaderProgramComponent(GLShaderProgramComp
 	return rhs;
 }
 
-bool GLRenderingSystemNS::initializeGLMeshDataComponent(GLMeshDataComponent * rhs, const std::vector<Vertex>& vertices, const std::vector<Index>& indices)
+bool GLRenderingSystemNS::initializeGLMeshDataComponent(GLMeshDataComponent * rhs, const MeshDataComponent* MDC)
 {
-	std::vector<float> l_verticesBuffer;
-	auto l_containerSize = vertices.size() * 8;
-	l_verticesBuffer.reserve(l_containerSize);
+	// the generated shapes are packed here, the converted meshes are uploaded as they were loaded
+	auto l_vertexFormat = MDC->m_vertexFormat;
+	auto l_verticesBuffer = MDC->getPackedVertices();
+	std::vector<unsigned char> l_packedVertices;
 
-	std::for_each(vertices.begin(), vertices.end(), [&](Vertex val)
+	if (l_vertexFormat == VertexFormat::UNPACKED)
 	{
-		l_verticesBuffer.emplace_back((float)val.m_pos.x);
-		l_verticesBuffer.emplace_back((float)val.m_pos.y);
-		l_verticesBuffer.emplace_back((float)val.m_pos.z);
-		l_verticesBuffer.emplace_back((float)val.m_texCoord.x);
-		l_verticesBuffer.emplace_back((float)val.m_texCoord.y);
-		l_verticesBuffer.emplace_back((float)val.m_normal.x);
-		l_verticesBuffer.emplace_back((float)val.m_normal.y);
-		l_verticesBuffer.emplace_back((float)val.m_normal.z);
-	});
+		l_vertexFormat = VertexFormat::FLOAT3;
+		VertexPackingUtilities::pack(MDC->m_vertices, l_vertexFormat, vec4(0.0f, 0.0f, 0.0f, 1.0f), 1.0f, l_packedVertices);
+		l_verticesBuffer = l_packedVertices;
+	}
+
+	auto l_stride = (GLsizei)VertexPackingUtilities::getStride(l_vertexFormat);
+	auto l_indices = MDC->getIndices();
 
 	glGenVertexArrays(1, &rhs->m_VAO);
 	glGenBuffers(1, &rhs->m_VBO);
@@ -434,22 +434,39 @@ bool GLRenderingSystemNS::initializeGLMeshDataComponent(GLMeshDataComponent * rh
 	glBindVertexArray(rhs->m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, rhs->m_VBO);
-	glBufferData(GL_ARRAY_BUFFER, l_verticesBuffer.size() * sizeof(float), &l_verticesBuffer[0], GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, l_verticesBuffer.size(), l_verticesBuffer.data(), GL_STATIC_DRAW);
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rhs->m_IBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, l_indices.size() * sizeof(unsigned int), l_indices.data(), GL_STATIC_DRAW);
+
+	// glBufferData has copied the mapped data, the pages are read again from the file if the CPU side needs them later
+	if (MDC->m_mappedFile)
+	{
+		MDC->m_mappedFile->releasePages(l_verticesBuffer.data(), l_verticesBuffer.size());
+		MDC->m_mappedFile->releasePages(l_indices.data(), l_indices.size() * sizeof(Index));
+	}
 
-	// position attribute, 1st attribution with 3 * sizeof(float) bits of data
+	// position attribute, UNORM16 in the quantization bounds which are folded into the model matrix, or 3 floats
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+	size_t l_texCoordOffset;
+	if (l_vertexFormat == VertexFormat::QUANTIZED)
+	{
+		glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, l_stride, (void*)offsetof(QuantizedVertex, m_pos));
+		l_texCoordOffset = offsetof(QuantizedVertex, m_texCoord);
+	}
+	else
+	{
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, l_stride, (void*)offsetof(Float3Vertex, m_pos));
+		l_texCoordOffset = offsetof(Float3Vertex, m_texCoord);
+	}
 
-	// texture attribute, 2nd attribution with 2 * sizeof(float) bits of data
+	// texture attribute, 2 half floats
 	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+	glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, l_stride, (void*)l_texCoordOffset);
 
-	// normal coord attribute, 3rd attribution with 3 * sizeof(float) bits of data
+	// normal attribute, 2 SNORM16 of the octahedral encoding, decoded in the vertex shaders
 	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(5 * sizeof(float)));
+	glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, l_stride, (void*)(l_texCoordOffset + 2 * sizeof(unsigned short)));
 
 	rhs->m_objectStatus = ObjectStatus::ALIVE;
 
@@ -743,6 +760,33 @@ void GLRenderingSystemNS::updateUBOImpl(const GLint & UBO, size_t size, const vo
 	//glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
+void GLRenderingSystemNS::generateTBO(GLenum internalFormat, GLuint& TBO, GLuint& TBOTexture)
+{
+	glGenBuffers(1, &TBO);
+	glBindBuffer(GL_TEXTURE_BUFFER, TBO);
+	glBufferData(GL_TEXTURE_BUFFER, 0, NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	glGenTextures(1, &TBOTexture);
+	glBindTexture(GL_TEXTURE_BUFFER, TBOTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, TBO);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+void GLRenderingSystemNS::updateTBO(GLuint TBO, size_t size, const void * TBOValue)
+{
+	// orphan the old storage, an empty buffer object can't be sampled so keep at least one element
+	glBindBuffer(GL_TEXTURE_BUFFER, TBO);
+	glBufferData(GL_TEXTURE_BUFFER, size ? size : 16, size ? TBOValue : NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void GLRenderingSystemNS::activateTBO(GLuint TBOTexture, int activateIndex)
+{
+	glActiveTexture(GL_TEXTURE0 + activateIndex);
+	glBindTexture(GL_TEXTURE_BUFFER, TBOTexture);
+}
+
 void GLRenderingSystemNS::updateUniform(const GLint uniformLocation, bool uniformValue)
 {
 	glUniform1i(uniformLocation, (int)uniformValue);
@@ -21,7 +21,7 @@ INNO_PRIVATE_SCOPE GLRenderingSystemNS
 	GLTextureDataComponent* generateGLTextureDataComponent(TextureDataComponent* rhs);
 
 	bool initializeGLShaderProgramComponent(GLShaderProgramComponent* rhs, const ShaderFilePaths& shaderFilePaths);
-	bool initializeGLMeshDataComponent(GLMeshDataComponent * rhs, const std::vector<Vertex>& vertices, const std::vector<Index>& indices);
+	bool initializeGLMeshDataComponent(GLMeshDataComponent * rhs, const MeshDataComponent* MDC);
 	bool initializeGLTextureDataComponent(GLTextureDataComponent * rhs, TextureDataDesc textureDataDesc, const std::vector<void*>& textureData);
 	GLTextureDataDesc getGLTextureDataDesc(const TextureDataDesc& textureDataDesc);
 
@@ -49,6 +49,10 @@ INNO_PRIVATE_SCOPE GLRenderingSystemNS
 		updateUBOImpl(UBO, sizeof(T), &UBOValue);
 	}
 
+	void generateTBO(GLenum internalFormat, GLuint& TBO, GLuint& TBOTexture);
+	void updateTBO(GLuint TBO, size_t size, const void* TBOValue);
+	void activateTBO(GLuint TBOTexture, int activateIndex);
+
 	void updateUniform(const GLint uniformLocation, bool uniformValue);
 	void updateUniform(const GLint uniformLocation, int uniformValue);
 	void updateUniform(const GLint uniformLocation, float uniformValue);
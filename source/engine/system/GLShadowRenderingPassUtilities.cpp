@@ -1,5 +1,6 @@
 #include "GLRenderingSystemUtilities.h"
 #include "GLShadowRenderingPassUtilities.h"
+#include "VertexPackingUtilities.h"
 #include "../component/GLShadowRenderPassComponent.h"
 #include "../component/GameSystemComponent.h"
 #include "../component/RenderingSystemComponent.h"
@@ -19,7 +20,9 @@ INNO_PRIVATE_SCOPE GLShadowRenderingPassUtilities
 
 	EntityID m_entityID;
 
-	void drawAllMeshDataComponents();
+	std::vector<std::vector<RenderDataPack>> m_shadowRenderDataPack;
+
+	void drawAllMeshDataComponents(size_t cascadeIndex);
 }
 
 void GLShadowRenderingPassUtilities::initialize()
@@ -81,28 +84,20 @@ void GLShadowRenderingPassUtilities::initialize()
 	GLShadowRenderPassComponent::get().m_SPC = rhs;
 }
 
-void GLShadowRenderingPassUtilities::drawAllMeshDataComponents()
+void GLShadowRenderingPassUtilities::drawAllMeshDataComponents(size_t cascadeIndex)
 {
-	for (auto& l_visibleComponent : GameSystemComponent::get().m_VisibleComponents)
+	if (cascadeIndex >= m_shadowRenderDataPack.size())
 	{
-		if (l_visibleComponent->m_visiblilityType == VisiblilityType::INNO_OPAQUE)
-		{
-			updateUniform(
-				GLShadowRenderPassComponent::get().m_shadowPass_uni_m,
-				g_pCoreSystem->getGameSystem()->get<TransformComponent>(l_visibleComponent->m_parentEntity)->m_globalTransformMatrix.m_transformationMat);
-
-			// draw each graphic data of visibleComponent
-			for (auto& l_modelPair : l_visibleComponent->m_modelMap)
-			{
-				// draw meshes
-				auto l_MDC = l_modelPair.first;
-				if (l_MDC)
-				{
-					// draw meshes
-					drawMesh(l_MDC);
-				}
-			}
-		}
+		return;
+	}
+
+	for (auto& i : m_shadowRenderDataPack[cascadeIndex])
+	{
+		updateUniform(
+			GLShadowRenderPassComponent::get().m_shadowPass_uni_m,
+			VertexPackingUtilities::foldPositionDecoding(i.m, i.MDC));
+
+		drawMesh(i.MDC);
 	}
 }
 
@@ -117,6 +112,11 @@ void GLShadowRenderingPassUtilities::update()
 
 	activateShaderProgram(GLShadowRenderPassComponent::get().m_SPC);
 
+	if (RenderingSystemComponent::get().m_isRenderDataPackValid)
+	{
+		m_shadowRenderDataPack = RenderingSystemComponent::get().m_shadowRenderDataPack.getRawData();
+	}
+
 	auto l_GLFBC = GLShadowRenderPassComponent::get().m_DirLight_GLRPC->m_GLFBC;
 	auto sizeX = l_GLFBC->m_GLFrameBufferDesc.sizeX;
 	auto sizeY = l_GLFBC->m_GLFrameBufferDesc.sizeY;
@@ -139,9 +139,9 @@ void GLShadowRenderingPassUtilities::update()
 				GLShadowRenderPassComponent::get().m_shadowPass_uni_v,
 				RenderingSystemComponent::get().m_CSMViews[splitCount]);
 
-			splitCount++;
+			drawAllMeshDataComponents(splitCount);
 
-			drawAllMeshDataComponents();
+			splitCount++;
 		}
 	}
 
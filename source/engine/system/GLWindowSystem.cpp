@@ -99,45 +99,17 @@ INNO_SYSTEM_EXPORT bool GLWindowSystem::update()
 		glfwPollEvents();
 
 		//update input
-		//keyboard
-		for (int i = 0; i < GLWindowSystemNS::g_WindowSystemComponent->NUM_KEYCODES; i++)
+		//keyboard, codes below INNO_KEY_SPACE are shared with the mouse buttons
+		for (int i = INNO_KEY_SPACE; i < GLWindowSystemNS::g_WindowSystemComponent->NUM_KEYCODES; i++)
 		{
-			if (glfwGetKey(GLWindowSystemNS::g_GLWindowSystemComponent->m_window, i) == GLFW_PRESS)
-			{
-				auto l_result = GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::PRESSED;
-				}
-			}
-			else
-			{
-				auto l_result = GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::RELEASED;
-				}
-			}
+			auto l_buttonStatus = glfwGetKey(GLWindowSystemNS::g_GLWindowSystemComponent->m_window, i) == GLFW_PRESS ? ButtonStatus::PRESSED : ButtonStatus::RELEASED;
+			GLWindowSystemNS::m_inputSystem->buttonStatusCallback(i, l_buttonStatus);
 		}
 		//mouse
 		for (int i = 0; i < GLWindowSystemNS::g_WindowSystemComponent->NUM_MOUSEBUTTONS; i++)
 		{
-			if (glfwGetMouseButton(GLWindowSystemNS::g_GLWindowSystemComponent->m_window, i) == GLFW_PRESS)
-			{
-				auto l_result = GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::PRESSED;
-				}
-			}
-			else
-			{
-				auto l_result = GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != GLWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::RELEASED;
-				}
-			}
+			auto l_buttonStatus = glfwGetMouseButton(GLWindowSystemNS::g_GLWindowSystemComponent->m_window, i) == GLFW_PRESS ? ButtonStatus::PRESSED : ButtonStatus::RELEASED;
+			GLWindowSystemNS::m_inputSystem->buttonStatusCallback(i, l_buttonStatus);
 		}
 	}
 
@@ -26,13 +26,8 @@ INNO_PRIVATE_SCOPE InnoGameSystemNS
 
 std::string InnoGameSystemNS::getEntityName(const EntityID& entityID)
 {
-	auto result = std::find_if(
-		GameSystemComponent::get().m_enitityNameMap.begin(),
-		GameSystemComponent::get().m_enitityNameMap.end(),
-		[&](auto& val)-> bool {
-		return val.first == entityID;
-	}
-	);
+	std::shared_lock<RWLock> l_lock(GameSystemComponent::get().m_enitityNameLock);
+	auto result = GameSystemComponent::get().m_enitityNameMap.find(entityID);
 
 	if (result == GameSystemComponent::get().m_enitityNameMap.end())
 	{
@@ -45,21 +40,17 @@ std::string InnoGameSystemNS::getEntityName(const EntityID& entityID)
 
 EntityID InnoGameSystemNS::getEntityID(const std::string& entityName)
 {
-	auto result = std::find_if(
-		GameSystemComponent::get().m_enitityNameMap.begin(),
-		GameSystemComponent::get().m_enitityNameMap.end(),
-		[&](auto& val)-> bool {
-		return val.second == entityName;
-	}
-	);
+	std::shared_lock<RWLock> l_lock(GameSystemComponent::get().m_enitityNameLock);
+	auto l_entityNameSymbol = InnoStringTable::get().find(entityName);
+	auto result = GameSystemComponent::get().m_enitityNameSymbolMap.find(l_entityNameSymbol);
 
-	if (result == GameSystemComponent::get().m_enitityNameMap.end())
+	if (l_entityNameSymbol == InnoStringTable::INVALID_SYMBOL || result == GameSystemComponent::get().m_enitityNameSymbolMap.end())
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "GameSystem: can't find entity ID by name " + entityName + " !");
 		return "AbnormalEntityID";
 	}
 
-	return result->first;
+	return result->second;
 }
 
 bool InnoGameSystemNS::setup()
@@ -141,14 +132,10 @@ INNO_SYSTEM_EXPORT void InnoGameSystem::setGameInstance(IGameInstance * rhs)
 
 EntityID InnoGameSystemNS::createEntity(const std::string & entityName)
 {
-	auto result = std::find_if(
-		GameSystemComponent::get().m_enitityNameMap.begin(),
-		GameSystemComponent::get().m_enitityNameMap.end(),
-		[&](auto& val) -> bool {
-		return val.second == entityName;
-	});
+	auto l_entityNameSymbol = InnoUtility::intern(entityName);
 
-	if (result != GameSystemComponent::get().m_enitityNameMap.end())
+	std::unique_lock<RWLock> l_lock(GameSystemComponent::get().m_enitityNameLock);
+	if (GameSystemComponent::get().m_enitityNameSymbolMap.find(l_entityNameSymbol) != GameSystemComponent::get().m_enitityNameSymbolMap.end())
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "GameSystem: duplicated entity name " + entityName + " !");
 		return 0;
@@ -156,6 +143,7 @@ EntityID InnoGameSystemNS::createEntity(const std::string & entityName)
 
 	auto l_entityID = InnoMath::createEntityID();
 	GameSystemComponent::get().m_enitityNameMap.emplace(l_entityID, entityName);
+	GameSystemComponent::get().m_enitityNameSymbolMap.emplace(l_entityNameSymbol, l_entityID);
 	return l_entityID;
 }
 
@@ -166,14 +154,16 @@ INNO_SYSTEM_EXPORT EntityID InnoGameSystem::createEntity(const std::string & ent
 
 INNO_SYSTEM_EXPORT bool InnoGameSystem::removeEntity(const std::string & entityName)
 {
-	for (auto i : GameSystemComponent::get().m_enitityNameMap)
+	std::unique_lock<RWLock> l_lock(GameSystemComponent::get().m_enitityNameLock);
+	auto l_entityNameSymbol = InnoStringTable::get().find(entityName);
+	auto result = GameSystemComponent::get().m_enitityNameSymbolMap.find(l_entityNameSymbol);
+
+	if (l_entityNameSymbol != InnoStringTable::INVALID_SYMBOL && result != GameSystemComponent::get().m_enitityNameSymbolMap.end())
 	{
-		if (i.second == entityName)
-		{
-			GameSystemComponent::get().m_enitityNameMap.erase(i.first);
-			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "GameSystem: entity " + entityName + " has been removed.");
-			return true;
-		}
+		GameSystemComponent::get().m_enitityNameMap.erase(result->second);
+		GameSystemComponent::get().m_enitityNameSymbolMap.erase(result);
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "GameSystem: entity " + entityName + " has been removed.");
+		return true;
 	}
 
 	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "GameSystem: can't remove entity " + entityName + " !");
@@ -222,6 +212,10 @@ INNO_SYSTEM_EXPORT bool InnoGameSystem::update()
 
 INNO_SYSTEM_EXPORT bool InnoGameSystem::terminate()
 {
+	auto l_readerContention = GameSystemComponent::get().m_componentRegistryLock.getReaderContentionData();
+	auto l_writerContention = GameSystemComponent::get().m_componentRegistryLock.getWriterContentionData();
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "GameSystem: component registry lock: " + std::to_string(l_readerContention.contendedCount) + "/" + std::to_string(l_readerContention.acquireCount) + " contended reads, " + std::to_string(l_writerContention.contendedCount) + "/" + std::to_string(l_writerContention.acquireCount) + " contended writes.");
+
 	if (!InnoGameSystemNS::m_gameInstance->terminate())
 	{
 		return false;
@@ -237,25 +231,24 @@ INNO_SYSTEM_EXPORT bool InnoGameSystem::terminate()
 #define registerComponentImplDefi( className ) \
 INNO_SYSTEM_EXPORT void InnoGameSystem::registerComponent(className* rhs, const EntityID& parentEntity) \
 { \
+	std::unique_lock<RWLock> l_lock(GameSystemComponent::get().m_componentRegistryLock); \
 	rhs->m_parentEntity = parentEntity; \
 	GameSystemComponent::get().m_##className##s.emplace_back(rhs); \
 	GameSystemComponent::get().m_##className##sMap.emplace(parentEntity, rhs); \
 \
-	auto indexOfTheComponent = GameSystemComponent::get().m_##className##s.size(); \
-	auto l_componentName = std::string(#className) + "_" + std::to_string(indexOfTheComponent); \
-	auto l_componentType = InnoUtility::getComponentType<className>(); \
-	auto l_componentMetaDataPair = componentMetadataPair(l_componentType, l_componentName); \
+	static const auto l_className = InnoUtility::intern(#className); \
+	auto l_componentMetadata = componentMetadata{ InnoUtility::getComponentType<className>(), l_className, (unsigned int)GameSystemComponent::get().m_##className##s.size() }; \
 \
 	auto result = GameSystemComponent::get().m_enitityChildrenComponentsMetadataMap.find(parentEntity); \
 	if (result != GameSystemComponent::get().m_enitityChildrenComponentsMetadataMap.end()) \
 	{ \
 		auto l_componentMetadataMap = &result->second; \
-		l_componentMetadataMap->emplace(rhs, l_componentMetaDataPair); \
+		l_componentMetadataMap->emplace(rhs, l_componentMetadata); \
 	} \
 	else \
 	{ \
 		auto l_componentMetadataMap = componentMetadataMap(); \
-		l_componentMetadataMap.emplace(rhs, l_componentMetaDataPair); \
+		l_componentMetadataMap.emplace(rhs, l_componentMetadata); \
 		GameSystemComponent::get().m_enitityChildrenComponentsMetadataMap.emplace(parentEntity, std::move(l_componentMetadataMap)); \
 	} \
 }
@@ -278,6 +271,7 @@ INNO_SYSTEM_EXPORT std::string InnoGameSystem::getGameName()
 #define getComponentImplDefi( className ) \
 INNO_SYSTEM_EXPORT className* InnoGameSystem::get##className(const EntityID& parentEntity) \
 { \
+	std::shared_lock<RWLock> l_lock(GameSystemComponent::get().m_componentRegistryLock); \
 	auto result = GameSystemComponent::get().m_##className##sMap.find(parentEntity); \
 	if (result != GameSystemComponent::get().m_##className##sMap.end()) \
 	{ \
@@ -330,6 +324,11 @@ INNO_SYSTEM_EXPORT void InnoGameSystem::registerMouseMovementCallback(InputCompo
 	}
 }
 
+INNO_SYSTEM_EXPORT void InnoGameSystem::registerInputEventCallback(InputComponent * inputComponent, InputEventCallback * function)
+{
+	inputComponent->m_inputEventCallbackImpl.emplace_back(function);
+}
+
 INNO_SYSTEM_EXPORT ObjectStatus InnoGameSystem::getStatus()
 {
 	return InnoGameSystemNS::m_objectStatus;
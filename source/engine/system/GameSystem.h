@@ -43,6 +43,7 @@ public:
 
 	INNO_SYSTEM_EXPORT void registerButtonStatusCallback(InputComponent* inputComponent, ButtonData boundButton, std::function<void()>* function) override;
 	INNO_SYSTEM_EXPORT void registerMouseMovementCallback(InputComponent* inputComponent, int mouseCode, std::function<void(float)>* function) override;
+	INNO_SYSTEM_EXPORT void registerInputEventCallback(InputComponent* inputComponent, InputEventCallback* function) override;
 
 	INNO_SYSTEM_EXPORT void saveComponentsCapture() override;
 	INNO_SYSTEM_EXPORT void setGameInstance(IGameInstance* rhs) override;
@@ -19,12 +19,15 @@ public:
 	INNO_SYSTEM_EXPORT virtual std::string loadTextFile(const std::string& fileName) = 0;
 
 	INNO_SYSTEM_EXPORT virtual bool loadDefaultScene() = 0;
+	// the scenes with the .InnoBinaryScene extension are loaded and saved in the binary format, the others in JSON
 	INNO_SYSTEM_EXPORT virtual bool loadScene(const std::string& fileName) = 0;
 	INNO_SYSTEM_EXPORT virtual bool saveScene(const std::string& fileName) = 0;
 
 	INNO_SYSTEM_EXPORT virtual bool addSceneLoadingCallback(std::function<void()>* functor) = 0;
 
 	INNO_SYSTEM_EXPORT virtual bool convertModel(const std::string & fileName, const std::string & exportPath) = 0;
+	// between .InnoScene and .InnoBinaryScene by the extension of the source file, the result is written to exportPath with the same file name
+	INNO_SYSTEM_EXPORT virtual bool convertScene(const std::string & fileName, const std::string & exportPath) = 0;
 
 	INNO_SYSTEM_EXPORT virtual ModelMap loadModel(const std::string & fileName) = 0;
 	INNO_SYSTEM_EXPORT virtual TextureDataComponent* loadTexture(const std::string & fileName) = 0;
@@ -78,6 +78,7 @@ public:
 
 	INNO_SYSTEM_EXPORT virtual void registerButtonStatusCallback(InputComponent* inputComponent, ButtonData boundButton, std::function<void()>* function) = 0;
 	INNO_SYSTEM_EXPORT virtual void registerMouseMovementCallback(InputComponent* inputComponent, int mouseCode, std::function<void(float)>* function) = 0;
+	INNO_SYSTEM_EXPORT virtual void registerInputEventCallback(InputComponent* inputComponent, InputEventCallback* function) = 0;
 
 	INNO_SYSTEM_EXPORT virtual void saveComponentsCapture() = 0;
 
@@ -19,7 +19,9 @@ public:
 	INNO_SYSTEM_EXPORT virtual void addMouseMovementCallback(int mouseCode, std::function<void(float)>* mouseMovementCallback) = 0;
 	INNO_SYSTEM_EXPORT virtual void addMouseMovementCallback(int mouseCode, std::vector<std::function<void(float)>*>& mouseMovementCallback) = 0;
 	INNO_SYSTEM_EXPORT virtual void addMouseMovementCallback(MouseMovementCallbackMap& mouseMovementCallback) = 0;
+	INNO_SYSTEM_EXPORT virtual void addInputEventCallback(InputEventCallback* inputEventCallback) = 0;
 
+	INNO_SYSTEM_EXPORT virtual void buttonStatusCallback(int code, ButtonStatus buttonStatus) = 0;
 	INNO_SYSTEM_EXPORT virtual void framebufferSizeCallback(int width, int height) = 0;
 	INNO_SYSTEM_EXPORT virtual void mousePositionCallback(float mouseXPos, float mouseYPos) = 0;
 	INNO_SYSTEM_EXPORT virtual void scrollCallback(float xoffset, float yoffset) = 0;
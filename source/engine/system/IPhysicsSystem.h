@@ -17,4 +17,11 @@ public:
 	INNO_SYSTEM_EXPORT virtual ObjectStatus getStatus() = 0;
 
 	INNO_SYSTEM_EXPORT virtual void generatePhysicsData(VisibleComponent* visibleComponent) = 0;
+	INNO_SYSTEM_EXPORT virtual void clearPhysicsProxies() = 0;
+
+	INNO_SYSTEM_EXPORT virtual void queryFrustum(const Frustum& frustum, std::vector<PhysicsProxy>& result) = 0;
+	INNO_SYSTEM_EXPORT virtual void queryOverlap(const AABB& bound, std::vector<PhysicsProxy>& result) = 0;
+	INNO_SYSTEM_EXPORT virtual void queryOverlap(const Sphere& sphere, std::vector<PhysicsProxy>& result) = 0;
+	INNO_SYSTEM_EXPORT virtual bool rayCastClosest(const Ray& ray, PhysicsProxy& result, float& distance) = 0;
+	INNO_SYSTEM_EXPORT virtual bool rayCastAny(const Ray& ray, float maxDistance) = 0;
 };
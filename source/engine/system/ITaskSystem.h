@@ -22,6 +22,8 @@ public:
 
 	INNO_SYSTEM_EXPORT virtual void waitAllTasksToFinish() = 0;
 
+	INNO_SYSTEM_EXPORT virtual size_t getThreadCount() = 0;
+
 	template <typename Func, typename... Args>
 	auto submit(Func&& func, Args&&... args)
 	{
@@ -35,4 +37,44 @@ public:
 		addTask(std::make_unique<TaskType>(std::move(task)));
 		return result;
 	}
+
+	// run job(i) for i in [0, jobCount) and wait for all of them, the calling thread takes jobs too
+	// the helper tasks might be queued behind long tasks like model loading, so the calling thread never waits for them to start
+	// a helper task which starts late finds no job left and returns, its future is stored into helperTasks
+	template <typename Job>
+	void dispatch(size_t jobCount, Job&& job, std::vector<InnoFuture<void>>& helperTasks)
+	{
+		struct JobCounter
+		{
+			std::atomic<size_t> m_next = 0;
+			std::atomic<size_t> m_finished = 0;
+		};
+
+		// outlives this function if a helper task starts late
+		auto l_counter = std::make_shared<JobCounter>();
+
+		auto l_runJobs = [l_counter, jobCount, l_job = &job]()
+		{
+			size_t i;
+			while ((i = l_counter->m_next++) < jobCount)
+			{
+				(*l_job)(i);
+				l_counter->m_finished++;
+			}
+		};
+
+		auto l_helperCount = std::min(jobCount - std::min<size_t>(jobCount, 1), getThreadCount());
+
+		for (size_t i = 0; i < l_helperCount; i++)
+		{
+			helperTasks.emplace_back(submit(l_runJobs));
+		}
+
+		l_runJobs();
+
+		while (l_counter->m_finished < jobCount)
+		{
+			std::this_thread::yield();
+		}
+	}
 };
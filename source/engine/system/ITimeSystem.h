@@ -15,6 +15,11 @@ public:
 
 	INNO_SYSTEM_EXPORT virtual ObjectStatus getStatus() = 0;
 
+	// in nanoseconds, measured from the start of the previous frame
 	INNO_SYSTEM_EXPORT virtual const long long getDeltaTime() = 0;
 	INNO_SYSTEM_EXPORT virtual const TimeData getCurrentTime(unsigned int timezone_adjustment = 8) = 0;
+	INNO_SYSTEM_EXPORT virtual long long getCurrentTimeInNanoSec() = 0;
+	// 0 means uncapped
+	INNO_SYSTEM_EXPORT virtual void setTargetFrameRate(double frameRate) = 0;
+	INNO_SYSTEM_EXPORT virtual const FrameTimeStatistics getFrameTimeStatistics() = 0;
 };
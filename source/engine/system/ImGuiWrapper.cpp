@@ -149,6 +149,13 @@ void ImGuiWrapperNS::showApplicationProfiler()
 
 	ImGui::Begin("Profiler", 0, ImGuiWindowFlags_AlwaysAutoResize);
 	ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	ImGui::Text("Culling: %u candidates, %u culled by BVH, %u culled by sphere", PhysicsSystemComponent::get().m_cullingCandidateCount.load(), PhysicsSystemComponent::get().m_BVHCulledCount.load(), PhysicsSystemComponent::get().m_sphereCulledCount.load());
+	auto l_occlusionTestedCount = PhysicsSystemComponent::get().m_occlusionTestedCount.load();
+	auto l_occlusionCulledCount = PhysicsSystemComponent::get().m_occlusionCulledCount.load();
+	ImGui::Text("Occlusion: %u occluders, %u tested, %u culled (%.1f%%)", PhysicsSystemComponent::get().m_occluderCount.load(), l_occlusionTestedCount, l_occlusionCulledCount, l_occlusionTestedCount ? 100.0f * l_occlusionCulledCount / l_occlusionTestedCount : 0.0f);
+	ImGui::Text("Shadow casters: %u", PhysicsSystemComponent::get().m_shadowCasterCount.load());
+	ImGui::Text("LOD: %u / %u / %u / %u+ meshes, %u triangles saved", PhysicsSystemComponent::get().m_LODLevelCounts[0].load(), PhysicsSystemComponent::get().m_LODLevelCounts[1].load(), PhysicsSystemComponent::get().m_LODLevelCounts[2].load(), PhysicsSystemComponent::get().m_LODLevelCounts[3].load(), PhysicsSystemComponent::get().m_LODSavedTriangleCount.load());
+	ImGui::Text("Rigid bodies: %u, %u awake in %u islands, %u contacts", PhysicsSystemComponent::get().m_rigidBodyCount.load(), PhysicsSystemComponent::get().m_awakeRigidBodyCount.load(), PhysicsSystemComponent::get().m_rigidBodyIslandCount.load(), PhysicsSystemComponent::get().m_rigidBodyContactCount.load());
 	if (ImGui::Checkbox("Use TAA", &l_renderingConfig.useTAA))
 	{
 		RenderingSystemComponent::get().m_useTAA = l_renderingConfig.useTAA;
@@ -169,6 +176,14 @@ void ImGuiWrapperNS::showApplicationProfiler()
 	{
 		RenderingSystemComponent::get().m_drawOverlapWireframe = l_renderingConfig.drawDebugObject;
 	}
+	if (ImGui::Checkbox("Draw LOD levels", &l_renderingConfig.drawLODLevels))
+	{
+		RenderingSystemComponent::get().m_drawLODLevels = l_renderingConfig.drawLODLevels;
+	}
+	if (ImGui::SliderFloat("LOD error budget (pixels)", &l_renderingConfig.LODErrorBudget, 0.1f, 16.0f))
+	{
+		PhysicsSystemComponent::get().m_LODErrorBudget = l_renderingConfig.LODErrorBudget;
+	}
 	if (ImGui::Checkbox("Pause game update", &l_gameConfig.pauseGameUpdate))
 	{
 		GameSystemComponent::get().m_pauseGameUpdate = l_gameConfig.pauseGameUpdate;
@@ -300,7 +315,7 @@ void ImGuiWrapperNS::showFileExplorer()
 						l_fileFullPath = i.fullPath;
 						l_AssetConvertPopMenuOpened = true;
 					}
-					else if (i.extension == ".InnoScene")
+					else if (i.extension == ".InnoScene" || i.extension == ".InnoBinaryScene")
 					{
 						l_fileFullPath = i.fullPath;
 						l_SceneLoadingPopMenuOpened = true;
@@ -372,6 +387,12 @@ void ImGuiWrapperNS::showSceneLoadingPopWindow(bool &l_popMenuOpened, std::strin
 			ImGui::CloseCurrentPopup();
 		}
 		ImGui::SameLine();
+		if (ImGui::Button("Convert", ImVec2(120, 0))) {
+			l_popMenuOpened = false;
+			g_pCoreSystem->getFileSystem()->convertScene(l_fileFullPath, std::filesystem::path(l_fileFullPath).parent_path().generic_string() + "//");
+			ImGui::CloseCurrentPopup();
+		}
+		ImGui::SameLine();
 		if (ImGui::Button("Cancel", ImVec2(120, 0))) {
 			l_popMenuOpened = false;
 			ImGui::CloseCurrentPopup();
@@ -398,10 +419,11 @@ void ImGuiWrapperNS::showWorldExplorer()
 
 				for (auto& j : l_componentNameMap)
 				{
-					if (ImGui::Selectable(j.second.second.c_str(), selectedComponent == j.first))
+					auto l_componentName = InnoUtility::toString(j.second.m_className) + "_" + std::to_string(j.second.m_index);
+					if (ImGui::Selectable(l_componentName.c_str(), selectedComponent == j.first))
 					{
 						selectedComponent = j.first;
-						selectedComponentType = j.second.first;
+						selectedComponentType = j.second.m_componentType;
 					}
 				}
 			}
@@ -10,6 +10,8 @@ struct RenderingConfig
 	bool drawTerrain = false;
 	bool drawSky = false;
 	bool drawDebugObject = false;
+	bool drawLODLevels = false;
+	float LODErrorBudget = 1.0f;
 	bool showRenderPassResult = false;
 };
 
@@ -9,6 +9,8 @@ extern ICoreSystem* g_pCoreSystem;
 INNO_PRIVATE_SCOPE InnoInputSystemNS
 {
 	vec4 calcMousePositionInWorldSpace();
+	void pushInputEvent(const InputEvent& inputEvent);
+	void dispatchInputEvents();
 
 	static WindowSystemComponent* g_WindowSystemComponent;
 	static GameSystemComponent* g_GameSystemComponent;
@@ -16,6 +18,55 @@ INNO_PRIVATE_SCOPE InnoInputSystemNS
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 };
 
+void InnoInputSystemNS::pushInputEvent(const InputEvent & inputEvent)
+{
+	// the oldest event would be overwritten if the queue is full
+	g_WindowSystemComponent->m_inputEventQueue.push(inputEvent);
+}
+
+void InnoInputSystemNS::dispatchInputEvents()
+{
+	auto& l_frameInputEvents = g_WindowSystemComponent->m_frameInputEvents;
+	l_frameInputEvents.clear();
+
+	InputEvent l_inputEvent;
+	while (g_WindowSystemComponent->m_inputEventQueue.pop(l_inputEvent))
+	{
+		l_frameInputEvents.emplace_back(l_inputEvent);
+	}
+
+	if (l_frameInputEvents.empty())
+	{
+		return;
+	}
+
+	for (auto i : g_WindowSystemComponent->m_inputEventCallback)
+	{
+		(*i)(&l_frameInputEvents[0], l_frameInputEvents.size());
+	}
+
+	// @TODO: relative offset for editor window
+	float l_mouseOffset[2] = { 0.0f, 0.0f };
+	for (auto& i : l_frameInputEvents)
+	{
+		if (i.m_type == InputEventType::MOUSE_MOVEMENT)
+		{
+			l_mouseOffset[i.m_code] += i.m_offset;
+		}
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (l_mouseOffset[i] != 0.0f)
+		{
+			for (auto j : g_WindowSystemComponent->m_mouseMovementCallback[i])
+			{
+				(*j)(l_mouseOffset[i]);
+			}
+		}
+	}
+}
+
 INNO_SYSTEM_EXPORT void InnoInputSystem::setup()
 {
 	InnoInputSystemNS::g_WindowSystemComponent = &WindowSystemComponent::get();
@@ -24,16 +75,18 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::setup()
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::initialize()
 {
-	for (int i = 0; i < InnoInputSystemNS::g_WindowSystemComponent->NUM_KEYCODES; i++)
-	{
-		InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus.emplace(i, ButtonStatus::RELEASED);
-	}
+	InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus.resize(InnoInputSystemNS::g_WindowSystemComponent->NUM_KEYCODES, ButtonStatus::RELEASED);
+	InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.resize(InnoInputSystemNS::g_WindowSystemComponent->NUM_KEYCODES * 2);
+	InnoInputSystemNS::g_WindowSystemComponent->m_frameInputEvents.reserve(InnoInputSystemNS::g_WindowSystemComponent->INPUT_EVENT_QUEUE_SIZE);
 
 	for (size_t i = 0; i < InnoInputSystemNS::g_GameSystemComponent->m_InputComponents.size(); i++)
 	{
-		// @TODO: multi input components need to register to multi map
 		addButtonStatusCallback(InnoInputSystemNS::g_GameSystemComponent->m_InputComponents[i]->m_buttonStatusCallbackImpl);
 		addMouseMovementCallback(InnoInputSystemNS::g_GameSystemComponent->m_InputComponents[i]->m_mouseMovementCallbackImpl);
+		for (auto j : InnoInputSystemNS::g_GameSystemComponent->m_InputComponents[i]->m_inputEventCallbackImpl)
+		{
+			addInputEventCallback(j);
+		}
 	}
 
 	InnoInputSystemNS::m_objectStatus = ObjectStatus::ALIVE;
@@ -42,44 +95,18 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::initialize()
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::update()
 {
-	for (auto& i : InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus)
-	{
-		auto l_keybinding = InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.find(ButtonData{ i.first, i.second });
-		if (l_keybinding != InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.end())
-		{
-			for (auto& j : l_keybinding->second)
-			{
-				if (j)
-				{
-					(*j)();
-				}
-			}
-		}
-	}
-	// @TODO: relative offset for editor window
-	if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.size() != 0)
+	// button callbacks are level-triggered, only the bound buttons need to be visited
+	for (auto i : InnoInputSystemNS::g_WindowSystemComponent->m_boundButtonCodes)
 	{
-		if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset != 0)
-		{
-			for (auto& j : InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.find(0)->second)
-			{
-				(*j)(InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset);
-			};
-		}
-		if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset != 0)
+		auto l_buttonStatus = InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus[i];
+		for (auto j : InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback[i * 2 + (int)l_buttonStatus])
 		{
-			for (auto& j : InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.find(1)->second)
-			{
-				(*j)(InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset);
-			};
-		}
-		if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset != 0 || InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset != 0)
-		{
-			InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset = 0;
-			InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset = 0;
+			(*j)();
 		}
 	}
 
+	InnoInputSystemNS::dispatchInputEvents();
+
 	InnoInputSystemNS::g_WindowSystemComponent->m_mousePositionInWorldSpace = InnoInputSystemNS::calcMousePositionInWorldSpace();
 }
 
@@ -91,15 +118,19 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::terminate()
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::addButtonStatusCallback(ButtonData boundButton, std::function<void()>* buttonStatusCallbackFunctor)
 {
-	auto l_keyboardInputCallbackFunctionVector = InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.find(boundButton);
-	if (l_keyboardInputCallbackFunctionVector != InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.end())
+	if (boundButton.m_code < 0 || boundButton.m_code >= InnoInputSystemNS::g_WindowSystemComponent->NUM_KEYCODES || !buttonStatusCallbackFunctor)
 	{
-		l_keyboardInputCallbackFunctionVector->second.emplace_back(buttonStatusCallbackFunctor);
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "InputSystem: invalid button status callback for button " + std::to_string(boundButton.m_code) + ".");
+		return;
 	}
-	else
+
+	auto& l_boundButtonCodes = InnoInputSystemNS::g_WindowSystemComponent->m_boundButtonCodes;
+	if (std::find(l_boundButtonCodes.begin(), l_boundButtonCodes.end(), boundButton.m_code) == l_boundButtonCodes.end())
 	{
-		InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback.emplace(boundButton, std::vector<std::function<void()>*>{buttonStatusCallbackFunctor});
+		l_boundButtonCodes.emplace_back(boundButton.m_code);
 	}
+
+	InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatusCallback[boundButton.m_code * 2 + (int)boundButton.m_status].emplace_back(buttonStatusCallbackFunctor);
 }
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::addButtonStatusCallback(ButtonData boundButton, std::vector<std::function<void()>*>& buttonStatusCallbackFunctor)
@@ -120,15 +151,13 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::addButtonStatusCallback(ButtonStatusCal
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::addMouseMovementCallback(int mouseCode, std::function<void(float)>* mouseMovementCallback)
 {
-	auto l_mouseMovementCallbackFunctionVector = InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.find(mouseCode);
-	if (l_mouseMovementCallbackFunctionVector != InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.end())
-	{
-		l_mouseMovementCallbackFunctionVector->second.emplace_back(mouseMovementCallback);
-	}
-	else
+	if (mouseCode < 0 || mouseCode > 1 || !mouseMovementCallback)
 	{
-		InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback.emplace(mouseCode, std::vector<std::function<void(float)>*>{mouseMovementCallback});
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "InputSystem: invalid mouse movement callback for axis " + std::to_string(mouseCode) + ".");
+		return;
 	}
+
+	InnoInputSystemNS::g_WindowSystemComponent->m_mouseMovementCallback[mouseCode].emplace_back(mouseMovementCallback);
 }
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::addMouseMovementCallback(int mouseCode, std::vector<std::function<void(float)>*>& mouseMovementCallback)
@@ -147,6 +176,36 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::addMouseMovementCallback(MouseMovementC
 	}
 }
 
+INNO_SYSTEM_EXPORT void InnoInputSystem::addInputEventCallback(InputEventCallback * inputEventCallback)
+{
+	if (inputEventCallback)
+	{
+		InnoInputSystemNS::g_WindowSystemComponent->m_inputEventCallback.emplace_back(inputEventCallback);
+	}
+}
+
+INNO_SYSTEM_EXPORT void InnoInputSystem::buttonStatusCallback(int code, ButtonStatus buttonStatus)
+{
+	if (code < 0 || code >= (int)InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus.size())
+	{
+		return;
+	}
+
+	auto& l_buttonStatus = InnoInputSystemNS::g_WindowSystemComponent->m_buttonStatus[code];
+	if (l_buttonStatus != buttonStatus)
+	{
+		l_buttonStatus = buttonStatus;
+
+		InputEvent l_inputEvent;
+		l_inputEvent.m_timeStamp = g_pCoreSystem->getTimeSystem()->getCurrentTimeInNanoSec();
+		l_inputEvent.m_type = InputEventType::BUTTON;
+		l_inputEvent.m_code = code;
+		l_inputEvent.m_status = buttonStatus;
+
+		InnoInputSystemNS::pushInputEvent(l_inputEvent);
+	}
+}
+
 INNO_SYSTEM_EXPORT void InnoInputSystem::framebufferSizeCallback(int width, int height)
 {
 	InnoInputSystemNS::g_WindowSystemComponent->m_windowResolution.x = width;
@@ -161,6 +220,23 @@ INNO_SYSTEM_EXPORT void InnoInputSystem::mousePositionCallback(float mouseXPos,
 
 	InnoInputSystemNS::g_WindowSystemComponent->m_mouseLastX = mouseXPos;
 	InnoInputSystemNS::g_WindowSystemComponent->m_mouseLastY = mouseYPos;
+
+	InputEvent l_inputEvent;
+	l_inputEvent.m_timeStamp = g_pCoreSystem->getTimeSystem()->getCurrentTimeInNanoSec();
+	l_inputEvent.m_type = InputEventType::MOUSE_MOVEMENT;
+
+	if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset != 0.0f)
+	{
+		l_inputEvent.m_code = 0;
+		l_inputEvent.m_offset = InnoInputSystemNS::g_WindowSystemComponent->m_mouseXOffset;
+		InnoInputSystemNS::pushInputEvent(l_inputEvent);
+	}
+	if (InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset != 0.0f)
+	{
+		l_inputEvent.m_code = 1;
+		l_inputEvent.m_offset = InnoInputSystemNS::g_WindowSystemComponent->m_mouseYOffset;
+		InnoInputSystemNS::pushInputEvent(l_inputEvent);
+	}
 }
 
 INNO_SYSTEM_EXPORT void InnoInputSystem::scrollCallback(float xoffset, float yoffset)
@@ -202,20 +278,20 @@ vec4 InnoInputSystemNS::calcMousePositionInWorldSpace()
 		);
 	//Column-Major memory layout
 #ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
-	l_ndcSpace = InnoMath::mul(l_ndcSpace, pCamera.inverse());
+	l_ndcSpace = InnoMath::mul(l_ndcSpace, pCamera.inversePerspective());
 	l_ndcSpace.z = -1.0f;
 	l_ndcSpace.w = 0.0f;
-	l_ndcSpace = InnoMath::mul(l_ndcSpace, rCamera.inverse());
-	l_ndcSpace = InnoMath::mul(l_ndcSpace, tCamera.inverse());
+	l_ndcSpace = InnoMath::mul(l_ndcSpace, rCamera.inverseOrthonormal());
+	l_ndcSpace = InnoMath::mul(l_ndcSpace, tCamera.inverseRigid());
 #endif
 	//Row-Major memory layout
 #ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
 
-	l_ndcSpace = InnoMath::mul(pCamera.inverse(), l_ndcSpace);
+	l_ndcSpace = InnoMath::mul(pCamera.inversePerspective(), l_ndcSpace);
 	l_ndcSpace.z = -1.0f;
 	l_ndcSpace.w = 0.0f;
-	l_ndcSpace = InnoMath::mul(tCamera.inverse(), l_ndcSpace);
-	l_ndcSpace = InnoMath::mul(rCamera.inverse(), l_ndcSpace);
+	l_ndcSpace = InnoMath::mul(tCamera.inverseRigid(), l_ndcSpace);
+	l_ndcSpace = InnoMath::mul(rCamera.inverseOrthonormal(), l_ndcSpace);
 #endif
 	l_ndcSpace = l_ndcSpace.normalize();
 	return l_ndcSpace;
@@ -17,7 +17,9 @@ public:
 	INNO_SYSTEM_EXPORT void addMouseMovementCallback(int mouseCode, std::function<void(float)>* mouseMovementCallback) override;
 	INNO_SYSTEM_EXPORT void addMouseMovementCallback(int mouseCode, std::vector<std::function<void(float)>*>& mouseMovementCallback) override;
 	INNO_SYSTEM_EXPORT void addMouseMovementCallback(MouseMovementCallbackMap& mouseMovementCallback) override;
+	INNO_SYSTEM_EXPORT void addInputEventCallback(InputEventCallback* inputEventCallback) override;
 
+	INNO_SYSTEM_EXPORT void buttonStatusCallback(int code, ButtonStatus buttonStatus) override;
 	INNO_SYSTEM_EXPORT void framebufferSizeCallback(int width, int height) override;
 	INNO_SYSTEM_EXPORT void mousePositionCallback(float mouseXPos, float mouseYPos) override;
 	INNO_SYSTEM_EXPORT void scrollCallback(float xoffset, float yoffset) override;
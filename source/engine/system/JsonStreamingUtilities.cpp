@@ -0,0 +1,238 @@
+#include "JsonStreamingUtilities.h"
+
+using json = nlohmann::json;
+
+INNO_PRIVATE_SCOPE JsonStreamingUtilities
+{
+	// a SAX handler, the containers outside of the streamed arrays are only tracked by their keys
+	class ArrayElementStreamer
+	{
+	public:
+		ArrayElementStreamer(const std::vector<std::string>& arrayPath, const std::function<bool(json&)>& callback)
+			: m_arrayPath(arrayPath), m_callback(callback)
+		{
+		};
+
+		bool null() { return addValue(json(nullptr)); }
+		bool boolean(bool val) { return addValue(json(val)); }
+		bool number_integer(json::number_integer_t val) { return addValue(json(val)); }
+		bool number_unsigned(json::number_unsigned_t val) { return addValue(json(val)); }
+		bool number_float(json::number_float_t val, const json::string_t&) { return addValue(json(val)); }
+		bool string(json::string_t& val) { return addValue(json(std::move(val))); }
+
+		// the text format has no binary values
+		template<typename T>
+		bool binary(T&)
+		{
+			return true;
+		}
+
+		bool start_object(std::size_t)
+		{
+			return startContainer(false);
+		}
+
+		bool key(json::string_t& val)
+		{
+			m_key = std::move(val);
+			return true;
+		}
+
+		bool end_object()
+		{
+			return endContainer();
+		}
+
+		bool start_array(std::size_t)
+		{
+			return startContainer(true);
+		}
+
+		bool end_array()
+		{
+			return endContainer();
+		}
+
+		template<typename Exception>
+		bool parse_error(std::size_t, const std::string&, const Exception&)
+		{
+			return false;
+		}
+
+	private:
+		struct Container
+		{
+			bool m_isArray;
+			// false for the array elements and the root
+			bool m_hasKey;
+			std::string m_key;
+		};
+
+		bool isInsideStreamedArray() const
+		{
+			return !m_containers.empty() && m_containers.back().m_isArray && m_streamedArrayDepth == m_containers.size();
+		}
+
+		bool isStreamedArray(const std::string& key) const
+		{
+			size_t l_index = 0;
+
+			for (auto& i : m_containers)
+			{
+				if (i.m_hasKey)
+				{
+					if (l_index >= m_arrayPath.size() || i.m_key != m_arrayPath[l_index])
+					{
+						return false;
+					}
+					l_index++;
+				}
+			}
+
+			return l_index + 1 == m_arrayPath.size() && key == m_arrayPath[l_index];
+		}
+
+		json* addToElement(json&& val)
+		{
+			if (m_elementStack.empty())
+			{
+				m_element = std::move(val);
+				return &m_element;
+			}
+
+			auto l_parent = m_elementStack.back();
+			if (l_parent->is_array())
+			{
+				l_parent->emplace_back(std::move(val));
+				return &l_parent->back();
+			}
+
+			auto& l_result = (*l_parent)[m_key];
+			l_result = std::move(val);
+			return &l_result;
+		}
+
+		bool emitElement()
+		{
+			auto l_result = m_callback(m_element);
+			m_element = json();
+			return l_result;
+		}
+
+		bool addValue(json&& val)
+		{
+			if (!m_elementStack.empty())
+			{
+				addToElement(std::move(val));
+				return true;
+			}
+
+			// a scalar element of the streamed array
+			if (isInsideStreamedArray())
+			{
+				addToElement(std::move(val));
+				return emitElement();
+			}
+
+			return true;
+		}
+
+		bool startContainer(bool isArray)
+		{
+			if (!m_elementStack.empty() || isInsideStreamedArray())
+			{
+				m_elementStack.emplace_back(addToElement(isArray ? json::array() : json::object()));
+				return true;
+			}
+
+			auto l_hasKey = !m_containers.empty() && !m_containers.back().m_isArray;
+			auto l_key = l_hasKey ? std::move(m_key) : std::string();
+
+			if (isArray && l_hasKey && isStreamedArray(l_key))
+			{
+				m_streamedArrayDepth = m_containers.size() + 1;
+			}
+
+			m_containers.emplace_back(Container{ isArray, l_hasKey, std::move(l_key) });
+
+			return true;
+		}
+
+		bool endContainer()
+		{
+			if (!m_elementStack.empty())
+			{
+				m_elementStack.pop_back();
+				if (m_elementStack.empty())
+				{
+					return emitElement();
+				}
+				return true;
+			}
+
+			if (m_streamedArrayDepth == m_containers.size())
+			{
+				m_streamedArrayDepth = 0;
+			}
+
+			m_containers.pop_back();
+
+			return true;
+		}
+
+		const std::vector<std::string>& m_arrayPath;
+		const std::function<bool(json&)>& m_callback;
+
+		std::vector<Container> m_containers;
+		// the depth of the streamed array currently open, 0 if none
+		size_t m_streamedArrayDepth = 0;
+		std::string m_key;
+
+		json m_element;
+		std::vector<json*> m_elementStack;
+	};
+
+	// a SAX handler which only lets the parser check the syntax
+	class Validator
+	{
+	public:
+		bool null() { return true; }
+		bool boolean(bool) { return true; }
+		bool number_integer(json::number_integer_t) { return true; }
+		bool number_unsigned(json::number_unsigned_t) { return true; }
+		bool number_float(json::number_float_t, const json::string_t&) { return true; }
+		bool string(json::string_t&) { return true; }
+
+		template<typename T>
+		bool binary(T&)
+		{
+			return true;
+		}
+
+		bool start_object(std::size_t) { return true; }
+		bool key(json::string_t&) { return true; }
+		bool end_object() { return true; }
+		bool start_array(std::size_t) { return true; }
+		bool end_array() { return true; }
+
+		template<typename Exception>
+		bool parse_error(std::size_t, const std::string&, const Exception&)
+		{
+			return false;
+		}
+	};
+}
+
+bool JsonStreamingUtilities::streamArrayElements(std::istream & stream, const std::vector<std::string>& arrayPath, const std::function<bool(json&)>& callback)
+{
+	ArrayElementStreamer l_streamer(arrayPath, callback);
+
+	return json::sax_parse(stream, &l_streamer);
+}
+
+bool JsonStreamingUtilities::validate(std::istream & stream)
+{
+	Validator l_validator;
+
+	return json::sax_parse(stream, &l_validator);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "json/json.hpp"
+
+INNO_PRIVATE_SCOPE JsonStreamingUtilities
+{
+	// parse the stream without building the DOM of the whole document, only the elements of the arrays at arrayPath are built one at a time and passed to the callback
+	// arrayPath is the chain of object keys from the root, { "Nodes", "Meshes" } streams the meshes of every node, the arrays in between are passed through
+	// return false if the JSON is malformed or the callback returns false
+	bool streamArrayElements(std::istream& stream, const std::vector<std::string>& arrayPath, const std::function<bool(nlohmann::json&)>& callback);
+
+	// parse the stream without building any value, return false if the JSON is malformed or truncated
+	bool validate(std::istream& stream);
+}
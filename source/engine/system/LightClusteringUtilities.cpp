@@ -0,0 +1,361 @@
+#include "LightClusteringUtilities.h"
+#include "../common/InnoConcurrency.h"
+
+#include "ICoreSystem.h"
+
+extern ICoreSystem* g_pCoreSystem;
+
+INNO_PRIVATE_SCOPE LightClusteringUtilities
+{
+	// in view space, the camera looks at -Z
+	struct ClusterBound
+	{
+		float m_min[3];
+		float m_max[3];
+	};
+
+	// the view space bound sphere of a light and the range of clusters it might overlap
+	struct LightCoverage
+	{
+		float m_center[3];
+		float m_radius;
+		bool m_isVisible;
+		unsigned int m_minX;
+		unsigned int m_maxX;
+		unsigned int m_minY;
+		unsigned int m_maxY;
+		unsigned int m_minZ;
+		unsigned int m_maxZ;
+	};
+
+	// per job output, each job owns a continuous range of depth slices
+	struct alignas(INNO_CACHE_LINE_SIZE) ClusterBucket
+	{
+		unsigned int m_minZ;
+		unsigned int m_maxZ;
+		std::vector<unsigned int> m_pointLightCounts;
+		std::vector<unsigned int> m_sphereLightCounts;
+		std::vector<unsigned int> m_cursors;
+		std::vector<unsigned int> m_lightIndices;
+	};
+
+	void updateClusterBounds(const mat4& projection, float zNear, float zFar);
+	unsigned int getDepthSlice(float depth);
+	unsigned int getTile(float NDC, unsigned int tileCount);
+	LightCoverage getLightCoverage(const mat4& view, const Sphere& lightBound);
+	bool intersectCheck(const ClusterBound& cluster, const LightCoverage& light);
+	template<class Visitor>
+	void visitClusters(const std::vector<LightCoverage>& lightCoverages, const ClusterBucket& bucket, Visitor&& visitor);
+	void assignLights(ClusterBucket& bucket);
+
+	float m_projectionScaleX = 0.0f;
+	float m_projectionScaleY = 0.0f;
+	float m_zNear = 0.0f;
+	float m_zFar = 0.0f;
+
+	float m_depthSliceScale = 0.0f;
+	float m_depthSliceBias = 0.0f;
+
+	std::vector<ClusterBound> m_clusterBounds;
+
+	std::vector<LightCoverage> m_pointLightCoverages;
+	std::vector<LightCoverage> m_sphereLightCoverages;
+
+	std::vector<ClusterBucket> m_clusterBuckets;
+
+	std::vector<unsigned int> m_clusterGrid;
+	std::vector<unsigned int> m_lightIndices;
+
+	std::vector<InnoFuture<void>> m_asyncTask;
+}
+
+// the cluster bounds only change with the projection
+void LightClusteringUtilities::updateClusterBounds(const mat4& projection, float zNear, float zFar)
+{
+	if (m_clusterBounds.size() == m_clusterCount && m_projectionScaleX == projection.m00 && m_projectionScaleY == projection.m11 && m_zNear == zNear && m_zFar == zFar)
+	{
+		return;
+	}
+
+	m_projectionScaleX = projection.m00;
+	m_projectionScaleY = projection.m11;
+	m_zNear = zNear;
+	m_zFar = zFar;
+
+	// exponential slices keep the clusters roughly cubic along the depth
+	m_depthSliceScale = (float)m_clusterCountZ / std::log(zFar / zNear);
+	m_depthSliceBias = -std::log(zNear) * m_depthSliceScale;
+
+	m_clusterBounds.resize(m_clusterCount);
+
+	for (unsigned int z = 0; z < m_clusterCountZ; z++)
+	{
+		auto l_near = zNear * std::pow(zFar / zNear, (float)z / (float)m_clusterCountZ);
+		auto l_far = zNear * std::pow(zFar / zNear, (float)(z + 1) / (float)m_clusterCountZ);
+
+		for (unsigned int y = 0; y < m_clusterCountY; y++)
+		{
+			auto l_minNDCY = -1.0f + 2.0f * (float)y / (float)m_clusterCountY;
+			auto l_maxNDCY = -1.0f + 2.0f * (float)(y + 1) / (float)m_clusterCountY;
+
+			for (unsigned int x = 0; x < m_clusterCountX; x++)
+			{
+				auto l_minNDCX = -1.0f + 2.0f * (float)x / (float)m_clusterCountX;
+				auto l_maxNDCX = -1.0f + 2.0f * (float)(x + 1) / (float)m_clusterCountX;
+
+				auto& l_bound = m_clusterBounds[(z * m_clusterCountY + y) * m_clusterCountX + x];
+
+				l_bound.m_min[0] = std::min(l_minNDCX * l_near, l_minNDCX * l_far) / m_projectionScaleX;
+				l_bound.m_max[0] = std::max(l_maxNDCX * l_near, l_maxNDCX * l_far) / m_projectionScaleX;
+				l_bound.m_min[1] = std::min(l_minNDCY * l_near, l_minNDCY * l_far) / m_projectionScaleY;
+				l_bound.m_max[1] = std::max(l_maxNDCY * l_near, l_maxNDCY * l_far) / m_projectionScaleY;
+				l_bound.m_min[2] = -l_far;
+				l_bound.m_max[2] = -l_near;
+			}
+		}
+	}
+}
+
+unsigned int LightClusteringUtilities::getDepthSlice(float depth)
+{
+	auto l_slice = (int)std::floor(std::log(depth) * m_depthSliceScale + m_depthSliceBias);
+
+	return (unsigned int)std::min(std::max(l_slice, 0), (int)m_clusterCountZ - 1);
+}
+
+unsigned int LightClusteringUtilities::getTile(float NDC, unsigned int tileCount)
+{
+	auto l_tile = (int)std::floor((NDC * 0.5f + 0.5f) * (float)tileCount);
+
+	return (unsigned int)std::min(std::max(l_tile, 0), (int)tileCount - 1);
+}
+
+LightClusteringUtilities::LightCoverage LightClusteringUtilities::getLightCoverage(const mat4& view, const Sphere& lightBound)
+{
+	LightCoverage l_result;
+
+	vec4 l_center;
+
+	//Column-Major memory layout
+#ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
+	l_center = InnoMath::mul(lightBound.m_center, view);
+#endif
+	//Row-Major memory layout
+#ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
+	l_center = InnoMath::mul(view, lightBound.m_center);
+#endif
+
+	l_result.m_center[0] = l_center.x;
+	l_result.m_center[1] = l_center.y;
+	l_result.m_center[2] = l_center.z;
+	l_result.m_radius = lightBound.m_radius;
+
+	auto l_minDepth = -l_center.z - lightBound.m_radius;
+	auto l_maxDepth = -l_center.z + lightBound.m_radius;
+
+	l_result.m_isVisible = l_maxDepth > m_zNear && l_minDepth < m_zFar;
+
+	if (!l_result.m_isVisible)
+	{
+		return l_result;
+	}
+
+	l_result.m_minZ = getDepthSlice(std::max(l_minDepth, m_zNear));
+	l_result.m_maxZ = getDepthSlice(std::min(l_maxDepth, m_zFar));
+
+	// the lights around the camera might cover any tile
+	if (l_minDepth <= m_zNear)
+	{
+		l_result.m_minX = 0;
+		l_result.m_maxX = m_clusterCountX - 1;
+		l_result.m_minY = 0;
+		l_result.m_maxY = m_clusterCountY - 1;
+
+		return l_result;
+	}
+
+	// the screen space bounds of the view space AABB of the sphere, x / depth is monotonic on the depth for a fixed x
+	auto l_minNDCX = m_projectionScaleX * std::min((l_center.x - lightBound.m_radius) / l_minDepth, (l_center.x - lightBound.m_radius) / l_maxDepth);
+	auto l_maxNDCX = m_projectionScaleX * std::max((l_center.x + lightBound.m_radius) / l_minDepth, (l_center.x + lightBound.m_radius) / l_maxDepth);
+	auto l_minNDCY = m_projectionScaleY * std::min((l_center.y - lightBound.m_radius) / l_minDepth, (l_center.y - lightBound.m_radius) / l_maxDepth);
+	auto l_maxNDCY = m_projectionScaleY * std::max((l_center.y + lightBound.m_radius) / l_minDepth, (l_center.y + lightBound.m_radius) / l_maxDepth);
+
+	if (l_maxNDCX < -1.0f || l_minNDCX > 1.0f || l_maxNDCY < -1.0f || l_minNDCY > 1.0f)
+	{
+		l_result.m_isVisible = false;
+		return l_result;
+	}
+
+	l_result.m_minX = getTile(l_minNDCX, m_clusterCountX);
+	l_result.m_maxX = getTile(l_maxNDCX, m_clusterCountX);
+	l_result.m_minY = getTile(l_minNDCY, m_clusterCountY);
+	l_result.m_maxY = getTile(l_maxNDCY, m_clusterCountY);
+
+	return l_result;
+}
+
+bool LightClusteringUtilities::intersectCheck(const ClusterBound& cluster, const LightCoverage& light)
+{
+	float l_distanceSquared = 0.0f;
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto l_closest = std::max(cluster.m_min[i], std::min(light.m_center[i], cluster.m_max[i]));
+		l_distanceSquared += (light.m_center[i] - l_closest) * (light.m_center[i] - l_closest);
+	}
+
+	return l_distanceSquared <= light.m_radius * light.m_radius;
+}
+
+// visitor(lightIndex, clusterIndexInBucket) is invoked for every light and cluster of the bucket they overlap
+template<class Visitor>
+void LightClusteringUtilities::visitClusters(const std::vector<LightCoverage>& lightCoverages, const ClusterBucket& bucket, Visitor&& visitor)
+{
+	for (unsigned int i = 0; i < (unsigned int)lightCoverages.size(); i++)
+	{
+		auto& l_light = lightCoverages[i];
+
+		if (!l_light.m_isVisible || l_light.m_maxZ < bucket.m_minZ || l_light.m_minZ > bucket.m_maxZ)
+		{
+			continue;
+		}
+
+		auto l_minZ = std::max(l_light.m_minZ, bucket.m_minZ);
+		auto l_maxZ = std::min(l_light.m_maxZ, bucket.m_maxZ);
+
+		for (auto z = l_minZ; z <= l_maxZ; z++)
+		{
+			for (auto y = l_light.m_minY; y <= l_light.m_maxY; y++)
+			{
+				for (auto x = l_light.m_minX; x <= l_light.m_maxX; x++)
+				{
+					auto l_clusterIndex = (z * m_clusterCountY + y) * m_clusterCountX + x;
+
+					if (intersectCheck(m_clusterBounds[l_clusterIndex], l_light))
+					{
+						visitor(i, ((z - bucket.m_minZ) * m_clusterCountY + y) * m_clusterCountX + x);
+					}
+				}
+			}
+		}
+	}
+}
+
+void LightClusteringUtilities::assignLights(ClusterBucket& bucket)
+{
+	auto l_clusterCount = (bucket.m_maxZ - bucket.m_minZ + 1) * m_clusterCountX * m_clusterCountY;
+
+	bucket.m_pointLightCounts.assign(l_clusterCount, 0);
+	bucket.m_sphereLightCounts.assign(l_clusterCount, 0);
+
+	// count the lights first, then the indices could be written in place without any per cluster container
+	visitClusters(m_pointLightCoverages, bucket, [&](unsigned int, unsigned int clusterIndex) { bucket.m_pointLightCounts[clusterIndex]++; });
+	visitClusters(m_sphereLightCoverages, bucket, [&](unsigned int, unsigned int clusterIndex) { bucket.m_sphereLightCounts[clusterIndex]++; });
+
+	bucket.m_cursors.resize(l_clusterCount);
+
+	unsigned int l_offset = 0;
+	auto l_firstCluster = bucket.m_minZ * m_clusterCountX * m_clusterCountY;
+
+	for (unsigned int i = 0; i < l_clusterCount; i++)
+	{
+		bucket.m_cursors[i] = l_offset;
+
+		auto l_gridEntry = &m_clusterGrid[(l_firstCluster + i) * 4];
+		l_gridEntry[0] = l_offset;
+		l_gridEntry[1] = bucket.m_pointLightCounts[i];
+		l_gridEntry[2] = bucket.m_sphereLightCounts[i];
+		l_gridEntry[3] = 0;
+
+		l_offset += bucket.m_pointLightCounts[i] + bucket.m_sphereLightCounts[i];
+	}
+
+	bucket.m_lightIndices.resize(l_offset);
+
+	// the visiting order is the same, so the point lights of each cluster are written before the sphere lights
+	visitClusters(m_pointLightCoverages, bucket, [&](unsigned int lightIndex, unsigned int clusterIndex) { bucket.m_lightIndices[bucket.m_cursors[clusterIndex]++] = lightIndex; });
+	visitClusters(m_sphereLightCoverages, bucket, [&](unsigned int lightIndex, unsigned int clusterIndex) { bucket.m_lightIndices[bucket.m_cursors[clusterIndex]++] = lightIndex; });
+}
+
+void LightClusteringUtilities::update(const mat4& view, const mat4& projection, float zNear, float zFar, const std::vector<Sphere>& pointLightBounds, const std::vector<Sphere>& sphereLightBounds)
+{
+	updateClusterBounds(projection, zNear, zFar);
+
+	m_pointLightCoverages.resize(pointLightBounds.size());
+	m_sphereLightCoverages.resize(sphereLightBounds.size());
+
+	for (size_t i = 0; i < pointLightBounds.size(); i++)
+	{
+		m_pointLightCoverages[i] = getLightCoverage(view, pointLightBounds[i]);
+	}
+	for (size_t i = 0; i < sphereLightBounds.size(); i++)
+	{
+		m_sphereLightCoverages[i] = getLightCoverage(view, sphereLightBounds[i]);
+	}
+
+	m_clusterGrid.resize(m_clusterCount * 4);
+
+	// each job owns a range of depth slices, so the jobs never write to the same cluster
+	auto l_jobCount = std::min<size_t>(m_clusterCountZ, (g_pCoreSystem->getTaskSystem()->getThreadCount() + 1) * 2);
+	auto l_slicesPerJob = ((size_t)m_clusterCountZ + l_jobCount - 1) / l_jobCount;
+	l_jobCount = ((size_t)m_clusterCountZ + l_slicesPerJob - 1) / l_slicesPerJob;
+
+	m_clusterBuckets.resize(l_jobCount);
+
+	for (size_t i = 0; i < l_jobCount; i++)
+	{
+		m_clusterBuckets[i].m_minZ = (unsigned int)(i * l_slicesPerJob);
+		m_clusterBuckets[i].m_maxZ = (unsigned int)std::min((i + 1) * l_slicesPerJob, (size_t)m_clusterCountZ) - 1;
+	}
+
+	g_pCoreSystem->getTaskSystem()->dispatch(l_jobCount, [&](size_t i) {
+		assignLights(m_clusterBuckets[i]);
+	}, m_asyncTask);
+
+	// the offsets of each bucket start from 0, rebase them to the merged light index list
+	size_t l_lightIndexCount = 0;
+
+	for (auto& i : m_clusterBuckets)
+	{
+		l_lightIndexCount += i.m_lightIndices.size();
+	}
+
+	m_lightIndices.clear();
+	m_lightIndices.reserve(l_lightIndexCount);
+
+	for (auto& i : m_clusterBuckets)
+	{
+		auto l_base = (unsigned int)m_lightIndices.size();
+		auto l_firstCluster = i.m_minZ * m_clusterCountX * m_clusterCountY;
+		auto l_lastCluster = (i.m_maxZ + 1) * m_clusterCountX * m_clusterCountY;
+
+		for (auto j = l_firstCluster; j < l_lastCluster; j++)
+		{
+			m_clusterGrid[j * 4] += l_base;
+		}
+
+		m_lightIndices.insert(m_lightIndices.end(), i.m_lightIndices.begin(), i.m_lightIndices.end());
+	}
+
+	g_pCoreSystem->getTaskSystem()->shrinkFutureContainer(m_asyncTask);
+}
+
+const std::vector<unsigned int>& LightClusteringUtilities::getClusterGrid()
+{
+	return m_clusterGrid;
+}
+
+const std::vector<unsigned int>& LightClusteringUtilities::getLightIndices()
+{
+	return m_lightIndices;
+}
+
+float LightClusteringUtilities::getDepthSliceScale()
+{
+	return m_depthSliceScale;
+}
+
+float LightClusteringUtilities::getDepthSliceBias()
+{
+	return m_depthSliceBias;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+
+// clustered light assignment, the view frustum is divided into a grid of froxels (screen tiles x exponential depth slices),
+// each froxel stores the indices of the point and sphere lights whose bound spheres overlap it
+INNO_PRIVATE_SCOPE LightClusteringUtilities
+{
+	const unsigned int m_clusterCountX = 16;
+	const unsigned int m_clusterCountY = 8;
+	const unsigned int m_clusterCountZ = 24;
+	const unsigned int m_clusterCount = m_clusterCountX * m_clusterCountY * m_clusterCountZ;
+
+	// the bound spheres are in world space, view is the world to view space matrix of the camera, projection has to be a symmetric perspective one
+	void update(const mat4& view, const mat4& projection, float zNear, float zFar, const std::vector<Sphere>& pointLightBounds, const std::vector<Sphere>& sphereLightBounds);
+
+	// 4 uints per cluster: offset in the light index list, point light count, sphere light count, unused
+	// the clusters are stored x first, then y, then z
+	const std::vector<unsigned int>& getClusterGrid();
+
+	// the point light indices of a cluster come first, followed by its sphere light indices
+	const std::vector<unsigned int>& getLightIndices();
+
+	// the slice of a view space depth d is floor(log(d) * scale + bias)
+	float getDepthSliceScale();
+	float getDepthSliceBias();
+}
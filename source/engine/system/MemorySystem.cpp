@@ -1,4 +1,5 @@
 #include "MemorySystem.h"
+#include "../common/InnoAllocator.h"
 #include <cstring>
 #include <iostream>
 #include <fstream>
@@ -6,39 +7,6 @@
 
 extern ICoreSystem* g_pCoreSystem;
 
-//Double-linked-list
-class freeChunk
-{
-public:
-	void* m_target = nullptr;
-	freeChunk* m_next = nullptr;
-	freeChunk* m_prev = nullptr;
-};
-
-template <class T, unsigned long long TCapability>
-class objectPool
-{
-public:
-	objectPool() : objectPool(TCapability)
-	{
-	};
-
-	objectPool(unsigned long long capability)
-	{
-		m_capability = capability;
-		m_poolSize = capability * sizeof(T);
-		m_poolPtr = ::new unsigned char[m_poolSize];
-	};
-
-	~objectPool() {
-		::delete[] m_poolPtr;
-	};
-
-	unsigned long long m_capability = 0;
-	unsigned long long m_poolSize = 0;
-	unsigned char* m_poolPtr = nullptr;
-};
-
 class MemoryWatchdog
 {
 public:
@@ -73,41 +41,8 @@ private:
 
 INNO_PRIVATE_SCOPE InnoMemorySystemNS
 {
-#define allocateInitialFreeChucksDefi( className ) \
-bool allocateInitialFreeChucksFor##className() \
-{ \
-	auto l_chuckUC = m_##className##FreeChunkPool->m_poolPtr; \
-	auto l_componentUC = m_##className##Pool->m_poolPtr; \
-\
-	freeChunk* l_prevFreeChunk = nullptr; \
-\
-	/* walk through others */ \
-	for (unsigned long long i = 0; i < m_##className##FreeChunkPool->m_capability; i++) \
-	{ \
-		auto l_newFreeChunk = new(l_chuckUC) freeChunk(); \
- \
-		l_newFreeChunk->m_target = l_componentUC; \
-		l_newFreeChunk->m_prev = l_prevFreeChunk; \
-		if(l_prevFreeChunk) \
-		{ \
-			l_newFreeChunk->m_prev->m_next = l_newFreeChunk; \
-		} \
-\
-		l_prevFreeChunk = l_newFreeChunk; \
-		l_chuckUC += sizeof(freeChunk); \
-		l_componentUC += sizeof(className); \
-	} \
-\
-	m_##className##CurrentFreeChunk = reinterpret_cast<freeChunk*>(m_##className##FreeChunkPool->m_poolPtr); \
-\
-	return true; \
-}
-
 #define objectPoolUniPtr( className, size ) \
-std::unique_ptr<objectPool<className, size>> m_##className##Pool = std::make_unique<objectPool<className, size>>(); \
-std::unique_ptr<objectPool<freeChunk, size>> m_##className##FreeChunkPool = std::make_unique<objectPool<freeChunk, size>>(); \
-freeChunk* m_##className##CurrentFreeChunk; \
-allocateInitialFreeChucksDefi(className)
+std::unique_ptr<componentPool<className, size>> m_##className##Pool = std::make_unique<componentPool<className, size>>();
 
 	// Memory pool for components
 	objectPoolUniPtr(TransformComponent, 16384);
@@ -146,7 +81,7 @@ allocateInitialFreeChucksDefi(className)
 bool InnoMemorySystemNS::setup()
 {
 #define constructObjectPool( className, size ) \
-	allocateInitialFreeChucksFor##className();
+	m_##className##Pool->allocateInitialFreeChunks();
 
 	constructObjectPool(TransformComponent, 16384);
 	constructObjectPool(VisibleComponent, 16384);
@@ -206,27 +141,12 @@ INNO_SYSTEM_EXPORT bool InnoMemorySystem::terminate()
 #define allocateComponentImplDefi( className ) \
 className* InnoMemorySystem::allocate##className() \
 { \
-	auto l_ptr = new(InnoMemorySystemNS::m_##className##CurrentFreeChunk->m_target) className(); \
-	if (l_ptr) \
-	{ \
-		auto l_next = InnoMemorySystemNS::m_##className##CurrentFreeChunk->m_next; \
-		if(l_next) \
-		{ \
-			l_next->m_prev = nullptr; \
-			InnoMemorySystemNS::m_##className##CurrentFreeChunk = l_next; \
-		} \
-		else \
-		{ \
-			InnoMemorySystemNS::m_##className##CurrentFreeChunk = nullptr; \
-			g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "MemorySystem: Run out of memory pool for " + std::string(#className) + " !"); \
-		} \
-		return l_ptr; \
-	} \
-	else \
+	auto l_ptr = InnoMemorySystemNS::m_##className##Pool->allocate(); \
+	if (!l_ptr) \
 	{ \
-		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "MemorySystem: Can't allocate memory for " + std::string(#className) + " !"); \
-		return nullptr; \
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "MemorySystem: Run out of memory pool for " + std::string(#className) + " !"); \
 	} \
+	return l_ptr; \
 }
 
 allocateComponentImplDefi(TransformComponent)
@@ -260,19 +180,7 @@ allocateComponentImplDefi(PhysicsDataComponent)
 #define freeComponentImplDefi( className ) \
 bool InnoMemorySystem::free##className(className* p) \
 { \
-	/* get pointer distance between this object and the head of the pool*/ \
-	auto l_offset = reinterpret_cast<unsigned char*>(p) - InnoMemorySystemNS::m_##className##Pool->m_poolPtr; \
-	auto l_index = l_offset / sizeof(className); \
-	auto l_freeChuck = new(InnoMemorySystemNS::m_##className##FreeChunkPool->m_poolPtr + l_index * sizeof(freeChunk)) freeChunk(); \
-	/* now insert after the current free chunk*/ \
-	l_freeChuck->m_target = p; \
-	l_freeChuck->m_prev = InnoMemorySystemNS::m_##className##CurrentFreeChunk; \
-	l_freeChuck->m_next = InnoMemorySystemNS::m_##className##CurrentFreeChunk->m_next; \
-	InnoMemorySystemNS::m_##className##CurrentFreeChunk->m_next = l_freeChuck; \
-	/*finally wipe away all the old data*/ \
-	std::memset((void*)p, 0, sizeof(className)); \
-\
-	return true; \
+	return InnoMemorySystemNS::m_##className##Pool->free(p); \
 } \
 
 freeComponentImplDefi(TransformComponent)
@@ -0,0 +1,526 @@
+#include "MeshSimplificationUtilities.h"
+
+INNO_PRIVATE_SCOPE MeshSimplificationUtilities
+{
+	// the sum of the squared distances to a set of planes as a symmetric 4x4 matrix
+	struct Quadric
+	{
+		double a2 = 0.0;
+		double ab = 0.0;
+		double ac = 0.0;
+		double ad = 0.0;
+		double b2 = 0.0;
+		double bc = 0.0;
+		double bd = 0.0;
+		double c2 = 0.0;
+		double cd = 0.0;
+		double d2 = 0.0;
+	};
+
+	struct Collapse
+	{
+		double m_cost;
+		unsigned int m_from;
+		unsigned int m_to;
+	};
+
+	struct SimplificationContext
+	{
+		// the vertices at the same position are welded, the collapses happen between positions
+		std::vector<vec4> m_positions;
+		std::vector<unsigned int> m_vertexPositions;
+		std::vector<std::vector<unsigned int>> m_positionVertices;
+		std::vector<Quadric> m_quadrics;
+
+		std::vector<Index> m_indices;
+		std::vector<unsigned char> m_isTriangleRemoved;
+		std::vector<std::vector<unsigned int>> m_vertexTriangles;
+		size_t m_triangleCount = 0;
+
+		std::vector<Collapse> m_collapses;
+		std::vector<unsigned char> m_isPositionLocked;
+		std::vector<std::pair<unsigned int, unsigned int>> m_collapseTargets;
+
+		double m_maxError = 0.0;
+	};
+
+	void addPlane(Quadric& quadric, double a, double b, double c, double d, double weight);
+	void addQuadric(Quadric& lhs, const Quadric& rhs);
+	double getError(const Quadric& quadric, const vec4& pos);
+
+	void initialize(SimplificationContext& context, const std::vector<Vertex>& vertices, const std::vector<Index>& indices);
+	bool collapsePass(SimplificationContext& context, size_t targetTriangleCount);
+	bool findCollapseTargets(SimplificationContext& context, unsigned int from, unsigned int to);
+	bool isFlipped(const SimplificationContext& context, unsigned int from, unsigned int to);
+	void collapse(SimplificationContext& context, unsigned int from, unsigned int to);
+	MeshLODData generateLODData(const SimplificationContext& context, const std::vector<Vertex>& vertices);
+
+	// the planes perpendicular to the border and seam edges keep them in place
+	const double m_seamWeight = 10.0;
+	// the cosine of the max rotation of a triangle normal in one collapse
+	const float m_maxNormalDeviation = 0.25f;
+	// skip the level if it isn't reduced by at least this ratio of the previous one
+	const float m_minReductionRatio = 0.9f;
+}
+
+void MeshSimplificationUtilities::addPlane(Quadric& quadric, double a, double b, double c, double d, double weight)
+{
+	quadric.a2 += weight * a * a;
+	quadric.ab += weight * a * b;
+	quadric.ac += weight * a * c;
+	quadric.ad += weight * a * d;
+	quadric.b2 += weight * b * b;
+	quadric.bc += weight * b * c;
+	quadric.bd += weight * b * d;
+	quadric.c2 += weight * c * c;
+	quadric.cd += weight * c * d;
+	quadric.d2 += weight * d * d;
+}
+
+void MeshSimplificationUtilities::addQuadric(Quadric& lhs, const Quadric& rhs)
+{
+	lhs.a2 += rhs.a2;
+	lhs.ab += rhs.ab;
+	lhs.ac += rhs.ac;
+	lhs.ad += rhs.ad;
+	lhs.b2 += rhs.b2;
+	lhs.bc += rhs.bc;
+	lhs.bd += rhs.bd;
+	lhs.c2 += rhs.c2;
+	lhs.cd += rhs.cd;
+	lhs.d2 += rhs.d2;
+}
+
+double MeshSimplificationUtilities::getError(const Quadric& quadric, const vec4& pos)
+{
+	double x = pos.x;
+	double y = pos.y;
+	double z = pos.z;
+
+	auto l_error = quadric.a2 * x * x + 2.0 * quadric.ab * x * y + 2.0 * quadric.ac * x * z + 2.0 * quadric.ad * x
+		+ quadric.b2 * y * y + 2.0 * quadric.bc * y * z + 2.0 * quadric.bd * y
+		+ quadric.c2 * z * z + 2.0 * quadric.cd * z
+		+ quadric.d2;
+
+	return std::max(l_error, 0.0);
+}
+
+void MeshSimplificationUtilities::initialize(SimplificationContext& context, const std::vector<Vertex>& vertices, const std::vector<Index>& indices)
+{
+	auto l_vertexCount = vertices.size();
+
+	// weld the vertices by position
+	std::vector<unsigned int> l_sortedVertices(l_vertexCount);
+	for (unsigned int i = 0; i < l_vertexCount; i++)
+	{
+		l_sortedVertices[i] = i;
+	}
+
+	auto l_lessPosition = [&](unsigned int lhs, unsigned int rhs) {
+		auto& l_lhs = vertices[lhs].m_pos;
+		auto& l_rhs = vertices[rhs].m_pos;
+		return std::tie(l_lhs.x, l_lhs.y, l_lhs.z) < std::tie(l_rhs.x, l_rhs.y, l_rhs.z);
+	};
+
+	std::sort(l_sortedVertices.begin(), l_sortedVertices.end(), l_lessPosition);
+
+	context.m_vertexPositions.resize(l_vertexCount);
+
+	for (size_t i = 0; i < l_vertexCount; i++)
+	{
+		auto l_vertex = l_sortedVertices[i];
+
+		if (i == 0 || l_lessPosition(l_sortedVertices[i - 1], l_vertex))
+		{
+			auto l_pos = vertices[l_vertex].m_pos;
+			context.m_positions.emplace_back(l_pos.x, l_pos.y, l_pos.z, 1.0f);
+			context.m_positionVertices.emplace_back();
+		}
+
+		context.m_vertexPositions[l_vertex] = (unsigned int)context.m_positions.size() - 1;
+		context.m_positionVertices.back().emplace_back(l_vertex);
+	}
+
+	context.m_quadrics.resize(context.m_positions.size());
+	context.m_isPositionLocked.resize(context.m_positions.size());
+
+	// the degenerated triangles are dropped
+	context.m_indices.reserve(indices.size());
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		auto l_p0 = context.m_vertexPositions[indices[i]];
+		auto l_p1 = context.m_vertexPositions[indices[i + 1]];
+		auto l_p2 = context.m_vertexPositions[indices[i + 2]];
+
+		if (l_p0 != l_p1 && l_p1 != l_p2 && l_p2 != l_p0)
+		{
+			context.m_indices.insert(context.m_indices.end(), { indices[i], indices[i + 1], indices[i + 2] });
+		}
+	}
+
+	context.m_triangleCount = context.m_indices.size() / 3;
+	context.m_isTriangleRemoved.resize(context.m_triangleCount);
+	context.m_vertexTriangles.resize(l_vertexCount);
+
+	for (unsigned int i = 0; i < context.m_triangleCount; i++)
+	{
+		for (size_t j = 0; j < 3; j++)
+		{
+			context.m_vertexTriangles[context.m_indices[i * 3 + j]].emplace_back(i);
+		}
+	}
+
+	// the directed edges between the vertices, an edge without its opposite one is either on the border or on a UV or normal seam
+	std::vector<std::pair<Index, Index>> l_edges;
+	l_edges.reserve(context.m_indices.size());
+
+	for (size_t i = 0; i < context.m_indices.size(); i += 3)
+	{
+		for (size_t j = 0; j < 3; j++)
+		{
+			l_edges.emplace_back(context.m_indices[i + j], context.m_indices[i + (j + 1) % 3]);
+		}
+	}
+
+	std::sort(l_edges.begin(), l_edges.end());
+
+	for (size_t i = 0; i < context.m_indices.size(); i += 3)
+	{
+		auto& l_pos0 = context.m_positions[context.m_vertexPositions[context.m_indices[i]]];
+		auto& l_pos1 = context.m_positions[context.m_vertexPositions[context.m_indices[i + 1]]];
+		auto& l_pos2 = context.m_positions[context.m_vertexPositions[context.m_indices[i + 2]]];
+
+		auto l_normal = (l_pos1 - l_pos0).cross(l_pos2 - l_pos0);
+		auto l_length = l_normal.length();
+
+		if (l_length <= std::numeric_limits<float>::epsilon())
+		{
+			continue;
+		}
+
+		l_normal = l_normal / l_length;
+		auto l_distance = -(l_normal.x * l_pos0.x + l_normal.y * l_pos0.y + l_normal.z * l_pos0.z);
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			addPlane(context.m_quadrics[context.m_vertexPositions[context.m_indices[i + j]]], l_normal.x, l_normal.y, l_normal.z, l_distance, 1.0);
+		}
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			auto l_v0 = context.m_indices[i + j];
+			auto l_v1 = context.m_indices[i + (j + 1) % 3];
+
+			if (std::binary_search(l_edges.begin(), l_edges.end(), std::make_pair(l_v1, l_v0)))
+			{
+				continue;
+			}
+
+			auto& l_edgePos0 = context.m_positions[context.m_vertexPositions[l_v0]];
+			auto& l_edgePos1 = context.m_positions[context.m_vertexPositions[l_v1]];
+
+			auto l_seamNormal = (l_edgePos1 - l_edgePos0).cross(l_normal);
+			auto l_seamNormalLength = l_seamNormal.length();
+
+			if (l_seamNormalLength <= std::numeric_limits<float>::epsilon())
+			{
+				continue;
+			}
+
+			l_seamNormal = l_seamNormal / l_seamNormalLength;
+			auto l_seamDistance = -(l_seamNormal.x * l_edgePos0.x + l_seamNormal.y * l_edgePos0.y + l_seamNormal.z * l_edgePos0.z);
+
+			addPlane(context.m_quadrics[context.m_vertexPositions[l_v0]], l_seamNormal.x, l_seamNormal.y, l_seamNormal.z, l_seamDistance, m_seamWeight);
+			addPlane(context.m_quadrics[context.m_vertexPositions[l_v1]], l_seamNormal.x, l_seamNormal.y, l_seamNormal.z, l_seamDistance, m_seamWeight);
+		}
+	}
+}
+
+// each vertex of the source position has to collapse to the vertex of the destination position it shares an edge with,
+// otherwise the collapse would tear a seam or pull a vertex across it
+bool MeshSimplificationUtilities::findCollapseTargets(SimplificationContext& context, unsigned int from, unsigned int to)
+{
+	context.m_collapseTargets.clear();
+
+	for (auto l_vertex : context.m_positionVertices[from])
+	{
+		bool l_hasTarget = false;
+		unsigned int l_target = 0;
+
+		for (auto l_triangle : context.m_vertexTriangles[l_vertex])
+		{
+			if (context.m_isTriangleRemoved[l_triangle])
+			{
+				continue;
+			}
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				auto l_corner = context.m_indices[l_triangle * 3 + i];
+
+				if (context.m_vertexPositions[l_corner] == to)
+				{
+					if (l_hasTarget && l_target != l_corner)
+					{
+						return false;
+					}
+
+					l_hasTarget = true;
+					l_target = l_corner;
+				}
+			}
+		}
+
+		if (!l_hasTarget)
+		{
+			// the vertices without any living triangle are left behind
+			for (auto l_triangle : context.m_vertexTriangles[l_vertex])
+			{
+				if (!context.m_isTriangleRemoved[l_triangle])
+				{
+					return false;
+				}
+			}
+			continue;
+		}
+
+		context.m_collapseTargets.emplace_back(l_vertex, l_target);
+	}
+
+	return true;
+}
+
+bool MeshSimplificationUtilities::isFlipped(const SimplificationContext& context, unsigned int from, unsigned int to)
+{
+	auto& l_newPos = context.m_positions[to];
+
+	for (auto l_vertex : context.m_positionVertices[from])
+	{
+		for (auto l_triangle : context.m_vertexTriangles[l_vertex])
+		{
+			if (context.m_isTriangleRemoved[l_triangle])
+			{
+				continue;
+			}
+
+			unsigned int l_corners[3];
+			bool l_isRemoved = false;
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				l_corners[i] = context.m_vertexPositions[context.m_indices[l_triangle * 3 + i]];
+				l_isRemoved |= l_corners[i] == to;
+			}
+
+			// the triangles on the collapsed edge are removed anyway
+			if (l_isRemoved)
+			{
+				continue;
+			}
+
+			vec4 l_oldPos[3];
+			vec4 l_movedPos[3];
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				l_oldPos[i] = context.m_positions[l_corners[i]];
+				l_movedPos[i] = l_corners[i] == from ? l_newPos : l_oldPos[i];
+			}
+
+			auto l_oldNormal = (l_oldPos[1] - l_oldPos[0]).cross(l_oldPos[2] - l_oldPos[0]);
+			auto l_newNormal = (l_movedPos[1] - l_movedPos[0]).cross(l_movedPos[2] - l_movedPos[0]);
+
+			// the triangles rotating too much are about to flip
+			if (l_oldNormal * l_newNormal <= m_maxNormalDeviation * l_oldNormal.length() * l_newNormal.length())
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void MeshSimplificationUtilities::collapse(SimplificationContext& context, unsigned int from, unsigned int to)
+{
+	for (auto& l_collapseTarget : context.m_collapseTargets)
+	{
+		auto l_vertex = l_collapseTarget.first;
+		auto l_target = l_collapseTarget.second;
+
+		for (auto l_triangle : context.m_vertexTriangles[l_vertex])
+		{
+			if (context.m_isTriangleRemoved[l_triangle])
+			{
+				continue;
+			}
+
+			unsigned int l_positionMask = 0;
+
+			for (size_t i = 0; i < 3; i++)
+			{
+				auto& l_corner = context.m_indices[l_triangle * 3 + i];
+				if (l_corner == l_vertex)
+				{
+					l_corner = l_target;
+				}
+				l_positionMask |= context.m_vertexPositions[l_corner] == to ? 1u << i : 0u;
+			}
+
+			// more than one corner at the destination position
+			if (l_positionMask & (l_positionMask - 1))
+			{
+				context.m_isTriangleRemoved[l_triangle] = true;
+				context.m_triangleCount--;
+			}
+			else
+			{
+				context.m_vertexTriangles[l_target].emplace_back(l_triangle);
+			}
+		}
+
+		context.m_vertexTriangles[l_vertex].clear();
+	}
+
+	addQuadric(context.m_quadrics[to], context.m_quadrics[from]);
+}
+
+// collapse the cheapest edges first, a position only moves or receives one collapse per pass so the costs stay valid
+bool MeshSimplificationUtilities::collapsePass(SimplificationContext& context, size_t targetTriangleCount)
+{
+	context.m_collapses.clear();
+
+	for (unsigned int i = 0; i < (unsigned int)context.m_isTriangleRemoved.size(); i++)
+	{
+		if (context.m_isTriangleRemoved[i])
+		{
+			continue;
+		}
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			auto l_p0 = context.m_vertexPositions[context.m_indices[i * 3 + j]];
+			auto l_p1 = context.m_vertexPositions[context.m_indices[i * 3 + (j + 1) % 3]];
+
+			Quadric l_quadric = context.m_quadrics[l_p0];
+			addQuadric(l_quadric, context.m_quadrics[l_p1]);
+
+			context.m_collapses.push_back({ getError(l_quadric, context.m_positions[l_p1]), l_p0, l_p1 });
+			context.m_collapses.push_back({ getError(l_quadric, context.m_positions[l_p0]), l_p1, l_p0 });
+		}
+	}
+
+	std::sort(context.m_collapses.begin(), context.m_collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+		return lhs.m_cost < rhs.m_cost;
+	});
+
+	std::fill(context.m_isPositionLocked.begin(), context.m_isPositionLocked.end(), 0);
+
+	size_t l_collapseCount = 0;
+
+	for (auto& i : context.m_collapses)
+	{
+		if (context.m_triangleCount <= targetTriangleCount)
+		{
+			break;
+		}
+
+		if (context.m_isPositionLocked[i.m_from] || context.m_isPositionLocked[i.m_to])
+		{
+			continue;
+		}
+
+		if (!findCollapseTargets(context, i.m_from, i.m_to) || isFlipped(context, i.m_from, i.m_to))
+		{
+			continue;
+		}
+
+		collapse(context, i.m_from, i.m_to);
+
+		context.m_isPositionLocked[i.m_from] = true;
+		context.m_isPositionLocked[i.m_to] = true;
+		context.m_maxError = std::max(context.m_maxError, i.m_cost);
+
+		l_collapseCount++;
+	}
+
+	return l_collapseCount > 0;
+}
+
+MeshLODData MeshSimplificationUtilities::generateLODData(const SimplificationContext& context, const std::vector<Vertex>& vertices)
+{
+	MeshLODData l_result;
+
+	// only keep the referenced vertices
+	std::vector<Index> l_remap(vertices.size(), std::numeric_limits<Index>::max());
+
+	l_result.m_indices.reserve(context.m_triangleCount * 3);
+
+	for (size_t i = 0; i < context.m_isTriangleRemoved.size(); i++)
+	{
+		if (context.m_isTriangleRemoved[i])
+		{
+			continue;
+		}
+
+		for (size_t j = 0; j < 3; j++)
+		{
+			auto l_vertex = context.m_indices[i * 3 + j];
+
+			if (l_remap[l_vertex] == std::numeric_limits<Index>::max())
+			{
+				l_remap[l_vertex] = (Index)l_result.m_vertices.size();
+				l_result.m_vertices.emplace_back(vertices[l_vertex]);
+			}
+
+			l_result.m_indices.emplace_back(l_remap[l_vertex]);
+		}
+	}
+
+	l_result.m_error = (float)std::sqrt(context.m_maxError);
+
+	return l_result;
+}
+
+std::vector<MeshLODData> MeshSimplificationUtilities::generateLODs(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, std::vector<float> triangleRatios)
+{
+	std::vector<MeshLODData> l_result;
+
+	if (vertices.empty() || indices.size() < 3)
+	{
+		return l_result;
+	}
+
+	std::sort(triangleRatios.begin(), triangleRatios.end(), std::greater<float>());
+
+	SimplificationContext l_context;
+	initialize(l_context, vertices, indices);
+
+	auto l_sourceTriangleCount = indices.size() / 3;
+	auto l_lastTriangleCount = l_sourceTriangleCount;
+
+	// the coarser levels continue from the finer ones
+	for (auto l_ratio : triangleRatios)
+	{
+		auto l_targetTriangleCount = (size_t)(l_sourceTriangleCount * std::max(l_ratio, 0.0f));
+
+		while (l_context.m_triangleCount > l_targetTriangleCount)
+		{
+			if (!collapsePass(l_context, l_targetTriangleCount))
+			{
+				break;
+			}
+		}
+
+		if (l_context.m_triangleCount == 0 || l_context.m_triangleCount > l_lastTriangleCount * m_minReductionRatio)
+		{
+			continue;
+		}
+
+		l_lastTriangleCount = l_context.m_triangleCount;
+		l_result.emplace_back(generateLODData(l_context, vertices));
+	}
+
+	return l_result;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+
+struct MeshLODData
+{
+	std::vector<Vertex> m_vertices;
+	std::vector<Index> m_indices;
+	// the estimated max deviation from the source mesh in model space
+	float m_error = 0.0f;
+};
+
+// quadric error metric edge collapse, the vertices only collapse to their neighbours so no new attribute is interpolated,
+// the vertices split by UV or normal seams move together along the seams
+INNO_PRIVATE_SCOPE MeshSimplificationUtilities
+{
+	// one LOD per triangle ratio of the source mesh, the ratios are sorted from fine to coarse,
+	// the levels which couldn't be reduced any further are dropped
+	std::vector<MeshLODData> generateLODs(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, std::vector<float> triangleRatios);
+}
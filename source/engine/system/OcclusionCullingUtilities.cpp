@@ -0,0 +1,525 @@
+#include "OcclusionCullingUtilities.h"
+#include "VertexPackingUtilities.h"
+
+INNO_PRIVATE_SCOPE OcclusionCullingUtilities
+{
+	struct ClipVertex
+	{
+		float x;
+		float y;
+		float z;
+		float w;
+	};
+
+	// screen space position in pixels and NDC depth remapped to [0, 1]
+	struct ScreenTriangle
+	{
+		float x[3];
+		float y[3];
+		float z[3];
+		int minY;
+		int maxY;
+	};
+
+	struct Occluder
+	{
+		mat4 m_globalTm;
+		const MeshDataComponent* m_MDC;
+		std::vector<ScreenTriangle> m_triangles;
+	};
+
+	void getRows(const mat4& m, float rows[4][4]);
+	ClipVertex transform(const float rows[4][4], const vec4& pos);
+	void clipNearPlane(const ClipVertex* input, std::vector<ClipVertex>& output);
+	void emitTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, std::vector<ScreenTriangle>& triangles);
+	void rasterizeTriangle(const ScreenTriangle& triangle, int bandMinY, int bandMaxY);
+
+	// low resolution is enough for the large occluders, and the whole buffer stays in the L2 cache
+	const int m_depthBufferWidth = 256;
+	const int m_depthBufferHeight = 128;
+	const int m_bandHeight = 16;
+
+	// the screen space bounds of a tested object span less than this many texels of the selected pyramid level per axis
+	const int m_maxTestTexelCount = 2;
+
+	float m_viewProjectionRows[4][4];
+
+	std::vector<Occluder> m_occluders;
+
+	struct DepthPyramidLevel
+	{
+		int m_width;
+		int m_height;
+		std::vector<float> m_depth;
+	};
+
+	// level 0 is the depth buffer itself, the texels of each level store the max depth of 2x2 texels of the previous level
+	std::vector<DepthPyramidLevel> m_depthPyramid;
+}
+
+void OcclusionCullingUtilities::getRows(const mat4& m, float rows[4][4])
+{
+	//Column-Major memory layout
+#ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
+	rows[0][0] = m.m00; rows[0][1] = m.m10; rows[0][2] = m.m20; rows[0][3] = m.m30;
+	rows[1][0] = m.m01; rows[1][1] = m.m11; rows[1][2] = m.m21; rows[1][3] = m.m31;
+	rows[2][0] = m.m02; rows[2][1] = m.m12; rows[2][2] = m.m22; rows[2][3] = m.m32;
+	rows[3][0] = m.m03; rows[3][1] = m.m13; rows[3][2] = m.m23; rows[3][3] = m.m33;
+#endif
+	//Row-Major memory layout
+#ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
+	rows[0][0] = m.m00; rows[0][1] = m.m01; rows[0][2] = m.m02; rows[0][3] = m.m03;
+	rows[1][0] = m.m10; rows[1][1] = m.m11; rows[1][2] = m.m12; rows[1][3] = m.m13;
+	rows[2][0] = m.m20; rows[2][1] = m.m21; rows[2][2] = m.m22; rows[2][3] = m.m23;
+	rows[3][0] = m.m30; rows[3][1] = m.m31; rows[3][2] = m.m32; rows[3][3] = m.m33;
+#endif
+}
+
+OcclusionCullingUtilities::ClipVertex OcclusionCullingUtilities::transform(const float rows[4][4], const vec4& pos)
+{
+	ClipVertex l_result;
+
+	l_result.x = rows[0][0] * pos.x + rows[0][1] * pos.y + rows[0][2] * pos.z + rows[0][3];
+	l_result.y = rows[1][0] * pos.x + rows[1][1] * pos.y + rows[1][2] * pos.z + rows[1][3];
+	l_result.z = rows[2][0] * pos.x + rows[2][1] * pos.y + rows[2][2] * pos.z + rows[2][3];
+	l_result.w = rows[3][0] * pos.x + rows[3][1] * pos.y + rows[3][2] * pos.z + rows[3][3];
+
+	return l_result;
+}
+
+void OcclusionCullingUtilities::initialize()
+{
+	m_depthPyramid.clear();
+
+	auto l_width = m_depthBufferWidth;
+	auto l_height = m_depthBufferHeight;
+
+	while (true)
+	{
+		DepthPyramidLevel l_level;
+		l_level.m_width = l_width;
+		l_level.m_height = l_height;
+		l_level.m_depth.resize(l_width * l_height, 1.0f);
+
+		m_depthPyramid.emplace_back(std::move(l_level));
+
+		if (l_width == 1 && l_height == 1)
+		{
+			break;
+		}
+
+		l_width = std::max(l_width / 2, 1);
+		l_height = std::max(l_height / 2, 1);
+	}
+}
+
+void OcclusionCullingUtilities::beginFrame(const mat4& viewProjection)
+{
+	if (m_depthPyramid.empty())
+	{
+		initialize();
+	}
+
+	getRows(viewProjection, m_viewProjectionRows);
+
+	m_occluders.clear();
+
+	std::fill(m_depthPyramid[0].m_depth.begin(), m_depthPyramid[0].m_depth.end(), 1.0f);
+}
+
+void OcclusionCullingUtilities::addOccluder(const mat4& globalTm, const MeshDataComponent* MDC)
+{
+	m_occluders.emplace_back(Occluder{ globalTm, MDC, {} });
+}
+
+size_t OcclusionCullingUtilities::getOccluderCount()
+{
+	return m_occluders.size();
+}
+
+// Sutherland-Hodgman against the GL near plane z + w >= 0, the far plane and the screen edges are handled by the rasterizer
+void OcclusionCullingUtilities::clipNearPlane(const ClipVertex* input, std::vector<ClipVertex>& output)
+{
+	output.clear();
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto& l_current = input[i];
+		auto& l_next = input[(i + 1) % 3];
+
+		auto l_currentDistance = l_current.z + l_current.w;
+		auto l_nextDistance = l_next.z + l_next.w;
+
+		if (l_currentDistance >= 0.0f)
+		{
+			output.emplace_back(l_current);
+		}
+
+		if ((l_currentDistance >= 0.0f) != (l_nextDistance >= 0.0f))
+		{
+			auto l_t = l_currentDistance / (l_currentDistance - l_nextDistance);
+
+			ClipVertex l_intersection;
+			l_intersection.x = l_current.x + (l_next.x - l_current.x) * l_t;
+			l_intersection.y = l_current.y + (l_next.y - l_current.y) * l_t;
+			l_intersection.z = l_current.z + (l_next.z - l_current.z) * l_t;
+			l_intersection.w = l_current.w + (l_next.w - l_current.w) * l_t;
+
+			output.emplace_back(l_intersection);
+		}
+	}
+}
+
+void OcclusionCullingUtilities::emitTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, std::vector<ScreenTriangle>& triangles)
+{
+	const ClipVertex* l_vertices[3] = { &v0, &v1, &v2 };
+
+	ScreenTriangle l_triangle;
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto l_w = l_vertices[i]->w;
+
+		// degenerated perspective, can't happen after the near plane clipping with a regular projection matrix
+		if (l_w <= epsilon8<float>)
+		{
+			return;
+		}
+
+		auto l_invW = 1.0f / l_w;
+
+		l_triangle.x[i] = (l_vertices[i]->x * l_invW * 0.5f + 0.5f) * m_depthBufferWidth;
+		l_triangle.y[i] = (l_vertices[i]->y * l_invW * 0.5f + 0.5f) * m_depthBufferHeight;
+		l_triangle.z[i] = std::min(std::max(l_vertices[i]->z * l_invW * 0.5f + 0.5f, 0.0f), 1.0f);
+	}
+
+	auto l_area = (l_triangle.x[1] - l_triangle.x[0]) * (l_triangle.y[2] - l_triangle.y[0]) - (l_triangle.x[2] - l_triangle.x[0]) * (l_triangle.y[1] - l_triangle.y[0]);
+
+	if (std::abs(l_area) <= epsilon8<float>)
+	{
+		return;
+	}
+
+	// the occluders are rasterized double sided, only the winding order of the edge functions is unified
+	if (l_area < 0.0f)
+	{
+		std::swap(l_triangle.x[1], l_triangle.x[2]);
+		std::swap(l_triangle.y[1], l_triangle.y[2]);
+		std::swap(l_triangle.z[1], l_triangle.z[2]);
+	}
+
+	auto l_minY = std::min(l_triangle.y[0], std::min(l_triangle.y[1], l_triangle.y[2]));
+	auto l_maxY = std::max(l_triangle.y[0], std::max(l_triangle.y[1], l_triangle.y[2]));
+	auto l_minX = std::min(l_triangle.x[0], std::min(l_triangle.x[1], l_triangle.x[2]));
+	auto l_maxX = std::max(l_triangle.x[0], std::max(l_triangle.x[1], l_triangle.x[2]));
+
+	if (l_maxY < 0.0f || l_minY > (float)m_depthBufferHeight || l_maxX < 0.0f || l_minX > (float)m_depthBufferWidth)
+	{
+		return;
+	}
+
+	l_triangle.minY = std::max((int)std::floor(l_minY), 0);
+	l_triangle.maxY = std::min((int)std::ceil(l_maxY), m_depthBufferHeight - 1);
+
+	triangles.emplace_back(l_triangle);
+}
+
+void OcclusionCullingUtilities::setupOccluder(size_t occluderIndex)
+{
+	auto& l_occluder = m_occluders[occluderIndex];
+	auto l_indices = l_occluder.m_MDC->getIndices();
+
+	l_occluder.m_triangles.clear();
+	l_occluder.m_triangles.reserve(l_indices.size() / 3);
+
+	float l_globalTmRows[4][4];
+	getRows(l_occluder.m_globalTm, l_globalTmRows);
+
+	// concatenate the matrices once instead of transforming each vertex twice
+	float l_MVPRows[4][4];
+	for (size_t i = 0; i < 4; i++)
+	{
+		for (size_t j = 0; j < 4; j++)
+		{
+			l_MVPRows[i][j] = m_viewProjectionRows[i][0] * l_globalTmRows[0][j]
+				+ m_viewProjectionRows[i][1] * l_globalTmRows[1][j]
+				+ m_viewProjectionRows[i][2] * l_globalTmRows[2][j]
+				+ m_viewProjectionRows[i][3] * l_globalTmRows[3][j];
+		}
+	}
+
+	std::vector<ClipVertex> l_clipVertices;
+	l_clipVertices.reserve(VertexPackingUtilities::getVerticesCount(l_occluder.m_MDC));
+
+	VertexPackingUtilities::forEachPosition(l_occluder.m_MDC, [&](const vec4& pos)
+	{
+		l_clipVertices.emplace_back(transform(l_MVPRows, pos));
+	});
+
+	std::vector<ClipVertex> l_clippedPolygon;
+	l_clippedPolygon.reserve(4);
+
+	for (size_t i = 0; i + 2 < l_indices.size(); i += 3)
+	{
+		if (l_indices[i] >= l_clipVertices.size() || l_indices[i + 1] >= l_clipVertices.size() || l_indices[i + 2] >= l_clipVertices.size())
+		{
+			continue;
+		}
+
+		ClipVertex l_triangle[3] = { l_clipVertices[l_indices[i]], l_clipVertices[l_indices[i + 1]], l_clipVertices[l_indices[i + 2]] };
+
+		auto l_isInside = [](const ClipVertex& v) { return v.z + v.w >= 0.0f; };
+
+		if (l_isInside(l_triangle[0]) && l_isInside(l_triangle[1]) && l_isInside(l_triangle[2]))
+		{
+			emitTriangle(l_triangle[0], l_triangle[1], l_triangle[2], l_occluder.m_triangles);
+		}
+		else
+		{
+			clipNearPlane(l_triangle, l_clippedPolygon);
+
+			for (size_t j = 2; j < l_clippedPolygon.size(); j++)
+			{
+				emitTriangle(l_clippedPolygon[0], l_clippedPolygon[j - 1], l_clippedPolygon[j], l_occluder.m_triangles);
+			}
+		}
+	}
+}
+
+size_t OcclusionCullingUtilities::getBandCount()
+{
+	return (m_depthBufferHeight + m_bandHeight - 1) / m_bandHeight;
+}
+
+void OcclusionCullingUtilities::rasterizeBand(size_t bandIndex)
+{
+	auto l_bandMinY = (int)bandIndex * m_bandHeight;
+	auto l_bandMaxY = std::min(l_bandMinY + m_bandHeight, m_depthBufferHeight) - 1;
+
+	for (auto& i : m_occluders)
+	{
+		for (auto& j : i.m_triangles)
+		{
+			if (j.maxY >= l_bandMinY && j.minY <= l_bandMaxY)
+			{
+				rasterizeTriangle(j, l_bandMinY, l_bandMaxY);
+			}
+		}
+	}
+}
+
+// "A Parallel Algorithm for Polygon Rasterization", Juan Pineda, 1988
+// the pixel centers are sampled with edge functions, 4 pixels of a row at once with SSE
+void OcclusionCullingUtilities::rasterizeTriangle(const ScreenTriangle& triangle, int bandMinY, int bandMaxY)
+{
+	auto l_minX = std::max((int)std::floor(std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2]))), 0);
+	auto l_maxX = std::min((int)std::ceil(std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2]))), m_depthBufferWidth - 1);
+	auto l_minY = std::max(triangle.minY, bandMinY);
+	auto l_maxY = std::min(triangle.maxY, bandMaxY);
+
+	if (l_minX > l_maxX || l_minY > l_maxY)
+	{
+		return;
+	}
+
+	// E(x, y) = A * x + B * y + C, positive inside the triangle
+	float l_edgeA[3];
+	float l_edgeB[3];
+	float l_edgeC[3];
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto l_next = (i + 1) % 3;
+		l_edgeA[i] = triangle.y[i] - triangle.y[l_next];
+		l_edgeB[i] = triangle.x[l_next] - triangle.x[i];
+		l_edgeC[i] = -(l_edgeA[i] * triangle.x[i] + l_edgeB[i] * triangle.y[i]);
+	}
+
+	// the depth plane z(x, y) = A * x + B * y + C
+	auto l_area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) - (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+	auto l_depthA = ((triangle.z[1] - triangle.z[0]) * (triangle.y[2] - triangle.y[0]) - (triangle.z[2] - triangle.z[0]) * (triangle.y[1] - triangle.y[0])) / l_area;
+	auto l_depthB = ((triangle.z[2] - triangle.z[0]) * (triangle.x[1] - triangle.x[0]) - (triangle.z[1] - triangle.z[0]) * (triangle.x[2] - triangle.x[0])) / l_area;
+
+	// write the farthest depth of the plane inside the pixel instead of the one at the center, so an occluder never covers anything in front of it
+	auto l_depthC = triangle.z[0] - l_depthA * triangle.x[0] - l_depthB * triangle.y[0] + 0.5f * (std::abs(l_depthA) + std::abs(l_depthB));
+	auto l_maxDepth = std::max(triangle.z[0], std::max(triangle.z[1], triangle.z[2]));
+
+	auto l_depthBuffer = m_depthPyramid[0].m_depth.data();
+
+#if defined INNO_MATH_USE_SSE
+	// start at a multiple of 4 pixels, the buffer width is one too so the last group never runs past the row
+	l_minX &= ~3;
+
+	auto l_zero = _mm_setzero_ps();
+	auto l_pixelOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	auto l_maxDepthV = _mm_set1_ps(l_maxDepth);
+	auto l_depthAV = _mm_set1_ps(l_depthA);
+
+	__m128 l_edgeAV[3];
+	for (size_t i = 0; i < 3; i++)
+	{
+		l_edgeAV[i] = _mm_set1_ps(l_edgeA[i]);
+	}
+
+	for (int y = l_minY; y <= l_maxY; y++)
+	{
+		auto l_pixelY = (float)y + 0.5f;
+
+		__m128 l_edgeRowV[3];
+		for (size_t i = 0; i < 3; i++)
+		{
+			l_edgeRowV[i] = _mm_set1_ps(l_edgeB[i] * l_pixelY + l_edgeC[i]);
+		}
+		auto l_depthRowV = _mm_set1_ps(l_depthB * l_pixelY + l_depthC);
+
+		auto l_row = l_depthBuffer + y * m_depthBufferWidth;
+
+		for (int x = l_minX; x <= l_maxX; x += 4)
+		{
+			auto l_pixelX = _mm_add_ps(_mm_set1_ps((float)x), l_pixelOffset);
+
+			auto l_e0 = _mm_add_ps(_mm_mul_ps(l_edgeAV[0], l_pixelX), l_edgeRowV[0]);
+			auto l_e1 = _mm_add_ps(_mm_mul_ps(l_edgeAV[1], l_pixelX), l_edgeRowV[1]);
+			auto l_e2 = _mm_add_ps(_mm_mul_ps(l_edgeAV[2], l_pixelX), l_edgeRowV[2]);
+
+			auto l_mask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(l_e0, l_zero), _mm_cmpge_ps(l_e1, l_zero)), _mm_cmpge_ps(l_e2, l_zero));
+
+			if (_mm_movemask_ps(l_mask) == 0)
+			{
+				continue;
+			}
+
+			auto l_depth = _mm_min_ps(_mm_add_ps(_mm_mul_ps(l_depthAV, l_pixelX), l_depthRowV), l_maxDepthV);
+			auto l_oldDepth = _mm_loadu_ps(l_row + x);
+			auto l_newDepth = _mm_min_ps(l_oldDepth, l_depth);
+
+			_mm_storeu_ps(l_row + x, _mm_or_ps(_mm_and_ps(l_mask, l_newDepth), _mm_andnot_ps(l_mask, l_oldDepth)));
+		}
+	}
+#else
+	for (int y = l_minY; y <= l_maxY; y++)
+	{
+		auto l_pixelY = (float)y + 0.5f;
+		auto l_row = l_depthBuffer + y * m_depthBufferWidth;
+
+		for (int x = l_minX; x <= l_maxX; x++)
+		{
+			auto l_pixelX = (float)x + 0.5f;
+
+			if (l_edgeA[0] * l_pixelX + l_edgeB[0] * l_pixelY + l_edgeC[0] >= 0.0f
+				&& l_edgeA[1] * l_pixelX + l_edgeB[1] * l_pixelY + l_edgeC[1] >= 0.0f
+				&& l_edgeA[2] * l_pixelX + l_edgeB[2] * l_pixelY + l_edgeC[2] >= 0.0f)
+			{
+				auto l_depth = std::min(l_depthA * l_pixelX + l_depthB * l_pixelY + l_depthC, l_maxDepth);
+				l_row[x] = std::min(l_row[x], l_depth);
+			}
+		}
+	}
+#endif
+}
+
+void OcclusionCullingUtilities::buildDepthPyramid()
+{
+	for (size_t i = 1; i < m_depthPyramid.size(); i++)
+	{
+		auto& l_source = m_depthPyramid[i - 1];
+		auto& l_target = m_depthPyramid[i];
+
+		for (int y = 0; y < l_target.m_height; y++)
+		{
+			auto l_y0 = std::min(y * 2, l_source.m_height - 1);
+			auto l_y1 = std::min(y * 2 + 1, l_source.m_height - 1);
+
+			for (int x = 0; x < l_target.m_width; x++)
+			{
+				auto l_x0 = std::min(x * 2, l_source.m_width - 1);
+				auto l_x1 = std::min(x * 2 + 1, l_source.m_width - 1);
+
+				l_target.m_depth[y * l_target.m_width + x] = std::max(
+					std::max(l_source.m_depth[l_y0 * l_source.m_width + l_x0], l_source.m_depth[l_y0 * l_source.m_width + l_x1]),
+					std::max(l_source.m_depth[l_y1 * l_source.m_width + l_x0], l_source.m_depth[l_y1 * l_source.m_width + l_x1]));
+			}
+		}
+	}
+}
+
+bool OcclusionCullingUtilities::isOccluded(const AABB& worldAABB)
+{
+	if (m_occluders.empty())
+	{
+		return false;
+	}
+
+	auto l_minNDCX = std::numeric_limits<float>::max();
+	auto l_minNDCY = std::numeric_limits<float>::max();
+	auto l_minNDCZ = std::numeric_limits<float>::max();
+	auto l_maxNDCX = std::numeric_limits<float>::lowest();
+	auto l_maxNDCY = std::numeric_limits<float>::lowest();
+
+	for (size_t i = 0; i < 8; i++)
+	{
+		vec4 l_corner(
+			(i & 1) ? worldAABB.m_boundMax.x : worldAABB.m_boundMin.x,
+			(i & 2) ? worldAABB.m_boundMax.y : worldAABB.m_boundMin.y,
+			(i & 4) ? worldAABB.m_boundMax.z : worldAABB.m_boundMin.z,
+			1.0f);
+
+		auto l_clipCorner = transform(m_viewProjectionRows, l_corner);
+
+		// crossing the near plane, the screen space bounds are unbounded
+		if (l_clipCorner.z + l_clipCorner.w < 0.0f || l_clipCorner.w <= epsilon8<float>)
+		{
+			return false;
+		}
+
+		auto l_invW = 1.0f / l_clipCorner.w;
+
+		l_minNDCX = std::min(l_minNDCX, l_clipCorner.x * l_invW);
+		l_minNDCY = std::min(l_minNDCY, l_clipCorner.y * l_invW);
+		l_minNDCZ = std::min(l_minNDCZ, l_clipCorner.z * l_invW);
+		l_maxNDCX = std::max(l_maxNDCX, l_clipCorner.x * l_invW);
+		l_maxNDCY = std::max(l_maxNDCY, l_clipCorner.y * l_invW);
+	}
+
+	auto l_nearestDepth = l_minNDCZ * 0.5f + 0.5f;
+
+	auto l_minX = std::max((int)std::floor((l_minNDCX * 0.5f + 0.5f) * m_depthBufferWidth), 0);
+	auto l_maxX = std::min((int)std::floor((l_maxNDCX * 0.5f + 0.5f) * m_depthBufferWidth), m_depthBufferWidth - 1);
+	auto l_minY = std::max((int)std::floor((l_minNDCY * 0.5f + 0.5f) * m_depthBufferHeight), 0);
+	auto l_maxY = std::min((int)std::floor((l_maxNDCY * 0.5f + 0.5f) * m_depthBufferHeight), m_depthBufferHeight - 1);
+
+	// outside of the screen, left to the frustum culling
+	if (l_minX > l_maxX || l_minY > l_maxY)
+	{
+		return false;
+	}
+
+	// pick the finest level where the bounds cover only a few texels
+	size_t l_level = 0;
+	auto l_size = std::max(l_maxX - l_minX, l_maxY - l_minY);
+
+	while ((l_size >> l_level) >= m_maxTestTexelCount && l_level + 1 < m_depthPyramid.size())
+	{
+		l_level++;
+	}
+
+	auto& l_pyramidLevel = m_depthPyramid[l_level];
+
+	auto l_levelMinX = std::min(l_minX >> l_level, l_pyramidLevel.m_width - 1);
+	auto l_levelMaxX = std::min(l_maxX >> l_level, l_pyramidLevel.m_width - 1);
+	auto l_levelMinY = std::min(l_minY >> l_level, l_pyramidLevel.m_height - 1);
+	auto l_levelMaxY = std::min(l_maxY >> l_level, l_pyramidLevel.m_height - 1);
+
+	for (int y = l_levelMinY; y <= l_levelMaxY; y++)
+	{
+		for (int x = l_levelMinX; x <= l_levelMaxX; x++)
+		{
+			if (l_nearestDepth <= l_pyramidLevel.m_depth[y * l_pyramidLevel.m_width + x])
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+#include "../component/MeshDataComponent.h"
+
+// CPU software occlusion culling, a few large occluders are rasterized into a low resolution depth buffer,
+// then the screen space bounds of the other objects are tested against a max depth pyramid of it
+INNO_PRIVATE_SCOPE OcclusionCullingUtilities
+{
+	void initialize();
+
+	// clear the depth buffer and the occluder list of the last frame
+	void beginFrame(const mat4& viewProjection);
+
+	// only call these between beginFrame() and rasterize()
+	void addOccluder(const mat4& globalTm, const MeshDataComponent* MDC);
+	size_t getOccluderCount();
+
+	// jobs of the rasterization stage, all the setup jobs should finish before any rasterization job starts
+	void setupOccluder(size_t occluderIndex);
+	size_t getBandCount();
+	void rasterizeBand(size_t bandIndex);
+
+	// after all the rasterization jobs finished
+	void buildDepthPyramid();
+
+	// thread safe after buildDepthPyramid()
+	bool isOccluded(const AABB& worldAABB);
+}
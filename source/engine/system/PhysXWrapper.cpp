@@ -1,29 +1,642 @@
 #include "PhysXWrapper.h"
 
+#include <list>
 #include "PxPhysicsAPI.h"
 
+#include "../common/InnoConcurrency.h"
+#include "../component/GameSystemComponent.h"
+#include "../component/PhysicsSystemComponent.h"
+#include "VertexPackingUtilities.h"
+
+#include "ICoreSystem.h"
+
+extern ICoreSystem* g_pCoreSystem;
+
+using namespace physx;
+
 INNO_PRIVATE_SCOPE PhysXWrapperNS
 {
-	void setup();
+	class PhysXErrorCallback : public PxErrorCallback
+	{
+	public:
+		void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
+		{
+			auto l_logType = code == PxErrorCode::eDEBUG_INFO ? LogType::INNO_DEV_VERBOSE : code == PxErrorCode::eDEBUG_WARNING || code == PxErrorCode::ePERF_WARNING ? LogType::INNO_WARNING : LogType::INNO_ERROR;
+			g_pCoreSystem->getLogSystem()->printLog(l_logType, "PhysXWrapper: " + std::string(message) + " at " + std::string(file) + ":" + std::to_string(line));
+		}
+	};
+
+	// PhysX hands over its simulation tasks one by one, they go to the task system queue directly
+	// without an InnoFuture since PhysX tracks the completion by itself
+	class PhysXTask : public IThreadTask
+	{
+	public:
+		explicit PhysXTask(PxBaseTask& task) : m_task(task) {};
+
+		void execute() override
+		{
+			m_task.run();
+			m_task.release();
+		}
+
+	private:
+		PxBaseTask& m_task;
+	};
+
+	class PhysXCpuDispatcher : public PxCpuDispatcher
+	{
+	public:
+		void submitTask(PxBaseTask& task) override
+		{
+			g_pCoreSystem->getTaskSystem()->addTask(std::make_unique<PhysXTask>(task));
+		}
+
+		uint32_t getWorkerCount() const override
+		{
+			return (uint32_t)g_pCoreSystem->getTaskSystem()->getThreadCount();
+		}
+	};
+
+	struct ActorData
+	{
+		VisibleComponent* m_visibleComponent = nullptr;
+		TransformComponent* m_transformComponent = nullptr;
+		PxRigidActor* m_actor = nullptr;
+		// the last local transform written by the simulation, any other value is a teleport from the game side
+		vec4 m_writtenPos;
+		vec4 m_writtenRot;
+	};
+
+	bool setup();
+	bool initialize();
+	bool update(float deltaTime);
+	bool terminate();
+
+	void createActor(VisibleComponent* visibleComponent);
+	void createShapes(PxRigidActor* actor, VisibleComponent* visibleComponent, const vec4& scale);
+	PxConvexMesh* getConvexMesh(MeshDataComponent* MDC);
+	void addPendingActors();
+	bool syncTeleportedActor(ActorData& actorData);
+	void syncTeleportedActors();
+	void syncActiveActors();
+	void writeTransform(ActorData& actorData, const PxTransform& globalPose);
+	void releaseActors();
+
+	TransformVector getGlobalTransformVector(TransformComponent* transformComponent);
+
+	PxVec3 toPxVec3(const vec4& rhs) { return PxVec3(rhs.x, rhs.y, rhs.z); };
+	PxQuat toPxQuat(const vec4& rhs) { return PxQuat(rhs.x, rhs.y, rhs.z, rhs.w); };
+	vec4 toVec4(const PxVec3& rhs, float w) { return vec4(rhs.x, rhs.y, rhs.z, w); };
+	vec4 toVec4(const PxQuat& rhs) { return vec4(rhs.x, rhs.y, rhs.z, rhs.w); };
+
+	bool getProxy(const PxShape* shape, PhysicsProxy& result);
+
+	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
+
+	PxDefaultAllocator m_allocator;
+	PhysXErrorCallback m_errorCallback;
+	PhysXCpuDispatcher m_cpuDispatcher;
+
+	PxFoundation* m_foundation = nullptr;
+	PxPhysics* m_physics = nullptr;
+	PxCooking* m_cooking = nullptr;
+	PxScene* m_scene = nullptr;
+	PxMaterial* m_material = nullptr;
+
+	// guards the scene between the simulation and the queries
+	RWLock m_sceneLock;
+
+	std::mutex m_pendingActorsMutex;
+	std::vector<VisibleComponent*> m_pendingActors;
+	// the simulated components whose world bound has changed since the last simulation step
+	std::vector<VisibleComponent*> m_movedComponents;
+
+	// stable addresses for the actor user data
+	std::list<ActorData> m_actorDatas;
+	std::unordered_map<VisibleComponent*, ActorData*> m_actorDataMap;
+	std::unordered_map<MeshDataComponent*, PxConvexMesh*> m_convexMeshes;
+
+	const float m_fixedTimeStep = 1.0f / 60.0f;
+	const unsigned int m_maxSubSteps = 4;
+	const unsigned int m_maxOverlapCount = 256;
+	float m_accumulatedTime = 0.0f;
+}
+
+bool PhysXWrapperNS::setup()
+{
+	m_foundation = PxCreateFoundation(PX_PHYSICS_VERSION, m_allocator, m_errorCallback);
+	if (!m_foundation)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "PhysXWrapper: Can't create PxFoundation!");
+		return false;
+	}
+
+	PxTolerancesScale l_tolerancesScale;
+
+	m_physics = PxCreatePhysics(PX_PHYSICS_VERSION, *m_foundation, l_tolerancesScale, false, nullptr);
+	if (!m_physics)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "PhysXWrapper: Can't create PxPhysics!");
+		return false;
+	}
+
+	m_cooking = PxCreateCooking(PX_PHYSICS_VERSION, *m_foundation, PxCookingParams(l_tolerancesScale));
+	if (!m_cooking)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "PhysXWrapper: Can't create PxCooking!");
+		return false;
+	}
+
+	if (!PxInitExtensions(*m_physics, nullptr))
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "PhysXWrapper: Can't initialize PhysX extensions!");
+		return false;
+	}
+
+	PxSceneDesc l_sceneDesc(m_physics->getTolerancesScale());
+	l_sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	l_sceneDesc.cpuDispatcher = &m_cpuDispatcher;
+	l_sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	l_sceneDesc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS;
+
+	m_scene = m_physics->createScene(l_sceneDesc);
+	if (!m_scene)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_ERROR, "PhysXWrapper: Can't create PxScene!");
+		return false;
+	}
+
+	m_material = m_physics->createMaterial(0.6f, 0.6f, 0.0f);
+
+	m_objectStatus = ObjectStatus::ALIVE;
+
+	return true;
+}
+
+bool PhysXWrapperNS::initialize()
+{
+	if (m_objectStatus != ObjectStatus::ALIVE)
+	{
+		return false;
+	}
+
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "PhysXWrapper has been initialized.");
+	return true;
+}
+
+// the global transform is computed from the local one since the transform update of this frame might not be finished yet
+TransformVector PhysXWrapperNS::getGlobalTransformVector(TransformComponent* transformComponent)
+{
+	auto l_parent = transformComponent->m_parentTransformComponent;
+	if (l_parent)
+	{
+		return InnoMath::LocalTransformVectorToGlobal(transformComponent->m_localTransformVector, l_parent->m_globalTransformVector, l_parent->m_globalTransformMatrix);
+	}
+	return transformComponent->m_localTransformVector;
+}
+
+PxConvexMesh* PhysXWrapperNS::getConvexMesh(MeshDataComponent* MDC)
+{
+	auto l_result = m_convexMeshes.find(MDC);
+	if (l_result != m_convexMeshes.end())
+	{
+		return l_result->second;
+	}
+
+	std::vector<vec4> l_positions;
+	VertexPackingUtilities::getPositions(MDC, l_positions);
+
+	PxConvexMeshDesc l_convexMeshDesc;
+	l_convexMeshDesc.points.count = (PxU32)l_positions.size();
+	l_convexMeshDesc.points.stride = sizeof(vec4);
+	l_convexMeshDesc.points.data = l_positions.data();
+	l_convexMeshDesc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+	l_convexMeshDesc.vertexLimit = 64;
+
+	auto l_convexMesh = m_cooking->createConvexMesh(l_convexMeshDesc, m_physics->getPhysicsInsertionCallback());
+	if (!l_convexMesh)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "PhysXWrapper: Can't cook the convex mesh, fall back to the box shape.");
+	}
+
+	m_convexMeshes.emplace(MDC, l_convexMesh);
+
+	return l_convexMesh;
+}
+
+// the shapes are in the actor space with the global scale baked in, the same as the native rigid body module
+void PhysXWrapperNS::createShapes(PxRigidActor* actor, VisibleComponent* visibleComponent, const vec4& scale)
+{
+	auto l_absScale = vec4(std::abs(scale.x), std::abs(scale.y), std::abs(scale.z), 0.0f);
+	auto l_maxScale = std::max(std::max(l_absScale.x, l_absScale.y), l_absScale.z);
+
+	for (auto& physicsData : visibleComponent->m_PhysicsDataComponent->m_physicsDatas)
+	{
+		PxShape* l_shape = nullptr;
+		PxConvexMesh* l_convexMesh = nullptr;
+
+		if (visibleComponent->m_meshShapeType == MeshShapeType::SPHERE)
+		{
+			auto l_center = physicsData.sphere.m_center.scale(scale);
+			l_shape = PxRigidActorExt::createExclusiveShape(*actor, PxSphereGeometry(std::max(physicsData.sphere.m_radius * l_maxScale, 0.001f)), *m_material);
+			l_shape->setLocalPose(PxTransform(toPxVec3(l_center)));
+		}
+		else if (visibleComponent->m_meshShapeType != MeshShapeType::CUBE && physicsData.MDC && VertexPackingUtilities::getVerticesCount(physicsData.MDC))
+		{
+			l_convexMesh = getConvexMesh(physicsData.MDC);
+		}
+
+		if (l_convexMesh)
+		{
+			l_shape = PxRigidActorExt::createExclusiveShape(*actor, PxConvexMeshGeometry(l_convexMesh, PxMeshScale(toPxVec3(scale))), *m_material);
+		}
+		else if (!l_shape)
+		{
+			auto l_center = physicsData.aabb.m_center.scale(scale);
+			auto l_halfExtend = (physicsData.aabb.m_extend * 0.5f).scale(l_absScale);
+			auto l_geometry = PxBoxGeometry(std::max(l_halfExtend.x, 0.001f), std::max(l_halfExtend.y, 0.001f), std::max(l_halfExtend.z, 0.001f));
+			l_shape = PxRigidActorExt::createExclusiveShape(*actor, l_geometry, *m_material);
+			l_shape->setLocalPose(PxTransform(toPxVec3(l_center)));
+		}
+
+		l_shape->userData = &physicsData;
+	}
+}
+
+void PhysXWrapperNS::createActor(VisibleComponent* visibleComponent)
+{
+	auto l_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(visibleComponent->m_parentEntity);
+	if (!l_transformComponent || !visibleComponent->m_PhysicsDataComponent)
+	{
+		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "PhysXWrapper: Can't create the actor for VisibleComponent " + visibleComponent->m_parentEntity + "!");
+		return;
+	}
+
+	auto l_global = getGlobalTransformVector(l_transformComponent);
+	auto l_pose = PxTransform(toPxVec3(l_global.m_pos), toPxQuat(l_global.m_rot).getNormalized());
+
+	PxRigidActor* l_actor;
+	if (visibleComponent->m_mass > 0.0f)
+	{
+		auto l_rigidDynamic = m_physics->createRigidDynamic(l_pose);
+		createShapes(l_rigidDynamic, visibleComponent, l_global.m_scale);
+		PxRigidBodyExt::setMassAndUpdateInertia(*l_rigidDynamic, visibleComponent->m_mass);
+		l_actor = l_rigidDynamic;
+	}
+	else
+	{
+		l_actor = m_physics->createRigidStatic(l_pose);
+		createShapes(l_actor, visibleComponent, l_global.m_scale);
+	}
+
+	m_actorDatas.emplace_back();
+	auto& l_actorData = m_actorDatas.back();
+	l_actorData.m_visibleComponent = visibleComponent;
+	l_actorData.m_transformComponent = l_transformComponent;
+	l_actorData.m_actor = l_actor;
+	l_actorData.m_writtenPos = l_transformComponent->m_localTransformVector.m_pos;
+	l_actorData.m_writtenRot = l_transformComponent->m_localTransformVector.m_rot;
+
+	l_actor->userData = &l_actorData;
+	m_actorDataMap.emplace(visibleComponent, &l_actorData);
+
+	m_scene->addActor(*l_actor);
+}
+
+// the actors are created in the physics update since the transforms of the newly loaded entities are final by then
+void PhysXWrapperNS::addPendingActors()
+{
+	std::vector<VisibleComponent*> l_pendingActors;
+	{
+		std::lock_guard<std::mutex> l_lock(m_pendingActorsMutex);
+		std::swap(l_pendingActors, m_pendingActors);
+	}
+
+	for (auto i : l_pendingActors)
+	{
+		createActor(i);
+	}
+}
+
+// push the actor back into the scene if the game has moved it since the last write
+bool PhysXWrapperNS::syncTeleportedActor(ActorData& actorData)
+{
+	auto& l_localTransformVector = actorData.m_transformComponent->m_localTransformVector;
+	if (l_localTransformVector.m_pos == actorData.m_writtenPos && l_localTransformVector.m_rot == actorData.m_writtenRot)
+	{
+		return false;
+	}
+
+	auto l_global = getGlobalTransformVector(actorData.m_transformComponent);
+	actorData.m_actor->setGlobalPose(PxTransform(toPxVec3(l_global.m_pos), toPxQuat(l_global.m_rot).getNormalized()));
+
+	auto l_rigidDynamic = actorData.m_actor->is<PxRigidDynamic>();
+	if (l_rigidDynamic)
+	{
+		l_rigidDynamic->setLinearVelocity(PxVec3(0.0f));
+		l_rigidDynamic->setAngularVelocity(PxVec3(0.0f));
+		l_rigidDynamic->wakeUp();
+	}
+
+	actorData.m_writtenPos = l_localTransformVector.m_pos;
+	actorData.m_writtenRot = l_localTransformVector.m_rot;
+
+	return true;
+}
+
+// only the components from the moved bound list of the physics system are visited, the rest of the actors can't have been teleported
+void PhysXWrapperNS::syncTeleportedActors()
+{
+	std::vector<VisibleComponent*> l_movedComponents;
+	{
+		std::lock_guard<std::mutex> l_lock(m_pendingActorsMutex);
+		std::swap(l_movedComponents, m_movedComponents);
+	}
+
+	for (auto i : l_movedComponents)
+	{
+		auto l_result = m_actorDataMap.find(i);
+		if (l_result != m_actorDataMap.end())
+		{
+			syncTeleportedActor(*l_result->second);
+		}
+	}
+}
+
+void PhysXWrapperNS::writeTransform(ActorData& actorData, const PxTransform& globalPose)
+{
+	auto l_pos = toVec4(globalPose.p, 1.0f);
+	auto l_rot = toVec4(globalPose.q);
+
+	auto& l_localTransformVector = actorData.m_transformComponent->m_localTransformVector;
+	auto l_parent = actorData.m_transformComponent->m_parentTransformComponent;
+
+	if (l_parent)
+	{
+		auto l_parentInverse = l_parent->m_globalTransformMatrix.m_transformationMat;
+		l_parentInverse = l_parentInverse.inverseAffine();
+		l_localTransformVector.m_pos = InnoMath::caclGlobalPos(l_parentInverse, l_pos);
+		l_localTransformVector.m_rot = l_parent->m_globalTransformVector.m_rot.quatConjugate().quatMul(l_rot);
+	}
+	else
+	{
+		l_localTransformVector.m_pos = l_pos;
+		l_localTransformVector.m_rot = l_rot;
+	}
+
+	actorData.m_writtenPos = l_localTransformVector.m_pos;
+	actorData.m_writtenRot = l_localTransformVector.m_rot;
+}
+
+// the active actors list of PhysX is the changed transform set, the sleeping actors are never visited
+void PhysXWrapperNS::syncActiveActors()
+{
+	PxU32 l_activeActorCount = 0;
+	auto l_activeActors = m_scene->getActiveActors(l_activeActorCount);
+
+	for (PxU32 i = 0; i < l_activeActorCount; i++)
+	{
+		auto l_actor = static_cast<PxRigidActor*>(l_activeActors[i]);
+		auto l_actorData = reinterpret_cast<ActorData*>(l_actor->userData);
+		// the moved bound list arrives after this step, an awake actor teleported by the game would be overwritten otherwise
+		if (l_actorData && !syncTeleportedActor(*l_actorData))
+		{
+			writeTransform(*l_actorData, l_actor->getGlobalPose());
+		}
+	}
+
+	PxSimulationStatistics l_statistics;
+	m_scene->getSimulationStatistics(l_statistics);
+
+	PhysicsSystemComponent::get().m_rigidBodyCount = (unsigned int)m_actorDatas.size();
+	PhysicsSystemComponent::get().m_awakeRigidBodyCount = l_activeActorCount;
+	PhysicsSystemComponent::get().m_rigidBodyIslandCount = 0;
+	PhysicsSystemComponent::get().m_rigidBodyContactCount = l_statistics.nbDiscreteContactPairsTotal;
+}
+
+bool PhysXWrapperNS::update(float deltaTime)
+{
+	if (m_objectStatus != ObjectStatus::ALIVE)
+	{
+		return false;
+	}
+
+	std::unique_lock<RWLock> l_lock(m_sceneLock);
+
+	addPendingActors();
+	syncTeleportedActors();
+
+	m_accumulatedTime = std::min(m_accumulatedTime + deltaTime, m_fixedTimeStep * m_maxSubSteps);
+
+	bool l_simulated = false;
+	while (m_accumulatedTime >= m_fixedTimeStep)
+	{
+		m_scene->simulate(m_fixedTimeStep);
+		m_scene->fetchResults(true);
+		m_accumulatedTime -= m_fixedTimeStep;
+		l_simulated = true;
+	}
+
+	if (l_simulated)
+	{
+		syncActiveActors();
+	}
+
+	return true;
+}
+
+void PhysXWrapperNS::releaseActors()
+{
+	for (auto& i : m_actorDatas)
+	{
+		m_scene->removeActor(*i.m_actor);
+		i.m_actor->release();
+	}
+	m_actorDatas.clear();
+	m_actorDataMap.clear();
+
+	for (auto& i : m_convexMeshes)
+	{
+		if (i.second)
+		{
+			i.second->release();
+		}
+	}
+	m_convexMeshes.clear();
+
+	m_accumulatedTime = 0.0f;
+}
+
+bool PhysXWrapperNS::terminate()
+{
+	if (m_scene)
+	{
+		releaseActors();
+		m_scene->release();
+		m_scene = nullptr;
+	}
+	if (m_material)
+	{
+		m_material->release();
+		m_material = nullptr;
+	}
+	if (m_physics)
+	{
+		PxCloseExtensions();
+	}
+	if (m_cooking)
+	{
+		m_cooking->release();
+		m_cooking = nullptr;
+	}
+	if (m_physics)
+	{
+		m_physics->release();
+		m_physics = nullptr;
+	}
+	if (m_foundation)
+	{
+		m_foundation->release();
+		m_foundation = nullptr;
+	}
+
+	m_objectStatus = ObjectStatus::SHUTDOWN;
+	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "PhysXWrapper has been terminated.");
+
+	return true;
+}
+
+bool PhysXWrapperNS::getProxy(const PxShape* shape, PhysicsProxy& result)
+{
+	auto l_actorData = reinterpret_cast<ActorData*>(shape->getActor()->userData);
+	if (!l_actorData)
+	{
+		return false;
+	}
+
+	result.transformComponent = l_actorData->m_transformComponent;
+	result.visibleComponent = l_actorData->m_visibleComponent;
+	result.physicsData = reinterpret_cast<PhysicsData*>(shape->userData);
+
+	return true;
+}
+
+bool PhysXWrapper::setup()
+{
+	return PhysXWrapperNS::setup();
 }
 
-void PhysXWrapperNS::setup()
+bool PhysXWrapper::initialize()
 {
+	return PhysXWrapperNS::initialize();
 }
 
-void PhysXWrapper::setup()
+bool PhysXWrapper::update(float deltaTime)
 {
-	PhysXWrapperNS::setup();
+	return PhysXWrapperNS::update(deltaTime);
 }
 
-void PhysXWrapper::initialize()
+bool PhysXWrapper::terminate()
 {
+	return PhysXWrapperNS::terminate();
 }
 
-void PhysXWrapper::update()
+void PhysXWrapper::createActor(VisibleComponent* visibleComponent)
 {
+	std::lock_guard<std::mutex> l_lock(PhysXWrapperNS::m_pendingActorsMutex);
+	PhysXWrapperNS::m_pendingActors.emplace_back(visibleComponent);
 }
 
-void PhysXWrapper::terminate()
+void PhysXWrapper::addMovedComponents(const std::vector<VisibleComponent*>& visibleComponents)
 {
+	std::lock_guard<std::mutex> l_lock(PhysXWrapperNS::m_pendingActorsMutex);
+	PhysXWrapperNS::m_movedComponents.insert(PhysXWrapperNS::m_movedComponents.end(), visibleComponents.begin(), visibleComponents.end());
+}
+
+void PhysXWrapper::clearActors()
+{
+	{
+		std::lock_guard<std::mutex> l_lock(PhysXWrapperNS::m_pendingActorsMutex);
+		PhysXWrapperNS::m_pendingActors.clear();
+		PhysXWrapperNS::m_movedComponents.clear();
+	}
+
+	std::unique_lock<RWLock> l_lock(PhysXWrapperNS::m_sceneLock);
+	if (PhysXWrapperNS::m_scene)
+	{
+		PhysXWrapperNS::releaseActors();
+	}
+}
+
+bool PhysXWrapper::rayCastClosest(const Ray& ray, float maxDistance, PhysicsProxy& result, float& distance)
+{
+	std::shared_lock<RWLock> l_lock(PhysXWrapperNS::m_sceneLock);
+	if (!PhysXWrapperNS::m_scene)
+	{
+		return false;
+	}
+
+	auto l_direction = PhysXWrapperNS::toPxVec3(ray.m_direction);
+	if (l_direction.normalize() == 0.0f)
+	{
+		return false;
+	}
+
+	PxRaycastBuffer l_hit;
+	if (!PhysXWrapperNS::m_scene->raycast(PhysXWrapperNS::toPxVec3(ray.m_origin), l_direction, maxDistance, l_hit) || !l_hit.hasBlock)
+	{
+		return false;
+	}
+
+	distance = l_hit.block.distance;
+	return PhysXWrapperNS::getProxy(l_hit.block.shape, result);
+}
+
+void PhysXWrapper::queryOverlap(const AABB& bound, std::vector<PhysicsProxy>& result)
+{
+	std::shared_lock<RWLock> l_lock(PhysXWrapperNS::m_sceneLock);
+	if (!PhysXWrapperNS::m_scene)
+	{
+		return;
+	}
+
+	auto l_halfExtend = bound.m_extend * 0.5f;
+	PxBoxGeometry l_geometry(std::max(l_halfExtend.x, 0.001f), std::max(l_halfExtend.y, 0.001f), std::max(l_halfExtend.z, 0.001f));
+
+	std::vector<PxOverlapHit> l_touches(PhysXWrapperNS::m_maxOverlapCount);
+	PxOverlapBuffer l_hit(l_touches.data(), (PxU32)l_touches.size());
+	PhysXWrapperNS::m_scene->overlap(l_geometry, PxTransform(PhysXWrapperNS::toPxVec3(bound.m_center)), l_hit, PxQueryFilterData(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eNO_BLOCK));
+
+	for (PxU32 i = 0; i < l_hit.getNbTouches(); i++)
+	{
+		PhysicsProxy l_proxy;
+		if (PhysXWrapperNS::getProxy(l_hit.getTouch(i).shape, l_proxy))
+		{
+			result.emplace_back(l_proxy);
+		}
+	}
+}
+
+void PhysXWrapper::queryOverlap(const Sphere& sphere, std::vector<PhysicsProxy>& result)
+{
+	std::shared_lock<RWLock> l_lock(PhysXWrapperNS::m_sceneLock);
+	if (!PhysXWrapperNS::m_scene)
+	{
+		return;
+	}
+
+	PxSphereGeometry l_geometry(std::max(sphere.m_radius, 0.001f));
+
+	std::vector<PxOverlapHit> l_touches(PhysXWrapperNS::m_maxOverlapCount);
+	PxOverlapBuffer l_hit(l_touches.data(), (PxU32)l_touches.size());
+	PhysXWrapperNS::m_scene->overlap(l_geometry, PxTransform(PhysXWrapperNS::toPxVec3(sphere.m_center)), l_hit, PxQueryFilterData(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eNO_BLOCK));
+
+	for (PxU32 i = 0; i < l_hit.getNbTouches(); i++)
+	{
+		PhysicsProxy l_proxy;
+		if (PhysXWrapperNS::getProxy(l_hit.getTouch(i).shape, l_proxy))
+		{
+			result.emplace_back(l_proxy);
+		}
+	}
 }
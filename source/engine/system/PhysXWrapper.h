@@ -1,6 +1,10 @@
 #pragma once
 #include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+#include "../component/VisibleComponent.h"
 
+// the PhysX simulation backend, only built with INNO_USE_PHYSX,
+// the VisibleComponents with m_simulatePhysics become PhysX actors and the simulation tasks run on the ITaskSystem workers
 class PhysXWrapper
 {
 public:
@@ -11,11 +15,23 @@ public:
 		static PhysXWrapper instance;
 		return instance;
 	}
-	void setup();
-	void initialize();
-	void update();
-	void terminate();
+	bool setup();
+	bool initialize();
+	// advance the simulation by the elapsed time in seconds with fixed sub steps
+	bool update(float deltaTime);
+	bool terminate();
+
+	// the actor is added to the scene before the next simulation step
+	void createActor(VisibleComponent* visibleComponent);
+	// the simulated components whose world bound has changed, the teleported ones among them are synchronized before the next simulation step
+	void addMovedComponents(const std::vector<VisibleComponent*>& visibleComponents);
+	void clearActors();
+
+	// only the simulated actors are tested
+	bool rayCastClosest(const Ray& ray, float maxDistance, PhysicsProxy& result, float& distance);
+	void queryOverlap(const AABB& bound, std::vector<PhysicsProxy>& result);
+	void queryOverlap(const Sphere& sphere, std::vector<PhysicsProxy>& result);
 
 private:
 	PhysXWrapper() {};
-};
\ No newline at end of file
+};
@@ -5,7 +5,12 @@
 #include "../component/FileSystemComponent.h"
 #include "../component/PhysicsSystemComponent.h"
 
-//#include "PhysXWrapper.h"
+#include "OcclusionCullingUtilities.h"
+#include "RigidBodyUtilities.h"
+
+#if defined (INNO_USE_PHYSX)
+#include "PhysXWrapper.h"
+#endif
 
 #include "ICoreSystem.h"
 
@@ -27,7 +32,6 @@ namespace InnoPhysicsSystemNS
 
 	AABB generateAABB(const std::vector<Vertex>& vertices);
 	AABB generateAABB(vec4 boundMax, vec4 boundMin);
-	Sphere generateBoundSphere(AABB rhs);
 
 	std::vector<Vertex> generateAABBVertices(vec4 boundMax, vec4 boundMin);
 	std::vector<Vertex> generateAABBVertices(AABB rhs);
@@ -41,16 +45,88 @@ namespace InnoPhysicsSystemNS
 	void updateLightComponents();
 	void updateVisibleComponents();
 	void updateCulling();
-	AABB transformAABBtoWorldSpace(AABB rhs, mat4 globalTm);
 	void updateSceneAABB(AABB rhs);
 
+	using BVH = InnoBVH<PhysicsProxy>;
+
+	// per job output of the parallel bound update, merged on the physics thread
+	struct alignas(INNO_CACHE_LINE_SIZE) BoundUpdateBucket
+	{
+		std::vector<std::pair<PhysicsProxy, AABB>> m_insertions;
+		std::vector<std::pair<int, AABB>> m_reinsertions;
+		// the debug wireframes are only created for the components which draw their AABB
+		std::vector<PhysicsData*> m_wireframeRequests;
+		// the simulated components whose world bound has changed, the PhysX actors are only synchronized for these
+		std::vector<VisibleComponent*> m_movedSimulatedComponents;
+		// the batch transformation scratch of the bounds of one VisibleComponent
+		AABBSoA m_localAABBs;
+		AABBSoA m_worldAABBs;
+		vec4 m_sceneBoundMax;
+		vec4 m_sceneBoundMin;
+	};
+
+	// per job output of the parallel culling, merged on the physics thread
+	struct alignas(INNO_CACHE_LINE_SIZE) CullingBucket
+	{
+		std::vector<int> m_candidates;
+		SphereSoA m_spheres;
+		std::vector<unsigned char> m_visibility;
+		std::vector<CullingDataPack> m_cullingDataPacks;
+		std::vector<int> m_visibleProxyIDs;
+		// screen size estimation and proxy ID of the visible occluder candidates
+		std::vector<std::pair<float, int>> m_occluderCandidates;
+		size_t m_occlusionCulledCount;
+		size_t m_LODLevelCounts[4];
+		size_t m_LODSavedTriangleCount;
+	};
+
+	size_t getJobCount(size_t workCount, size_t minWorkPerJob);
+	template<class Job>
+	void dispatchJobs(size_t jobCount, Job&& job);
+	void updateBounds(BVH& bvh, size_t begin, size_t end, BoundUpdateBucket& bucket);
+	void cullSubtree(const BVH& bvh, const Frustum& frustum, const vec4& cameraPos, const BVH::FrustumQueryNode& subtree, CullingBucket& bucket);
+	bool isOccluderCandidate(const PhysicsProxy& proxy);
+	Sphere getWorldBoundSphere(const PhysicsProxy& proxy);
+	void updateOcclusionCulling(const BVH& bvh, const mat4& viewProjection);
+	void occludeBucket(const BVH& bvh, CullingBucket& bucket);
+	void selectLODs(const BVH& bvh, const vec4& cameraPos, float zNear, float errorScale, CullingBucket& bucket);
+	void updateShadowCasterCulling(const BVH& bvh);
+	CullingDataPack generateCullingDataPack(const PhysicsProxy& proxy);
+
+	// more jobs than threads to balance the uneven chunks
+	const size_t m_jobsPerThread = 4;
+	const size_t m_minVisibleComponentsPerJob = 256;
+	const size_t m_minBVHLeavesPerJob = 1024;
+
+	std::vector<BoundUpdateBucket> m_boundUpdateBuckets;
+	std::vector<CullingBucket> m_cullingBuckets;
+	std::vector<BVH::FrustumQueryNode> m_cullingSubtrees;
+
+	// the largest visible objects on screen are rasterized as occluders, plus the ones flagged by VisibleComponent::m_isOccluder
+	const size_t m_maxOccluderCount = 16;
+	const size_t m_maxOccluderTriangleCount = 4096;
+	// bound sphere radius over the distance to the camera
+	const float m_minOccluderScreenSize = 0.2f;
+
+	std::vector<std::pair<float, int>> m_occluderCandidates;
+
+	// a coarser LOD is only selected when its screen space error is below this ratio of the budget
+	const float m_LODHysteresis = 0.75f;
+
+	// rebuild the BVH with SAH when the incremental insertions exceed this ratio of the leaf count
+	const float m_BVHRebuildRatio = 0.5f;
+	size_t m_BVHInsertionsSinceBuild = 0;
+
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 	EntityID m_entityID;
 
 	std::vector<InnoFuture<void>> m_asyncTask;
 
-	vec4 m_sceneBoundMax = vec4(std::numeric_limits<float>::min(), std::numeric_limits<float>::min(), std::numeric_limits<float>::min(), 1.0f);
-	vec4 m_sceneBoundMin = vec4(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 1.0f);
+	const vec4 m_emptyBoundMax = vec4(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), 1.0f);
+	const vec4 m_emptyBoundMin = vec4(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 1.0f);
+
+	vec4 m_sceneBoundMax = m_emptyBoundMax;
+	vec4 m_sceneBoundMin = m_emptyBoundMin;
 
 	InputComponent* m_inputComponent;
 	std::function<void()> f_mouseSelect;
@@ -71,34 +147,23 @@ bool InnoPhysicsSystemNS::setup()
 			l_mouseRay.m_origin = g_pCoreSystem->getGameSystem()->get<TransformComponent>(GameSystemComponent::get().m_CameraComponents[0]->m_parentEntity)->m_globalTransformVector.m_pos;
 			l_mouseRay.m_direction = WindowSystemComponent::get().m_mousePositionInWorldSpace;
 
-			for (auto visibleComponent : GameSystemComponent::get().m_VisibleComponents)
+			PhysicsProxy l_proxy;
+			float l_distance;
+			if (g_pCoreSystem->getPhysicsSystem()->rayCastClosest(l_mouseRay, l_proxy, l_distance))
 			{
-				if (visibleComponent->m_visiblilityType != VisiblilityType::INNO_INVISIBLE)
-				{
-					auto l_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(visibleComponent->m_parentEntity);
-					auto l_globalTm = l_transformComponent->m_globalTransformMatrix.m_transformationMat;
-
-					if (visibleComponent->m_PhysicsDataComponent)
-					{
-						for (auto& physicsData : visibleComponent->m_PhysicsDataComponent->m_physicsDatas)
-						{
-							auto l_AABBws = transformAABBtoWorldSpace(physicsData.aabb, l_globalTm);
-
-							if (InnoMath::intersectCheck(l_AABBws, l_mouseRay))
-							{
-								PhysicsSystemComponent::get().m_selectedVisibleComponent = visibleComponent;
-								break;
-							}
-						}
-					}
-				}
+				PhysicsSystemComponent::get().m_selectedVisibleComponent = l_proxy.visibleComponent;
 			}
 		}
 	};
 
 	g_pCoreSystem->getGameSystem()->registerButtonStatusCallback(m_inputComponent, ButtonData{ INNO_MOUSE_BUTTON_LEFT, ButtonStatus::PRESSED }, &f_mouseSelect);
 
-	//PhysXWrapper::get().setup();
+#if defined (INNO_USE_PHYSX)
+	if (!PhysXWrapper::get().setup())
+	{
+		return false;
+	}
+#endif
 
 	m_objectStatus = ObjectStatus::ALIVE;
 
@@ -133,33 +198,28 @@ std::vector<Vertex> InnoPhysicsSystemNS::generateFrustumVertices(CameraComponent
 
 	auto l_NDC = InnoMath::generateNDC<float>();
 
-	for (auto& l_vertexData : l_NDC)
-	{
-		vec4 l_mulPos;
-		l_mulPos = l_vertexData.m_pos;
-		// from projection space to view space
-		//Column-Major memory layout
-#ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
-		l_mulPos = InnoMath::mul(l_mulPos, l_pCamera.inverse());
-#endif
-		//Row-Major memory layout
-#ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
-		l_mulPos = InnoMath::mul(l_pCamera.inverse(), l_mulPos);
-#endif
-		// perspective division
-		l_mulPos = l_mulPos * (1.0f / l_mulPos.w);
-		// from view space to world space
-		//Column-Major memory layout
+	// from projection space to world space, the perspective division is deferred after the affine view transformation
+	//Column-Major memory layout
 #ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
-		l_mulPos = InnoMath::mul(l_mulPos, l_rCamera);
-		l_mulPos = InnoMath::mul(l_mulPos, l_tCamera);
+	auto l_m = l_pCamera.inversePerspective() * l_rCamera * l_tCamera;
 #endif
-		//Row-Major memory layout
+	//Row-Major memory layout
 #ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
-		l_mulPos = InnoMath::mul(l_rCamera, l_mulPos);
-		l_mulPos = InnoMath::mul(l_tCamera, l_mulPos);
+	auto l_m = l_tCamera * l_rCamera * l_pCamera.inversePerspective();
 #endif
-		l_vertexData.m_pos = l_mulPos;
+
+	VectorSoA l_pos;
+	l_pos.reserve(l_NDC.size());
+	for (auto& l_vertexData : l_NDC)
+	{
+		l_pos.emplace_back(l_vertexData.m_pos);
+	}
+
+	InnoMath::transformPointsProjective(l_m, l_pos, l_pos);
+
+	for (size_t i = 0; i < l_NDC.size(); i++)
+	{
+		l_NDC[i].m_pos = l_pos.get(i, 1.0f);
 	}
 
 	for (auto& l_vertexData : l_NDC)
@@ -175,7 +235,11 @@ std::vector<Vertex> InnoPhysicsSystemNS::generateFrustumVertices(CameraComponent
 
 void InnoPhysicsSystemNS::generateFrustum(CameraComponent * cameraComponent)
 {
-	cameraComponent->m_frustum = InnoMath::makeFrustum(generateFrustumVertices(cameraComponent));
+	auto l_cameraTransformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(cameraComponent->m_parentEntity);
+	auto l_r = InnoMath::getInvertRotationMatrix(l_cameraTransformComponent->m_globalTransformVector.m_rot);
+	auto l_t = InnoMath::getInvertTranslationMatrix(l_cameraTransformComponent->m_globalTransformVector.m_pos);
+
+	cameraComponent->m_frustum = InnoMath::makeFrustum(cameraComponent->m_projectionMatrix * l_r * l_t);
 }
 
 void InnoPhysicsSystemNS::generatePointLightComponentAttenuationRadius(PointLightComponent* pointLightComponent)
@@ -224,29 +288,41 @@ void InnoPhysicsSystemNS::generateAABB(DirectionalLightComponent* directionalLig
 	directionalLightComponent->m_AABBsInWorldSpace = std::move(l_AABBsWS);
 
 	//4. transform frustum vertices to light space
-	auto l_lightRotMat = g_pCoreSystem->getGameSystem()->get<TransformComponent>(directionalLightComponent->m_parentEntity)->m_globalTransformMatrix.m_rotationMat.inverse();
+	auto l_lightRotMat = g_pCoreSystem->getGameSystem()->get<TransformComponent>(directionalLightComponent->m_parentEntity)->m_globalTransformMatrix.m_rotationMat.inverseOrthonormal();
+	VectorSoA l_pos;
+	l_pos.reserve(l_frustumVertices.size());
+	for (auto& l_vertexData : l_frustumVertices)
+	{
+		l_pos.emplace_back(l_vertexData.m_pos);
+	}
+
+	InnoMath::transformPoints(l_lightRotMat, l_pos, l_pos);
+
 	for (size_t i = 0; i < l_frustumVertices.size(); i++)
 	{
-		//Column-Major memory layout
-#ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
-		l_frustumVertices[i].m_pos = InnoMath::mul(l_frustumVertices[i].m_pos, l_lightRotMat);
-#endif
-		//Row-Major memory layout
-#ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
-		l_frustumVertices[i].m_pos = InnoMath::mul(l_lightRotMat, l_frustumVertices[i].m_pos);
-#endif
+		l_frustumVertices[i].m_pos = l_pos.get(i, 1.0f);
 	}
 
 	//5.calculate AABBs in light space
 	auto l_AABBsLS = frustumsVerticesToAABBs(l_frustumVertices, l_CSMSplitFactors);
 
 	//6. extend AABB to include the sphere
-	for (size_t i = 0; i < 4; i++)
+	AABBSoA l_AABBsLSSoA;
+	l_AABBsLSSoA.reserve(l_AABBsLS.size());
+	for (auto& l_AABB : l_AABBsLS)
+	{
+		l_AABBsLSSoA.emplace_back(l_AABB.m_center, l_AABB.m_extend * 0.5f);
+	}
+
+	SphereSoA l_spheresLS;
+	InnoMath::generateBoundSpheres(l_AABBsLSSoA, l_spheresLS);
+
+	for (size_t i = 0; i < l_AABBsLS.size(); i++)
 	{
-		auto sphereRadius = (l_AABBsLS[i].m_boundMax - l_AABBsLS[i].m_center).length();
-		auto l_boundMax = l_AABBsLS[i].m_center + sphereRadius;
+		auto l_center = vec4(l_spheresLS.m_centerX[i], l_spheresLS.m_centerY[i], l_spheresLS.m_centerZ[i], 1.0f);
+		auto l_boundMax = l_center + l_spheresLS.m_radius[i];
 		l_boundMax.w = 1.0f;
-		auto l_boundMin = l_AABBsLS[i].m_center - sphereRadius;
+		auto l_boundMin = l_center - l_spheresLS.m_radius[i];
 		l_boundMin.w = 1.0f;
 		l_AABBsLS[i] = generateAABB(l_boundMax, l_boundMin);
 	}
@@ -321,42 +397,11 @@ std::vector<AABB> InnoPhysicsSystemNS::frustumsVerticesToAABBs(const std::vector
 
 AABB InnoPhysicsSystemNS::generateAABB(const std::vector<Vertex>& vertices)
 {
-	float maxX = vertices[0].m_pos.x;
-	float maxY = vertices[0].m_pos.y;
-	float maxZ = vertices[0].m_pos.z;
-	float minX = vertices[0].m_pos.x;
-	float minY = vertices[0].m_pos.y;
-	float minZ = vertices[0].m_pos.z;
+	vec4 l_boundMax;
+	vec4 l_boundMin;
+	InnoMath::generateBounds(vertices.data(), vertices.size(), l_boundMax, l_boundMin);
 
-	for (auto& l_vertexData : vertices)
-	{
-		if (l_vertexData.m_pos.x >= maxX)
-		{
-			maxX = l_vertexData.m_pos.x;
-		}
-		if (l_vertexData.m_pos.y >= maxY)
-		{
-			maxY = l_vertexData.m_pos.y;
-		}
-		if (l_vertexData.m_pos.z >= maxZ)
-		{
-			maxZ = l_vertexData.m_pos.z;
-		}
-		if (l_vertexData.m_pos.x <= minX)
-		{
-			minX = l_vertexData.m_pos.x;
-		}
-		if (l_vertexData.m_pos.y <= minY)
-		{
-			minY = l_vertexData.m_pos.y;
-		}
-		if (l_vertexData.m_pos.z <= minZ)
-		{
-			minZ = l_vertexData.m_pos.z;
-		}
-	}
-
-	return generateAABB(vec4(maxX, maxY, maxZ, 1.0f), vec4(minX, minY, minZ, 1.0f));
+	return generateAABB(l_boundMax, l_boundMin);
 }
 
 AABB InnoPhysicsSystemNS::generateAABB(vec4 boundMax, vec4 boundMin)
@@ -372,14 +417,6 @@ AABB InnoPhysicsSystemNS::generateAABB(vec4 boundMax, vec4 boundMin)
 	return l_AABB;
 }
 
-Sphere InnoPhysicsSystemNS::generateBoundSphere(AABB rhs)
-{
-	Sphere l_result;
-	l_result.m_center = rhs.m_center;
-	l_result.m_radius = (rhs.m_boundMax - rhs.m_center).length();
-	return l_result;
-}
-
 std::vector<Vertex> InnoPhysicsSystemNS::generateAABBVertices(vec4 boundMax, vec4 boundMin)
 {
 	Vertex l_VertexData_1;
@@ -473,14 +510,19 @@ PhysicsDataComponent* InnoPhysicsSystemNS::generatePhysicsDataComponent(const Mo
 	{
 		PhysicsData l_physicsData;
 
-		auto l_AABB = generateAABB(l_MDC.first->m_vertices);
-		auto l_MDCforAABB = generateMeshDataComponent(l_AABB);
-		auto l_sphere = generateBoundSphere(l_AABB);
-
 		l_physicsData.MDC = l_MDC.first;
-		l_physicsData.wireframeMDC = l_MDCforAABB;
-		l_physicsData.aabb = l_AABB;
-		l_physicsData.sphere = l_sphere;
+
+		if (l_MDC.first->m_hasBounds)
+		{
+			l_physicsData.aabb = l_MDC.first->m_AABB;
+			l_physicsData.sphere = l_MDC.first->m_boundSphere;
+		}
+		else
+		{
+			auto& l_vertices = l_MDC.first->m_vertices;
+			l_physicsData.aabb = generateAABB(l_vertices);
+			l_physicsData.sphere = InnoMath::generateBoundSphere(l_vertices.data(), l_vertices.size(), l_physicsData.aabb.m_boundMax, l_physicsData.aabb.m_boundMin);
+		}
 
 		l_PDC->m_physicsDatas.emplace_back(l_physicsData);
 	}
@@ -488,30 +530,15 @@ PhysicsDataComponent* InnoPhysicsSystemNS::generatePhysicsDataComponent(const Mo
 	return l_PDC;
 }
 
-AABB InnoPhysicsSystemNS::transformAABBtoWorldSpace(AABB rhs, mat4 globalTm)
+INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::initialize()
 {
-	AABB l_AABB;
-
-	//Column-Major memory layout
-#ifdef USE_COLUMN_MAJOR_MEMORY_LAYOUT
-	l_AABB.m_boundMax = InnoMath::mul(rhs.m_boundMax, globalTm);
-	l_AABB.m_boundMin = InnoMath::mul(rhs.m_boundMin, globalTm);
-	l_AABB.m_center = InnoMath::mul(rhs.m_center, globalTm);
-#endif
-	//Row-Major memory layout
-#ifdef USE_ROW_MAJOR_MEMORY_LAYOUT
-	l_AABB.m_boundMax = InnoMath::mul(globalTm, rhs.m_boundMax);
-	l_AABB.m_boundMin = InnoMath::mul(globalTm, rhs.m_boundMin);
-	l_AABB.m_center = InnoMath::mul(globalTm, rhs.m_center);
+#if defined (INNO_USE_PHYSX)
+	if (!PhysXWrapper::get().initialize())
+	{
+		return false;
+	}
 #endif
 
-	l_AABB.m_extend = l_AABB.m_boundMax - l_AABB.m_boundMin;
-
-	return l_AABB;
-}
-
-INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::initialize()
-{
 	InnoPhysicsSystemNS::m_objectStatus = ObjectStatus::ALIVE;
 	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "PhysicsSystem has been initialized.");
 	return true;
@@ -543,73 +570,502 @@ void InnoPhysicsSystemNS::updateLightComponents()
 	}
 }
 
+size_t InnoPhysicsSystemNS::getJobCount(size_t workCount, size_t minWorkPerJob)
+{
+	auto l_maxJobCount = (g_pCoreSystem->getTaskSystem()->getThreadCount() + 1) * m_jobsPerThread;
+
+	return std::max<size_t>(std::min(workCount / minWorkPerJob, l_maxJobCount), 1);
+}
+
+template<class Job>
+void InnoPhysicsSystemNS::dispatchJobs(size_t jobCount, Job&& job)
+{
+	g_pCoreSystem->getTaskSystem()->dispatch(jobCount, job, m_asyncTask);
+}
+
+void InnoPhysicsSystemNS::updateBounds(BVH& bvh, size_t begin, size_t end, BoundUpdateBucket& bucket)
+{
+	bucket.m_insertions.clear();
+	bucket.m_reinsertions.clear();
+	bucket.m_wireframeRequests.clear();
+	bucket.m_movedSimulatedComponents.clear();
+	bucket.m_sceneBoundMax = m_emptyBoundMax;
+	bucket.m_sceneBoundMin = m_emptyBoundMin;
+
+	auto& l_visibleComponents = GameSystemComponent::get().m_VisibleComponents;
+
+	for (size_t i = begin; i < end; i++)
+	{
+		auto visibleComponent = l_visibleComponents[i];
+
+		if (visibleComponent->m_visiblilityType != VisiblilityType::INNO_INVISIBLE && visibleComponent->m_objectStatus == ObjectStatus::ALIVE)
+		{
+			auto l_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(visibleComponent->m_parentEntity);
+			auto l_globalTm = l_transformComponent->m_globalTransformMatrix.m_transformationMat;
+
+			if (visibleComponent->m_PhysicsDataComponent)
+			{
+				auto& l_physicsDatas = visibleComponent->m_PhysicsDataComponent->m_physicsDatas;
+
+				bucket.m_localAABBs.clear();
+				for (auto& physicsData : l_physicsDatas)
+				{
+					bucket.m_localAABBs.emplace_back(physicsData.aabb.m_center, physicsData.aabb.m_extend * 0.5f);
+				}
+
+				InnoMath::transformAABBs(l_globalTm, bucket.m_localAABBs, bucket.m_worldAABBs);
+
+				bool l_isMoved = false;
+
+				for (size_t j = 0; j < l_physicsDatas.size(); j++)
+				{
+					auto& physicsData = l_physicsDatas[j];
+					auto l_AABBws = bucket.m_worldAABBs.get(j);
+
+					bucket.m_sceneBoundMax.x = std::max(bucket.m_sceneBoundMax.x, l_AABBws.m_boundMax.x);
+					bucket.m_sceneBoundMax.y = std::max(bucket.m_sceneBoundMax.y, l_AABBws.m_boundMax.y);
+					bucket.m_sceneBoundMax.z = std::max(bucket.m_sceneBoundMax.z, l_AABBws.m_boundMax.z);
+					bucket.m_sceneBoundMin.x = std::min(bucket.m_sceneBoundMin.x, l_AABBws.m_boundMin.x);
+					bucket.m_sceneBoundMin.y = std::min(bucket.m_sceneBoundMin.y, l_AABBws.m_boundMin.y);
+					bucket.m_sceneBoundMin.z = std::min(bucket.m_sceneBoundMin.z, l_AABBws.m_boundMin.z);
+
+					// the tree structure can only be modified on the physics thread
+					if (physicsData.BVHProxyID == BVH::NULL_NODE)
+					{
+						bucket.m_insertions.emplace_back(PhysicsProxy{ l_transformComponent, visibleComponent, &physicsData }, l_AABBws);
+					}
+					else
+					{
+						if (visibleComponent->m_simulatePhysics && !l_isMoved)
+						{
+							l_isMoved = bvh.isTightBoundChanged(physicsData.BVHProxyID, l_AABBws);
+						}
+
+						if (!bvh.updateTightBound(physicsData.BVHProxyID, l_AABBws))
+						{
+							bucket.m_reinsertions.emplace_back(physicsData.BVHProxyID, l_AABBws);
+						}
+					}
+
+					if (visibleComponent->m_drawAABB && !physicsData.wireframeMDC)
+					{
+						bucket.m_wireframeRequests.emplace_back(&physicsData);
+					}
+				}
+
+				if (l_isMoved)
+				{
+					bucket.m_movedSimulatedComponents.emplace_back(visibleComponent);
+				}
+			}
+		}
+	}
+}
+
 void InnoPhysicsSystemNS::updateVisibleComponents()
 {
+	std::unique_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+
+	auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+	auto l_visibleComponentCount = GameSystemComponent::get().m_VisibleComponents.size();
+
+	auto l_jobCount = getJobCount(l_visibleComponentCount, m_minVisibleComponentsPerJob);
+	auto l_chunkSize = (l_visibleComponentCount + l_jobCount - 1) / l_jobCount;
+
+	m_boundUpdateBuckets.resize(l_jobCount);
+
+	dispatchJobs(l_jobCount, [&](size_t i) {
+		auto l_begin = std::min(i * l_chunkSize, l_visibleComponentCount);
+		auto l_end = std::min(l_begin + l_chunkSize, l_visibleComponentCount);
+		updateBounds(l_BVH, l_begin, l_end, m_boundUpdateBuckets[i]);
+	});
+
+	m_sceneBoundMax = m_emptyBoundMax;
+	m_sceneBoundMin = m_emptyBoundMin;
+
+	for (auto& i : m_boundUpdateBuckets)
+	{
+		updateSceneAABB(generateAABB(i.m_sceneBoundMax, i.m_sceneBoundMin));
+
+		for (auto& j : i.m_reinsertions)
+		{
+			l_BVH.update(j.first, j.second);
+		}
+		for (auto& j : i.m_insertions)
+		{
+			j.first.physicsData->BVHProxyID = l_BVH.insert(j.second, j.first);
+		}
+		for (auto j : i.m_wireframeRequests)
+		{
+			j->wireframeMDC = generateMeshDataComponent(j->aabb);
+		}
+
+#if defined (INNO_USE_PHYSX)
+		PhysXWrapper::get().addMovedComponents(i.m_movedSimulatedComponents);
+#endif
+
+		m_BVHInsertionsSinceBuild += i.m_reinsertions.size() + i.m_insertions.size();
+	}
+
+	// static geometry streams in incrementally while loading, rebuild it with SAH when most of the tree is new
+	if (m_BVHInsertionsSinceBuild > l_BVH.size() * m_BVHRebuildRatio)
+	{
+		l_BVH.build();
+		m_BVHInsertionsSinceBuild = 0;
+	}
 }
 
 void InnoPhysicsSystemNS::updateSceneAABB(AABB rhs)
 {
-	auto boundMax = rhs.m_boundMax;
-	auto boundMin = rhs.m_boundMin;
+	m_sceneBoundMax.x = std::max(m_sceneBoundMax.x, rhs.m_boundMax.x);
+	m_sceneBoundMax.y = std::max(m_sceneBoundMax.y, rhs.m_boundMax.y);
+	m_sceneBoundMax.z = std::max(m_sceneBoundMax.z, rhs.m_boundMax.z);
+	m_sceneBoundMin.x = std::min(m_sceneBoundMin.x, rhs.m_boundMin.x);
+	m_sceneBoundMin.y = std::min(m_sceneBoundMin.y, rhs.m_boundMin.y);
+	m_sceneBoundMin.z = std::min(m_sceneBoundMin.z, rhs.m_boundMin.z);
+}
 
-	if (boundMax.x > InnoPhysicsSystemNS::m_sceneBoundMax.x
-		&&boundMax.y > InnoPhysicsSystemNS::m_sceneBoundMax.y
-		&&boundMax.z > InnoPhysicsSystemNS::m_sceneBoundMax.z)
+void InnoPhysicsSystemNS::cullSubtree(const BVH& bvh, const Frustum& frustum, const vec4& cameraPos, const BVH::FrustumQueryNode& subtree, CullingBucket& bucket)
+{
+	bucket.m_candidates.clear();
+	bucket.m_spheres.clear();
+	bucket.m_cullingDataPacks.clear();
+	bucket.m_visibleProxyIDs.clear();
+	bucket.m_occluderCandidates.clear();
+
+	// coarse pass, walk the BVH and test the world space AABBs hierarchically
+	bvh.queryFrustum(frustum, subtree, [&](int proxyID) {
+		bucket.m_candidates.emplace_back(proxyID);
+	});
+
+	auto l_candidateCount = bucket.m_candidates.size();
+
+	// fine pass, bound spheres follow the rotation of the mesh and are tighter than the world space AABBs for rotated objects
+	bucket.m_spheres.reserve(l_candidateCount);
+
+	for (auto proxyID : bucket.m_candidates)
 	{
-		InnoPhysicsSystemNS::m_sceneBoundMax = boundMax;
+		auto l_sphere = getWorldBoundSphere(bvh.getUserData(proxyID));
+
+		bucket.m_spheres.emplace_back(l_sphere.m_center, l_sphere.m_radius);
 	}
-	if (boundMax.x < InnoPhysicsSystemNS::m_sceneBoundMax.x
-		&&boundMax.y < InnoPhysicsSystemNS::m_sceneBoundMax.y
-		&&boundMax.z < InnoPhysicsSystemNS::m_sceneBoundMax.z)
+
+	bucket.m_visibility.resize(l_candidateCount);
+	auto l_visibleCount = InnoMath::intersectCheck(frustum, bucket.m_spheres, 0, l_candidateCount, bucket.m_visibility.data());
+
+	bucket.m_cullingDataPacks.reserve(l_visibleCount);
+	bucket.m_visibleProxyIDs.reserve(l_visibleCount);
+
+	for (size_t i = 0; i < l_candidateCount; i++)
 	{
-		InnoPhysicsSystemNS::m_sceneBoundMin = boundMin;
+		if (bucket.m_visibility[i])
+		{
+			auto l_proxyID = bucket.m_candidates[i];
+			auto& l_proxy = bvh.getUserData(l_proxyID);
+
+			if (isOccluderCandidate(l_proxy))
+			{
+				auto l_distance = (vec4(bucket.m_spheres.m_centerX[i], bucket.m_spheres.m_centerY[i], bucket.m_spheres.m_centerZ[i], 1.0f) - cameraPos).length();
+				auto l_screenSize = l_distance > bucket.m_spheres.m_radius[i] ? bucket.m_spheres.m_radius[i] / l_distance : 1.0f;
+
+				if (l_proxy.visibleComponent->m_isOccluder)
+				{
+					bucket.m_occluderCandidates.emplace_back(std::numeric_limits<float>::max(), l_proxyID);
+				}
+				else if (l_screenSize >= m_minOccluderScreenSize)
+				{
+					bucket.m_occluderCandidates.emplace_back(l_screenSize, l_proxyID);
+				}
+			}
+
+			bucket.m_cullingDataPacks.emplace_back(generateCullingDataPack(l_proxy));
+			bucket.m_visibleProxyIDs.emplace_back(l_proxyID);
+		}
+	}
+}
+
+Sphere InnoPhysicsSystemNS::getWorldBoundSphere(const PhysicsProxy& proxy)
+{
+	// the bound sphere is not always centered on the AABB, its center follows the transformation of the mesh
+	auto& l_sphere = proxy.physicsData->sphere;
+	auto l_globalScale = proxy.transformComponent->m_globalTransformVector.m_scale;
+	auto l_maxScale = std::max(std::abs(l_globalScale.x), std::max(std::abs(l_globalScale.y), std::abs(l_globalScale.z)));
+
+	Sphere l_result;
+	l_result.m_center = InnoMath::caclGlobalPos(proxy.transformComponent->m_globalTransformMatrix.m_transformationMat, vec4(l_sphere.m_center.x, l_sphere.m_center.y, l_sphere.m_center.z, 1.0f));
+	l_result.m_radius = l_sphere.m_radius * l_maxScale;
+
+	return l_result;
+}
+
+CullingDataPack InnoPhysicsSystemNS::generateCullingDataPack(const PhysicsProxy& proxy)
+{
+	CullingDataPack l_cullingDataPack;
+
+	l_cullingDataPack.m = proxy.transformComponent->m_globalTransformMatrix.m_transformationMat;
+	l_cullingDataPack.m_prev = proxy.transformComponent->m_globalTransformMatrix_prev.m_transformationMat;
+	l_cullingDataPack.normalMat = proxy.transformComponent->m_globalTransformMatrix.m_rotationMat;
+	l_cullingDataPack.visibleComponent = proxy.visibleComponent;
+	l_cullingDataPack.MDC = proxy.physicsData->MDC;
+	l_cullingDataPack.LODLevel = proxy.physicsData->LODLevel;
+
+	return l_cullingDataPack;
+}
+
+bool InnoPhysicsSystemNS::isOccluderCandidate(const PhysicsProxy& proxy)
+{
+	auto l_MDC = proxy.physicsData->MDC;
+
+	if (!l_MDC || l_MDC->m_meshPrimitiveTopology != MeshPrimitiveTopology::TRIANGLE || l_MDC->getIndices().empty())
+	{
+		return false;
+	}
+
+	if (proxy.visibleComponent->m_isOccluder)
+	{
+		return true;
+	}
+
+	return proxy.visibleComponent->m_visiblilityType == VisiblilityType::INNO_OPAQUE && l_MDC->getIndices().size() / 3 <= m_maxOccluderTriangleCount;
+}
+
+void InnoPhysicsSystemNS::updateOcclusionCulling(const BVH& bvh, const mat4& viewProjection)
+{
+	m_occluderCandidates.clear();
+
+	for (auto& i : m_cullingBuckets)
+	{
+		i.m_occlusionCulledCount = 0;
+		m_occluderCandidates.insert(m_occluderCandidates.end(), i.m_occluderCandidates.begin(), i.m_occluderCandidates.end());
+	}
+
+	if (m_occluderCandidates.empty())
+	{
+		return;
+	}
+
+	auto l_occluderCount = std::min(m_occluderCandidates.size(), m_maxOccluderCount);
+
+	std::partial_sort(m_occluderCandidates.begin(), m_occluderCandidates.begin() + l_occluderCount, m_occluderCandidates.end(), [](const std::pair<float, int>& lhs, const std::pair<float, int>& rhs) {
+		return lhs.first > rhs.first;
+	});
+
+	OcclusionCullingUtilities::beginFrame(viewProjection);
+
+	for (size_t i = 0; i < l_occluderCount; i++)
+	{
+		auto& l_proxy = bvh.getUserData(m_occluderCandidates[i].second);
+		OcclusionCullingUtilities::addOccluder(l_proxy.transformComponent->m_globalTransformMatrix.m_transformationMat, l_proxy.physicsData->MDC);
+	}
+
+	dispatchJobs(l_occluderCount, [&](size_t i) {
+		OcclusionCullingUtilities::setupOccluder(i);
+	});
+
+	// each job owns a horizontal band of the depth buffer
+	dispatchJobs(OcclusionCullingUtilities::getBandCount(), [&](size_t i) {
+		OcclusionCullingUtilities::rasterizeBand(i);
+	});
+
+	OcclusionCullingUtilities::buildDepthPyramid();
+
+	dispatchJobs(m_cullingBuckets.size(), [&](size_t i) {
+		occludeBucket(bvh, m_cullingBuckets[i]);
+	});
+}
+
+void InnoPhysicsSystemNS::occludeBucket(const BVH& bvh, CullingBucket& bucket)
+{
+	size_t l_visibleCount = 0;
+
+	for (size_t i = 0; i < bucket.m_cullingDataPacks.size(); i++)
+	{
+		if (!OcclusionCullingUtilities::isOccluded(bvh.getBound(bucket.m_visibleProxyIDs[i])))
+		{
+			bucket.m_cullingDataPacks[l_visibleCount] = bucket.m_cullingDataPacks[i];
+			bucket.m_visibleProxyIDs[l_visibleCount] = bucket.m_visibleProxyIDs[i];
+			l_visibleCount++;
+		}
+	}
+
+	bucket.m_occlusionCulledCount = bucket.m_cullingDataPacks.size() - l_visibleCount;
+
+	bucket.m_cullingDataPacks.resize(l_visibleCount);
+	bucket.m_visibleProxyIDs.resize(l_visibleCount);
+}
+
+void InnoPhysicsSystemNS::selectLODs(const BVH& bvh, const vec4& cameraPos, float zNear, float errorScale, CullingBucket& bucket)
+{
+	std::fill(std::begin(bucket.m_LODLevelCounts), std::end(bucket.m_LODLevelCounts), 0);
+	bucket.m_LODSavedTriangleCount = 0;
+
+	for (size_t i = 0; i < bucket.m_cullingDataPacks.size(); i++)
+	{
+		auto l_proxyID = bucket.m_visibleProxyIDs[i];
+		auto& l_proxy = bvh.getUserData(l_proxyID);
+		auto l_MDC = l_proxy.physicsData->MDC;
+		auto l_LODCount = (unsigned int)std::min(l_MDC->m_LODs.size(), l_MDC->m_LODErrors.size());
+		auto l_level = std::min(l_proxy.physicsData->LODLevel, l_LODCount);
+
+		if (l_LODCount)
+		{
+			auto l_globalScale = l_proxy.transformComponent->m_globalTransformVector.m_scale;
+			auto l_maxScale = std::max(std::abs(l_globalScale.x), std::max(std::abs(l_globalScale.y), std::abs(l_globalScale.z)));
+			auto l_sphere = getWorldBoundSphere(l_proxy);
+			auto l_distance = (l_sphere.m_center - cameraPos).length() - l_sphere.m_radius;
+
+			// the screen space error over the budget of a unit model space deviation at the nearest point of the bound sphere
+			auto l_errorScale = errorScale * l_maxScale / std::max(l_distance, zNear);
+
+			while (l_level > 0 && l_MDC->m_LODErrors[l_level - 1] * l_errorScale > 1.0f)
+			{
+				l_level--;
+			}
+
+			// the LOD would pop back and forth around the budget without the hysteresis
+			while (l_level < l_LODCount && l_MDC->m_LODErrors[l_level] * l_errorScale < m_LODHysteresis)
+			{
+				l_level++;
+			}
+
+			l_proxy.physicsData->LODLevel = l_level;
+
+			if (l_level > 0 && l_MDC->m_indicesSize > l_MDC->m_LODs[l_level - 1]->m_indicesSize)
+			{
+				bucket.m_LODSavedTriangleCount += (l_MDC->m_indicesSize - l_MDC->m_LODs[l_level - 1]->m_indicesSize) / 3;
+			}
+		}
+
+		bucket.m_cullingDataPacks[i].LODLevel = l_level;
+		bucket.m_LODLevelCounts[std::min<size_t>(l_level, 3)]++;
+	}
+}
+
+void InnoPhysicsSystemNS::updateShadowCasterCulling(const BVH& bvh)
+{
+	std::vector<std::vector<CullingDataPack>> l_shadowCullingDataPacks;
+
+	if (GameSystemComponent::get().m_DirectionalLightComponents.size() > 0)
+	{
+		auto l_directionalLight = GameSystemComponent::get().m_DirectionalLightComponents[0];
+		auto l_lightRotMat = g_pCoreSystem->getGameSystem()->get<TransformComponent>(l_directionalLight->m_parentEntity)->m_globalTransformMatrix.m_rotationMat.inverseOrthonormal();
+
+		l_shadowCullingDataPacks.resize(l_directionalLight->m_projectionMatrices.size());
+
+		dispatchJobs(l_shadowCullingDataPacks.size(), [&](size_t i) {
+			// the same view projection matrix as the shadow pass of the cascade
+			auto l_cascadeFrustum = InnoMath::makeFrustum(l_directionalLight->m_projectionMatrices[i] * l_lightRotMat);
+
+			// the casters between the light and the cascade still cast shadows into it, extrude the volume toward the light by ignoring the near plane
+			bvh.queryFrustum(l_cascadeFrustum, [&](int proxyID) {
+				auto& l_proxy = bvh.getUserData(proxyID);
+				if (l_proxy.visibleComponent->m_visiblilityType == VisiblilityType::INNO_OPAQUE)
+				{
+					l_shadowCullingDataPacks[i].emplace_back(generateCullingDataPack(l_proxy));
+				}
+			}, BVH::ALL_PLANES & ~BVH::NEAR_PLANE);
+		});
+	}
+
+	size_t l_shadowCasterCount = 0;
+
+	for (auto& i : l_shadowCullingDataPacks)
+	{
+		l_shadowCasterCount += i.size();
 	}
+
+	PhysicsSystemComponent::get().m_shadowCullingDataPack.setRawData(std::move(l_shadowCullingDataPacks));
+	PhysicsSystemComponent::get().m_shadowCasterCount = (unsigned int)l_shadowCasterCount;
 }
 
 void InnoPhysicsSystemNS::updateCulling()
 {
 	PhysicsSystemComponent::get().m_cullingDataPack.clear();
+	PhysicsSystemComponent::get().m_shadowCullingDataPack.clear();
 
 	if (GameSystemComponent::get().m_CameraComponents.size() > 0)
 	{
-		Ray l_mouseRay;
-		l_mouseRay.m_origin = g_pCoreSystem->getGameSystem()->get<TransformComponent>(GameSystemComponent::get().m_CameraComponents[0]->m_parentEntity)->m_globalTransformVector.m_pos;
-		l_mouseRay.m_direction = WindowSystemComponent::get().m_mousePositionInWorldSpace;
+		auto l_cameraComponent = GameSystemComponent::get().m_CameraComponents[0];
+		auto l_cameraFrustum = l_cameraComponent->m_frustum;
+
+		auto l_cameraTransformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(l_cameraComponent->m_parentEntity);
+		auto l_cameraPos = l_cameraTransformComponent->m_globalTransformVector.m_pos;
+		auto l_r = InnoMath::getInvertRotationMatrix(l_cameraTransformComponent->m_globalTransformVector.m_rot);
+		auto l_t = InnoMath::getInvertTranslationMatrix(l_cameraPos);
+		auto l_viewProjection = l_cameraComponent->m_projectionMatrix * l_r * l_t;
+
+		std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+
+		auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+
+		// each job walks an independent subtree and writes into its own bucket
+		m_cullingSubtrees.clear();
+		l_BVH.splitFrustumQuery(l_cameraFrustum, getJobCount(l_BVH.size(), m_minBVHLeavesPerJob), m_cullingSubtrees);
+
+		m_cullingBuckets.resize(m_cullingSubtrees.size());
 
-		auto l_cameraFrustum = GameSystemComponent::get().m_CameraComponents[0]->m_frustum;
-		auto l_eyeRay = GameSystemComponent::get().m_CameraComponents[0]->m_rayOfEye;
+		dispatchJobs(m_cullingSubtrees.size(), [&](size_t i) {
+			cullSubtree(l_BVH, l_cameraFrustum, l_cameraPos, m_cullingSubtrees[i], m_cullingBuckets[i]);
+		});
 
-		for (auto visibleComponent : GameSystemComponent::get().m_VisibleComponents)
+		size_t l_candidateCount = 0;
+		size_t l_frustumVisibleCount = 0;
+
+		for (auto& i : m_cullingBuckets)
 		{
-			if (visibleComponent->m_visiblilityType != VisiblilityType::INNO_INVISIBLE && visibleComponent->m_objectStatus == ObjectStatus::ALIVE)
-			{
-				auto l_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(visibleComponent->m_parentEntity);
-				auto l_globalTm = l_transformComponent->m_globalTransformMatrix.m_transformationMat;
+			l_candidateCount += i.m_candidates.size();
+			l_frustumVisibleCount += i.m_cullingDataPacks.size();
+		}
 
-				if (visibleComponent->m_PhysicsDataComponent)
-				{
-					for (auto& physicsData : visibleComponent->m_PhysicsDataComponent->m_physicsDatas)
-					{
-						auto l_AABBws = transformAABBtoWorldSpace(physicsData.aabb, l_globalTm);
+		updateOcclusionCulling(l_BVH, l_viewProjection);
 
-						//if (InnoMath::intersectCheck(l_AABBws, l_cameraAABB))
-						//{
-						CullingDataPack l_cullingDataPack;
+		// pixels per unit at unit distance
+		auto l_projectionScale = l_cameraComponent->m_projectionMatrix.m11 * WindowSystemComponent::get().m_windowResolution.y * 0.5f;
+		auto l_errorScale = l_projectionScale / std::max(PhysicsSystemComponent::get().m_LODErrorBudget.load(), std::numeric_limits<float>::epsilon());
 
-						l_cullingDataPack.m = l_globalTm;
-						l_cullingDataPack.m_prev = l_transformComponent->m_globalTransformMatrix_prev.m_transformationMat;
-						l_cullingDataPack.normalMat = l_transformComponent->m_globalTransformMatrix.m_rotationMat;
-						l_cullingDataPack.visibleComponent = visibleComponent;
-						l_cullingDataPack.MDC = physicsData.MDC;
+		dispatchJobs(m_cullingBuckets.size(), [&](size_t i) {
+			selectLODs(l_BVH, l_cameraPos, l_cameraComponent->m_zNear, l_errorScale, m_cullingBuckets[i]);
+		});
 
-						PhysicsSystemComponent::get().m_cullingDataPack.emplace_back(l_cullingDataPack);
-						//}
+		size_t l_visibleCount = 0;
+		size_t l_LODLevelCounts[4] = {};
+		size_t l_LODSavedTriangleCount = 0;
 
-						updateSceneAABB(l_AABBws);
-					}
-				}
+		for (auto& i : m_cullingBuckets)
+		{
+			l_visibleCount += i.m_cullingDataPacks.size();
+			l_LODSavedTriangleCount += i.m_LODSavedTriangleCount;
+
+			for (size_t j = 0; j < 4; j++)
+			{
+				l_LODLevelCounts[j] += i.m_LODLevelCounts[j];
 			}
 		}
+
+		std::vector<CullingDataPack> l_cullingDataPacks;
+		l_cullingDataPacks.reserve(l_visibleCount);
+
+		for (auto& i : m_cullingBuckets)
+		{
+			l_cullingDataPacks.insert(l_cullingDataPacks.end(), i.m_cullingDataPacks.begin(), i.m_cullingDataPacks.end());
+		}
+
+		PhysicsSystemComponent::get().m_cullingDataPack.setRawData(std::move(l_cullingDataPacks));
+
+		updateShadowCasterCulling(l_BVH);
+
+		PhysicsSystemComponent::get().m_cullingCandidateCount = (unsigned int)l_BVH.size();
+		PhysicsSystemComponent::get().m_BVHCulledCount = (unsigned int)(l_BVH.size() - l_candidateCount);
+		PhysicsSystemComponent::get().m_sphereCulledCount = (unsigned int)(l_candidateCount - l_frustumVisibleCount);
+		PhysicsSystemComponent::get().m_occluderCount = (unsigned int)std::min(m_occluderCandidates.size(), m_maxOccluderCount);
+		PhysicsSystemComponent::get().m_occlusionTestedCount = (unsigned int)l_frustumVisibleCount;
+		PhysicsSystemComponent::get().m_occlusionCulledCount = (unsigned int)(l_frustumVisibleCount - l_visibleCount);
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			PhysicsSystemComponent::get().m_LODLevelCounts[i] = (unsigned int)l_LODLevelCounts[i];
+		}
+		PhysicsSystemComponent::get().m_LODSavedTriangleCount = (unsigned int)l_LODSavedTriangleCount;
 	}
 }
 
@@ -618,12 +1074,23 @@ INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::update()
 	if (GameSystemComponent::get().m_isLoadingScene)
 	{
 		PhysicsSystemComponent::get().m_cullingDataPack.clear();
+		PhysicsSystemComponent::get().m_shadowCullingDataPack.clear();
 		PhysicsSystemComponent::get().m_isCullingDataPackValid = false;
 		return true;
 	}
 
 	InnoPhysicsSystemNS::updateCameraComponents();
 	InnoPhysicsSystemNS::updateLightComponents();
+
+	if (!GameSystemComponent::get().m_pauseGameUpdate)
+	{
+#if defined (INNO_USE_PHYSX)
+		PhysXWrapper::get().update(g_pCoreSystem->getTimeSystem()->getDeltaTime() / 1000000000.0f);
+#else
+		RigidBodyUtilities::update(g_pCoreSystem->getTimeSystem()->getDeltaTime() / 1000000000.0f);
+#endif
+	}
+
 	InnoPhysicsSystemNS::updateVisibleComponents();
 
 	PhysicsSystemComponent::get().m_isCullingDataPackValid = false;
@@ -643,6 +1110,10 @@ INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::update()
 
 INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::terminate()
 {
+#if defined (INNO_USE_PHYSX)
+	PhysXWrapper::get().terminate();
+#endif
+
 	InnoPhysicsSystemNS::m_objectStatus = ObjectStatus::SHUTDOWN;
 	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "PhysicsSystem has been terminated.");
 	return true;
@@ -660,10 +1131,119 @@ INNO_SYSTEM_EXPORT void InnoPhysicsSystem::generatePhysicsData(VisibleComponent*
 		auto l_physicsComponent = InnoPhysicsSystemNS::generatePhysicsDataComponent(visibleComponent->m_modelMap);
 		visibleComponent->m_PhysicsDataComponent = l_physicsComponent;
 		visibleComponent->m_objectStatus = ObjectStatus::ALIVE;
+#if defined (INNO_USE_PHYSX)
+		if (visibleComponent->m_simulatePhysics)
+		{
+			PhysXWrapper::get().createActor(visibleComponent);
+		}
+#endif
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_VERBOSE, "PhysicsSystem: PhysicsDataComponent has been generated for VisibleComponent " + visibleComponent->m_parentEntity + ".");
 	}
 	else
 	{
 		g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_WARNING, "PhysicsSystem: PhysicsDataComponent has already been generated for VisibleComponent " + visibleComponent->m_parentEntity + "!");
 	}
-}
\ No newline at end of file
+}
+INNO_SYSTEM_EXPORT void InnoPhysicsSystem::clearPhysicsProxies()
+{
+	std::unique_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	PhysicsSystemComponent::get().m_BVH.clear();
+	InnoPhysicsSystemNS::m_BVHInsertionsSinceBuild = 0;
+#if defined (INNO_USE_PHYSX)
+	PhysXWrapper::get().clearActors();
+#else
+	RigidBodyUtilities::clear();
+#endif
+}
+
+INNO_SYSTEM_EXPORT void InnoPhysicsSystem::queryFrustum(const Frustum & frustum, std::vector<PhysicsProxy>& result)
+{
+	std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+	l_BVH.queryFrustum(frustum, [&](int proxyID) { result.emplace_back(l_BVH.getUserData(proxyID)); });
+}
+
+// with PhysX the simulated actors are tested against their collision shapes, the BVH only answers for the rest
+INNO_SYSTEM_EXPORT void InnoPhysicsSystem::queryOverlap(const AABB & bound, std::vector<PhysicsProxy>& result)
+{
+	std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+#if defined (INNO_USE_PHYSX)
+	l_BVH.queryOverlap(bound, [&](int proxyID) {
+		auto& l_proxy = l_BVH.getUserData(proxyID);
+		if (!l_proxy.visibleComponent->m_simulatePhysics)
+		{
+			result.emplace_back(l_proxy);
+		}
+	});
+	PhysXWrapper::get().queryOverlap(bound, result);
+#else
+	l_BVH.queryOverlap(bound, [&](int proxyID) { result.emplace_back(l_BVH.getUserData(proxyID)); });
+#endif
+}
+
+INNO_SYSTEM_EXPORT void InnoPhysicsSystem::queryOverlap(const Sphere & sphere, std::vector<PhysicsProxy>& result)
+{
+	std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+#if defined (INNO_USE_PHYSX)
+	l_BVH.queryOverlap(sphere, [&](int proxyID) {
+		auto& l_proxy = l_BVH.getUserData(proxyID);
+		if (!l_proxy.visibleComponent->m_simulatePhysics)
+		{
+			result.emplace_back(l_proxy);
+		}
+	});
+	PhysXWrapper::get().queryOverlap(sphere, result);
+#else
+	l_BVH.queryOverlap(sphere, [&](int proxyID) { result.emplace_back(l_BVH.getUserData(proxyID)); });
+#endif
+}
+
+INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::rayCastClosest(const Ray & ray, PhysicsProxy & result, float & distance)
+{
+	std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	auto& l_BVH = PhysicsSystemComponent::get().m_BVH;
+
+	int l_proxyID;
+#if defined (INNO_USE_PHYSX)
+	auto l_isHit = l_BVH.rayCastClosest(ray, l_proxyID, distance, std::numeric_limits<float>::max(), [&](int proxyID) {
+		return !l_BVH.getUserData(proxyID).visibleComponent->m_simulatePhysics;
+	});
+	if (l_isHit)
+	{
+		result = l_BVH.getUserData(l_proxyID);
+	}
+
+	// PhysX measures in world units, the result stays in the unit of the ray direction
+	auto l_directionLength = std::sqrt(ray.m_direction.x * ray.m_direction.x + ray.m_direction.y * ray.m_direction.y + ray.m_direction.z * ray.m_direction.z);
+	if (l_directionLength > 0.0f)
+	{
+		auto l_maxDistance = l_isHit ? distance * l_directionLength : std::numeric_limits<float>::max();
+
+		PhysicsProxy l_proxy;
+		float l_distance;
+		if (PhysXWrapper::get().rayCastClosest(ray, l_maxDistance, l_proxy, l_distance))
+		{
+			result = l_proxy;
+			distance = l_distance / l_directionLength;
+			l_isHit = true;
+		}
+	}
+
+	return l_isHit;
+#else
+	if (l_BVH.rayCastClosest(ray, l_proxyID, distance))
+	{
+		result = l_BVH.getUserData(l_proxyID);
+		return true;
+	}
+	return false;
+#endif
+}
+
+INNO_SYSTEM_EXPORT bool InnoPhysicsSystem::rayCastAny(const Ray & ray, float maxDistance)
+{
+	std::shared_lock<RWLock> l_lock(PhysicsSystemComponent::get().m_BVHLock);
+	return PhysicsSystemComponent::get().m_BVH.rayCastAny(ray, maxDistance);
+}
@@ -14,4 +14,11 @@ public:
 	INNO_SYSTEM_EXPORT ObjectStatus getStatus() override;
 
 	INNO_SYSTEM_EXPORT void generatePhysicsData(VisibleComponent* visibleComponent) override;
+	INNO_SYSTEM_EXPORT void clearPhysicsProxies() override;
+
+	INNO_SYSTEM_EXPORT void queryFrustum(const Frustum& frustum, std::vector<PhysicsProxy>& result) override;
+	INNO_SYSTEM_EXPORT void queryOverlap(const AABB& bound, std::vector<PhysicsProxy>& result) override;
+	INNO_SYSTEM_EXPORT void queryOverlap(const Sphere& sphere, std::vector<PhysicsProxy>& result) override;
+	INNO_SYSTEM_EXPORT bool rayCastClosest(const Ray& ray, PhysicsProxy& result, float& distance) override;
+	INNO_SYSTEM_EXPORT bool rayCastAny(const Ray& ray, float maxDistance) override;
 };
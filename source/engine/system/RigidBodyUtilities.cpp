@@ -0,0 +1,1618 @@
+#include "RigidBodyUtilities.h"
+#include "VertexPackingUtilities.h"
+#include <numeric>
+#include "../common/InnoConcurrency.h"
+#include "../component/GameSystemComponent.h"
+#include "../component/PhysicsSystemComponent.h"
+
+#include "ICoreSystem.h"
+
+extern ICoreSystem* g_pCoreSystem;
+
+INNO_PRIVATE_SCOPE RigidBodyUtilities
+{
+	enum class ShapeType { SPHERE, BOX, CONVEX };
+
+	// the rows of a 3x3 matrix, w is unused
+	struct Mat3
+	{
+		vec4 m_rows[3];
+	};
+
+	struct Shape
+	{
+		ShapeType m_type;
+		unsigned int m_body;
+		// relative to the center of mass in the body space with the scale applied,
+		// the center and half extend bound every shape type
+		vec4 m_center;
+		vec4 m_halfExtend;
+		float m_radius;
+		std::vector<vec4> m_points;
+		// world space, expanded by the contact margin
+		vec4 m_boundMax;
+		vec4 m_boundMin;
+	};
+
+	struct Body
+	{
+		VisibleComponent* m_visibleComponent;
+		TransformComponent* m_transformComponent;
+		unsigned int m_shapeBegin;
+		unsigned int m_shapeEnd;
+
+		// 0 for the static bodies
+		float m_inverseMass;
+		// diagonal of the inverse inertia tensor in the body space
+		vec4 m_inverseInertia;
+		// relative to the transform origin in the body space
+		vec4 m_localCenterOfMass;
+
+		// the center of mass in world space
+		vec4 m_position;
+		vec4 m_orientation;
+		Mat3 m_rotation;
+		Mat3 m_inverseInertiaWorld;
+		vec4 m_linearVelocity;
+		vec4 m_angularVelocity;
+
+		// the last local transform written by the simulation, anything else means the body has been moved by someone else
+		vec4 m_writtenPos;
+		vec4 m_writtenRot;
+
+		float m_sleepTime;
+		bool m_isAwake;
+		bool m_isMoved;
+	};
+
+	struct ContactPoint
+	{
+		// relative to the centers of mass in the body spaces
+		vec4 m_localA;
+		vec4 m_localB;
+		// relative to the centers of mass in world space, refreshed before solving
+		vec4 m_rA;
+		vec4 m_rB;
+		// positive when the shapes overlap
+		float m_depth;
+		float m_normalImpulse;
+		float m_tangentImpulses[2];
+		float m_normalMass;
+		float m_tangentMasses[2];
+		float m_bias;
+	};
+
+	// up to 4 points sharing the normal which points from shape A to shape B
+	struct Manifold
+	{
+		unsigned int m_shapeA;
+		unsigned int m_shapeB;
+		unsigned int m_bodyA;
+		unsigned int m_bodyB;
+		vec4 m_normal;
+		vec4 m_tangents[2];
+		unsigned int m_pointCount;
+		ContactPoint m_points[4];
+	};
+
+	// a vertex of the Minkowski difference A - B and the points on A and B it comes from
+	struct SupportPoint
+	{
+		vec4 m_point;
+		vec4 m_onA;
+		vec4 m_onB;
+	};
+
+	// the bodies and manifolds of an island are continuous ranges of m_islandBodies and m_islandManifolds
+	struct Island
+	{
+		unsigned int m_bodyBegin;
+		unsigned int m_bodyEnd;
+		unsigned int m_manifoldBegin;
+		unsigned int m_manifoldEnd;
+	};
+
+	float dot3(const vec4& lhs, const vec4& rhs);
+	float lengthSquared3(const vec4& rhs);
+	vec4 normalize3(const vec4& rhs);
+	vec4 mul(const Mat3& lhs, const vec4& rhs);
+	vec4 mulTransposed(const Mat3& lhs, const vec4& rhs);
+	Mat3 toRotationMatrix(const vec4& quat);
+	Mat3 toInverseInertiaWorld(const Mat3& rotation, const vec4& inverseInertia);
+	void generateTangents(const vec4& normal, vec4& tangent1, vec4& tangent2);
+
+	TransformVector getGlobalTransformVector(TransformComponent* transformComponent);
+	std::vector<vec4> generateConvexPoints(const MeshDataComponent* MDC, const vec4& scale);
+	void initializeBody(Body& body, unsigned int bodyIndex, VisibleComponent* visibleComponent);
+	void readTransform(Body& body);
+	void writeTransform(Body& body);
+	void updateShapeBounds(const Body& body);
+	void syncBodies();
+
+	void updateBroadphase();
+
+	vec4 support(const Shape& shape, const Body& body, const vec4& direction);
+	SupportPoint support(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, const vec4& direction);
+	bool doSimplex(std::array<SupportPoint, 4>& simplex, unsigned int& simplexSize, vec4& direction);
+	bool GJK(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, std::array<SupportPoint, 4>& simplex);
+	bool EPA(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, const std::array<SupportPoint, 4>& simplex, vec4& normal, vec4& onA, vec4& onB);
+
+	void addContactPoint(Manifold& manifold, const vec4& onA, const vec4& onB);
+	void refreshContactPoints(Manifold& manifold);
+	bool collideSpheres(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, vec4& normal, vec4& onA, vec4& onB);
+	bool collideSphereBox(const Shape& sphere, const Body& sphereBody, const Shape& box, const Body& boxBody, vec4& normal, vec4& onSphere, vec4& onBox);
+	void collide(const std::pair<unsigned int, unsigned int>& pair, const Manifold* cachedManifold, Manifold& manifold);
+	void updateNarrowphase();
+
+	void updateIslands();
+	void applyImpulse(Body& bodyA, Body& bodyB, const vec4& rA, const vec4& rB, const vec4& impulse);
+	void solveIsland(const Island& island, float timeStep);
+	void step(float timeStep);
+
+	const float m_timeStep = 1.0f / 60.0f;
+	const unsigned int m_maxSubSteps = 4;
+	const unsigned int m_velocityIterations = 10;
+	const vec4 m_gravity = vec4(0.0f, -9.81f, 0.0f, 0.0f);
+	const float m_linearDamping = 0.01f;
+	const float m_angularDamping = 0.05f;
+	const float m_friction = 0.6f;
+
+	// the penetration is corrected by the Baumgarte stabilization above the slop
+	const float m_baumgarteFactor = 0.2f;
+	const float m_penetrationSlop = 0.005f;
+	// the cached contact points are dropped when they separate or slide further than this
+	const float m_contactMargin = 0.02f;
+
+	const float m_sleepLinearVelocity = 0.05f;
+	const float m_sleepAngularVelocity = 0.05f;
+	const float m_timeToSleep = 0.5f;
+
+	const unsigned int m_maxGJKIterations = 64;
+	const unsigned int m_maxEPAIterations = 32;
+	const float m_EPATolerance = 0.0001f;
+
+	const size_t m_minPairsPerJob = 64;
+
+	float m_timeAccumulator = 0.0f;
+
+	std::vector<Body> m_bodies;
+	std::vector<Shape> m_shapes;
+
+	// shape indices sorted by the min X of their bounds, mostly sorted already from the last step
+	std::vector<unsigned int> m_sortedShapes;
+	std::vector<std::pair<unsigned int, unsigned int>> m_pairs;
+
+	std::vector<Manifold> m_manifolds;
+	std::vector<Manifold> m_cachedManifolds;
+	// shape pair to the index in m_cachedManifolds
+	FlatHashMap<uint64_t, unsigned int> m_cachedManifoldMap;
+
+	std::vector<unsigned int> m_islandParents;
+	std::vector<unsigned int> m_islandBodies;
+	std::vector<unsigned int> m_islandManifolds;
+	std::vector<Island> m_islands;
+
+	std::vector<VisibleComponent*> m_simulatedVisibleComponents;
+
+	std::vector<InnoFuture<void>> m_asyncTask;
+}
+
+float RigidBodyUtilities::dot3(const vec4& lhs, const vec4& rhs)
+{
+	return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+float RigidBodyUtilities::lengthSquared3(const vec4& rhs)
+{
+	return dot3(rhs, rhs);
+}
+
+vec4 RigidBodyUtilities::normalize3(const vec4& rhs)
+{
+	auto l_length = std::sqrt(lengthSquared3(rhs));
+	if (l_length < std::numeric_limits<float>::epsilon())
+	{
+		return vec4(0.0f, 1.0f, 0.0f, 0.0f);
+	}
+	return vec4(rhs.x / l_length, rhs.y / l_length, rhs.z / l_length, 0.0f);
+}
+
+vec4 RigidBodyUtilities::mul(const Mat3& lhs, const vec4& rhs)
+{
+	return vec4(dot3(lhs.m_rows[0], rhs), dot3(lhs.m_rows[1], rhs), dot3(lhs.m_rows[2], rhs), 0.0f);
+}
+
+vec4 RigidBodyUtilities::mulTransposed(const Mat3& lhs, const vec4& rhs)
+{
+	return vec4(
+		lhs.m_rows[0].x * rhs.x + lhs.m_rows[1].x * rhs.y + lhs.m_rows[2].x * rhs.z,
+		lhs.m_rows[0].y * rhs.x + lhs.m_rows[1].y * rhs.y + lhs.m_rows[2].y * rhs.z,
+		lhs.m_rows[0].z * rhs.x + lhs.m_rows[1].z * rhs.y + lhs.m_rows[2].z * rhs.z,
+		0.0f);
+}
+
+RigidBodyUtilities::Mat3 RigidBodyUtilities::toRotationMatrix(const vec4& quat)
+{
+	auto x = quat.x;
+	auto y = quat.y;
+	auto z = quat.z;
+	auto w = quat.w;
+
+	Mat3 l_result;
+	l_result.m_rows[0] = vec4(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y), 0.0f);
+	l_result.m_rows[1] = vec4(2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x), 0.0f);
+	l_result.m_rows[2] = vec4(2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y), 0.0f);
+	return l_result;
+}
+
+// R * I^-1 * R^T
+RigidBodyUtilities::Mat3 RigidBodyUtilities::toInverseInertiaWorld(const Mat3& rotation, const vec4& inverseInertia)
+{
+	Mat3 l_result;
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto l_scaledRow = rotation.m_rows[i].scale(inverseInertia);
+		l_result.m_rows[i] = vec4(dot3(l_scaledRow, rotation.m_rows[0]), dot3(l_scaledRow, rotation.m_rows[1]), dot3(l_scaledRow, rotation.m_rows[2]), 0.0f);
+	}
+	return l_result;
+}
+
+void RigidBodyUtilities::generateTangents(const vec4& normal, vec4& tangent1, vec4& tangent2)
+{
+	if (std::abs(normal.x) >= 0.57735f)
+	{
+		tangent1 = normalize3(vec4(normal.y, -normal.x, 0.0f, 0.0f));
+	}
+	else
+	{
+		tangent1 = normalize3(vec4(0.0f, normal.z, -normal.y, 0.0f));
+	}
+	tangent2 = normal.cross(tangent1);
+}
+
+// the global transform is computed from the local one since the transform update of this frame might not be finished yet
+TransformVector RigidBodyUtilities::getGlobalTransformVector(TransformComponent* transformComponent)
+{
+	auto l_parent = transformComponent->m_parentTransformComponent;
+	if (l_parent)
+	{
+		return InnoMath::LocalTransformVectorToGlobal(transformComponent->m_localTransformVector, l_parent->m_globalTransformVector, l_parent->m_globalTransformMatrix);
+	}
+	return transformComponent->m_localTransformVector;
+}
+
+// the extreme vertices along 26 directions approximate the convex hull well enough for the props
+std::vector<vec4> RigidBodyUtilities::generateConvexPoints(const MeshDataComponent* MDC, const vec4& scale)
+{
+	std::vector<vec4> l_positions;
+	VertexPackingUtilities::getPositions(MDC, l_positions);
+
+	std::vector<vec4> l_directions;
+	for (int x = -1; x <= 1; x++)
+	{
+		for (int y = -1; y <= 1; y++)
+		{
+			for (int z = -1; z <= 1; z++)
+			{
+				if (x || y || z)
+				{
+					l_directions.emplace_back((float)x, (float)y, (float)z, 0.0f);
+				}
+			}
+		}
+	}
+
+	std::vector<size_t> l_extremes(l_directions.size(), 0);
+	std::vector<float> l_maxDistances(l_directions.size(), std::numeric_limits<float>::lowest());
+
+	for (size_t i = 0; i < l_positions.size(); i++)
+	{
+		auto l_point = l_positions[i].scale(scale);
+		for (size_t j = 0; j < l_directions.size(); j++)
+		{
+			auto l_distance = dot3(l_point, l_directions[j]);
+			if (l_distance > l_maxDistances[j])
+			{
+				l_maxDistances[j] = l_distance;
+				l_extremes[j] = i;
+			}
+		}
+	}
+
+	std::sort(l_extremes.begin(), l_extremes.end());
+	l_extremes.erase(std::unique(l_extremes.begin(), l_extremes.end()), l_extremes.end());
+
+	std::vector<vec4> l_result;
+	l_result.reserve(l_extremes.size());
+	for (auto i : l_extremes)
+	{
+		auto l_point = l_positions[i].scale(scale);
+		l_point.w = 0.0f;
+		l_result.emplace_back(l_point);
+	}
+
+	return l_result;
+}
+
+void RigidBodyUtilities::initializeBody(Body& body, unsigned int bodyIndex, VisibleComponent* visibleComponent)
+{
+	body.m_visibleComponent = visibleComponent;
+	body.m_transformComponent = g_pCoreSystem->getGameSystem()->get<TransformComponent>(visibleComponent->m_parentEntity);
+
+	auto l_scale = getGlobalTransformVector(body.m_transformComponent).m_scale;
+	auto l_absScale = vec4(std::abs(l_scale.x), std::abs(l_scale.y), std::abs(l_scale.z), 0.0f);
+	auto l_maxScale = std::max(std::max(l_absScale.x, l_absScale.y), l_absScale.z);
+
+	body.m_shapeBegin = (unsigned int)m_shapes.size();
+
+	std::vector<float> l_volumes;
+	float l_totalVolume = 0.0f;
+	vec4 l_centerOfMass = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	for (auto& physicsData : visibleComponent->m_PhysicsDataComponent->m_physicsDatas)
+	{
+		Shape l_shape;
+		l_shape.m_body = bodyIndex;
+		l_shape.m_center = physicsData.aabb.m_center.scale(l_scale);
+		l_shape.m_center.w = 0.0f;
+		l_shape.m_halfExtend = (physicsData.aabb.m_extend * 0.5f).scale(l_absScale);
+		l_shape.m_halfExtend.w = 0.0f;
+		l_shape.m_radius = 0.0f;
+
+		if (visibleComponent->m_meshShapeType == MeshShapeType::SPHERE)
+		{
+			l_shape.m_type = ShapeType::SPHERE;
+			l_shape.m_center = physicsData.sphere.m_center.scale(l_scale);
+			l_shape.m_center.w = 0.0f;
+			l_shape.m_radius = physicsData.sphere.m_radius * l_maxScale;
+			l_shape.m_halfExtend = vec4(l_shape.m_radius, l_shape.m_radius, l_shape.m_radius, 0.0f);
+		}
+		else if (visibleComponent->m_meshShapeType != MeshShapeType::CUBE && physicsData.MDC && VertexPackingUtilities::getVerticesCount(physicsData.MDC))
+		{
+			l_shape.m_type = ShapeType::CONVEX;
+			l_shape.m_points = generateConvexPoints(physicsData.MDC, l_scale);
+		}
+		else
+		{
+			l_shape.m_type = ShapeType::BOX;
+		}
+
+		float l_volume;
+		if (l_shape.m_type == ShapeType::SPHERE)
+		{
+			l_volume = 4.0f / 3.0f * PI<float> * l_shape.m_radius * l_shape.m_radius * l_shape.m_radius;
+		}
+		else
+		{
+			l_volume = 8.0f * l_shape.m_halfExtend.x * l_shape.m_halfExtend.y * l_shape.m_halfExtend.z;
+		}
+		l_volume = std::max(l_volume, std::numeric_limits<float>::epsilon());
+
+		l_volumes.emplace_back(l_volume);
+		l_totalVolume += l_volume;
+		l_centerOfMass = l_centerOfMass + l_shape.m_center * l_volume;
+
+		m_shapes.emplace_back(std::move(l_shape));
+	}
+
+	body.m_shapeEnd = (unsigned int)m_shapes.size();
+
+	if (l_totalVolume > 0.0f)
+	{
+		l_centerOfMass = l_centerOfMass / l_totalVolume;
+	}
+	body.m_localCenterOfMass = l_centerOfMass;
+
+	vec4 l_inertia = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+	auto l_mass = visibleComponent->m_mass;
+
+	for (auto i = body.m_shapeBegin; i < body.m_shapeEnd; i++)
+	{
+		auto& l_shape = m_shapes[i];
+		l_shape.m_center = l_shape.m_center - l_centerOfMass;
+		for (auto& j : l_shape.m_points)
+		{
+			j = j - l_centerOfMass;
+		}
+
+		// the convex shapes are approximated by their boxes, plus the parallel axis term
+		auto l_shapeMass = l_mass * l_volumes[i - body.m_shapeBegin] / l_totalVolume;
+		auto& c = l_shape.m_center;
+		if (l_shape.m_type == ShapeType::SPHERE)
+		{
+			auto l_sphereInertia = 0.4f * l_shapeMass * l_shape.m_radius * l_shape.m_radius;
+			l_inertia = l_inertia + vec4(l_sphereInertia, l_sphereInertia, l_sphereInertia, 0.0f);
+		}
+		else
+		{
+			auto& h = l_shape.m_halfExtend;
+			l_inertia = l_inertia + vec4(h.y * h.y + h.z * h.z, h.x * h.x + h.z * h.z, h.x * h.x + h.y * h.y, 0.0f) * (l_shapeMass / 3.0f);
+		}
+		l_inertia = l_inertia + vec4(c.y * c.y + c.z * c.z, c.x * c.x + c.z * c.z, c.x * c.x + c.y * c.y, 0.0f) * l_shapeMass;
+	}
+
+	if (l_mass > 0.0f)
+	{
+		body.m_inverseMass = 1.0f / l_mass;
+		body.m_inverseInertia = vec4(
+			l_inertia.x > 0.0f ? 1.0f / l_inertia.x : 0.0f,
+			l_inertia.y > 0.0f ? 1.0f / l_inertia.y : 0.0f,
+			l_inertia.z > 0.0f ? 1.0f / l_inertia.z : 0.0f,
+			0.0f);
+	}
+	else
+	{
+		body.m_inverseMass = 0.0f;
+		body.m_inverseInertia = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	body.m_linearVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+	body.m_angularVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+	body.m_sleepTime = 0.0f;
+	body.m_isAwake = body.m_inverseMass > 0.0f;
+	body.m_isMoved = false;
+
+	readTransform(body);
+}
+
+void RigidBodyUtilities::readTransform(Body& body)
+{
+	auto l_global = getGlobalTransformVector(body.m_transformComponent);
+
+	body.m_orientation = l_global.m_rot;
+	body.m_rotation = toRotationMatrix(body.m_orientation);
+	body.m_inverseInertiaWorld = toInverseInertiaWorld(body.m_rotation, body.m_inverseInertia);
+	body.m_position = l_global.m_pos + mul(body.m_rotation, body.m_localCenterOfMass);
+	body.m_position.w = 1.0f;
+
+	body.m_writtenPos = body.m_transformComponent->m_localTransformVector.m_pos;
+	body.m_writtenRot = body.m_transformComponent->m_localTransformVector.m_rot;
+
+	updateShapeBounds(body);
+}
+
+void RigidBodyUtilities::writeTransform(Body& body)
+{
+	auto l_origin = body.m_position - mul(body.m_rotation, body.m_localCenterOfMass);
+	l_origin.w = 1.0f;
+
+	auto& l_localTransformVector = body.m_transformComponent->m_localTransformVector;
+	auto l_parent = body.m_transformComponent->m_parentTransformComponent;
+
+	if (l_parent)
+	{
+		auto l_parentInverse = l_parent->m_globalTransformMatrix.m_transformationMat;
+		l_parentInverse = l_parentInverse.inverseAffine();
+		l_localTransformVector.m_pos = InnoMath::caclGlobalPos(l_parentInverse, l_origin);
+		l_localTransformVector.m_rot = l_parent->m_globalTransformVector.m_rot.quatConjugate().quatMul(body.m_orientation);
+	}
+	else
+	{
+		l_localTransformVector.m_pos = l_origin;
+		l_localTransformVector.m_rot = body.m_orientation;
+	}
+
+	body.m_writtenPos = l_localTransformVector.m_pos;
+	body.m_writtenRot = l_localTransformVector.m_rot;
+}
+
+// "Transforming Axis-Aligned Bounding Boxes", James Arvo, Graphics Gems, 1990
+void RigidBodyUtilities::updateShapeBounds(const Body& body)
+{
+	auto& R = body.m_rotation;
+
+	for (auto i = body.m_shapeBegin; i < body.m_shapeEnd; i++)
+	{
+		auto& l_shape = m_shapes[i];
+		auto l_center = body.m_position + mul(R, l_shape.m_center);
+		auto& h = l_shape.m_halfExtend;
+
+		vec4 l_halfExtend;
+		l_halfExtend.x = std::abs(R.m_rows[0].x) * h.x + std::abs(R.m_rows[0].y) * h.y + std::abs(R.m_rows[0].z) * h.z + m_contactMargin;
+		l_halfExtend.y = std::abs(R.m_rows[1].x) * h.x + std::abs(R.m_rows[1].y) * h.y + std::abs(R.m_rows[1].z) * h.z + m_contactMargin;
+		l_halfExtend.z = std::abs(R.m_rows[2].x) * h.x + std::abs(R.m_rows[2].y) * h.y + std::abs(R.m_rows[2].z) * h.z + m_contactMargin;
+		l_halfExtend.w = 0.0f;
+
+		l_shape.m_boundMax = l_center + l_halfExtend;
+		l_shape.m_boundMin = l_center - l_halfExtend;
+	}
+}
+
+void RigidBodyUtilities::syncBodies()
+{
+	m_simulatedVisibleComponents.clear();
+
+	for (auto i : GameSystemComponent::get().m_VisibleComponents)
+	{
+		if (i->m_simulatePhysics && i->m_objectStatus == ObjectStatus::ALIVE && i->m_PhysicsDataComponent)
+		{
+			m_simulatedVisibleComponents.emplace_back(i);
+		}
+	}
+
+	bool l_isChanged = m_simulatedVisibleComponents.size() != m_bodies.size();
+	for (size_t i = 0; !l_isChanged && i < m_bodies.size(); i++)
+	{
+		l_isChanged = m_bodies[i].m_visibleComponent != m_simulatedVisibleComponents[i];
+	}
+
+	if (l_isChanged)
+	{
+		// the shape indices change, so the cached contacts are dropped, the velocities survive
+		FlatHashMap<VisibleComponent*, unsigned int> l_previousBodies;
+		for (unsigned int i = 0; i < m_bodies.size(); i++)
+		{
+			l_previousBodies.emplace(m_bodies[i].m_visibleComponent, i);
+		}
+
+		auto l_previous = std::move(m_bodies);
+		m_bodies.clear();
+		m_shapes.clear();
+		m_bodies.resize(m_simulatedVisibleComponents.size());
+
+		for (unsigned int i = 0; i < m_bodies.size(); i++)
+		{
+			auto& l_body = m_bodies[i];
+			initializeBody(l_body, i, m_simulatedVisibleComponents[i]);
+
+			auto l_result = l_previousBodies.find(l_body.m_visibleComponent);
+			if (l_result != l_previousBodies.end() && l_body.m_inverseMass > 0.0f)
+			{
+				auto& l_previousBody = l_previous[l_result->second];
+				l_body.m_linearVelocity = l_previousBody.m_linearVelocity;
+				l_body.m_angularVelocity = l_previousBody.m_angularVelocity;
+				l_body.m_sleepTime = l_previousBody.m_sleepTime;
+				l_body.m_isAwake = l_previousBody.m_isAwake;
+			}
+		}
+
+		m_sortedShapes.resize(m_shapes.size());
+		std::iota(m_sortedShapes.begin(), m_sortedShapes.end(), 0);
+
+		m_manifolds.clear();
+		m_cachedManifolds.clear();
+		m_cachedManifoldMap.clear();
+
+		return;
+	}
+
+	for (auto& i : m_bodies)
+	{
+		auto& l_localTransformVector = i.m_transformComponent->m_localTransformVector;
+		if (l_localTransformVector.m_pos != i.m_writtenPos || l_localTransformVector.m_rot != i.m_writtenRot)
+		{
+			readTransform(i);
+			i.m_linearVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+			i.m_angularVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+			i.m_sleepTime = 0.0f;
+			i.m_isAwake = i.m_inverseMass > 0.0f;
+		}
+	}
+}
+
+// sweep and prune along X, the insertion sort is close to linear since the order barely changes between the steps
+void RigidBodyUtilities::updateBroadphase()
+{
+	for (size_t i = 1; i < m_sortedShapes.size(); i++)
+	{
+		auto l_shape = m_sortedShapes[i];
+		auto l_minX = m_shapes[l_shape].m_boundMin.x;
+		auto j = i;
+		while (j > 0 && m_shapes[m_sortedShapes[j - 1]].m_boundMin.x > l_minX)
+		{
+			m_sortedShapes[j] = m_sortedShapes[j - 1];
+			j--;
+		}
+		m_sortedShapes[j] = l_shape;
+	}
+
+	m_pairs.clear();
+
+	for (size_t i = 0; i < m_sortedShapes.size(); i++)
+	{
+		auto& l_shapeA = m_shapes[m_sortedShapes[i]];
+		auto& l_bodyA = m_bodies[l_shapeA.m_body];
+
+		for (size_t j = i + 1; j < m_sortedShapes.size(); j++)
+		{
+			auto& l_shapeB = m_shapes[m_sortedShapes[j]];
+
+			if (l_shapeB.m_boundMin.x > l_shapeA.m_boundMax.x)
+			{
+				break;
+			}
+
+			if (l_shapeA.m_body == l_shapeB.m_body)
+			{
+				continue;
+			}
+
+			auto& l_bodyB = m_bodies[l_shapeB.m_body];
+
+			// the static pairs never collide, the sleeping pairs are still reported to keep their islands together
+			if (l_bodyA.m_inverseMass == 0.0f && l_bodyB.m_inverseMass == 0.0f)
+			{
+				continue;
+			}
+
+			if (l_shapeA.m_boundMin.y > l_shapeB.m_boundMax.y || l_shapeB.m_boundMin.y > l_shapeA.m_boundMax.y
+				|| l_shapeA.m_boundMin.z > l_shapeB.m_boundMax.z || l_shapeB.m_boundMin.z > l_shapeA.m_boundMax.z)
+			{
+				continue;
+			}
+
+			m_pairs.emplace_back(std::min(m_sortedShapes[i], m_sortedShapes[j]), std::max(m_sortedShapes[i], m_sortedShapes[j]));
+		}
+	}
+}
+
+vec4 RigidBodyUtilities::support(const Shape& shape, const Body& body, const vec4& direction)
+{
+	switch (shape.m_type)
+	{
+	case ShapeType::SPHERE:
+	{
+		return body.m_position + mul(body.m_rotation, shape.m_center) + normalize3(direction) * shape.m_radius;
+	}
+	case ShapeType::BOX:
+	{
+		auto l_localDirection = mulTransposed(body.m_rotation, direction);
+		auto l_corner = vec4(
+			l_localDirection.x >= 0.0f ? shape.m_halfExtend.x : -shape.m_halfExtend.x,
+			l_localDirection.y >= 0.0f ? shape.m_halfExtend.y : -shape.m_halfExtend.y,
+			l_localDirection.z >= 0.0f ? shape.m_halfExtend.z : -shape.m_halfExtend.z,
+			0.0f);
+		return body.m_position + mul(body.m_rotation, shape.m_center + l_corner);
+	}
+	default:
+	{
+		auto l_localDirection = mulTransposed(body.m_rotation, direction);
+		size_t l_index = 0;
+		auto l_maxDistance = std::numeric_limits<float>::lowest();
+		for (size_t i = 0; i < shape.m_points.size(); i++)
+		{
+			auto l_distance = dot3(shape.m_points[i], l_localDirection);
+			if (l_distance > l_maxDistance)
+			{
+				l_maxDistance = l_distance;
+				l_index = i;
+			}
+		}
+		return body.m_position + mul(body.m_rotation, shape.m_points[l_index]);
+	}
+	}
+}
+
+RigidBodyUtilities::SupportPoint RigidBodyUtilities::support(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, const vec4& direction)
+{
+	SupportPoint l_result;
+	l_result.m_onA = support(shapeA, bodyA, direction);
+	l_result.m_onB = support(shapeB, bodyB, direction * -1.0f);
+	l_result.m_point = l_result.m_onA - l_result.m_onB;
+	l_result.m_point.w = 0.0f;
+	return l_result;
+}
+
+// the newest point is simplex[0], reduce the simplex to the feature closest to the origin and point the direction to the origin
+bool RigidBodyUtilities::doSimplex(std::array<SupportPoint, 4>& simplex, unsigned int& simplexSize, vec4& direction)
+{
+	auto l_sameDirection = [](const vec4& lhs, const vec4& rhs) { return dot3(lhs, rhs) > 0.0f; };
+
+	auto l_line = [&]() {
+		auto a = simplex[0].m_point;
+		auto b = simplex[1].m_point;
+		auto ab = b - a;
+		auto ao = a * -1.0f;
+		if (l_sameDirection(ab, ao))
+		{
+			direction = ab.cross(ao).cross(ab);
+		}
+		else
+		{
+			simplexSize = 1;
+			direction = ao;
+		}
+		return false;
+	};
+
+	auto l_triangle = [&]() {
+		auto a = simplex[0].m_point;
+		auto b = simplex[1].m_point;
+		auto c = simplex[2].m_point;
+		auto ab = b - a;
+		auto ac = c - a;
+		auto ao = a * -1.0f;
+		auto abc = ab.cross(ac);
+
+		if (l_sameDirection(abc.cross(ac), ao))
+		{
+			if (l_sameDirection(ac, ao))
+			{
+				simplex[1] = simplex[2];
+				simplexSize = 2;
+				direction = ac.cross(ao).cross(ac);
+				return false;
+			}
+			simplexSize = 2;
+			return l_line();
+		}
+		if (l_sameDirection(ab.cross(abc), ao))
+		{
+			simplexSize = 2;
+			return l_line();
+		}
+		if (l_sameDirection(abc, ao))
+		{
+			direction = abc;
+		}
+		else
+		{
+			std::swap(simplex[1], simplex[2]);
+			direction = abc * -1.0f;
+		}
+		return false;
+	};
+
+	switch (simplexSize)
+	{
+	case 2:
+		return l_line();
+	case 3:
+		return l_triangle();
+	default:
+	{
+		auto a = simplex[0].m_point;
+		auto ab = simplex[1].m_point - a;
+		auto ac = simplex[2].m_point - a;
+		auto ad = simplex[3].m_point - a;
+		auto ao = a * -1.0f;
+
+		if (l_sameDirection(ab.cross(ac), ao))
+		{
+			simplexSize = 3;
+			return l_triangle();
+		}
+		if (l_sameDirection(ac.cross(ad), ao))
+		{
+			simplex[1] = simplex[2];
+			simplex[2] = simplex[3];
+			simplexSize = 3;
+			return l_triangle();
+		}
+		if (l_sameDirection(ad.cross(ab), ao))
+		{
+			simplex[2] = simplex[1];
+			simplex[1] = simplex[3];
+			simplexSize = 3;
+			return l_triangle();
+		}
+		return true;
+	}
+	}
+}
+
+// "A Fast Procedure for Computing the Distance Between Complex Objects in Three-Dimensional Space", Gilbert, Johnson and Keerthi, 1988
+// returns true with a tetrahedron containing the origin when the shapes overlap
+bool RigidBodyUtilities::GJK(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, std::array<SupportPoint, 4>& simplex)
+{
+	auto l_direction = (bodyB.m_position + mul(bodyB.m_rotation, shapeB.m_center)) - (bodyA.m_position + mul(bodyA.m_rotation, shapeA.m_center));
+	if (lengthSquared3(l_direction) < std::numeric_limits<float>::epsilon())
+	{
+		l_direction = vec4(1.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	simplex[0] = support(shapeA, bodyA, shapeB, bodyB, l_direction);
+	unsigned int l_simplexSize = 1;
+	l_direction = simplex[0].m_point * -1.0f;
+
+	for (unsigned int i = 0; i < m_maxGJKIterations; i++)
+	{
+		// the origin lies on the boundary, treated as separated
+		if (lengthSquared3(l_direction) < std::numeric_limits<float>::epsilon())
+		{
+			return false;
+		}
+
+		auto l_point = support(shapeA, bodyA, shapeB, bodyB, l_direction);
+		if (dot3(l_point.m_point, l_direction) < 0.0f)
+		{
+			return false;
+		}
+
+		for (auto j = l_simplexSize; j > 0; j--)
+		{
+			simplex[j] = simplex[j - 1];
+		}
+		simplex[0] = l_point;
+		l_simplexSize++;
+
+		if (doSimplex(simplex, l_simplexSize, l_direction))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// "Proximity Queries and Penetration Depth Computation on 3D Game Objects", Gino van den Bergen, GDC 2001
+// expand the GJK tetrahedron to the face of the Minkowski difference closest to the origin
+bool RigidBodyUtilities::EPA(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, const std::array<SupportPoint, 4>& simplex, vec4& normal, vec4& onA, vec4& onB)
+{
+	struct Face
+	{
+		unsigned int m_indices[3];
+		vec4 m_normal;
+		float m_distance;
+	};
+
+	std::vector<SupportPoint> l_polytope(simplex.begin(), simplex.end());
+	std::vector<Face> l_faces;
+	std::vector<std::pair<unsigned int, unsigned int>> l_edges;
+
+	// the origin is inside of the polytope, so the outward normals have positive distances
+	auto l_addFace = [&](unsigned int a, unsigned int b, unsigned int c) {
+		auto l_normal = (l_polytope[b].m_point - l_polytope[a].m_point).cross(l_polytope[c].m_point - l_polytope[a].m_point);
+		if (lengthSquared3(l_normal) < std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon())
+		{
+			return false;
+		}
+		Face l_face = { { a, b, c }, normalize3(l_normal), 0.0f };
+		l_face.m_distance = dot3(l_face.m_normal, l_polytope[a].m_point);
+		if (l_face.m_distance < 0.0f)
+		{
+			std::swap(l_face.m_indices[1], l_face.m_indices[2]);
+			l_face.m_normal = l_face.m_normal * -1.0f;
+			l_face.m_distance = -l_face.m_distance;
+		}
+		l_faces.emplace_back(l_face);
+		return true;
+	};
+
+	if (!l_addFace(0, 1, 2) || !l_addFace(0, 3, 1) || !l_addFace(0, 2, 3) || !l_addFace(1, 3, 2))
+	{
+		return false;
+	}
+
+	size_t l_closest = 0;
+
+	for (unsigned int i = 0; i < m_maxEPAIterations; i++)
+	{
+		l_closest = 0;
+		for (size_t j = 1; j < l_faces.size(); j++)
+		{
+			if (l_faces[j].m_distance < l_faces[l_closest].m_distance)
+			{
+				l_closest = j;
+			}
+		}
+
+		auto l_normal = l_faces[l_closest].m_normal;
+		auto l_point = support(shapeA, bodyA, shapeB, bodyB, l_normal);
+
+		if (dot3(l_normal, l_point.m_point) - l_faces[l_closest].m_distance < m_EPATolerance)
+		{
+			break;
+		}
+
+		// remove the faces which can see the new point and keep the horizon edges
+		l_edges.clear();
+		for (size_t j = 0; j < l_faces.size();)
+		{
+			auto& l_face = l_faces[j];
+			if (dot3(l_face.m_normal, l_point.m_point - l_polytope[l_face.m_indices[0]].m_point) > 0.0f)
+			{
+				for (size_t k = 0; k < 3; k++)
+				{
+					auto l_edge = std::make_pair(l_face.m_indices[k], l_face.m_indices[(k + 1) % 3]);
+					auto l_reversed = std::find(l_edges.begin(), l_edges.end(), std::make_pair(l_edge.second, l_edge.first));
+					if (l_reversed != l_edges.end())
+					{
+						l_edges.erase(l_reversed);
+					}
+					else
+					{
+						l_edges.emplace_back(l_edge);
+					}
+				}
+				l_face = l_faces.back();
+				l_faces.pop_back();
+			}
+			else
+			{
+				j++;
+			}
+		}
+
+		auto l_newIndex = (unsigned int)l_polytope.size();
+		l_polytope.emplace_back(l_point);
+
+		for (auto& j : l_edges)
+		{
+			l_addFace(j.first, j.second, l_newIndex);
+		}
+
+		if (l_faces.empty())
+		{
+			return false;
+		}
+	}
+
+	if (l_closest >= l_faces.size())
+	{
+		return false;
+	}
+
+	// the barycentric coordinates of the origin projected onto the closest face give the points on A and B
+	auto& l_face = l_faces[l_closest];
+	auto& a = l_polytope[l_face.m_indices[0]];
+	auto& b = l_polytope[l_face.m_indices[1]];
+	auto& c = l_polytope[l_face.m_indices[2]];
+
+	auto l_projection = l_face.m_normal * l_face.m_distance;
+	auto v0 = b.m_point - a.m_point;
+	auto v1 = c.m_point - a.m_point;
+	auto v2 = l_projection - a.m_point;
+	auto d00 = dot3(v0, v0);
+	auto d01 = dot3(v0, v1);
+	auto d11 = dot3(v1, v1);
+	auto d20 = dot3(v2, v0);
+	auto d21 = dot3(v2, v1);
+	auto l_denominator = d00 * d11 - d01 * d01;
+
+	float u = 1.0f;
+	float v = 0.0f;
+	float w = 0.0f;
+	if (std::abs(l_denominator) > std::numeric_limits<float>::epsilon())
+	{
+		v = (d11 * d20 - d01 * d21) / l_denominator;
+		w = (d00 * d21 - d01 * d20) / l_denominator;
+		u = 1.0f - v - w;
+	}
+
+	normal = l_face.m_normal;
+	onA = a.m_onA * u + b.m_onA * v + c.m_onA * w;
+	onB = a.m_onB * u + b.m_onB * v + c.m_onB * w;
+
+	return true;
+}
+
+// a new point close to a cached one replaces it and inherits its impulses,
+// a fifth point replaces the one whose removal leaves the largest area, the deepest point is always kept
+void RigidBodyUtilities::addContactPoint(Manifold& manifold, const vec4& onA, const vec4& onB)
+{
+	auto& l_bodyA = m_bodies[manifold.m_bodyA];
+	auto& l_bodyB = m_bodies[manifold.m_bodyB];
+
+	ContactPoint l_point = {};
+	l_point.m_localA = mulTransposed(l_bodyA.m_rotation, onA - l_bodyA.m_position);
+	l_point.m_localB = mulTransposed(l_bodyB.m_rotation, onB - l_bodyB.m_position);
+	l_point.m_depth = dot3(onA - onB, manifold.m_normal);
+
+	vec4 l_positions[5];
+	for (unsigned int i = 0; i < manifold.m_pointCount; i++)
+	{
+		l_positions[i] = l_bodyA.m_position + mul(l_bodyA.m_rotation, manifold.m_points[i].m_localA);
+
+		if (lengthSquared3(l_positions[i] - onA) < m_contactMargin * m_contactMargin)
+		{
+			l_point.m_normalImpulse = manifold.m_points[i].m_normalImpulse;
+			l_point.m_tangentImpulses[0] = manifold.m_points[i].m_tangentImpulses[0];
+			l_point.m_tangentImpulses[1] = manifold.m_points[i].m_tangentImpulses[1];
+			manifold.m_points[i] = l_point;
+			return;
+		}
+	}
+
+	if (manifold.m_pointCount < 4)
+	{
+		manifold.m_points[manifold.m_pointCount++] = l_point;
+		return;
+	}
+
+	l_positions[4] = onA;
+
+	unsigned int l_deepest = 4;
+	auto l_maxDepth = l_point.m_depth;
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		if (manifold.m_points[i].m_depth > l_maxDepth)
+		{
+			l_maxDepth = manifold.m_points[i].m_depth;
+			l_deepest = i;
+		}
+	}
+
+	unsigned int l_removed = 4;
+	float l_maxArea = -1.0f;
+	for (unsigned int i = 0; i < 5; i++)
+	{
+		if (i == l_deepest)
+		{
+			continue;
+		}
+
+		vec4 p[4];
+		unsigned int l_count = 0;
+		for (unsigned int j = 0; j < 5; j++)
+		{
+			if (j != i)
+			{
+				p[l_count++] = l_positions[j];
+			}
+		}
+
+		auto l_area = std::max(std::max(
+			lengthSquared3((p[0] - p[1]).cross(p[2] - p[3])),
+			lengthSquared3((p[0] - p[2]).cross(p[1] - p[3]))),
+			lengthSquared3((p[0] - p[3]).cross(p[1] - p[2])));
+
+		if (l_area > l_maxArea)
+		{
+			l_maxArea = l_area;
+			l_removed = i;
+		}
+	}
+
+	if (l_removed < 4)
+	{
+		manifold.m_points[l_removed] = l_point;
+	}
+}
+
+// move the cached points with the bodies, the ones which separated or slid away are dropped
+void RigidBodyUtilities::refreshContactPoints(Manifold& manifold)
+{
+	auto& l_bodyA = m_bodies[manifold.m_bodyA];
+	auto& l_bodyB = m_bodies[manifold.m_bodyB];
+
+	for (unsigned int i = 0; i < manifold.m_pointCount;)
+	{
+		auto& l_point = manifold.m_points[i];
+		auto l_onA = l_bodyA.m_position + mul(l_bodyA.m_rotation, l_point.m_localA);
+		auto l_onB = l_bodyB.m_position + mul(l_bodyB.m_rotation, l_point.m_localB);
+		auto l_offset = l_onA - l_onB;
+		l_point.m_depth = dot3(l_offset, manifold.m_normal);
+		auto l_drift = l_offset - manifold.m_normal * l_point.m_depth;
+
+		if (l_point.m_depth < -m_contactMargin || lengthSquared3(l_drift) > m_contactMargin * m_contactMargin)
+		{
+			manifold.m_points[i] = manifold.m_points[--manifold.m_pointCount];
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+bool RigidBodyUtilities::collideSpheres(const Shape& shapeA, const Body& bodyA, const Shape& shapeB, const Body& bodyB, vec4& normal, vec4& onA, vec4& onB)
+{
+	auto l_centerA = bodyA.m_position + mul(bodyA.m_rotation, shapeA.m_center);
+	auto l_centerB = bodyB.m_position + mul(bodyB.m_rotation, shapeB.m_center);
+	auto l_offset = l_centerB - l_centerA;
+	auto l_radius = shapeA.m_radius + shapeB.m_radius + m_contactMargin;
+
+	if (lengthSquared3(l_offset) > l_radius * l_radius)
+	{
+		return false;
+	}
+
+	normal = normalize3(l_offset);
+	onA = l_centerA + normal * shapeA.m_radius;
+	onB = l_centerB - normal * shapeB.m_radius;
+	return true;
+}
+
+// the normal points from the sphere to the box
+bool RigidBodyUtilities::collideSphereBox(const Shape& sphere, const Body& sphereBody, const Shape& box, const Body& boxBody, vec4& normal, vec4& onSphere, vec4& onBox)
+{
+	auto l_sphereCenter = sphereBody.m_position + mul(sphereBody.m_rotation, sphere.m_center);
+	auto l_boxCenter = boxBody.m_position + mul(boxBody.m_rotation, box.m_center);
+	auto l_localCenter = mulTransposed(boxBody.m_rotation, l_sphereCenter - l_boxCenter);
+	auto& h = box.m_halfExtend;
+
+	auto l_closest = vec4(
+		std::clamp(l_localCenter.x, -h.x, h.x),
+		std::clamp(l_localCenter.y, -h.y, h.y),
+		std::clamp(l_localCenter.z, -h.z, h.z),
+		0.0f);
+
+	vec4 l_localNormal;
+	auto l_offset = l_localCenter - l_closest;
+
+	if (lengthSquared3(l_offset) > std::numeric_limits<float>::epsilon())
+	{
+		if (lengthSquared3(l_offset) > (sphere.m_radius + m_contactMargin) * (sphere.m_radius + m_contactMargin))
+		{
+			return false;
+		}
+		l_localNormal = normalize3(l_offset);
+	}
+	else
+	{
+		// the center is inside of the box, push it out through the closest face
+		float l_distances[3] = { h.x - std::abs(l_localCenter.x), h.y - std::abs(l_localCenter.y), h.z - std::abs(l_localCenter.z) };
+		size_t l_axis = 0;
+		if (l_distances[1] < l_distances[l_axis])
+		{
+			l_axis = 1;
+		}
+		if (l_distances[2] < l_distances[l_axis])
+		{
+			l_axis = 2;
+		}
+
+		float l_sign[3] = { l_localCenter.x >= 0.0f ? 1.0f : -1.0f, l_localCenter.y >= 0.0f ? 1.0f : -1.0f, l_localCenter.z >= 0.0f ? 1.0f : -1.0f };
+		l_localNormal = vec4(l_axis == 0 ? l_sign[0] : 0.0f, l_axis == 1 ? l_sign[1] : 0.0f, l_axis == 2 ? l_sign[2] : 0.0f, 0.0f);
+
+		if (l_axis == 0)
+		{
+			l_closest.x = l_sign[0] * h.x;
+		}
+		else if (l_axis == 1)
+		{
+			l_closest.y = l_sign[1] * h.y;
+		}
+		else
+		{
+			l_closest.z = l_sign[2] * h.z;
+		}
+	}
+
+	// the local normal points from the box to the sphere
+	normal = mul(boxBody.m_rotation, l_localNormal) * -1.0f;
+	onSphere = l_sphereCenter + normal * sphere.m_radius;
+	onBox = l_boxCenter + mul(boxBody.m_rotation, l_closest);
+	return true;
+}
+
+void RigidBodyUtilities::collide(const std::pair<unsigned int, unsigned int>& pair, const Manifold* cachedManifold, Manifold& manifold)
+{
+	auto& l_shapeA = m_shapes[pair.first];
+	auto& l_shapeB = m_shapes[pair.second];
+	auto& l_bodyA = m_bodies[l_shapeA.m_body];
+	auto& l_bodyB = m_bodies[l_shapeB.m_body];
+
+	if (cachedManifold)
+	{
+		manifold = *cachedManifold;
+	}
+	else
+	{
+		manifold.m_shapeA = pair.first;
+		manifold.m_shapeB = pair.second;
+		manifold.m_bodyA = l_shapeA.m_body;
+		manifold.m_bodyB = l_shapeB.m_body;
+		manifold.m_normal = vec4(0.0f, 1.0f, 0.0f, 0.0f);
+		manifold.m_pointCount = 0;
+	}
+
+	// the contacts between the sleeping and static bodies stay as they are
+	if (!l_bodyA.m_isAwake && !l_bodyB.m_isAwake)
+	{
+		return;
+	}
+
+	vec4 l_normal;
+	vec4 l_onA;
+	vec4 l_onB;
+	bool l_hasContact = false;
+	bool l_isPersistent = false;
+
+	if (l_shapeA.m_type == ShapeType::SPHERE && l_shapeB.m_type == ShapeType::SPHERE)
+	{
+		l_hasContact = collideSpheres(l_shapeA, l_bodyA, l_shapeB, l_bodyB, l_normal, l_onA, l_onB);
+	}
+	else if (l_shapeA.m_type == ShapeType::SPHERE && l_shapeB.m_type == ShapeType::BOX)
+	{
+		l_hasContact = collideSphereBox(l_shapeA, l_bodyA, l_shapeB, l_bodyB, l_normal, l_onA, l_onB);
+	}
+	else if (l_shapeA.m_type == ShapeType::BOX && l_shapeB.m_type == ShapeType::SPHERE)
+	{
+		l_hasContact = collideSphereBox(l_shapeB, l_bodyB, l_shapeA, l_bodyA, l_normal, l_onB, l_onA);
+		l_normal = l_normal * -1.0f;
+	}
+	else
+	{
+		// GJK and EPA find one point per step, the manifold is built over several steps
+		l_isPersistent = true;
+		std::array<SupportPoint, 4> l_simplex;
+		if (GJK(l_shapeA, l_bodyA, l_shapeB, l_bodyB, l_simplex))
+		{
+			l_hasContact = EPA(l_shapeA, l_bodyA, l_shapeB, l_bodyB, l_simplex, l_normal, l_onA, l_onB);
+		}
+	}
+
+	if (l_isPersistent)
+	{
+		if (l_hasContact)
+		{
+			manifold.m_normal = l_normal;
+		}
+		refreshContactPoints(manifold);
+		if (l_hasContact)
+		{
+			addContactPoint(manifold, l_onA, l_onB);
+		}
+	}
+	else
+	{
+		// the sphere contacts are a single point, only its impulses are cached
+		ContactPoint l_cachedPoint = {};
+		if (manifold.m_pointCount)
+		{
+			l_cachedPoint = manifold.m_points[0];
+		}
+		manifold.m_pointCount = 0;
+
+		if (l_hasContact)
+		{
+			manifold.m_normal = l_normal;
+			addContactPoint(manifold, l_onA, l_onB);
+			manifold.m_points[0].m_normalImpulse = l_cachedPoint.m_normalImpulse;
+			manifold.m_points[0].m_tangentImpulses[0] = l_cachedPoint.m_tangentImpulses[0];
+			manifold.m_points[0].m_tangentImpulses[1] = l_cachedPoint.m_tangentImpulses[1];
+		}
+	}
+
+	generateTangents(manifold.m_normal, manifold.m_tangents[0], manifold.m_tangents[1]);
+}
+
+void RigidBodyUtilities::updateNarrowphase()
+{
+	m_manifolds.resize(m_pairs.size());
+
+	auto l_pairCount = m_pairs.size();
+	auto l_jobCount = std::max<size_t>(std::min((l_pairCount + m_minPairsPerJob - 1) / m_minPairsPerJob, g_pCoreSystem->getTaskSystem()->getThreadCount() * 4), 1);
+	auto l_chunkSize = (l_pairCount + l_jobCount - 1) / l_jobCount;
+
+	g_pCoreSystem->getTaskSystem()->dispatch(l_jobCount, [&](size_t i) {
+		auto l_begin = std::min(i * l_chunkSize, l_pairCount);
+		auto l_end = std::min(l_begin + l_chunkSize, l_pairCount);
+		for (auto j = l_begin; j < l_end; j++)
+		{
+			auto& l_pair = m_pairs[j];
+			auto l_cached = m_cachedManifoldMap.find(((uint64_t)l_pair.first << 32) | l_pair.second);
+			collide(l_pair, l_cached != m_cachedManifoldMap.end() ? &m_cachedManifolds[l_cached->second] : nullptr, m_manifolds[j]);
+		}
+	}, m_asyncTask);
+
+	m_manifolds.erase(std::remove_if(m_manifolds.begin(), m_manifolds.end(), [](const Manifold& rhs) { return rhs.m_pointCount == 0; }), m_manifolds.end());
+
+	m_cachedManifoldMap.clear();
+	for (unsigned int i = 0; i < m_manifolds.size(); i++)
+	{
+		m_cachedManifoldMap.emplace(((uint64_t)m_manifolds[i].m_shapeA << 32) | m_manifolds[i].m_shapeB, i);
+	}
+}
+
+// union find over the dynamic bodies connected by contacts, the static bodies don't connect islands,
+// an island with any awake body wakes up as a whole
+void RigidBodyUtilities::updateIslands()
+{
+	auto l_bodyCount = (unsigned int)m_bodies.size();
+	m_islandParents.resize(l_bodyCount);
+	std::iota(m_islandParents.begin(), m_islandParents.end(), 0);
+
+	auto l_find = [&](unsigned int i) {
+		while (m_islandParents[i] != i)
+		{
+			m_islandParents[i] = m_islandParents[m_islandParents[i]];
+			i = m_islandParents[i];
+		}
+		return i;
+	};
+
+	for (auto& i : m_manifolds)
+	{
+		if (m_bodies[i.m_bodyA].m_inverseMass > 0.0f && m_bodies[i.m_bodyB].m_inverseMass > 0.0f)
+		{
+			auto l_rootA = l_find(i.m_bodyA);
+			auto l_rootB = l_find(i.m_bodyB);
+			if (l_rootA != l_rootB)
+			{
+				m_islandParents[l_rootA] = l_rootB;
+			}
+		}
+	}
+
+	// island root to island index, counted and filled like a counting sort
+	std::vector<unsigned int> l_islandIndices(l_bodyCount, std::numeric_limits<unsigned int>::max());
+	std::vector<bool> l_isAwake;
+	m_islands.clear();
+
+	for (unsigned int i = 0; i < l_bodyCount; i++)
+	{
+		if (m_bodies[i].m_inverseMass == 0.0f)
+		{
+			continue;
+		}
+		auto l_root = l_find(i);
+		if (l_islandIndices[l_root] == std::numeric_limits<unsigned int>::max())
+		{
+			l_islandIndices[l_root] = (unsigned int)m_islands.size();
+			m_islands.emplace_back(Island{ 0, 0, 0, 0 });
+			l_isAwake.emplace_back(false);
+		}
+		auto l_island = l_islandIndices[l_root];
+		m_islands[l_island].m_bodyEnd++;
+		l_isAwake[l_island] = l_isAwake[l_island] || m_bodies[i].m_isAwake;
+	}
+
+	auto l_dynamicBodyOf = [&](const Manifold& rhs) {
+		return m_bodies[rhs.m_bodyA].m_inverseMass > 0.0f ? rhs.m_bodyA : rhs.m_bodyB;
+	};
+
+	for (auto& i : m_manifolds)
+	{
+		m_islands[l_islandIndices[l_find(l_dynamicBodyOf(i))]].m_manifoldEnd++;
+	}
+
+	unsigned int l_bodyOffset = 0;
+	unsigned int l_manifoldOffset = 0;
+	for (auto& i : m_islands)
+	{
+		i.m_bodyBegin = l_bodyOffset;
+		l_bodyOffset += i.m_bodyEnd;
+		i.m_bodyEnd = i.m_bodyBegin;
+		i.m_manifoldBegin = l_manifoldOffset;
+		l_manifoldOffset += i.m_manifoldEnd;
+		i.m_manifoldEnd = i.m_manifoldBegin;
+	}
+
+	m_islandBodies.resize(l_bodyOffset);
+	m_islandManifolds.resize(l_manifoldOffset);
+
+	for (unsigned int i = 0; i < l_bodyCount; i++)
+	{
+		if (m_bodies[i].m_inverseMass > 0.0f)
+		{
+			auto l_island = l_islandIndices[l_find(i)];
+			m_islandBodies[m_islands[l_island].m_bodyEnd++] = i;
+			if (l_isAwake[l_island] && !m_bodies[i].m_isAwake)
+			{
+				m_bodies[i].m_isAwake = true;
+				m_bodies[i].m_sleepTime = 0.0f;
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < m_manifolds.size(); i++)
+	{
+		auto l_island = l_islandIndices[l_find(l_dynamicBodyOf(m_manifolds[i]))];
+		m_islandManifolds[m_islands[l_island].m_manifoldEnd++] = i;
+	}
+
+	// the sleeping islands are skipped by the solver
+	size_t l_awakeIslandCount = 0;
+	for (size_t i = 0; i < m_islands.size(); i++)
+	{
+		if (l_isAwake[i])
+		{
+			m_islands[l_awakeIslandCount++] = m_islands[i];
+		}
+	}
+	m_islands.resize(l_awakeIslandCount);
+}
+
+// the static bodies are shared by the islands, they are never written
+void RigidBodyUtilities::applyImpulse(Body& bodyA, Body& bodyB, const vec4& rA, const vec4& rB, const vec4& impulse)
+{
+	if (bodyA.m_inverseMass > 0.0f)
+	{
+		bodyA.m_linearVelocity = bodyA.m_linearVelocity - impulse * bodyA.m_inverseMass;
+		bodyA.m_angularVelocity = bodyA.m_angularVelocity - mul(bodyA.m_inverseInertiaWorld, rA.cross(impulse));
+	}
+	if (bodyB.m_inverseMass > 0.0f)
+	{
+		bodyB.m_linearVelocity = bodyB.m_linearVelocity + impulse * bodyB.m_inverseMass;
+		bodyB.m_angularVelocity = bodyB.m_angularVelocity + mul(bodyB.m_inverseInertiaWorld, rB.cross(impulse));
+	}
+}
+
+// sequential impulses with warm starting and Baumgarte stabilization, "Iterative Dynamics with Temporal Coherence", Erin Catto, GDC 2005
+void RigidBodyUtilities::solveIsland(const Island& island, float timeStep)
+{
+	for (auto i = island.m_bodyBegin; i < island.m_bodyEnd; i++)
+	{
+		auto& l_body = m_bodies[m_islandBodies[i]];
+		l_body.m_linearVelocity = (l_body.m_linearVelocity + m_gravity * timeStep) * (1.0f / (1.0f + timeStep * m_linearDamping));
+		l_body.m_angularVelocity = l_body.m_angularVelocity * (1.0f / (1.0f + timeStep * m_angularDamping));
+	}
+
+	auto l_effectiveMass = [](const Body& bodyA, const Body& bodyB, const vec4& rA, const vec4& rB, const vec4& direction) {
+		auto l_rnA = rA.cross(direction);
+		auto l_rnB = rB.cross(direction);
+		auto l_mass = bodyA.m_inverseMass + bodyB.m_inverseMass + dot3(l_rnA, mul(bodyA.m_inverseInertiaWorld, l_rnA)) + dot3(l_rnB, mul(bodyB.m_inverseInertiaWorld, l_rnB));
+		return l_mass > 0.0f ? 1.0f / l_mass : 0.0f;
+	};
+
+	for (auto i = island.m_manifoldBegin; i < island.m_manifoldEnd; i++)
+	{
+		auto& l_manifold = m_manifolds[m_islandManifolds[i]];
+		auto& l_bodyA = m_bodies[l_manifold.m_bodyA];
+		auto& l_bodyB = m_bodies[l_manifold.m_bodyB];
+
+		for (unsigned int j = 0; j < l_manifold.m_pointCount; j++)
+		{
+			auto& l_point = l_manifold.m_points[j];
+			l_point.m_rA = mul(l_bodyA.m_rotation, l_point.m_localA);
+			l_point.m_rB = mul(l_bodyB.m_rotation, l_point.m_localB);
+
+			l_point.m_normalMass = l_effectiveMass(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_manifold.m_normal);
+			l_point.m_tangentMasses[0] = l_effectiveMass(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_manifold.m_tangents[0]);
+			l_point.m_tangentMasses[1] = l_effectiveMass(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_manifold.m_tangents[1]);
+
+			// a separated cached point only stops the approach faster than closing the gap in this step
+			if (l_point.m_depth > m_penetrationSlop)
+			{
+				l_point.m_bias = m_baumgarteFactor / timeStep * (l_point.m_depth - m_penetrationSlop);
+			}
+			else if (l_point.m_depth < 0.0f)
+			{
+				l_point.m_bias = l_point.m_depth / timeStep;
+			}
+			else
+			{
+				l_point.m_bias = 0.0f;
+			}
+
+			auto l_impulse = l_manifold.m_normal * l_point.m_normalImpulse + l_manifold.m_tangents[0] * l_point.m_tangentImpulses[0] + l_manifold.m_tangents[1] * l_point.m_tangentImpulses[1];
+			applyImpulse(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_impulse);
+		}
+	}
+
+	for (unsigned int iteration = 0; iteration < m_velocityIterations; iteration++)
+	{
+		for (auto i = island.m_manifoldBegin; i < island.m_manifoldEnd; i++)
+		{
+			auto& l_manifold = m_manifolds[m_islandManifolds[i]];
+			auto& l_bodyA = m_bodies[l_manifold.m_bodyA];
+			auto& l_bodyB = m_bodies[l_manifold.m_bodyB];
+
+			for (unsigned int j = 0; j < l_manifold.m_pointCount; j++)
+			{
+				auto& l_point = l_manifold.m_points[j];
+
+				auto l_relativeVelocity = [&]() {
+					return (l_bodyB.m_linearVelocity + l_bodyB.m_angularVelocity.cross(l_point.m_rB)) - (l_bodyA.m_linearVelocity + l_bodyA.m_angularVelocity.cross(l_point.m_rA));
+				};
+
+				// Coulomb friction, clamped by the current normal impulse
+				auto l_maxFriction = m_friction * l_point.m_normalImpulse;
+				for (size_t k = 0; k < 2; k++)
+				{
+					auto& l_tangent = l_manifold.m_tangents[k];
+					auto l_lambda = -dot3(l_relativeVelocity(), l_tangent) * l_point.m_tangentMasses[k];
+					auto l_accumulated = std::clamp(l_point.m_tangentImpulses[k] + l_lambda, -l_maxFriction, l_maxFriction);
+					l_lambda = l_accumulated - l_point.m_tangentImpulses[k];
+					l_point.m_tangentImpulses[k] = l_accumulated;
+					applyImpulse(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_tangent * l_lambda);
+				}
+
+				auto l_lambda = (l_point.m_bias - dot3(l_relativeVelocity(), l_manifold.m_normal)) * l_point.m_normalMass;
+				auto l_accumulated = std::max(l_point.m_normalImpulse + l_lambda, 0.0f);
+				l_lambda = l_accumulated - l_point.m_normalImpulse;
+				l_point.m_normalImpulse = l_accumulated;
+				applyImpulse(l_bodyA, l_bodyB, l_point.m_rA, l_point.m_rB, l_manifold.m_normal * l_lambda);
+			}
+		}
+	}
+
+	float l_minSleepTime = std::numeric_limits<float>::max();
+
+	for (auto i = island.m_bodyBegin; i < island.m_bodyEnd; i++)
+	{
+		auto& l_body = m_bodies[m_islandBodies[i]];
+
+		l_body.m_position = l_body.m_position + l_body.m_linearVelocity * timeStep;
+		l_body.m_position.w = 1.0f;
+
+		// dq / dt = 0.5 * (w, 0) * q
+		auto& q = l_body.m_orientation;
+		auto& w = l_body.m_angularVelocity;
+		auto l_spin = vec4(
+			w.x * q.w + w.y * q.z - w.z * q.y,
+			w.y * q.w + w.z * q.x - w.x * q.z,
+			w.z * q.w + w.x * q.y - w.y * q.x,
+			-(w.x * q.x + w.y * q.y + w.z * q.z));
+		q = (q + l_spin * (0.5f * timeStep)).normalize();
+
+		l_body.m_rotation = toRotationMatrix(q);
+		l_body.m_inverseInertiaWorld = toInverseInertiaWorld(l_body.m_rotation, l_body.m_inverseInertia);
+		l_body.m_isMoved = true;
+
+		updateShapeBounds(l_body);
+
+		if (lengthSquared3(l_body.m_linearVelocity) > m_sleepLinearVelocity * m_sleepLinearVelocity || lengthSquared3(l_body.m_angularVelocity) > m_sleepAngularVelocity * m_sleepAngularVelocity)
+		{
+			l_body.m_sleepTime = 0.0f;
+		}
+		else
+		{
+			l_body.m_sleepTime += timeStep;
+		}
+		l_minSleepTime = std::min(l_minSleepTime, l_body.m_sleepTime);
+	}
+
+	if (l_minSleepTime >= m_timeToSleep)
+	{
+		for (auto i = island.m_bodyBegin; i < island.m_bodyEnd; i++)
+		{
+			auto& l_body = m_bodies[m_islandBodies[i]];
+			l_body.m_isAwake = false;
+			l_body.m_linearVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+			l_body.m_angularVelocity = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+		}
+	}
+}
+
+void RigidBodyUtilities::step(float timeStep)
+{
+	updateBroadphase();
+	updateNarrowphase();
+	updateIslands();
+
+	g_pCoreSystem->getTaskSystem()->dispatch(m_islands.size(), [&](size_t i) {
+		solveIsland(m_islands[i], timeStep);
+	}, m_asyncTask);
+
+	m_cachedManifolds.swap(m_manifolds);
+}
+
+void RigidBodyUtilities::update(float deltaTime)
+{
+	syncBodies();
+
+	if (m_bodies.empty())
+	{
+		m_timeAccumulator = 0.0f;
+		return;
+	}
+
+	m_timeAccumulator = std::min(m_timeAccumulator + deltaTime, m_timeStep * m_maxSubSteps);
+
+	while (m_timeAccumulator >= m_timeStep)
+	{
+		step(m_timeStep);
+		m_timeAccumulator -= m_timeStep;
+	}
+
+	g_pCoreSystem->getTaskSystem()->shrinkFutureContainer(m_asyncTask);
+
+	unsigned int l_awakeBodyCount = 0;
+	for (auto& i : m_bodies)
+	{
+		if (i.m_isMoved)
+		{
+			writeTransform(i);
+			i.m_isMoved = false;
+		}
+		l_awakeBodyCount += i.m_isAwake;
+	}
+
+	unsigned int l_contactCount = 0;
+	for (auto& i : m_cachedManifolds)
+	{
+		l_contactCount += i.m_pointCount;
+	}
+
+	PhysicsSystemComponent::get().m_rigidBodyCount = (unsigned int)m_bodies.size();
+	PhysicsSystemComponent::get().m_awakeRigidBodyCount = l_awakeBodyCount;
+	PhysicsSystemComponent::get().m_rigidBodyIslandCount = (unsigned int)m_islands.size();
+	PhysicsSystemComponent::get().m_rigidBodyContactCount = l_contactCount;
+}
+
+void RigidBodyUtilities::clear()
+{
+	m_bodies.clear();
+	m_shapes.clear();
+	m_sortedShapes.clear();
+	m_pairs.clear();
+	m_manifolds.clear();
+	m_cachedManifolds.clear();
+	m_cachedManifoldMap.clear();
+	m_islands.clear();
+	m_timeAccumulator = 0.0f;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+
+// rigid body dynamics of the VisibleComponents with m_simulatePhysics,
+// sweep and prune broadphase over the PhysicsData bounds, sphere / box / convex narrowphase,
+// and a sequential impulse solver which runs the simulation islands concurrently on the task system
+INNO_PRIVATE_SCOPE RigidBodyUtilities
+{
+	// advance the simulation by the elapsed time in seconds with fixed sub steps,
+	// the new poses are written into the local transform vectors of the bodies
+	void update(float deltaTime);
+
+	// drop all the bodies and contacts, the bodies are rebuilt from the VisibleComponents in the next update
+	void clear();
+}
@@ -117,3 +117,8 @@ INNO_SYSTEM_EXPORT void InnoTaskSystem::waitAllTasksToFinish()
 		}
 	}
 }
+
+INNO_SYSTEM_EXPORT size_t InnoTaskSystem::getThreadCount()
+{
+	return InnoTaskSystemNS::m_threads.size();
+}
@@ -18,5 +18,7 @@ public:
 	INNO_SYSTEM_EXPORT void shrinkFutureContainer(std::vector<InnoFuture<void>>& rhs) override;
 
 	INNO_SYSTEM_EXPORT void waitAllTasksToFinish() override;
+
+	INNO_SYSTEM_EXPORT size_t getThreadCount() override;
 };
 
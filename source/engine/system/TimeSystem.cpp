@@ -5,16 +5,26 @@ extern ICoreSystem* g_pCoreSystem;
 
 INNO_PRIVATE_SCOPE InnoTimeSystemNS
 {
-	const long long getCurrentTimeInMillSec();
+	long long getCurrentTimeInNanoSec();
 	const std::tuple<int, unsigned, unsigned> getCivilFromDays(int z);
+	void paceFrame();
+	void recordFrameTime(long long frameTime);
 
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 
-	const double m_frameTime = (1.0 / 120.0) * 1000.0 * 1000.0;
+	using clock = std::chrono::steady_clock;
+
+	// the last part of the wait is spinned since sleep_for() usually overshoots by the scheduler granularity
+	const long long m_spinThreshold = 1000 * 1000;
+
 	long long m_gameStartTime;
-	std::chrono::high_resolution_clock::time_point m_updateStartTime;
-	long long m_deltaTime;
-	double m_unprocessedTime;
+	clock::time_point m_clockStartTime;
+	clock::time_point m_frameStartTime;
+	long long m_targetFrameTime = 0;
+	long long m_deltaTime = 0;
+
+	RingBuffer<long long, 256> m_frameTimeSamples;
+	std::mutex m_frameTimeSampleMutex;
 };
 
 const std::tuple<int, unsigned, unsigned> InnoTimeSystemNS::getCivilFromDays(int z)
@@ -38,19 +48,49 @@ const std::tuple<int, unsigned, unsigned> InnoTimeSystemNS::getCivilFromDays(int
 	return std::tuple<int, unsigned, unsigned>(y + (m <= 2), m, d);
 }
 
-const long long InnoTimeSystemNS::getCurrentTimeInMillSec()
+long long InnoTimeSystemNS::getCurrentTimeInNanoSec()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_clockStartTime).count();
+}
+
+void InnoTimeSystemNS::paceFrame()
 {
-	return (std::chrono::high_resolution_clock::now().time_since_epoch() / std::chrono::milliseconds(1));
+	if (m_targetFrameTime <= 0)
+	{
+		return;
+	}
+
+	auto l_deadline = m_frameStartTime + std::chrono::nanoseconds(m_targetFrameTime);
+	auto l_remainingTime = l_deadline - clock::now();
+
+	if (l_remainingTime > std::chrono::nanoseconds(m_spinThreshold))
+	{
+		std::this_thread::sleep_for(l_remainingTime - std::chrono::nanoseconds(m_spinThreshold));
+	}
+
+	while (clock::now() < l_deadline)
+	{
+	}
+}
+
+void InnoTimeSystemNS::recordFrameTime(long long frameTime)
+{
+	std::lock_guard<std::mutex> l_lock(m_frameTimeSampleMutex);
+
+	m_frameTimeSamples.push(frameTime);
 }
 
 INNO_SYSTEM_EXPORT bool InnoTimeSystem::setup()
 {
 	InnoTimeSystemNS::m_gameStartTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+	InnoTimeSystemNS::m_clockStartTime = InnoTimeSystemNS::clock::now();
+	InnoTimeSystemNS::m_frameStartTime = InnoTimeSystemNS::m_clockStartTime;
 	return true;
 }
 
 INNO_SYSTEM_EXPORT bool InnoTimeSystem::initialize()
 {
+	InnoTimeSystemNS::m_frameStartTime = InnoTimeSystemNS::clock::now();
 	InnoTimeSystemNS::m_objectStatus = ObjectStatus::ALIVE;
 	g_pCoreSystem->getLogSystem()->printLog(LogType::INNO_DEV_SUCCESS, "TimeSystem has been initialized.");
 	return true;
@@ -58,19 +98,14 @@ INNO_SYSTEM_EXPORT bool InnoTimeSystem::initialize()
 
 INNO_SYSTEM_EXPORT bool InnoTimeSystem::update()
 {
-	InnoTimeSystemNS::m_updateStartTime = std::chrono::high_resolution_clock::now();
-	InnoTimeSystemNS::m_deltaTime = (std::chrono::high_resolution_clock::now() - InnoTimeSystemNS::m_updateStartTime).count();
+	InnoTimeSystemNS::paceFrame();
+
+	auto l_currentTime = InnoTimeSystemNS::clock::now();
+	InnoTimeSystemNS::m_deltaTime = std::chrono::duration_cast<std::chrono::nanoseconds>(l_currentTime - InnoTimeSystemNS::m_frameStartTime).count();
+	InnoTimeSystemNS::m_frameStartTime = l_currentTime;
+
+	InnoTimeSystemNS::recordFrameTime(InnoTimeSystemNS::m_deltaTime);
 
-	InnoTimeSystemNS::m_unprocessedTime += InnoTimeSystemNS::m_deltaTime;
-	if (InnoTimeSystemNS::m_unprocessedTime >= InnoTimeSystemNS::m_frameTime)
-	{
-		InnoTimeSystemNS::m_unprocessedTime -= InnoTimeSystemNS::m_frameTime;
-		InnoTimeSystemNS::m_objectStatus = ObjectStatus::ALIVE;
-	}
-	else
-	{
-		InnoTimeSystemNS::m_objectStatus = ObjectStatus::STANDBY;
-	}
 	return true;
 }
 
@@ -124,4 +159,74 @@ INNO_SYSTEM_EXPORT ObjectStatus InnoTimeSystem::getStatus()
 INNO_SYSTEM_EXPORT const long long InnoTimeSystem::getDeltaTime()
 {
 	return InnoTimeSystemNS::m_deltaTime;
-}
\ No newline at end of file
+}
+
+INNO_SYSTEM_EXPORT long long InnoTimeSystem::getCurrentTimeInNanoSec()
+{
+	return InnoTimeSystemNS::getCurrentTimeInNanoSec();
+}
+
+INNO_SYSTEM_EXPORT void InnoTimeSystem::setTargetFrameRate(double frameRate)
+{
+	if (frameRate > 0.0)
+	{
+		InnoTimeSystemNS::m_targetFrameTime = (long long)(1000.0 * 1000.0 * 1000.0 / frameRate);
+	}
+	else
+	{
+		InnoTimeSystemNS::m_targetFrameTime = 0;
+	}
+}
+
+INNO_SYSTEM_EXPORT const FrameTimeStatistics InnoTimeSystem::getFrameTimeStatistics()
+{
+	std::vector<long long> l_samples;
+	{
+		std::lock_guard<std::mutex> l_lock(InnoTimeSystemNS::m_frameTimeSampleMutex);
+		l_samples.reserve(InnoTimeSystemNS::m_frameTimeSamples.size());
+		for (size_t i = 0; i < InnoTimeSystemNS::m_frameTimeSamples.size(); i++)
+		{
+			l_samples.emplace_back(InnoTimeSystemNS::m_frameTimeSamples[i]);
+		}
+	}
+
+	FrameTimeStatistics l_result;
+
+	if (l_samples.empty())
+	{
+		return l_result;
+	}
+
+	std::sort(l_samples.begin(), l_samples.end());
+
+	const double l_nsToMs = 1.0 / (1000.0 * 1000.0);
+	auto l_sampleCount = l_samples.size();
+
+	double l_sum = 0.0;
+	for (auto i : l_samples)
+	{
+		l_sum += (double)i;
+	}
+	auto l_mean = l_sum / (double)l_sampleCount;
+
+	double l_squaredDiffSum = 0.0;
+	for (auto i : l_samples)
+	{
+		auto l_diff = (double)i - l_mean;
+		l_squaredDiffSum += l_diff * l_diff;
+	}
+
+	auto l_percentile = [&](double p) {
+		auto l_index = (size_t)std::ceil(p * (double)l_sampleCount) - 1;
+		return (double)l_samples[std::min(l_index, l_sampleCount - 1)] * l_nsToMs;
+	};
+
+	l_result.mean = l_mean * l_nsToMs;
+	l_result.p50 = l_percentile(0.5);
+	l_result.p95 = l_percentile(0.95);
+	l_result.p99 = l_percentile(0.99);
+	l_result.variance = l_squaredDiffSum / (double)l_sampleCount * l_nsToMs * l_nsToMs;
+	l_result.sampleCount = (unsigned int)l_sampleCount;
+
+	return l_result;
+}
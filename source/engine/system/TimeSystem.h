@@ -15,4 +15,7 @@ public:
 
 	INNO_SYSTEM_EXPORT const long long getDeltaTime() override;
 	INNO_SYSTEM_EXPORT const TimeData getCurrentTime(unsigned int timezone_adjustment = 8) override;
+	INNO_SYSTEM_EXPORT long long getCurrentTimeInNanoSec() override;
+	INNO_SYSTEM_EXPORT void setTargetFrameRate(double frameRate) override;
+	INNO_SYSTEM_EXPORT const FrameTimeStatistics getFrameTimeStatistics() override;
 };
@@ -97,45 +97,17 @@ INNO_SYSTEM_EXPORT bool VKWindowSystem::update()
 		glfwPollEvents();
 
 		//update input
-		//keyboard
-		for (int i = 0; i < VKWindowSystemNS::g_WindowSystemComponent->NUM_KEYCODES; i++)
+		//keyboard, codes below INNO_KEY_SPACE are shared with the mouse buttons
+		for (int i = INNO_KEY_SPACE; i < VKWindowSystemNS::g_WindowSystemComponent->NUM_KEYCODES; i++)
 		{
-			if (glfwGetKey(VKWindowSystemNS::g_VKWindowSystemComponent->m_window, i) == GLFW_PRESS)
-			{
-				auto l_result = VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::PRESSED;
-				}
-			}
-			else
-			{
-				auto l_result = VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::RELEASED;
-				}
-			}
+			auto l_buttonStatus = glfwGetKey(VKWindowSystemNS::g_VKWindowSystemComponent->m_window, i) == GLFW_PRESS ? ButtonStatus::PRESSED : ButtonStatus::RELEASED;
+			VKWindowSystemNS::m_inputSystem->buttonStatusCallback(i, l_buttonStatus);
 		}
 		//mouse
 		for (int i = 0; i < VKWindowSystemNS::g_WindowSystemComponent->NUM_MOUSEBUTTONS; i++)
 		{
-			if (glfwGetMouseButton(VKWindowSystemNS::g_VKWindowSystemComponent->m_window, i) == GLFW_PRESS)
-			{
-				auto l_result = VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::PRESSED;
-				}
-			}
-			else
-			{
-				auto l_result = VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.find(i);
-				if (l_result != VKWindowSystemNS::g_WindowSystemComponent->m_buttonStatus.end())
-				{
-					l_result->second = ButtonStatus::RELEASED;
-				}
-			}
+			auto l_buttonStatus = glfwGetMouseButton(VKWindowSystemNS::g_VKWindowSystemComponent->m_window, i) == GLFW_PRESS ? ButtonStatus::PRESSED : ButtonStatus::RELEASED;
+			VKWindowSystemNS::m_inputSystem->buttonStatusCallback(i, l_buttonStatus);
 		}
 	}
 
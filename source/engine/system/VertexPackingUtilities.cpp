@@ -0,0 +1,297 @@
+#include "VertexPackingUtilities.h"
+#include <cstring>
+
+INNO_PRIVATE_SCOPE VertexPackingUtilities
+{
+	unsigned short toUNORM16(float rhs)
+	{
+		return (unsigned short)std::lround(std::min(std::max(rhs, 0.0f), 1.0f) * 65535.0f);
+	}
+
+	short toSNORM16(float rhs)
+	{
+		return (short)std::lround(std::min(std::max(rhs, -1.0f), 1.0f) * 32767.0f);
+	}
+
+	float fromSNORM16(short rhs)
+	{
+		return std::max((float)rhs / 32767.0f, -1.0f);
+	}
+
+	float signNotZero(float rhs)
+	{
+		return rhs >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	template<typename T>
+	void packAttributes(const Vertex& vertex, T& result)
+	{
+		result.m_texCoord[0] = toHalf(vertex.m_texCoord.x);
+		result.m_texCoord[1] = toHalf(vertex.m_texCoord.y);
+		encodeOctahedral(vertex.m_normal, result.m_normal[0], result.m_normal[1]);
+	}
+
+	template<typename T>
+	void unpackAttributes(const T& packedVertex, Vertex& result)
+	{
+		result.m_texCoord = vec2(fromHalf(packedVertex.m_texCoord[0]), fromHalf(packedVertex.m_texCoord[1]));
+		result.m_normal = decodeOctahedral(packedVertex.m_normal[0], packedVertex.m_normal[1]);
+	}
+}
+
+size_t VertexPackingUtilities::getStride(VertexFormat format)
+{
+	switch (format)
+	{
+	case VertexFormat::QUANTIZED: return sizeof(QuantizedVertex);
+	case VertexFormat::FLOAT3: return sizeof(Float3Vertex);
+	default: return sizeof(Vertex);
+	}
+}
+
+size_t VertexPackingUtilities::getVerticesCount(const MeshDataComponent* MDC)
+{
+	if (MDC->m_vertexFormat == VertexFormat::UNPACKED)
+	{
+		return MDC->m_vertices.size();
+	}
+
+	return MDC->getPackedVertices().size() / getStride(MDC->m_vertexFormat);
+}
+
+void VertexPackingUtilities::getQuantizationParameters(const vec4& boundMax, const vec4& boundMin, vec4& positionOffset, float& positionScale)
+{
+	positionOffset = vec4(boundMin.x, boundMin.y, boundMin.z, 1.0f);
+	positionScale = std::max(std::max(boundMax.x - boundMin.x, boundMax.y - boundMin.y), boundMax.z - boundMin.z);
+
+	if (!(positionScale > 0.0f))
+	{
+		positionScale = 1.0f;
+	}
+}
+
+void VertexPackingUtilities::pack(const std::vector<Vertex>& vertices, VertexFormat format, const vec4& positionOffset, float positionScale, std::vector<unsigned char>& result)
+{
+	if (format == VertexFormat::UNPACKED)
+	{
+		result.resize(vertices.size() * sizeof(Vertex));
+		if (!vertices.empty())
+		{
+			std::memcpy(result.data(), vertices.data(), result.size());
+		}
+		return;
+	}
+
+	result.resize(vertices.size() * getStride(format));
+
+	if (format == VertexFormat::QUANTIZED)
+	{
+		auto l_packedVertices = reinterpret_cast<QuantizedVertex*>(result.data());
+		auto l_inverseScale = 1.0f / positionScale;
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			auto& l_packedVertex = l_packedVertices[i];
+			l_packedVertex.m_pos[0] = toUNORM16((vertices[i].m_pos.x - positionOffset.x) * l_inverseScale);
+			l_packedVertex.m_pos[1] = toUNORM16((vertices[i].m_pos.y - positionOffset.y) * l_inverseScale);
+			l_packedVertex.m_pos[2] = toUNORM16((vertices[i].m_pos.z - positionOffset.z) * l_inverseScale);
+			l_packedVertex.m_pos[3] = 0;
+			packAttributes(vertices[i], l_packedVertex);
+		}
+	}
+	else
+	{
+		auto l_packedVertices = reinterpret_cast<Float3Vertex*>(result.data());
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			auto& l_packedVertex = l_packedVertices[i];
+			l_packedVertex.m_pos[0] = vertices[i].m_pos.x;
+			l_packedVertex.m_pos[1] = vertices[i].m_pos.y;
+			l_packedVertex.m_pos[2] = vertices[i].m_pos.z;
+			packAttributes(vertices[i], l_packedVertex);
+		}
+	}
+}
+
+void VertexPackingUtilities::unpack(const MeshDataComponent* MDC, std::vector<Vertex>& result)
+{
+	if (MDC->m_vertexFormat == VertexFormat::UNPACKED)
+	{
+		result = MDC->m_vertices;
+		return;
+	}
+
+	result.clear();
+	result.reserve(getVerticesCount(MDC));
+
+	forEachPosition(MDC, [&](const vec4& pos)
+	{
+		Vertex l_vertex;
+		l_vertex.m_pos = pos;
+		result.emplace_back(l_vertex);
+	});
+
+	if (MDC->m_vertexFormat == VertexFormat::QUANTIZED)
+	{
+		auto l_packedVertices = reinterpret_cast<const QuantizedVertex*>(MDC->getPackedVertices().data());
+		for (size_t i = 0; i < result.size(); i++)
+		{
+			unpackAttributes(l_packedVertices[i], result[i]);
+		}
+	}
+	else
+	{
+		auto l_packedVertices = reinterpret_cast<const Float3Vertex*>(MDC->getPackedVertices().data());
+		for (size_t i = 0; i < result.size(); i++)
+		{
+			unpackAttributes(l_packedVertices[i], result[i]);
+		}
+	}
+}
+
+void VertexPackingUtilities::getPositions(const MeshDataComponent* MDC, std::vector<vec4>& result)
+{
+	result.clear();
+	result.reserve(getVerticesCount(MDC));
+
+	forEachPosition(MDC, [&](const vec4& pos)
+	{
+		result.emplace_back(pos);
+	});
+}
+
+mat4 VertexPackingUtilities::foldPositionDecoding(const mat4& m, const MeshDataComponent* MDC)
+{
+	if (MDC->m_vertexFormat != VertexFormat::QUANTIZED)
+	{
+		return m;
+	}
+
+	auto l_m = m;
+	auto l_scale = MDC->m_positionScale;
+	auto l_decodingMatrix = InnoMath::toTranslationMatrix(MDC->m_positionOffset) * InnoMath::toScaleMatrix(vec4(l_scale, l_scale, l_scale, 1.0f));
+
+	return l_m * l_decodingMatrix;
+}
+
+// round to nearest even, the values out of range become infinity
+unsigned short VertexPackingUtilities::toHalf(float rhs)
+{
+	unsigned int l_bits;
+	std::memcpy(&l_bits, &rhs, sizeof(float));
+
+	auto l_sign = (unsigned short)((l_bits >> 16) & 0x8000);
+	auto l_abs = l_bits & 0x7FFFFFFF;
+
+	// infinity or NaN
+	if (l_abs >= 0x7F800000)
+	{
+		return l_sign | 0x7C00 | (l_abs > 0x7F800000 ? 0x0200 : 0);
+	}
+	// 65520 and above round to infinity
+	if (l_abs >= 0x477FF000)
+	{
+		return l_sign | 0x7C00;
+	}
+	// below 2^-14 is a subnormal half
+	if (l_abs < 0x38800000)
+	{
+		if (l_abs < 0x33000000)
+		{
+			return l_sign;
+		}
+
+		auto l_mantissa = (l_abs & 0x007FFFFF) | 0x00800000;
+		auto l_shift = 126 - (l_abs >> 23);
+		auto l_result = l_mantissa >> l_shift;
+		auto l_remainder = l_mantissa & ((1u << l_shift) - 1);
+		auto l_halfway = 1u << (l_shift - 1);
+
+		if (l_remainder > l_halfway || (l_remainder == l_halfway && (l_result & 1)))
+		{
+			l_result++;
+		}
+
+		return l_sign | (unsigned short)l_result;
+	}
+
+	// rebias the exponent from 127 to 15
+	auto l_rebiased = l_abs - 0x38000000;
+
+	return l_sign | (unsigned short)((l_rebiased + 0x0FFF + ((l_rebiased >> 13) & 1)) >> 13);
+}
+
+float VertexPackingUtilities::fromHalf(unsigned short rhs)
+{
+	unsigned int l_sign = (unsigned int)(rhs & 0x8000) << 16;
+	unsigned int l_exponent = (rhs >> 10) & 0x1F;
+	unsigned int l_mantissa = rhs & 0x03FF;
+
+	if (l_exponent == 0)
+	{
+		auto l_result = std::ldexp((float)l_mantissa, -24);
+		return l_sign ? -l_result : l_result;
+	}
+
+	unsigned int l_bits;
+	if (l_exponent == 31)
+	{
+		l_bits = l_sign | 0x7F800000 | (l_mantissa << 13);
+	}
+	else
+	{
+		l_bits = l_sign | ((l_exponent + 112) << 23) | (l_mantissa << 13);
+	}
+
+	float l_result;
+	std::memcpy(&l_result, &l_bits, sizeof(float));
+
+	return l_result;
+}
+
+// project to the octahedron then unfold the lower half over the diagonals, the zero vector becomes +Z
+void VertexPackingUtilities::encodeOctahedral(const vec4& normal, short& x, short& y)
+{
+	auto l_sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+
+	if (!(l_sum > 0.0f))
+	{
+		x = 0;
+		y = 0;
+		return;
+	}
+
+	auto l_x = normal.x / l_sum;
+	auto l_y = normal.y / l_sum;
+
+	if (normal.z < 0.0f)
+	{
+		auto l_foldedX = (1.0f - std::abs(l_y)) * signNotZero(l_x);
+		auto l_foldedY = (1.0f - std::abs(l_x)) * signNotZero(l_y);
+		l_x = l_foldedX;
+		l_y = l_foldedY;
+	}
+
+	x = toSNORM16(l_x);
+	y = toSNORM16(l_y);
+}
+
+vec4 VertexPackingUtilities::decodeOctahedral(short x, short y)
+{
+	auto l_x = fromSNORM16(x);
+	auto l_y = fromSNORM16(y);
+	auto l_z = 1.0f - std::abs(l_x) - std::abs(l_y);
+
+	if (l_z < 0.0f)
+	{
+		auto l_unfoldedX = (1.0f - std::abs(l_y)) * signNotZero(l_x);
+		auto l_unfoldedY = (1.0f - std::abs(l_x)) * signNotZero(l_y);
+		l_x = l_unfoldedX;
+		l_y = l_unfoldedY;
+	}
+
+	auto l_result = vec4(l_x, l_y, l_z, 0.0f);
+
+	return l_result.normalize();
+}
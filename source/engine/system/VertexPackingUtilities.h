@@ -0,0 +1,85 @@
+#pragma once
+#include "../common/InnoType.h"
+#include "../common/InnoMath.h"
+#include "../component/MeshDataComponent.h"
+
+// VertexFormat::QUANTIZED, 16 bytes
+struct QuantizedVertex
+{
+	// UNORM in the quantization bounds, the 4th component is padding
+	unsigned short m_pos[4];
+	// half float
+	unsigned short m_texCoord[2];
+	// octahedral SNORM
+	short m_normal[2];
+};
+
+// VertexFormat::FLOAT3, 20 bytes
+struct Float3Vertex
+{
+	float m_pos[3];
+	unsigned short m_texCoord[2];
+	short m_normal[2];
+};
+
+// conversion between Vertex and the compact vertex layouts, the packed bytes are the same in the .InnoRaw file, in memory and in the GPU buffer
+INNO_PRIVATE_SCOPE VertexPackingUtilities
+{
+	size_t getStride(VertexFormat format);
+	size_t getVerticesCount(const MeshDataComponent* MDC);
+
+	// one scale for all the axes so the normal matrix of the model matrix with the decoding folded in is still valid
+	void getQuantizationParameters(const vec4& boundMax, const vec4& boundMin, vec4& positionOffset, float& positionScale);
+
+	// the positions should be inside the quantization bounds for VertexFormat::QUANTIZED
+	void pack(const std::vector<Vertex>& vertices, VertexFormat format, const vec4& positionOffset, float positionScale, std::vector<unsigned char>& result);
+	void unpack(const MeshDataComponent* MDC, std::vector<Vertex>& result);
+
+	// model matrix * position decoding matrix for VertexFormat::QUANTIZED, otherwise the model matrix itself
+	mat4 foldPositionDecoding(const mat4& m, const MeshDataComponent* MDC);
+
+	unsigned short toHalf(float rhs);
+	float fromHalf(unsigned short rhs);
+	void encodeOctahedral(const vec4& normal, short& x, short& y);
+	vec4 decodeOctahedral(short x, short y);
+
+	// model space positions with w = 1 of any vertex format
+	template<typename Function>
+	void forEachPosition(const MeshDataComponent* MDC, Function&& function)
+	{
+		if (MDC->m_vertexFormat == VertexFormat::QUANTIZED)
+		{
+			auto l_packedVertices = MDC->getPackedVertices();
+			auto l_vertices = reinterpret_cast<const QuantizedVertex*>(l_packedVertices.data());
+			auto l_count = l_packedVertices.size() / sizeof(QuantizedVertex);
+			auto l_scale = MDC->m_positionScale / 65535.0f;
+			for (size_t i = 0; i < l_count; i++)
+			{
+				function(vec4(
+					MDC->m_positionOffset.x + (float)l_vertices[i].m_pos[0] * l_scale,
+					MDC->m_positionOffset.y + (float)l_vertices[i].m_pos[1] * l_scale,
+					MDC->m_positionOffset.z + (float)l_vertices[i].m_pos[2] * l_scale,
+					1.0f));
+			}
+		}
+		else if (MDC->m_vertexFormat == VertexFormat::FLOAT3)
+		{
+			auto l_packedVertices = MDC->getPackedVertices();
+			auto l_vertices = reinterpret_cast<const Float3Vertex*>(l_packedVertices.data());
+			auto l_count = l_packedVertices.size() / sizeof(Float3Vertex);
+			for (size_t i = 0; i < l_count; i++)
+			{
+				function(vec4(l_vertices[i].m_pos[0], l_vertices[i].m_pos[1], l_vertices[i].m_pos[2], 1.0f));
+			}
+		}
+		else
+		{
+			for (auto& i : MDC->m_vertices)
+			{
+				function(i.m_pos);
+			}
+		}
+	}
+
+	void getPositions(const MeshDataComponent* MDC, std::vector<vec4>& result);
+}
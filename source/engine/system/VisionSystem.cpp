@@ -37,9 +37,12 @@ INNO_PRIVATE_SCOPE InnoVisionSystemNS
 
 	float radicalInverse(unsigned int n, unsigned int base);
 	void initializeHaltonSampler();
+	bool generateRenderDataPack(const CullingDataPack& cullingDataPack, RenderDataPack& renderDataPack);
 
 	std::vector<InnoFuture<void>> m_asyncTask;
+
 	std::vector<CullingDataPack> m_cullingDataPack;
+	std::vector<std::vector<CullingDataPack>> m_shadowCullingDataPack;
 	ObjectStatus m_objectStatus = ObjectStatus::SHUTDOWN;
 }
 
@@ -204,6 +207,7 @@ INNO_SYSTEM_EXPORT bool InnoVisionSystem::update()
 		if (PhysicsSystemComponent::get().m_isCullingDataPackValid)
 		{
 			InnoVisionSystemNS::m_cullingDataPack = PhysicsSystemComponent::get().m_cullingDataPack.getRawData();
+			InnoVisionSystemNS::m_shadowCullingDataPack = PhysicsSystemComponent::get().m_shadowCullingDataPack.getRawData();
 		}
 
 		// main camera render data
@@ -219,8 +223,8 @@ INNO_SYSTEM_EXPORT bool InnoVisionSystem::update()
 			InnoMath::getInvertTranslationMatrix(
 				l_mainCameraTransformComponent->m_globalTransformVector.m_pos
 			);
-		auto r_prev = l_mainCameraTransformComponent->m_globalTransformMatrix_prev.m_rotationMat.inverse();
-		auto t_prev = l_mainCameraTransformComponent->m_globalTransformMatrix_prev.m_translationMat.inverse();
+		auto r_prev = l_mainCameraTransformComponent->m_globalTransformMatrix_prev.m_rotationMat.inverseOrthonormal();
+		auto t_prev = l_mainCameraTransformComponent->m_globalTransformMatrix_prev.m_translationMat.inverseRigid();
 
 		RenderingSystemComponent::get().m_CamProjOriginal = l_p;
 		RenderingSystemComponent::get().m_CamProjJittered = l_p;
@@ -277,7 +281,7 @@ INNO_SYSTEM_EXPORT bool InnoVisionSystem::update()
 			RenderingSystemComponent::get().m_CSMProjs[j] = l_directionalLight->m_projectionMatrices[j];
 			RenderingSystemComponent::get().m_CSMSplitCorners[j] = l_shadowSplitCorner;
 
-			auto l_lightRotMat = l_directionalLightTransformComponent->m_globalTransformMatrix.m_rotationMat.inverse();
+			auto l_lightRotMat = l_directionalLightTransformComponent->m_globalTransformMatrix.m_rotationMat.inverseOrthonormal();
 
 			RenderingSystemComponent::get().m_CSMViews[j] = l_lightRotMat;
 		}
@@ -289,28 +293,31 @@ INNO_SYSTEM_EXPORT bool InnoVisionSystem::update()
 
 		for (auto& i : InnoVisionSystemNS::m_cullingDataPack)
 		{
-			if (i.visibleComponent != nullptr && i.MDC != nullptr)
+			RenderDataPack l_renderDataPack;
+			if (InnoVisionSystemNS::generateRenderDataPack(i, l_renderDataPack))
 			{
-				if (i.MDC->m_objectStatus == ObjectStatus::ALIVE)
-				{
-					auto l_modelPair = i.visibleComponent->m_modelMap.find(i.MDC);
-					if (l_modelPair != i.visibleComponent->m_modelMap.end())
-					{
-						RenderDataPack l_renderDataPack;
+				RenderingSystemComponent::get().m_renderDataPack.emplace_back(l_renderDataPack);
+			}
+		}
 
-						l_renderDataPack.m = i.m;
-						l_renderDataPack.m_prev = i.m_prev;
-						l_renderDataPack.normalMat = i.normalMat;
-						l_renderDataPack.MDC = i.MDC;
-						l_renderDataPack.material = l_modelPair->second;
-						l_renderDataPack.visiblilityType = i.visibleComponent->m_visiblilityType;
+		std::vector<std::vector<RenderDataPack>> l_shadowRenderDataPack(InnoVisionSystemNS::m_shadowCullingDataPack.size());
 
-						RenderingSystemComponent::get().m_renderDataPack.emplace_back(l_renderDataPack);
-					}
+		for (size_t i = 0; i < InnoVisionSystemNS::m_shadowCullingDataPack.size(); i++)
+		{
+			l_shadowRenderDataPack[i].reserve(InnoVisionSystemNS::m_shadowCullingDataPack[i].size());
+
+			for (auto& j : InnoVisionSystemNS::m_shadowCullingDataPack[i])
+			{
+				RenderDataPack l_renderDataPack;
+				if (InnoVisionSystemNS::generateRenderDataPack(j, l_renderDataPack))
+				{
+					l_shadowRenderDataPack[i].emplace_back(l_renderDataPack);
 				}
 			}
 		}
 
+		RenderingSystemComponent::get().m_shadowRenderDataPack.setRawData(std::move(l_shadowRenderDataPack));
+
 		RenderingSystemComponent::get().m_isRenderDataPackValid = true;
 
 		RenderingSystemComponent::get().m_selectedVisibleComponent = PhysicsSystemComponent::get().m_selectedVisibleComponent;
@@ -352,6 +359,42 @@ INNO_SYSTEM_EXPORT bool InnoVisionSystem::update()
 	}
 }
 
+bool InnoVisionSystemNS::generateRenderDataPack(const CullingDataPack& cullingDataPack, RenderDataPack& renderDataPack)
+{
+	if (cullingDataPack.visibleComponent != nullptr && cullingDataPack.MDC != nullptr)
+	{
+		if (cullingDataPack.MDC->m_objectStatus == ObjectStatus::ALIVE)
+		{
+			auto l_modelPair = cullingDataPack.visibleComponent->m_modelMap.find(cullingDataPack.MDC);
+			if (l_modelPair != cullingDataPack.visibleComponent->m_modelMap.end())
+			{
+				renderDataPack.m = cullingDataPack.m;
+				renderDataPack.m_prev = cullingDataPack.m_prev;
+				renderDataPack.normalMat = cullingDataPack.normalMat;
+				renderDataPack.MDC = cullingDataPack.MDC;
+				renderDataPack.material = l_modelPair->second;
+				renderDataPack.visiblilityType = cullingDataPack.visibleComponent->m_visiblilityType;
+				renderDataPack.LODLevel = 0;
+
+				// the material is shared by all the LODs, fall back to the full resolution mesh until the LOD is loaded
+				if (cullingDataPack.LODLevel > 0 && cullingDataPack.LODLevel <= cullingDataPack.MDC->m_LODs.size())
+				{
+					auto l_LODMDC = cullingDataPack.MDC->m_LODs[cullingDataPack.LODLevel - 1];
+					if (l_LODMDC->m_objectStatus == ObjectStatus::ALIVE)
+					{
+						renderDataPack.MDC = l_LODMDC;
+						renderDataPack.LODLevel = cullingDataPack.LODLevel;
+					}
+				}
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 INNO_SYSTEM_EXPORT bool InnoVisionSystem::terminate()
 {
 	if (!InnoVisionSystemNS::m_guiSystem->terminate())
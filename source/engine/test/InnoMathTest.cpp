@@ -0,0 +1,252 @@
+#include "../common/InnoMath.h"
+#include <new>
+
+// usage: InnoMathTest [--iterations <count>]
+// compares the SIMD specializations of TVec4<float> and TMat4<float> with the generic templates instantiated for double on random inputs,
+// the polynomial trigonometric functions with the standard library and the batched slerp and nlerp with the scalar ones,
+// the exit code is 1 when any result differs by more than the tolerance relative to the magnitude of the inputs
+INNO_PRIVATE_SCOPE InnoMathTest
+{
+	using dvec4 = TVec4<double>;
+	using dmat4 = TMat4<double>;
+
+	std::mt19937 m_generator(42);
+
+	const double m_tolerance = 1e-5;
+	double m_maxError = 0.0;
+	size_t m_failureCount = 0;
+	const size_t m_maxReportedFailures = 16;
+
+	// the documented max absolute errors of the polynomial approximations
+	const double m_sinTolerance = 1.7e-7;
+	const double m_acosTolerance = 4.4e-7;
+	const double m_atan2Tolerance = 3.2e-7;
+	const double m_batchTolerance = 2e-7;
+
+	// not multiples of the SIMD widths, the scalar tails are covered too
+	const size_t m_batchSizes[] = { 1, 3, 5, 7, 9, 13, 17, 31 };
+
+	float randomFloat(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(m_generator);
+	}
+
+	vec4 randomVec4()
+	{
+		return vec4(randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f));
+	}
+
+	mat4 randomMat4()
+	{
+		mat4 l_m;
+		auto l_data = &l_m.m00;
+		for (size_t i = 0; i < 16; i++)
+		{
+			l_data[i] = randomFloat(-10.0f, 10.0f);
+		}
+		return l_m;
+	}
+
+	dvec4 toDouble(const vec4& rhs)
+	{
+		return dvec4(rhs.x, rhs.y, rhs.z, rhs.w);
+	}
+
+	dmat4 toDouble(const mat4& rhs)
+	{
+		dmat4 l_m;
+		auto l_source = &rhs.m00;
+		auto l_destination = &l_m.m00;
+		for (size_t i = 0; i < 16; i++)
+		{
+			l_destination[i] = l_source[i];
+		}
+		return l_m;
+	}
+
+	void check(const char* name, double result, double expected, double magnitude, double tolerance = m_tolerance)
+	{
+		auto l_error = std::abs(result - expected) / std::max(1.0, std::abs(magnitude));
+		m_maxError = std::max(m_maxError, l_error);
+
+		if (!(l_error <= tolerance))
+		{
+			if (m_failureCount < m_maxReportedFailures)
+			{
+				std::cerr << name << ": " << result << " expected " << expected << std::endl;
+			}
+			m_failureCount++;
+		}
+	}
+
+	void check(const char* name, const vec4& result, const dvec4& expected, double magnitude, double tolerance = m_tolerance)
+	{
+		check(name, result.x, expected.x, magnitude, tolerance);
+		check(name, result.y, expected.y, magnitude, tolerance);
+		check(name, result.z, expected.z, magnitude, tolerance);
+		check(name, result.w, expected.w, magnitude, tolerance);
+	}
+
+	void check(const char* name, const mat4& result, const dmat4& expected, double magnitude)
+	{
+		auto l_result = &result.m00;
+		auto l_expected = &expected.m00;
+		for (size_t i = 0; i < 16; i++)
+		{
+			check(name, l_result[i], l_expected[i], magnitude);
+		}
+	}
+
+	void checkCondition(const char* name, bool condition)
+	{
+		if (!condition)
+		{
+			if (m_failureCount < m_maxReportedFailures)
+			{
+				std::cerr << name << ": failed" << std::endl;
+			}
+			m_failureCount++;
+		}
+	}
+
+	void testVec4()
+	{
+		auto a = randomVec4();
+		auto b = randomVec4();
+		auto s = randomFloat(0.5f, 10.0f);
+		auto l_a = toDouble(a);
+		auto l_b = toDouble(b);
+
+		check("vec4 + vec4", a + b, l_a + l_b, 10.0);
+		check("vec4 + float", a + s, l_a + (double)s, 10.0);
+		check("vec4 - vec4", a - b, l_a - l_b, 10.0);
+		check("vec4 - float", a - s, l_a - (double)s, 10.0);
+		check("vec4 * vec4", a * b, l_a * l_b, 400.0);
+		check("vec4 * float", a * s, l_a * (double)s, 100.0);
+		check("vec4 / float", a / s, l_a / (double)s, 20.0);
+		check("vec4::cross", a.cross(b), l_a.cross(l_b), 200.0);
+		check("vec4::scale", a.scale(b), l_a.scale(l_b), 100.0);
+		check("vec4::quatMul", a.quatMul(b), l_a.quatMul(l_b), 400.0);
+		check("vec4::length", a.length(), l_a.length(), 20.0);
+		check("vec4::normalize", a.normalize(), l_a.normalize(), 1.0);
+
+		checkCondition("vec4::cross w", a.cross(b).w == 0.0f);
+		checkCondition("vec4 == self", a == a);
+		checkCondition("vec4 != self", !(a != a));
+		checkCondition("vec4 != vec4", (a != b) == (l_a != l_b));
+	}
+
+	void testMat4()
+	{
+		// TMat4<float> is only 16-byte aligned, the 256-bit accesses must not assume more
+		alignas(32) unsigned char l_buffer[2 * sizeof(mat4) + 16];
+		auto l_m = new (l_buffer + 16) mat4(randomMat4());
+		auto l_n = new (l_buffer + 16 + sizeof(mat4)) mat4(randomMat4());
+		auto& m = *l_m;
+		auto& n = *l_n;
+
+		auto v = randomVec4();
+		auto s = randomFloat(-10.0f, 10.0f);
+		auto l_dm = toDouble(m);
+		auto l_dn = toDouble(n);
+		auto l_dv = toDouble(v);
+
+		check("mat4 * mat4", m * n, l_dm * l_dn, 400.0);
+		check("mat4 * float", m * s, l_dm * (double)s, 100.0);
+		check("mat4::transpose", m.transpose(), l_dm.transpose(), 10.0);
+		//Column-Major memory layout
+#if defined (USE_COLUMN_MAJOR_MEMORY_LAYOUT)
+		check("mul(vec4, mat4)", InnoMath::mul(v, m), InnoMath::mul(l_dv, l_dm), 400.0);
+#endif
+		//Row-Major memory layout
+#if defined (USE_ROW_MAJOR_MEMORY_LAYOUT)
+		check("mul(mat4, vec4)", InnoMath::mul(m, v), InnoMath::mul(l_dm, l_dv), 400.0);
+#endif
+
+		auto l_pos = vec4(randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), 1.0f);
+		auto l_rot = randomVec4().normalize();
+		auto l_scale = vec4(randomFloat(0.5f, 2.0f), randomFloat(0.5f, 2.0f), randomFloat(0.5f, 2.0f), 1.0f);
+		check("composeTransformationMatrix", InnoMath::composeTransformationMatrix(l_pos, l_rot, l_scale), InnoMath::composeTransformationMatrix(toDouble(l_pos), toDouble(l_rot), toDouble(l_scale)), 20.0);
+
+		l_n->~mat4();
+		l_m->~mat4();
+	}
+
+	void testTrigonometry()
+	{
+		auto x = randomFloat(-8192.0f, 8192.0f);
+		auto l_small = randomFloat(-4.0f, 4.0f);
+		auto l_unit = randomFloat(-1.0f, 1.0f);
+		auto l_y = randomFloat(-10.0f, 10.0f);
+		auto l_x = randomFloat(-10.0f, 10.0f);
+
+		check("fastSin", InnoMath::fastSin(x), std::sin((double)x), 1.0, m_sinTolerance);
+		check("fastCos", InnoMath::fastCos(x), std::cos((double)x), 1.0, m_sinTolerance);
+		check("fastSin small", InnoMath::fastSin(l_small), std::sin((double)l_small), 1.0, m_sinTolerance);
+		check("fastCos small", InnoMath::fastCos(l_small), std::cos((double)l_small), 1.0, m_sinTolerance);
+		check("fastAcos", InnoMath::fastAcos(l_unit), std::acos((double)l_unit), 1.0, m_acosTolerance);
+		check("fastAsin", InnoMath::fastAsin(l_unit), std::asin((double)l_unit), 1.0, m_acosTolerance);
+		check("fastAtan2", InnoMath::fastAtan2(l_y, l_x), std::atan2((double)l_y, (double)l_x), 1.0, m_atan2Tolerance);
+	}
+
+	void testBatch(size_t size)
+	{
+		std::vector<vec4> a(size);
+		std::vector<vec4> b(size);
+		std::vector<vec4> l_slerp(size);
+		std::vector<vec4> l_nlerp(size);
+
+		for (size_t i = 0; i < size; i++)
+		{
+			a[i] = randomVec4().normalize();
+			b[i] = randomVec4().normalize();
+		}
+		auto l_alpha = randomFloat(0.0f, 1.0f);
+
+		InnoMath::slerp(a.data(), b.data(), l_alpha, l_slerp.data(), size);
+		InnoMath::nlerp(a.data(), b.data(), l_alpha, l_nlerp.data(), size);
+
+		for (size_t i = 0; i < size; i++)
+		{
+			auto l_a = toDouble(a[i]);
+			auto l_b = toDouble(b[i]);
+			check("batched slerp", l_slerp[i], InnoMath::slerp(l_a, l_b, (double)l_alpha), 1.0, m_batchTolerance);
+
+			// the rounding error of the normalization grows with the inverse length of the interpolated quaternion
+			auto l_lerp = l_a * (double)l_alpha + l_b * (1.0 - (double)l_alpha);
+			check("batched nlerp", l_nlerp[i], InnoMath::nlerp(l_a, l_b, (double)l_alpha), 1.0 / std::sqrt(l_lerp * l_lerp), m_batchTolerance);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t l_iterations = 100000;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string l_arg = argv[i];
+
+		if (l_arg == "--iterations" && i + 1 < argc)
+		{
+			l_iterations = std::stoull(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "InnoMathTest: unknown argument " << l_arg << std::endl;
+			return 1;
+		}
+	}
+
+	for (size_t i = 0; i < l_iterations; i++)
+	{
+		InnoMathTest::testVec4();
+		InnoMathTest::testMat4();
+		InnoMathTest::testTrigonometry();
+		InnoMathTest::testBatch(InnoMathTest::m_batchSizes[i % (sizeof(InnoMathTest::m_batchSizes) / sizeof(size_t))]);
+	}
+
+	std::cout << "InnoMathTest: " << l_iterations << " iterations, max relative error " << InnoMathTest::m_maxError << ", " << InnoMathTest::m_failureCount << " failures" << std::endl;
+
+	return InnoMathTest::m_failureCount ? 1 : 0;
+}
@@ -0,0 +1,42 @@
+
+#ifndef INNO_GAME_EXPORT_H
+#define INNO_GAME_EXPORT_H
+
+#ifdef INNO_GAME_BUILT_AS_STATIC
+#  define INNO_GAME_EXPORT
+#  define INNO_GAME_NO_EXPORT
+#else
+#  ifndef INNO_GAME_EXPORT
+#    ifdef InnoGame_EXPORTS
+        /* We are building this library */
+#      define INNO_GAME_EXPORT __attribute__((visibility("default")))
+#    else
+        /* We are using this library */
+#      define INNO_GAME_EXPORT __attribute__((visibility("default")))
+#    endif
+#  endif
+
+#  ifndef INNO_GAME_NO_EXPORT
+#    define INNO_GAME_NO_EXPORT __attribute__((visibility("hidden")))
+#  endif
+#endif
+
+#ifndef INNO_GAME_DEPRECATED
+#  define INNO_GAME_DEPRECATED __attribute__ ((__deprecated__))
+#endif
+
+#ifndef INNO_GAME_DEPRECATED_EXPORT
+#  define INNO_GAME_DEPRECATED_EXPORT INNO_GAME_EXPORT INNO_GAME_DEPRECATED
+#endif
+
+#ifndef INNO_GAME_DEPRECATED_NO_EXPORT
+#  define INNO_GAME_DEPRECATED_NO_EXPORT INNO_GAME_NO_EXPORT INNO_GAME_DEPRECATED
+#endif
+
+#if 0 /* DEFINE_NO_DEPRECATED */
+#  ifndef INNO_GAME_NO_DEPRECATED
+#    define INNO_GAME_NO_DEPRECATED
+#  endif
+#endif
+
+#endif /* INNO_GAME_EXPORT_H */